@@ -0,0 +1,127 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+// Solution of a model made of independent blocks
+// - as a whole
+// - block by block (DecompositionSolver.hpp) with a single worker and with the hardware threads
+// and cost of the evaluations of a block (SubModel.hpp): the objective and the Lagrangian Hessian of a block are
+// evaluated on the variables of the block only (subset evaluations of the original model)
+// Usage: decomposition_benchmark [number of blocks ...]. Run from the build directory (uno.options is copied there)
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DecompositionSolver.hpp"
+#include "Uno.hpp"
+#include "interfaces/Modeling/ModelBuilder.hpp"
+#include "linear_algebra/CSCSymmetricMatrix.hpp"
+#include "optimization/SubModel.hpp"
+#include "preprocessing/Decomposition.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Options.hpp"
+
+thread_local Level Logger::level = INFO;
+
+// min sum_k (x_2k - a_k)^2 + exp(x_2k+1) - x_2k+1 s.t. x_2k^2 + x_2k+1^2 <= 4 (reentrant NLModel)
+std::unique_ptr<Model> build_blocks(size_t number_blocks) {
+   ModelBuilder builder("blocks");
+   std::vector<Expression> terms;
+   for (size_t k = 0; k < number_blocks; k++) {
+      const Expression x = builder.add_variable(-INF<double>, INF<double>, 0.5);
+      const Expression y = builder.add_variable(-INF<double>, INF<double>, 0.5);
+      const double a = 1. + static_cast<double>(k % 5);
+      terms.push_back(pow(x - a, 2.) + exp(y) - y);
+      builder.add_constraint(pow(x, 2.) + pow(y, 2.), -INF<double>, 4.);
+   }
+   builder.minimize(sum(terms));
+   return builder.build();
+}
+
+template <typename Function>
+double best_time(size_t number_repetitions, const Function& function) {
+   double time = std::numeric_limits<double>::infinity();
+   for (size_t repetition = 0; repetition < number_repetitions; repetition++) {
+      const auto start = std::chrono::steady_clock::now();
+      function();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      time = std::min(time, elapsed.count());
+   }
+   return time;
+}
+
+// Lagrangian Hessian of the whole model and of its first block
+std::pair<double, double> hessian_times(size_t number_blocks) {
+   const size_t number_evaluations = 100;
+   std::unique_ptr<Model> model = build_blocks(number_blocks);
+   std::vector<double> x(model->number_variables);
+   model->get_initial_primal_point(x);
+   const std::vector<double> multipliers(model->number_constraints, 1.);
+   CSCSymmetricMatrix<double> hessian(model->number_variables, model->get_number_hessian_nonzeros(), false);
+   const double model_time = best_time(number_evaluations, [&]() {
+      model->evaluate_lagrangian_hessian(x, 1., multipliers, hessian);
+   });
+
+   const std::vector<ModelComponent> components = Decomposition::compute_components(*model, x);
+   const ModelComponent& component = components.front();
+   std::vector<Interval> variable_bounds(component.variables.size(), {-INF<double>, INF<double>});
+   const std::shared_ptr<const Model> original_model(std::move(model));
+   const SubModel block("block", original_model, component.variables, component.constraints, x, std::move(variable_bounds));
+   std::vector<double> block_x(block.number_variables);
+   block.get_initial_primal_point(block_x);
+   const std::vector<double> block_multipliers(block.number_constraints, 1.);
+   CSCSymmetricMatrix<double> block_hessian(block.number_variables, block.number_variables, false);
+   const double block_time = best_time(number_evaluations, [&]() {
+      block.evaluate_lagrangian_hessian(block_x, 1., block_multipliers, block_hessian);
+   });
+   return {model_time, block_time};
+}
+
+int main(int argc, char* argv[]) {
+   Logger::set_logger("ERROR");
+   std::vector<size_t> numbers_blocks{10, 100, 400};
+   if (1 < argc) {
+      numbers_blocks.clear();
+      for (int argument = 1; argument < argc; argument++) {
+         numbers_blocks.push_back(std::strtoul(argv[argument], nullptr, 10));
+      }
+   }
+   Options options = get_default_options("uno.options");
+   find_preset("ipopt", options);
+   options["linear_solver"] = "LDL";
+   options["logger"] = "ERROR";
+   options["statistics_sink"] = "none";
+   options["trace_file"] = "none";
+   const size_t number_threads = std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+
+   std::cout << std::setw(8) << "blocks" << std::setw(14) << "whole (s)" << std::setw(14) << "1 worker (s)" << std::setw(14) <<
+         (std::to_string(number_threads) + " workers (s)") << std::setw(20) << "Hessian: model (s)" << std::setw(20) << "Hessian: block (s)" << '\n';
+   for (size_t number_blocks: numbers_blocks) {
+      const size_t number_repetitions = 3;
+      const double whole_time = best_time(number_repetitions, [&]() {
+         (void) Uno::solve_model(build_blocks(number_blocks), options);
+      });
+      const DecompositionSolver sequential_solver([&]() {
+         return build_blocks(number_blocks);
+      }, 1);
+      const double sequential_time = best_time(number_repetitions, [&]() {
+         (void) sequential_solver.solve(options);
+      });
+      const DecompositionSolver concurrent_solver([&]() {
+         return build_blocks(number_blocks);
+      }, number_threads);
+      const double concurrent_time = best_time(number_repetitions, [&]() {
+         (void) concurrent_solver.solve(options);
+      });
+      const auto [model_hessian_time, block_hessian_time] = hessian_times(number_blocks);
+      std::cout << std::setw(8) << number_blocks << std::scientific << std::setprecision(3) << std::setw(14) << whole_time <<
+            std::setw(14) << sequential_time << std::setw(14) << concurrent_time << std::setw(20) << model_hessian_time <<
+            std::setw(20) << block_hessian_time << '\n' << std::defaultfloat;
+   }
+   return EXIT_SUCCESS;
+}
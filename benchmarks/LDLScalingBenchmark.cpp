@@ -0,0 +1,88 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+// Scaling of the numerical factorization of SparseLDLSolver with the number of threads.
+// Usage: ldl_scaling_benchmark matrix1.mtx [matrix2.mtx ...]
+// The matrices are symmetric Matrix Market files, e.g. KKT matrices dumped with the option augmented_system_dump_prefix.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+#include "solvers/linear/SparseLDLSolver.hpp"
+#include "tools/Logger.hpp"
+
+thread_local Level Logger::level = INFO;
+
+std::unique_ptr<COOSymmetricMatrix<double>> read_matrix_market(const std::string& file_name) {
+   std::ifstream file(file_name);
+   if (not file) {
+      throw std::invalid_argument("The file " + file_name + " could not be opened");
+   }
+   std::string line;
+   // skip the header and the comments
+   do {
+      std::getline(file, line);
+   } while (not line.empty() && line[0] == '%');
+   std::istringstream sizes(line);
+   size_t number_rows, number_columns, number_entries;
+   sizes >> number_rows >> number_columns >> number_entries;
+   if (number_rows != number_columns) {
+      throw std::invalid_argument("The matrix in " + file_name + " is not square");
+   }
+   auto matrix = std::make_unique<COOSymmetricMatrix<double>>(number_rows, number_entries, false);
+   for (size_t k = 0; k < number_entries; k++) {
+      size_t i, j;
+      double entry;
+      file >> i >> j >> entry;
+      // stored in the upper triangle, 0-based
+      matrix->insert(entry, std::min(i, j) - 1, std::max(i, j) - 1);
+   }
+   return matrix;
+}
+
+int main(int argc, char* argv[]) {
+   if (argc < 2) {
+      std::cout << "Usage: " << argv[0] << " matrix1.mtx [matrix2.mtx ...]\n";
+      return EXIT_FAILURE;
+   }
+   const std::vector<size_t> thread_counts{1, 2, 4, 8, 16, 32};
+   const size_t number_repetitions = 5;
+
+   std::cout << std::setw(40) << std::left << "matrix" << std::right << std::setw(10) << "dimension" << std::setw(12) << "nonzeros";
+   for (size_t number_threads: thread_counts) {
+      std::cout << std::setw(12) << (std::to_string(number_threads) + " thr (s)") << std::setw(9) << "speedup";
+   }
+   std::cout << '\n';
+
+   for (int argument = 1; argument < argc; argument++) {
+      const std::string file_name(argv[argument]);
+      const auto matrix = read_matrix_market(file_name);
+      SparseLDLSolver solver(matrix->dimension, matrix->number_nonzeros, std::make_unique<FillReducingOrdering>("MD", "none"), 1);
+      solver.do_symbolic_factorization(*matrix);
+
+      std::cout << std::setw(40) << std::left << file_name << std::right << std::setw(10) << matrix->dimension << std::setw(12) << matrix->number_nonzeros;
+      double sequential_time = 0.;
+      for (size_t number_threads: thread_counts) {
+         solver.set_number_threads(number_threads);
+         // best time over the repetitions
+         double best_time = std::numeric_limits<double>::infinity();
+         for (size_t repetition = 0; repetition < number_repetitions; repetition++) {
+            const auto start = std::chrono::steady_clock::now();
+            solver.do_numerical_factorization(*matrix);
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best_time = std::min(best_time, elapsed.count());
+         }
+         if (number_threads == 1) {
+            sequential_time = best_time;
+         }
+         std::cout << std::setw(12) << std::scientific << std::setprecision(3) << best_time << std::setw(9) << std::fixed << std::setprecision(2) <<
+               sequential_time / best_time;
+      }
+      std::cout << '\n';
+   }
+   return EXIT_SUCCESS;
+}
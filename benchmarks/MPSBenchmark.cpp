@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+// Solution of LPs and QPs in MPS/QPS format with each preset, by
+// - the dedicated convex QP interior-point method (ConvexQPSolver.hpp)
+// - the ingredients of the preset (-convex_qp_solver no). The SQP presets need a QP solver (BQPD): without it, their
+//   ingredients are reported as unavailable
+// Usage: mps_benchmark [file.mps ...] (default: the MPS/QPS files of the examples directory). Run from the build
+// directory (uno.options and examples are copied there)
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Uno.hpp"
+#include "interfaces/MPS/MPSModel.hpp"
+#include "solvers/linear/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Options.hpp"
+
+thread_local Level Logger::level = INFO;
+
+// best time of several solves (the problems are small)
+double best_time(const std::string& file_name, const Options& options, std::optional<Result>& result) {
+   const size_t number_repetitions = 10;
+   double time = std::numeric_limits<double>::infinity();
+   for (size_t repetition = 0; repetition < number_repetitions; repetition++) {
+      const auto start = std::chrono::steady_clock::now();
+      result.emplace(Uno::solve_model(std::make_unique<MPSModel>(file_name), options));
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      time = std::min(time, elapsed.count());
+   }
+   return time;
+}
+
+std::string outcome(const Result& result) {
+   std::ostringstream stream;
+   stream << ((result.solution.status == TerminationStatus::FEASIBLE_KKT_POINT) ? "" : "(failed) ") << std::setprecision(8) <<
+         result.solution.evaluations.objective;
+   return stream.str();
+}
+
+int main(int argc, char* argv[]) {
+   Logger::set_logger("ERROR");
+   std::vector<std::string> file_names{"examples/lp_small.mps", "examples/qp_small.qps", "examples/transport.mps"};
+   if (1 < argc) {
+      file_names.assign(argv + 1, argv + argc);
+   }
+
+   std::cout << std::setw(24) << std::left << "problem" << std::setw(12) << "preset" << std::right << std::setw(18) << "objective" <<
+         std::setw(16) << "convex QP (s)" << std::setw(18) << "ingredients (s)" << std::setw(10) << "speedup" << '\n';
+   for (const std::string& file_name: file_names) {
+      for (const std::string preset: {"ipopt", "filtersqp", "byrd", "funnelsqp"}) {
+         Options options = get_default_options("uno.options");
+         find_preset(preset, options);
+         // MA57 if available, LDL otherwise
+         options["linear_solver"] = SymmetricIndefiniteLinearSolverFactory::available_solvers().front() == "MA57" ? "MA57" : "LDL";
+         options["logger"] = "ERROR";
+         options["statistics_sink"] = "none";
+         options["trace_file"] = "none";
+         std::optional<Result> convex_qp_result, ingredients_result;
+         const double convex_qp_time = best_time(file_name, options, convex_qp_result);
+         // the line is printed once both solves are done (the solvers may print)
+         std::ostringstream line;
+         line << std::setw(24) << std::left << file_name.substr(file_name.find_last_of('/') + 1) << std::setw(12) << preset << std::right <<
+               std::setw(18) << outcome(*convex_qp_result) << std::scientific << std::setprecision(3) << std::setw(16) << convex_qp_time;
+         options["convex_qp_solver"] = "no";
+         try {
+            const double ingredients_time = best_time(file_name, options, ingredients_result);
+            line << std::setw(18) << ingredients_time << std::fixed << std::setprecision(2) << std::setw(10) <<
+                  ingredients_time / convex_qp_time << "   (ingredients: " << outcome(*ingredients_result) << ")";
+         }
+         catch (const std::exception&) {
+            line << std::setw(18) << "unavailable" << std::setw(10) << "-";
+         }
+         std::cout << line.str() << '\n';
+      }
+   }
+   return EXIT_SUCCESS;
+}
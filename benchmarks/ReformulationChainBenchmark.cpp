@@ -0,0 +1,148 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+// Bound and type queries of the interior-point reformulation (scaling, slacks, bound relaxation) through
+// - the chain of reformulations (one virtual call per reformulation)
+// - the materialized model (MaterializedModel.hpp)
+// Usage: reformulation_chain_benchmark [number of variables]
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "optimization/ModelFactory.hpp"
+#include "optimization/ScaledModel.hpp"
+#include "optimization/EqualityConstrainedModel.hpp"
+#include "optimization/BoundRelaxedModel.hpp"
+#include "optimization/MaterializedModel.hpp"
+#include "tools/Infinity.hpp"
+
+thread_local Level Logger::level = INFO;
+
+// model with bounds only (the evaluations are not benchmarked). One constraint for two variables, every other one
+// is an inequality
+class BoundsModel: public Model {
+public:
+   BoundsModel(size_t number_variables): Model("bounds", number_variables, number_variables / 2),
+         variable_status(number_variables), constraint_status(number_variables / 2) {
+      for (size_t i: Range(number_variables)) {
+         this->variable_status[i] = (i % 2 == 0) ? BOUNDED_BOTH_SIDES : BOUNDED_LOWER;
+         this->lower_bounded_variables.push_back(i);
+         if (i % 2 == 0) {
+            this->upper_bounded_variables.push_back(i);
+         }
+         else {
+            this->single_lower_bounded_variables.push_back(i);
+         }
+      }
+      for (size_t j: Range(this->number_constraints)) {
+         this->constraint_status[j] = (j % 2 == 0) ? EQUAL_BOUNDS : BOUNDED_UPPER;
+         if (j % 2 == 0) {
+            this->equality_constraints.push_back(j);
+         }
+         else {
+            this->inequality_constraints.push_back(j);
+         }
+      }
+   }
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override { return -static_cast<double>(i % 7); }
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override { return (i % 2 == 0) ? static_cast<double>(i % 5) : INF<double>; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override { return (j % 2 == 0) ? 1. : -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t /*j*/) const override { return 1.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override { return this->variable_status[i]; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*j*/) const override { return NONLINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override { return this->constraint_status[j]; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return 0; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return 0; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return 0; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& /*x*/) const override { return 0.; }
+   void evaluate_objective_gradient(const std::vector<double>& /*x*/, SparseVector<double>& /*gradient*/) const override { }
+   void evaluate_constraints(const std::vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+   void evaluate_constraint_gradient(const std::vector<double>& /*x*/, size_t /*j*/, SparseVector<double>& /*gradient*/) const override { }
+   void evaluate_constraint_jacobian(const std::vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+   void evaluate_lagrangian_hessian(const std::vector<double>& /*x*/, double /*objective_multiplier*/, const std::vector<double>& /*multipliers*/,
+         SymmetricMatrix<double>& /*hessian*/) const override { }
+   void get_initial_primal_point(std::vector<double>& /*x*/) const override { }
+   void get_initial_dual_point(std::vector<double>& /*multipliers*/) const override { }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+private:
+   std::vector<BoundType> variable_status;
+   std::vector<BoundType> constraint_status;
+   const std::vector<size_t> linear_constraints{};
+};
+
+std::unique_ptr<Model> create_chain(size_t number_variables, const Options& options) {
+   std::unique_ptr<Model> model = std::make_unique<BoundsModel>(number_variables);
+   // the functions are not scaled: the initial iterate is not evaluated
+   Iterate initial_iterate(0, 0);
+   model = std::make_unique<ScaledModel>(std::move(model), initial_iterate, options);
+   model = std::make_unique<EqualityConstrainedModel>(std::move(model));
+   return std::make_unique<BoundRelaxedModel>(std::move(model), options);
+}
+
+// typical loop of the interior-point method: distances to the bounds and bound types
+double interior_point_loop(const Model& model, const std::vector<double>& x) {
+   double result = 0.;
+   for (size_t i: Range(model.number_variables)) {
+      const double lower_bound = model.get_variable_lower_bound(i);
+      const double upper_bound = model.get_variable_upper_bound(i);
+      if (is_finite(lower_bound)) {
+         result += x[i] - lower_bound;
+      }
+      if (is_finite(upper_bound)) {
+         result += upper_bound - x[i];
+      }
+      if (model.get_variable_bound_type(i) == BOUNDED_BOTH_SIDES) {
+         result += 1.;
+      }
+   }
+   for (size_t j: Range(model.number_constraints)) {
+      result += model.get_constraint_lower_bound(j) + static_cast<double>(model.get_constraint_bound_type(j));
+   }
+   return result;
+}
+
+double best_time(const std::function<double()>& function, double& result) {
+   const size_t number_repetitions = 20;
+   double time = std::numeric_limits<double>::infinity();
+   for (size_t repetition = 0; repetition < number_repetitions; repetition++) {
+      const auto start = std::chrono::steady_clock::now();
+      result = function();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      time = std::min(time, elapsed.count());
+   }
+   return time;
+}
+
+int main(int argc, char* argv[]) {
+   const size_t n = (1 < argc) ? std::stoul(argv[1]) : 1000000;
+   Options options;
+   options["scale_functions"] = "no";
+   options["function_scaling_threshold"] = "100";
+   options["tolerance"] = "1e-8";
+   const std::unique_ptr<Model> chain = create_chain(n, options);
+   const MaterializedModel materialized_model(create_chain(n, options));
+   const std::vector<double> x(chain->number_variables, 0.5);
+
+   double chain_result, materialized_result;
+   const double chain_time = best_time([&]() {
+      return interior_point_loop(*chain, x);
+   }, chain_result);
+   const double materialized_time = best_time([&]() {
+      return interior_point_loop(materialized_model, x);
+   }, materialized_result);
+
+   std::cout << chain->number_variables << " variables, " << chain->number_constraints << " constraints\n";
+   std::cout << std::setw(30) << std::left << "query" << std::right << std::setw(14) << "chain (s)" << std::setw(18) << "materialized (s)" <<
+         std::setw(10) << "speedup" << '\n';
+   std::cout << std::setw(30) << std::left << "bounds and types" << std::right << std::scientific << std::setprecision(3) <<
+         std::setw(14) << chain_time << std::setw(18) << materialized_time << std::fixed << std::setprecision(2) <<
+         std::setw(10) << chain_time / materialized_time << "   (results " << std::scientific << chain_result << " / " << materialized_result << ")\n";
+   return EXIT_SUCCESS;
+}
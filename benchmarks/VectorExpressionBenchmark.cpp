@@ -0,0 +1,109 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+// Evaluation of the norm of the constraint violation and of a complementarity error with
+// - lazy expressions based on std::function (previous implementation of VectorExpression)
+// - expression templates (VectorExpression.hpp)
+// Usage: vector_expression_benchmark [size]
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "linear_algebra/Vector.hpp"
+#include "linear_algebra/VectorExpression.hpp"
+
+thread_local Level Logger::level = INFO;
+
+// previous implementation: one indirect call per component
+class FunctionExpression {
+public:
+   using value_type = double;
+
+   FunctionExpression(size_t size, const std::function<double(size_t)>& ith_component): length(size), ith_component(ith_component) { }
+   [[nodiscard]] size_t size() const { return this->length; }
+   [[nodiscard]] double operator[](size_t i) const { return this->ith_component(i); }
+
+protected:
+   const size_t length;
+   const std::function<double(size_t)> ith_component;
+};
+
+template <typename Function>
+double best_time(const Function& function, double& result) {
+   const size_t number_repetitions = 20;
+   double time = std::numeric_limits<double>::infinity();
+   for (size_t repetition = 0; repetition < number_repetitions; repetition++) {
+      const auto start = std::chrono::steady_clock::now();
+      result = function();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      time = std::min(time, elapsed.count());
+   }
+   return time;
+}
+
+void report(const std::string& name, const std::function<double()>& function_version, const std::function<double()>& template_version) {
+   double function_result, template_result;
+   const double function_time = best_time(function_version, function_result);
+   const double template_time = best_time(template_version, template_result);
+   std::cout << std::setw(30) << std::left << name << std::right << std::scientific << std::setprecision(3) <<
+         std::setw(14) << function_time << std::setw(14) << template_time << std::fixed << std::setprecision(2) <<
+         std::setw(10) << function_time / template_time << "   (results " << std::scientific << function_result << " / " << template_result << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+   const size_t n = (1 < argc) ? std::stoul(argv[1]) : 1000000;
+   std::vector<double> constraints(n), lower_bounds(n), upper_bounds(n), multipliers(n);
+   std::vector<size_t> inequality_constraints;
+   for (size_t j: Range(n)) {
+      constraints[j] = std::sin(static_cast<double>(j));
+      lower_bounds[j] = -0.5;
+      upper_bounds[j] = (j % 3 == 0) ? -0.5 : 0.5;
+      multipliers[j] = std::cos(static_cast<double>(j));
+      if (j % 3 != 0) {
+         inequality_constraints.push_back(j);
+      }
+   }
+   const auto constraint_violation = [&](size_t j) {
+      return std::max({0., lower_bounds[j] - constraints[j], constraints[j] - upper_bounds[j]});
+   };
+   const auto complementarity = [&](size_t j) {
+      if (0. < multipliers[j]) {
+         return multipliers[j] * (constraints[j] - lower_bounds[j]);
+      }
+      else if (multipliers[j] < 0.) {
+         return multipliers[j] * (constraints[j] - upper_bounds[j]);
+      }
+      return 0.;
+   };
+
+   std::cout << "size " << n << '\n';
+   std::cout << std::setw(30) << std::left << "expression" << std::right << std::setw(14) << "function (s)" << std::setw(14) << "template (s)" <<
+         std::setw(10) << "speedup" << '\n';
+   report("constraint violation (L1)", [&]() {
+      return norm_1(FunctionExpression(n, constraint_violation));
+   }, [&]() {
+      return norm_1(VectorExpression(n, constraint_violation));
+   });
+   report("constraint violation (INF)", [&]() {
+      return norm_inf(FunctionExpression(n, constraint_violation));
+   }, [&]() {
+      return norm_inf(VectorExpression(n, constraint_violation));
+   });
+   report("complementarity subset (L1)", [&]() {
+      return norm_1(FunctionExpression(inequality_constraints.size(), [&](size_t index) {
+         return complementarity(inequality_constraints[index]);
+      }));
+   }, [&]() {
+      return norm_1(subset(VectorExpression(n, complementarity), inequality_constraints));
+   });
+   report("projected residual (L2)", [&]() {
+      return norm_2(FunctionExpression(n, [&](size_t j) {
+         return std::min(std::max(constraints[j] - 0.5 * multipliers[j], lower_bounds[j]), upper_bounds[j]) - constraints[j];
+      }));
+   }, [&]() {
+      return norm_2(componentwise_min(componentwise_max(constraints - scale(0.5, multipliers), lower_bounds), upper_bounds) - constraints);
+   });
+   return EXIT_SUCCESS;
+}
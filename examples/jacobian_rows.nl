@@ -0,0 +1,48 @@
+g3 1 1 0	# problem jacobian_rows
+ 3 3 1 0 0	# vars, constraints, objectives, ranges, eqns
+ 2 1	# nonlinear constraints, objectives
+ 0 0	# network constraints: nonlinear, linear
+ 2 1 1	# nonlinear vars in constraints, objectives, both
+ 0 0 0 1	# linear network variables; functions; arith, flags
+ 0 0 0 0 0	# discrete variables: binary, integer, nonlinear (b,c,o)
+ 5 2	# nonzeros in Jacobian, gradients
+ 0 0	# max name lengths: constraints, variables
+ 0 0 0 0 0	# common exprs: b,c,o,c1,o1
+C0
+o2
+v0
+v1
+C1
+o44
+v0
+C2
+n0
+O0 0
+o5
+v0
+n2
+x3
+0 1
+1 2
+2 3
+r
+1 10
+1 20
+1 1
+b
+3
+3
+3
+k2
+2
+4
+J0 3
+0 0
+1 0
+2 2
+J1 2
+0 0
+1 3
+G0 2
+0 0
+2 1
@@ -0,0 +1,23 @@
+* max 3 x + 2 y + 1 s.t. x + y <= 4, x + 3 y <= 6, 1 <= x - y <= 2 (range), 0 <= x <= 3, y >= 0
+* optimal solution: x = 3, y = 1, objective 12 (fixed and free formats)
+NAME          LPSMALL
+OBJSENSE
+    MAX
+ROWS
+ N  PROFIT
+ L  LIM1
+ L  LIM2
+ G  DIFF
+COLUMNS
+    X         PROFIT    3.0            LIM1      1.0
+    X         LIM2      1.0            DIFF      1.0
+    Y         PROFIT    2.0            LIM1      1.0
+    Y         LIM2      3.0            DIFF      -1.0
+RHS
+    RHS       LIM1      4.0            LIM2      6.0
+    RHS       DIFF      1.0            PROFIT    -1.0
+RANGES
+    RNG       DIFF      1.0
+BOUNDS
+ UP BND       X         3.0
+ENDATA
@@ -0,0 +1,43 @@
+* transportation problem: 3 sources with supplies (20, 30, 25), 4 destinations with demands (10, 25, 15, 20)
+* optimal objective 550
+NAME TRANSPORT
+ROWS
+ N COST
+ L SUPPLY1
+ L SUPPLY2
+ L SUPPLY3
+ E DEMAND1
+ E DEMAND2
+ E DEMAND3
+ E DEMAND4
+COLUMNS
+ X11 COST 8.0 SUPPLY1 1.0
+ X11 DEMAND1 1.0
+ X12 COST 6.0 SUPPLY1 1.0
+ X12 DEMAND2 1.0
+ X13 COST 10.0 SUPPLY1 1.0
+ X13 DEMAND3 1.0
+ X14 COST 9.0 SUPPLY1 1.0
+ X14 DEMAND4 1.0
+ X21 COST 9.0 SUPPLY2 1.0
+ X21 DEMAND1 1.0
+ X22 COST 12.0 SUPPLY2 1.0
+ X22 DEMAND2 1.0
+ X23 COST 13.0 SUPPLY2 1.0
+ X23 DEMAND3 1.0
+ X24 COST 7.0 SUPPLY2 1.0
+ X24 DEMAND4 1.0
+ X31 COST 14.0 SUPPLY3 1.0
+ X31 DEMAND1 1.0
+ X32 COST 9.0 SUPPLY3 1.0
+ X32 DEMAND2 1.0
+ X33 COST 16.0 SUPPLY3 1.0
+ X33 DEMAND3 1.0
+ X34 COST 5.0 SUPPLY3 1.0
+ X34 DEMAND4 1.0
+RHS
+ RHS SUPPLY1 20.0 SUPPLY2 30.0
+ RHS SUPPLY3 25.0 DEMAND1 10.0
+ RHS DEMAND2 25.0 DEMAND3 15.0
+ RHS DEMAND4 20.0
+ENDATA
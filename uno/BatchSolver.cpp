@@ -0,0 +1,152 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <new>
+#include <thread>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#include "BatchSolver.hpp"
+#include "Uno.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+
+BatchSolver::BatchSolver(ModelLoader model_loader, size_t number_workers, size_t memory_limit):
+      model_loader(std::move(model_loader)),
+      number_workers((0 < number_workers) ? number_workers : std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency()))),
+      memory_limit(memory_limit) {
+}
+
+// the address space is shared by the workers: the budget of a job is enforced on the whole process (budget of all
+// workers plus what is already mapped). A job that exceeds it fails with std::bad_alloc, the other jobs carry on
+class AddressSpaceLimit {
+public:
+   AddressSpaceLimit(size_t memory_limit, size_t number_workers) {
+#ifdef __linux__
+      if (0 < memory_limit && getrlimit(RLIMIT_AS, &this->previous_limit) == 0) {
+         // memory already mapped by the process (first field of /proc/self/statm, in pages)
+         size_t mapped_pages = 0;
+         std::ifstream statm("/proc/self/statm");
+         statm >> mapped_pages;
+         const rlim_t mapped_memory = static_cast<rlim_t>(mapped_pages) * static_cast<rlim_t>(sysconf(_SC_PAGESIZE));
+         // each worker also needs a stack and a malloc arena
+         constexpr rlim_t worker_overhead = rlim_t(128) << 20;
+         rlimit limit = this->previous_limit;
+         limit.rlim_cur = std::min(this->previous_limit.rlim_max, mapped_memory +
+               static_cast<rlim_t>(number_workers) * ((static_cast<rlim_t>(memory_limit) << 20) + worker_overhead));
+         this->is_set = (setrlimit(RLIMIT_AS, &limit) == 0);
+      }
+#else
+      (void) memory_limit;
+      (void) number_workers;
+#endif
+   }
+
+   ~AddressSpaceLimit() {
+#ifdef __linux__
+      if (this->is_set) {
+         setrlimit(RLIMIT_AS, &this->previous_limit);
+      }
+#endif
+   }
+
+private:
+#ifdef __linux__
+   rlimit previous_limit{};
+#endif
+   bool is_set{false};
+};
+
+std::vector<BatchResult> BatchSolver::solve(const std::vector<BatchJob>& jobs) const {
+   std::vector<BatchResult> results(jobs.size());
+   const size_t number_threads = std::min(this->number_workers, jobs.size());
+   const AddressSpaceLimit address_space_limit(this->memory_limit, number_threads);
+
+   // the workers pick the next job until there are none left
+   std::atomic<size_t> next_job{0};
+   const auto worker = [&]() {
+      for (size_t job_index = next_job++; job_index < jobs.size(); job_index = next_job++) {
+         results[job_index] = this->solve_job(jobs[job_index]);
+      }
+   };
+   std::vector<std::thread> threads;
+   threads.reserve(number_threads);
+   for (size_t thread_index = 0; thread_index < number_threads; thread_index++) {
+      threads.emplace_back(worker);
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   return results;
+}
+
+BatchResult BatchSolver::solve_job(const BatchJob& job) const {
+   BatchResult result;
+   result.model_file = job.model_file;
+   result.option_set = job.option_set;
+   Timer timer{};
+   try {
+      // the verbosity is per thread
+      Logger::set_logger(job.options.get_string("logger"));
+      std::unique_ptr<Model> model = this->model_loader(job.model_file);
+      const Result solve_result = Uno::solve_model(std::move(model), job.options);
+      result.status = to_string(solve_result.solution.status);
+      if (solve_result.solution.status == TerminationStatus::NOT_OPTIMAL) {
+         if (job.options.get_double("time_limit") <= solve_result.cpu_time) {
+            result.status = "time limit";
+         }
+         else if (job.options.get_unsigned_int("max_iterations") <= solve_result.iteration) {
+            result.status = "iteration limit";
+         }
+      }
+      result.objective = solve_result.solution.evaluations.objective;
+      result.iterations = solve_result.iteration;
+      result.objective_evaluations = solve_result.objective_evaluations;
+      result.constraint_evaluations = solve_result.constraint_evaluations;
+      result.objective_gradient_evaluations = solve_result.objective_gradient_evaluations;
+      result.jacobian_evaluations = solve_result.jacobian_evaluations;
+      result.hessian_evaluations = solve_result.hessian_evaluations;
+      result.number_subproblems_solved = solve_result.number_subproblems_solved;
+   }
+   catch (const std::bad_alloc&) {
+      result.status = "memory limit";
+   }
+   catch (const std::exception& exception) {
+      std::string message = exception.what();
+      std::replace(message.begin(), message.end(), '\n', ' ');
+      result.status = "error: " + message;
+   }
+   result.wall_time = timer.get_duration();
+   return result;
+}
+
+static void write_csv_string(std::ostream& stream, const std::string& value) {
+   stream << '"';
+   for (char character: value) {
+      stream << ((character == '"') ? "\"\"" : std::string(1, character));
+   }
+   stream << '"';
+}
+
+void BatchSolver::write_results(std::ostream& stream, const std::vector<BatchResult>& results) {
+   const std::streamsize precision = stream.precision(std::numeric_limits<double>::max_digits10);
+   stream << "model,option set,status,objective,iterations,objective evaluations,constraint evaluations,objective gradient evaluations,"
+             "Jacobian evaluations,Hessian evaluations,subproblems solved,wall time\n";
+   for (const BatchResult& result: results) {
+      write_csv_string(stream, result.model_file);
+      stream << ',';
+      write_csv_string(stream, result.option_set);
+      stream << ',';
+      write_csv_string(stream, result.status);
+      stream << ',' << result.objective << ',' << result.iterations << ',' << result.objective_evaluations << ',' <<
+            result.constraint_evaluations << ',' << result.objective_gradient_evaluations << ',' << result.jacobian_evaluations << ',' <<
+            result.hessian_evaluations << ',' << result.number_subproblems_solved << ',' << result.wall_time << '\n';
+   }
+   stream.precision(precision);
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCHSOLVER_H
+#define UNO_BATCHSOLVER_H
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "optimization/Model.hpp"
+#include "tools/Options.hpp"
+
+// a model solved with a named set of options
+struct BatchJob {
+   std::string model_file;
+   std::string option_set;
+   Options options;
+};
+
+struct BatchResult {
+   std::string model_file;
+   std::string option_set;
+   std::string status{"not solved"};
+   double objective{0.};
+   size_t iterations{0};
+   size_t objective_evaluations{0};
+   size_t constraint_evaluations{0};
+   size_t objective_gradient_evaluations{0};
+   size_t jacobian_evaluations{0};
+   size_t hessian_evaluations{0};
+   size_t number_subproblems_solved{0};
+   double wall_time{0.};
+};
+
+/*! \class BatchSolver
+ * \brief Solves many models concurrently in the same process
+ *
+ *  The jobs are distributed on a pool of workers. Each job loads its own model and builds its own ingredients,
+ *  so that the solves share no state. The time limit of a job is its time_limit option.
+ *  The exception is BQPD (QP and LP solver of the SQP/SLP presets), which is not reentrant: its solves are serialized
+ *  across all the workers, so that concurrent SQP jobs only overlap outside of their subproblems.
+ */
+class BatchSolver {
+public:
+   using ModelLoader = std::function<std::unique_ptr<Model>(const std::string& model_file)>;
+
+   // number_workers = 0: number of hardware threads. memory_limit (in MB per job) = 0: no limit
+   BatchSolver(ModelLoader model_loader, size_t number_workers, size_t memory_limit);
+
+   // the results are in the order of the jobs
+   [[nodiscard]] std::vector<BatchResult> solve(const std::vector<BatchJob>& jobs) const;
+   static void write_results(std::ostream& stream, const std::vector<BatchResult>& results);
+
+private:
+   const ModelLoader model_loader;
+   const size_t number_workers;
+   const size_t memory_limit;
+
+   [[nodiscard]] BatchResult solve_job(const BatchJob& job) const;
+};
+
+#endif // UNO_BATCHSOLVER_H
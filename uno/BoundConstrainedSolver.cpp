@@ -0,0 +1,351 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include "BoundConstrainedSolver.hpp"
+#include "Uno.hpp"
+#include "linear_algebra/SymmetricMatrixFactory.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "optimization/Iterate.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
+#include "tools/Timer.hpp"
+
+// ratio of actual to predicted reduction above which the step is accepted
+constexpr double ACCEPTANCE_RATIO = 1e-4;
+// ratio above which a step on the boundary of the trust region increases the radius
+constexpr double INCREASE_RATIO = 0.75;
+// fraction of the radius above which a step is on the boundary of the trust region
+constexpr double BOUNDARY_FRACTION = 0.99;
+// fraction of the first-order decrease that the Cauchy point must achieve
+constexpr double SUFFICIENT_DECREASE_FRACTION = 0.01;
+constexpr double BACKTRACKING_RATIO = 0.5;
+constexpr size_t MAX_BACKTRACKS = 50;
+
+BoundConstrainedSolver::BoundConstrainedSolver(const Model& model, const Options& options):
+      max_iterations(options.get_unsigned_int("max_iterations")),
+      time_limit(options.get_double("time_limit")),
+      trace_file_name(options.get_string("trace_file")),
+      tolerance(options.get_double("tolerance")),
+      unbounded_objective_threshold(options.get_double("unbounded_objective_threshold")),
+      radius(options.get_double("TR_radius")),
+      increase_factor(options.get_double("TR_increase_factor")),
+      decrease_factor(options.get_double("TR_decrease_factor")),
+      min_radius(options.get_double("TR_min_radius")),
+      lower_bounds(model.number_variables),
+      upper_bounds(model.number_variables),
+      hessian(SymmetricMatrixFactory<double>::create(options.get_string("sparse_format"), model.number_variables,
+            model.get_number_hessian_nonzeros(), false)),
+      trust_region_lower_bounds(model.number_variables),
+      trust_region_upper_bounds(model.number_variables),
+      gradient(model.number_variables),
+      cauchy_point(model.number_variables),
+      cauchy_step(model.number_variables),
+      trial_point(model.number_variables),
+      step(model.number_variables),
+      hessian_product(model.number_variables),
+      conjugate_direction(model.number_variables),
+      residual(model.number_variables),
+      newton_direction(model.number_variables) {
+   for (size_t i: Range(model.number_variables)) {
+      this->lower_bounds[i] = model.get_variable_lower_bound(i);
+      this->upper_bounds[i] = model.get_variable_upper_bound(i);
+   }
+}
+
+bool BoundConstrainedSolver::is_applicable(const Model& model, const Options& options) {
+   return options.get_bool("gradient_projection") && options.get_string("hessian_model") == "exact" && not model.is_constrained() &&
+         (not model.lower_bounded_variables.empty() || not model.upper_bounded_variables.empty());
+}
+
+Statistics BoundConstrainedSolver::create_statistics(const Options& options) {
+   Statistics statistics(options);
+   statistics.add_column("iters", ColumnType::INTEGER, options.get_int("statistics_major_column_order"));
+   statistics.add_column("CG iters", ColumnType::INTEGER, options.get_int("statistics_minor_column_order"));
+   statistics.add_column("TR radius", ColumnType::DOUBLE, options.get_int("statistics_TR_radius_column_order"));
+   statistics.add_column("step norm", ColumnType::DOUBLE, options.get_int("statistics_step_norm_column_order"));
+   statistics.add_column("objective", ColumnType::DOUBLE, options.get_int("statistics_objective_column_order"));
+   statistics.add_column("stationarity", ColumnType::DOUBLE, options.get_int("statistics_stationarity_column_order"));
+   return statistics;
+}
+
+Result BoundConstrainedSolver::solve(Statistics& statistics, const Model& model, Iterate& current_iterate) {
+   Timer timer{};
+   Uno::reset_evaluation_counters();
+   size_t iteration = 0;
+   // the solve scope ends before the trace is closed
+   const TraceSession trace_session(this->trace_file_name);
+   PROFILE_SCOPE("solve");
+
+   INFO << "\nProblem " << model.name << '\n';
+   INFO << model.number_variables << " variables, bound constrained: gradient projection\n\n";
+
+   try {
+      this->evaluate_derivatives(model, current_iterate);
+   }
+   catch (const std::exception& e) {
+      ERROR << RED << "An error occurred at the initial iterate: " << e.what() << RESET;
+      throw;
+   }
+   this->compute_residuals(current_iterate);
+
+   const std::vector<double> constraint_multipliers{};
+   Iterate trial_iterate(model.number_variables, 0);
+   // the Hessian is evaluated at the current iterate, that is at the initial point and after each accepted step
+   bool is_hessian_evaluated = false;
+   try {
+      while (current_iterate.status == TerminationStatus::NOT_OPTIMAL && iteration < this->max_iterations &&
+            timer.get_duration() < this->time_limit) {
+         PROFILE_SCOPE("iteration");
+         Cancellation::check();
+         statistics.new_line();
+         iteration++;
+         DEBUG << "### Outer iteration " << iteration << '\n';
+
+         if (not is_hessian_evaluated) {
+            model.evaluate_lagrangian_hessian(current_iterate.primals, 1., constraint_multipliers, *this->hessian);
+            this->hessian_evaluations++;
+            is_hessian_evaluated = true;
+         }
+         size_t number_cg_iterations = 0;
+         const double predicted_reduction = -this->compute_step(current_iterate, number_cg_iterations);
+         const double step_norm = norm_inf(this->step);
+
+         // evaluate the objective at the trial point
+         trial_iterate.primals = this->trial_point;
+         trial_iterate.is_objective_computed = false;
+         trial_iterate.is_objective_gradient_computed = false;
+         double actual_reduction = -INF<double>;
+         try {
+            trial_iterate.evaluate_objective(model);
+            actual_reduction = current_iterate.evaluations.objective - trial_iterate.evaluations.objective;
+         }
+         catch (const FunctionEvaluationError&) {
+            DEBUG << "The objective could not be evaluated at the trial point\n";
+         }
+
+         // trust-region update
+         const double ratio = (0. < predicted_reduction) ? actual_reduction / predicted_reduction : -INF<double>;
+         DEBUG << "Actual/predicted reduction ratio: " << ratio << '\n';
+         if (ACCEPTANCE_RATIO <= ratio) {
+            std::swap(current_iterate, trial_iterate);
+            this->evaluate_derivatives(model, current_iterate);
+            is_hessian_evaluated = false;
+            this->compute_residuals(current_iterate);
+            if (INCREASE_RATIO < ratio && BOUNDARY_FRACTION * this->radius <= step_norm) {
+               this->radius *= this->increase_factor;
+            }
+            if (current_iterate.evaluations.objective < this->unbounded_objective_threshold) {
+               current_iterate.status = TerminationStatus::UNBOUNDED;
+            }
+         }
+         else {
+            this->radius = std::min(this->radius, step_norm) / this->decrease_factor;
+            if (current_iterate.status == TerminationStatus::NOT_OPTIMAL && this->radius < this->min_radius) {
+               current_iterate.status = TerminationStatus::FEASIBLE_SMALL_STEP;
+            }
+         }
+
+         TRACE_COUNTER("trust-region radius", this->radius);
+         statistics.add_statistic("iters", iteration);
+         statistics.add_statistic("CG iters", number_cg_iterations);
+         statistics.add_statistic("TR radius", this->radius);
+         statistics.add_statistic("step norm", step_norm);
+         statistics.add_statistic("objective", current_iterate.evaluations.objective);
+         statistics.add_statistic("stationarity", current_iterate.residuals.optimality_stationarity);
+         if (statistics.is_enabled()) {
+            statistics.print_current_line();
+         }
+      }
+   }
+   catch (const SolveCancelled& exception) {
+      DEBUG << exception.what();
+   }
+   catch (const std::exception& exception) {
+      ERROR << RED << exception.what() << RESET;
+   }
+   statistics.close();
+   model.postprocess_solution(current_iterate, current_iterate.status);
+   DEBUG2 << "Final iterate:\n" << current_iterate;
+
+   Result result = {std::move(current_iterate), model.number_variables, model.number_constraints, iteration, timer.get_duration(),
+         Iterate::number_eval_objective, Iterate::number_eval_constraints, Iterate::number_eval_objective_gradient,
+         Iterate::number_eval_jacobian, this->hessian_evaluations, iteration, 0, 0};
+   return result;
+}
+
+void BoundConstrainedSolver::evaluate_derivatives(const Model& model, Iterate& iterate) {
+   iterate.evaluate_objective(model);
+   iterate.evaluate_objective_gradient(model);
+   initialize_vector(this->gradient, 0.);
+   iterate.evaluations.objective_gradient.for_each([&](size_t i, double derivative) {
+      this->gradient[i] += derivative;
+   });
+}
+
+// the bound multipliers are the components of the gradient at the active bounds (with the correct sign).
+// The stationarity error is the norm of the projected gradient step
+void BoundConstrainedSolver::compute_residuals(Iterate& iterate) const {
+   double stationarity_error = 0.;
+   for (size_t i: Range(iterate.number_variables)) {
+      const double x_i = iterate.primals[i];
+      const double derivative = this->gradient[i];
+      iterate.multipliers.lower_bounds[i] = (x_i == this->lower_bounds[i]) ? std::max(0., derivative) : 0.;
+      iterate.multipliers.upper_bounds[i] = (x_i == this->upper_bounds[i]) ? std::min(0., derivative) : 0.;
+      iterate.lagrangian_gradient.objective_contribution[i] = derivative;
+      iterate.lagrangian_gradient.constraints_contribution[i] = -(iterate.multipliers.lower_bounds[i] + iterate.multipliers.upper_bounds[i]);
+      const double projected_point = std::min(std::max(x_i - derivative, this->lower_bounds[i]), this->upper_bounds[i]);
+      stationarity_error = std::max(stationarity_error, std::abs(projected_point - x_i));
+   }
+   iterate.multipliers.objective = 1.;
+   iterate.residuals.optimality_stationarity = stationarity_error;
+   iterate.residuals.feasibility_stationarity = 0.;
+   iterate.residuals.infeasibility = 0.;
+   iterate.residuals.optimality_complementarity = 0.;
+   iterate.residuals.feasibility_complementarity = 0.;
+   iterate.residuals.stationarity_scaling = 1.;
+   iterate.residuals.complementarity_scaling = 1.;
+   const double objective = iterate.evaluations.objective;
+   iterate.progress = {0., [=](double objective_multiplier) {
+      return objective_multiplier * objective;
+   }, 0.};
+   iterate.status = (stationarity_error <= this->tolerance) ? TerminationStatus::FEASIBLE_KKT_POINT : TerminationStatus::NOT_OPTIMAL;
+}
+
+// compute the trial point and return the value of the quadratic model at the step (negative)
+double BoundConstrainedSolver::compute_step(const Iterate& iterate, size_t& number_cg_iterations) {
+   // intersection of the bounds and of the trust region
+   for (size_t i: Range(iterate.number_variables)) {
+      this->trust_region_lower_bounds[i] = std::max(this->lower_bounds[i], iterate.primals[i] - this->radius);
+      this->trust_region_upper_bounds[i] = std::min(this->upper_bounds[i], iterate.primals[i] + this->radius);
+   }
+   const double cauchy_model_value = this->compute_cauchy_step(iterate);
+   return this->compute_subspace_step(iterate, cauchy_model_value, number_cg_iterations);
+}
+
+// projected search along the steepest descent direction
+double BoundConstrainedSolver::compute_cauchy_step(const Iterate& iterate) {
+   // the first trial step reaches the boundary of the trust region
+   double step_length = this->radius / norm_inf(this->gradient);
+   double model_value = 0.;
+   for (size_t backtrack = 0; backtrack < MAX_BACKTRACKS; backtrack++) {
+      this->project_point(iterate.primals, this->gradient, -step_length, this->cauchy_point);
+      for (size_t i: Range(iterate.number_variables)) {
+         this->cauchy_step[i] = this->cauchy_point[i] - iterate.primals[i];
+      }
+      model_value = this->evaluate_quadratic_model(this->cauchy_step);
+      if (model_value <= SUFFICIENT_DECREASE_FRACTION * dot(this->gradient, this->cauchy_step)) {
+         break;
+      }
+      step_length *= BACKTRACKING_RATIO;
+   }
+   return model_value;
+}
+
+// truncated conjugate gradient on the variables that are free at the Cauchy point, then projected search from the Cauchy point
+double BoundConstrainedSolver::compute_subspace_step(const Iterate& iterate, double cauchy_model_value, size_t& number_cg_iterations) {
+   const size_t number_variables = iterate.number_variables;
+   const auto is_free = [&](size_t i) {
+      return this->trust_region_lower_bounds[i] < this->cauchy_point[i] && this->cauchy_point[i] < this->trust_region_upper_bounds[i];
+   };
+
+   // residual: negative gradient of the quadratic model at the Cauchy point, restricted to the free variables
+   this->compute_hessian_product(this->cauchy_step, this->hessian_product);
+   size_t number_free_variables = 0;
+   for (size_t i: Range(number_variables)) {
+      if (is_free(i)) {
+         this->residual[i] = -(this->gradient[i] + this->hessian_product[i]);
+         number_free_variables++;
+      }
+      else {
+         this->residual[i] = 0.;
+      }
+   }
+   const double initial_residual_norm = norm_2(this->residual);
+   if (initial_residual_norm == 0.) {
+      this->trial_point = this->cauchy_point;
+      this->step = this->cauchy_step;
+      return cauchy_model_value;
+   }
+   const double residual_tolerance = std::min(0.1, std::sqrt(initial_residual_norm)) * initial_residual_norm;
+
+   initialize_vector(this->newton_direction, 0.);
+   this->conjugate_direction = this->residual;
+   double squared_residual_norm = dot(this->residual, this->residual);
+   while (number_cg_iterations < number_free_variables) {
+      number_cg_iterations++;
+      this->compute_hessian_product(this->conjugate_direction, this->hessian_product);
+      for (size_t i: Range(number_variables)) {
+         if (not is_free(i)) {
+            this->hessian_product[i] = 0.;
+         }
+      }
+      const double curvature = dot(this->conjugate_direction, this->hessian_product);
+      if (curvature <= 0.) {
+         // negative curvature: go beyond the trust region, the projected search cuts the direction
+         const double step_length = 2. * this->radius / norm_inf(this->conjugate_direction);
+         add_vectors(this->newton_direction, this->conjugate_direction, step_length, this->newton_direction);
+         break;
+      }
+      const double step_length = squared_residual_norm / curvature;
+      add_vectors(this->newton_direction, this->conjugate_direction, step_length, this->newton_direction);
+      add_vectors(this->residual, this->hessian_product, -step_length, this->residual);
+
+      // stop when a free variable leaves the trust region
+      bool leaves_trust_region = false;
+      for (size_t i: Range(number_variables)) {
+         const double x_i = this->cauchy_point[i] + this->newton_direction[i];
+         if (x_i < this->trust_region_lower_bounds[i] || this->trust_region_upper_bounds[i] < x_i) {
+            leaves_trust_region = true;
+         }
+      }
+      const double new_squared_residual_norm = dot(this->residual, this->residual);
+      if (leaves_trust_region || std::sqrt(new_squared_residual_norm) <= residual_tolerance) {
+         break;
+      }
+      add_vectors(this->residual, this->conjugate_direction, new_squared_residual_norm / squared_residual_norm, this->conjugate_direction);
+      squared_residual_norm = new_squared_residual_norm;
+   }
+
+   // projected search: the trial point must improve the Cauchy point
+   double step_length = 1.;
+   for (size_t backtrack = 0; backtrack < MAX_BACKTRACKS; backtrack++) {
+      this->project_point(this->cauchy_point, this->newton_direction, step_length, this->trial_point);
+      for (size_t i: Range(number_variables)) {
+         this->step[i] = this->trial_point[i] - iterate.primals[i];
+      }
+      const double model_value = this->evaluate_quadratic_model(this->step);
+      if (model_value < cauchy_model_value) {
+         return model_value;
+      }
+      step_length *= BACKTRACKING_RATIO;
+   }
+   this->trial_point = this->cauchy_point;
+   this->step = this->cauchy_step;
+   return cauchy_model_value;
+}
+
+// projection of x + step_length * direction onto the intersection of the bounds and the trust region
+void BoundConstrainedSolver::project_point(const std::vector<double>& x, const std::vector<double>& direction, double step_length,
+      std::vector<double>& result) const {
+   for (size_t i: Range(x.size())) {
+      result[i] = std::min(std::max(x[i] + step_length * direction[i], this->trust_region_lower_bounds[i]), this->trust_region_upper_bounds[i]);
+   }
+}
+
+double BoundConstrainedSolver::evaluate_quadratic_model(const std::vector<double>& direction) const {
+   return dot(this->gradient, direction) + 0.5 * this->hessian->quadratic_product(direction, direction);
+}
+
+// the off-diagonal terms are stored once
+void BoundConstrainedSolver::compute_hessian_product(const std::vector<double>& vector, std::vector<double>& result) const {
+   initialize_vector(result, 0.);
+   this->hessian->for_each([&](size_t i, size_t j, double entry) {
+      result[i] += entry * vector[j];
+      if (i != j) {
+         result[j] += entry * vector[i];
+      }
+   });
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BOUNDCONSTRAINEDSOLVER_H
+#define UNO_BOUNDCONSTRAINEDSOLVER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/Model.hpp"
+#include "optimization/Result.hpp"
+#include "tools/Options.hpp"
+#include "tools/Statistics.hpp"
+
+/*! \class BoundConstrainedSolver
+ * \brief Trust-region gradient projection method for models without general constraints
+ *
+ *  Each iteration minimizes the quadratic model of the objective (exact Hessian) over the intersection of the bounds and
+ *  an \f$\ell_\infty\f$ trust region, in the style of TRON:
+ *  - the Cauchy point is obtained by a projected search along the steepest descent direction;
+ *  - the variables that are free at the Cauchy point are improved by a truncated conjugate gradient (Hessian-vector
+ *    products), followed by a projected search.
+ *  The bound multipliers are the components of the objective gradient at the active bounds.
+ */
+class BoundConstrainedSolver {
+public:
+   BoundConstrainedSolver(const Model& model, const Options& options);
+
+   // the model has no general constraints and at least one bound
+   [[nodiscard]] static bool is_applicable(const Model& model, const Options& options);
+   [[nodiscard]] static Statistics create_statistics(const Options& options);
+   [[nodiscard]] Result solve(Statistics& statistics, const Model& model, Iterate& current_iterate);
+
+private:
+   const size_t max_iterations;
+   const double time_limit;
+   const std::string trace_file_name; /*!< Chrome trace-event file of the solver phases ("none": no trace) */
+   const double tolerance;
+   const double unbounded_objective_threshold;
+   double radius;
+   const double increase_factor;
+   const double decrease_factor;
+   const double min_radius;
+   std::vector<double> lower_bounds;
+   std::vector<double> upper_bounds;
+   const std::unique_ptr<SymmetricMatrix<double>> hessian;
+   size_t hessian_evaluations{0};
+   // intersection of the bounds and of the trust region
+   std::vector<double> trust_region_lower_bounds;
+   std::vector<double> trust_region_upper_bounds;
+   std::vector<double> gradient;
+   std::vector<double> cauchy_point;
+   std::vector<double> cauchy_step;
+   std::vector<double> trial_point;
+   std::vector<double> step;
+   std::vector<double> hessian_product;
+   std::vector<double> conjugate_direction;
+   std::vector<double> residual;
+   std::vector<double> newton_direction;
+
+   void evaluate_derivatives(const Model& model, Iterate& iterate);
+   void compute_residuals(Iterate& iterate) const;
+   [[nodiscard]] double compute_step(const Iterate& iterate, size_t& number_cg_iterations);
+   [[nodiscard]] double compute_cauchy_step(const Iterate& iterate);
+   [[nodiscard]] double compute_subspace_step(const Iterate& iterate, double cauchy_model_value, size_t& number_cg_iterations);
+   void project_point(const std::vector<double>& x, const std::vector<double>& direction, double step_length, std::vector<double>& result) const;
+   [[nodiscard]] double evaluate_quadratic_model(const std::vector<double>& direction) const;
+   void compute_hessian_product(const std::vector<double>& vector, std::vector<double>& result) const;
+};
+
+#endif // UNO_BOUNDCONSTRAINEDSOLVER_H
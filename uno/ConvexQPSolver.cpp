@@ -0,0 +1,545 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "ConvexQPSolver.hpp"
+#include "Uno.hpp"
+#include "linear_algebra/SymmetricMatrixFactory.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Iterate.hpp"
+#include "solvers/linear/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
+#include "tools/Timer.hpp"
+
+// the Hessian is positive semidefinite if Q + CONVEXITY_TOLERANCE * max |Q_ij| I has no negative eigenvalue
+constexpr double CONVEXITY_TOLERANCE = 1e-8;
+// push of the initial point into the interior of the bounds (relative to the bounds, then to the width of the bounds)
+constexpr double PUSH_TO_INTERIOR_FACTOR = 1e-2;
+constexpr double INITIAL_BOUND_MULTIPLIER = 1.;
+// lower bound of the fraction to the boundary (goes to 1 with the complementarity)
+constexpr double MIN_FRACTION_TO_BOUNDARY = 0.99;
+
+ConvexQPSolver::ConvexQPSolver(const Model& model, const Options& options):
+      number_variables(model.number_variables),
+      number_constraints(model.number_constraints),
+      max_iterations(options.get_unsigned_int("max_iterations")),
+      time_limit(options.get_double("time_limit")),
+      trace_file_name(options.get_string("trace_file")),
+      tolerance(options.get_double("tolerance")),
+      unbounded_objective_threshold(options.get_double("unbounded_objective_threshold")),
+      residual_scaling_threshold(options.get_double("residual_scaling_threshold")),
+      lower_bounds(model.number_variables),
+      upper_bounds(model.number_variables),
+      constraint_targets(model.number_constraints),
+      barrier_hessian(SymmetricMatrixFactory<double>::create(options.get_string("sparse_format"), model.number_variables,
+            model.get_number_hessian_nonzeros() + model.number_variables /* diagonal barrier terms */, false)),
+      // the augmented matrix is assembled block by block (not column by column): COO regardless of the preset
+      augmented_system("COO", model.number_variables + model.number_constraints,
+            model.get_number_hessian_nonzeros()
+            + model.number_variables /* diagonal barrier terms */
+            + model.get_number_jacobian_nonzeros() /* Jacobian */,
+            true, /* use regularization */
+            options),
+      linear_solver(SymmetricIndefiniteLinearSolverFactory::create(model.number_variables + model.number_constraints,
+            model.get_number_hessian_nonzeros()
+            + model.number_variables + model.number_constraints /* regularization */
+            + model.number_variables /* diagonal barrier terms */
+            + model.get_number_jacobian_nonzeros() /* Jacobian */, options)),
+      lower_multipliers(model.number_variables),
+      upper_multipliers(model.number_variables),
+      dual_residuals(model.number_variables),
+      primal_residuals(model.number_constraints),
+      lower_targets(model.number_variables),
+      upper_targets(model.number_variables),
+      primal_direction(model.number_variables),
+      constraint_multipliers_direction(model.number_constraints),
+      lower_multipliers_direction(model.number_variables),
+      upper_multipliers_direction(model.number_variables) {
+   for (size_t i: Range(model.number_variables)) {
+      this->lower_bounds[i] = model.get_variable_lower_bound(i);
+      this->upper_bounds[i] = model.get_variable_upper_bound(i);
+      this->number_bounds += (is_finite(this->lower_bounds[i]) ? 1 : 0) + (is_finite(this->upper_bounds[i]) ? 1 : 0);
+   }
+   for (size_t j: Range(model.number_constraints)) {
+      this->constraint_targets[j] = model.get_constraint_lower_bound(j);
+   }
+}
+
+bool ConvexQPSolver::is_applicable(const Model& model, const Options& options) {
+   if (not options.get_bool("convex_qp_solver") || not model.is_quadratic_program()) {
+      return false;
+   }
+   // convexity: inertia of the slightly regularized Hessian (constant, evaluated at 0)
+   const size_t number_variables = model.number_variables;
+   const size_t number_hessian_nonzeros = model.get_number_hessian_nonzeros() + number_variables;
+   const std::unique_ptr<SymmetricMatrix<double>> hessian = SymmetricMatrixFactory<double>::create(options.get_string("sparse_format"),
+         number_variables, number_hessian_nonzeros, true);
+   const std::vector<double> x(number_variables, 0.);
+   const std::vector<double> multipliers(model.number_constraints, 0.);
+   try {
+      model.evaluate_lagrangian_hessian(x, 1., multipliers, *hessian);
+   }
+   catch (const std::exception&) {
+      return false;
+   }
+   double largest_entry = 0.;
+   hessian->for_each([&](size_t /*i*/, size_t /*j*/, double entry) {
+      largest_entry = std::max(largest_entry, std::abs(entry));
+   });
+   // linear program
+   if (largest_entry == 0.) {
+      return true;
+   }
+   const double regularization = CONVEXITY_TOLERANCE * largest_entry;
+   hessian->set_regularization([=](size_t /*i*/) {
+      return regularization;
+   });
+   const auto linear_solver = SymmetricIndefiniteLinearSolverFactory::create(number_variables, number_hessian_nonzeros, options);
+   linear_solver->factorize(*hessian);
+   const bool is_convex = (linear_solver->number_negative_eigenvalues() == 0);
+   if (not is_convex) {
+      INFO << "The quadratic program is not convex: the general method is used\n";
+   }
+   return is_convex;
+}
+
+Statistics ConvexQPSolver::create_statistics(const Options& options) {
+   Statistics statistics(options);
+   statistics.add_column("iters", ColumnType::INTEGER, options.get_int("statistics_major_column_order"));
+   statistics.add_column("regularization", ColumnType::DOUBLE, options.get_int("statistics_regularization_column_order"));
+   statistics.add_column("complementarity", ColumnType::DOUBLE, options.get_int("statistics_barrier_parameter_column_order"));
+   statistics.add_column("primal step", ColumnType::DOUBLE, options.get_int("statistics_LS_step_length_column_order"));
+   statistics.add_column("dual step", ColumnType::DOUBLE, options.get_int("statistics_step_norm_column_order"));
+   statistics.add_column("objective", ColumnType::DOUBLE, options.get_int("statistics_objective_column_order"));
+   statistics.add_column("primal infeas.", ColumnType::DOUBLE, options.get_int("statistics_primal_infeasibility_column_order"));
+   statistics.add_column("stationarity", ColumnType::DOUBLE, options.get_int("statistics_stationarity_column_order"));
+   return statistics;
+}
+
+Result ConvexQPSolver::solve(Statistics& statistics, const Model& model, Iterate& current_iterate) {
+   Timer timer{};
+   Uno::reset_evaluation_counters();
+   size_t iteration = 0;
+   // the solve scope ends before the trace is closed
+   const TraceSession trace_session(this->trace_file_name);
+   PROFILE_SCOPE("solve");
+
+   INFO << "\nProblem " << model.name << '\n';
+   try {
+      this->evaluate_hessian(model, current_iterate);
+      this->initialize_iterate(model, current_iterate);
+      this->compute_starting_point(statistics, model, current_iterate);
+      this->compute_residuals(model, current_iterate);
+   }
+   catch (const std::exception& e) {
+      ERROR << RED << "An error occurred at the initial iterate: " << e.what() << RESET;
+      throw;
+   }
+   INFO << model.number_variables << " variables, " << model.number_constraints << " constraints, " <<
+         (this->is_linear_program ? "linear" : "convex quadratic") << " program: interior-point method\n\n";
+
+   try {
+      while (current_iterate.status == TerminationStatus::NOT_OPTIMAL && iteration < this->max_iterations &&
+            timer.get_duration() < this->time_limit) {
+         PROFILE_SCOPE("iteration");
+         Cancellation::check();
+         statistics.new_line();
+         iteration++;
+         DEBUG << "### Outer iteration " << iteration << '\n';
+
+         // a single factorization per iteration
+         const double complementarity = this->compute_complementarity(current_iterate, 0., 0.);
+         this->assemble_augmented_system(statistics, model, current_iterate, [&](size_t variable_index) {
+            return this->compute_barrier_term(current_iterate, variable_index);
+         }, complementarity);
+
+         // affine scaling direction (no centering)
+         initialize_vector(this->lower_targets, 0.);
+         initialize_vector(this->upper_targets, 0.);
+         this->compute_direction(current_iterate);
+         const auto [affine_primal_step_length, affine_dual_step_length] = this->compute_step_lengths(current_iterate, 1.);
+         const double affine_complementarity = this->compute_complementarity(current_iterate, affine_primal_step_length, affine_dual_step_length);
+         const double centering_parameter = (0. < complementarity) ? std::pow(affine_complementarity / complementarity, 3) : 0.;
+         DEBUG << "Complementarity: " << complementarity << ", affine complementarity: " << affine_complementarity << '\n';
+
+         // centering-corrector direction (second-order correction of the complementarity)
+         const double target = centering_parameter * complementarity;
+         for (size_t i: Range(this->number_variables)) {
+            this->lower_targets[i] = target - this->primal_direction[i] * this->lower_multipliers_direction[i];
+            this->upper_targets[i] = target + this->primal_direction[i] * this->upper_multipliers_direction[i];
+         }
+         this->compute_direction(current_iterate);
+         const double fraction_to_boundary = std::max(MIN_FRACTION_TO_BOUNDARY, 1. - complementarity);
+         const auto [primal_step_length, dual_step_length] = this->compute_step_lengths(current_iterate, fraction_to_boundary);
+
+         this->update_iterate(current_iterate, primal_step_length, dual_step_length);
+         this->compute_residuals(model, current_iterate);
+         if (current_iterate.evaluations.objective < this->unbounded_objective_threshold) {
+            current_iterate.status = TerminationStatus::UNBOUNDED;
+         }
+
+         TRACE_COUNTER("complementarity", complementarity);
+         statistics.add_statistic("iters", iteration);
+         statistics.add_statistic("complementarity", complementarity);
+         statistics.add_statistic("primal step", primal_step_length);
+         statistics.add_statistic("dual step", dual_step_length);
+         statistics.add_statistic("objective", current_iterate.evaluations.objective);
+         statistics.add_statistic("primal infeas.", current_iterate.residuals.infeasibility);
+         statistics.add_statistic("stationarity", current_iterate.residuals.optimality_stationarity);
+         if (statistics.is_enabled()) {
+            statistics.print_current_line();
+         }
+      }
+   }
+   catch (const SolveCancelled& exception) {
+      DEBUG << exception.what();
+   }
+   catch (const std::exception& exception) {
+      ERROR << RED << exception.what() << RESET;
+   }
+   statistics.close();
+   model.postprocess_solution(current_iterate, current_iterate.status);
+   DEBUG2 << "Final iterate:\n" << current_iterate;
+
+   // the Hessian was evaluated once, a single augmented system is factorized per iteration
+   Result result = {std::move(current_iterate), model.number_variables, model.number_constraints, iteration, timer.get_duration(),
+         Iterate::number_eval_objective, Iterate::number_eval_constraints, Iterate::number_eval_objective_gradient,
+         Iterate::number_eval_jacobian, 1, iteration, 0, 0};
+   return result;
+}
+
+// the Hessian and the Jacobian are constant
+void ConvexQPSolver::evaluate_hessian(const Model& model, const Iterate& iterate) {
+   const std::unique_ptr<SymmetricMatrix<double>> hessian = SymmetricMatrixFactory<double>::create("COO", this->number_variables,
+         model.get_number_hessian_nonzeros(), false);
+   model.evaluate_lagrangian_hessian(iterate.primals, 1., iterate.multipliers.constraints, *hessian);
+   hessian->for_each([&](size_t i, size_t j, double entry) {
+      if (entry != 0.) {
+         // upper triangle
+         this->hessian_entries.emplace_back(std::min(i, j), std::max(i, j), entry);
+         this->is_linear_program = false;
+      }
+   });
+   std::stable_sort(this->hessian_entries.begin(), this->hessian_entries.end(), [](const auto& entry1, const auto& entry2) {
+      return std::get<1>(entry1) < std::get<1>(entry2);
+   });
+}
+
+void ConvexQPSolver::initialize_iterate(const Model& model, Iterate& iterate) {
+   // the slacks are the values of their constraints
+   iterate.evaluate_constraints(model);
+   model.slacks.for_each([&](size_t j, size_t i) {
+      iterate.primals[i] = iterate.evaluations.constraints[j] - this->constraint_targets[j];
+   });
+   // push the primals into the interior of the bounds and center the bound multipliers
+   for (size_t i: Range(this->number_variables)) {
+      const double lower_bound = this->lower_bounds[i];
+      const double upper_bound = this->upper_bounds[i];
+      const double width = upper_bound - lower_bound;
+      if (is_finite(lower_bound)) {
+         const double perturbation = std::min(PUSH_TO_INTERIOR_FACTOR * std::max(1., std::abs(lower_bound)), PUSH_TO_INTERIOR_FACTOR * width);
+         iterate.primals[i] = std::max(iterate.primals[i], lower_bound + perturbation);
+      }
+      if (is_finite(upper_bound)) {
+         const double perturbation = std::min(PUSH_TO_INTERIOR_FACTOR * std::max(1., std::abs(upper_bound)), PUSH_TO_INTERIOR_FACTOR * width);
+         iterate.primals[i] = std::min(iterate.primals[i], upper_bound - perturbation);
+      }
+      this->lower_multipliers[i] = is_finite(lower_bound) ? INITIAL_BOUND_MULTIPLIER : 0.;
+      this->upper_multipliers[i] = is_finite(upper_bound) ? INITIAL_BOUND_MULTIPLIER : 0.;
+   }
+   iterate.is_objective_computed = false;
+   iterate.are_constraints_computed = false;
+   iterate.is_objective_gradient_computed = false;
+   iterate.evaluate_constraint_jacobian(model);
+}
+
+// Mehrotra's starting point. With the augmented matrix [[Q + I, J^T], [J, 0]]:
+// - primal estimate: closest point to the initial point that satisfies the (linear) constraints
+// - dual estimate: least-squares constraint multipliers, the reduced costs give the bound multipliers
+// The distances to the bounds and the bound multipliers are then shifted to be positive and well centered
+void ConvexQPSolver::compute_starting_point(Statistics& statistics, const Model& model, Iterate& iterate) {
+   this->assemble_augmented_system(statistics, model, iterate, [](size_t /*variable_index*/) {
+      return 1.;
+   }, 1.);
+
+   // primal estimate
+   iterate.evaluate_constraints(model);
+   for (size_t i: Range(this->number_variables)) {
+      this->augmented_system.rhs[i] = 0.;
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      this->augmented_system.rhs[this->number_variables + j] = this->constraint_targets[j] - iterate.evaluations.constraints[j];
+   }
+   this->augmented_system.solve(*this->linear_solver);
+   for (size_t i: Range(this->number_variables)) {
+      iterate.primals[i] += this->augmented_system.solution[i];
+   }
+
+   // dual estimate: the reduced costs are g - J^T y = z_L - z_U
+   iterate.is_objective_gradient_computed = false;
+   iterate.evaluate_objective_gradient(model);
+   initialize_vector(this->augmented_system.rhs, 0.);
+   iterate.evaluations.objective_gradient.for_each([&](size_t i, double derivative) {
+      this->augmented_system.rhs[i] += derivative;
+   });
+   this->augmented_system.solve(*this->linear_solver);
+   for (size_t j: Range(this->number_constraints)) {
+      iterate.multipliers.constraints[j] = this->augmented_system.solution[this->number_variables + j];
+   }
+   for (size_t i: Range(this->number_variables)) {
+      const double reduced_cost = this->augmented_system.solution[i];
+      const bool has_lower_bound = is_finite(this->lower_bounds[i]);
+      const bool has_upper_bound = is_finite(this->upper_bounds[i]);
+      this->lower_multipliers[i] = has_lower_bound ? (has_upper_bound ? std::max(reduced_cost, 0.) : reduced_cost) : 0.;
+      this->upper_multipliers[i] = has_upper_bound ? (has_lower_bound ? std::max(-reduced_cost, 0.) : -reduced_cost) : 0.;
+   }
+   if (this->number_bounds == 0) {
+      return;
+   }
+
+   // shifts of the distances to the bounds and of the bound multipliers
+   double smallest_distance = INF<double>;
+   double smallest_multiplier = INF<double>;
+   this->for_each_bound(iterate, [&](double distance, double multiplier) {
+      smallest_distance = std::min(smallest_distance, distance);
+      smallest_multiplier = std::min(smallest_multiplier, multiplier);
+   });
+   const double primal_shift = std::max(-1.5 * smallest_distance, 0.);
+   const double dual_shift = std::max(-1.5 * smallest_multiplier, 0.);
+   double product = 0.;
+   double sum_distances = 0.;
+   double sum_multipliers = 0.;
+   this->for_each_bound(iterate, [&](double distance, double multiplier) {
+      product += (distance + primal_shift) * (multiplier + dual_shift);
+      sum_distances += distance + primal_shift;
+      sum_multipliers += multiplier + dual_shift;
+   });
+   // the second shifts center the products. Without product (e.g. zero costs), the shifts are constant
+   const double centering_primal_shift = (0. < product) ? 0.5 * product / sum_multipliers : INITIAL_BOUND_MULTIPLIER;
+   const double centering_dual_shift = (0. < product) ? 0.5 * product / sum_distances : INITIAL_BOUND_MULTIPLIER;
+   const double total_primal_shift = primal_shift + centering_primal_shift;
+   const double total_dual_shift = dual_shift + centering_dual_shift;
+   for (size_t i: Range(this->number_variables)) {
+      const double lower_bound = this->lower_bounds[i];
+      const double upper_bound = this->upper_bounds[i];
+      if (is_finite(lower_bound) && is_finite(upper_bound)) {
+         // the distances to both bounds cannot be shifted: the primal is pushed into the interior
+         const double width = upper_bound - lower_bound;
+         const double perturbation = std::min(PUSH_TO_INTERIOR_FACTOR * width, total_primal_shift);
+         iterate.primals[i] = std::min(std::max(iterate.primals[i], lower_bound + perturbation), upper_bound - perturbation);
+      }
+      else if (is_finite(lower_bound)) {
+         iterate.primals[i] += total_primal_shift;
+      }
+      else if (is_finite(upper_bound)) {
+         iterate.primals[i] -= total_primal_shift;
+      }
+      this->lower_multipliers[i] = is_finite(lower_bound) ? this->lower_multipliers[i] + total_dual_shift : 0.;
+      this->upper_multipliers[i] = is_finite(upper_bound) ? this->upper_multipliers[i] + total_dual_shift : 0.;
+   }
+   iterate.is_objective_computed = false;
+   iterate.are_constraints_computed = false;
+   iterate.is_objective_gradient_computed = false;
+}
+
+// applies a function to the distance to each finite bound and to the corresponding multiplier
+void ConvexQPSolver::for_each_bound(const Iterate& iterate, const std::function<void(double, double)>& function) const {
+   for (size_t i: Range(this->number_variables)) {
+      if (is_finite(this->lower_bounds[i])) {
+         function(iterate.primals[i] - this->lower_bounds[i], this->lower_multipliers[i]);
+      }
+      if (is_finite(this->upper_bounds[i])) {
+         function(this->upper_bounds[i] - iterate.primals[i], this->upper_multipliers[i]);
+      }
+   }
+}
+
+// KKT residuals: the multipliers follow the convention of Uno (the upper bound multipliers are nonpositive)
+void ConvexQPSolver::compute_residuals(const Model& model, Iterate& iterate) {
+   iterate.evaluate_objective(model);
+   iterate.evaluate_objective_gradient(model);
+   iterate.evaluate_constraints(model);
+   initialize_vector(iterate.lagrangian_gradient.objective_contribution, 0.);
+   iterate.evaluations.objective_gradient.for_each([&](size_t i, double derivative) {
+      iterate.lagrangian_gradient.objective_contribution[i] += derivative;
+   });
+   for (size_t i: Range(this->number_variables)) {
+      iterate.multipliers.lower_bounds[i] = this->lower_multipliers[i];
+      iterate.multipliers.upper_bounds[i] = -this->upper_multipliers[i];
+      iterate.lagrangian_gradient.constraints_contribution[i] = -this->lower_multipliers[i] + this->upper_multipliers[i];
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      iterate.evaluations.constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+         iterate.lagrangian_gradient.constraints_contribution[i] -= iterate.multipliers.constraints[j] * derivative;
+      });
+      this->primal_residuals[j] = iterate.evaluations.constraints[j] - this->constraint_targets[j];
+   }
+   double complementarity_error = 0.;
+   for (size_t i: Range(this->number_variables)) {
+      this->dual_residuals[i] = iterate.lagrangian_gradient.objective_contribution[i] + iterate.lagrangian_gradient.constraints_contribution[i];
+      if (is_finite(this->lower_bounds[i])) {
+         complementarity_error = std::max(complementarity_error, (iterate.primals[i] - this->lower_bounds[i]) * this->lower_multipliers[i]);
+      }
+      if (is_finite(this->upper_bounds[i])) {
+         complementarity_error = std::max(complementarity_error, (this->upper_bounds[i] - iterate.primals[i]) * this->upper_multipliers[i]);
+      }
+   }
+   iterate.multipliers.objective = 1.;
+   iterate.residuals.optimality_stationarity = norm_inf(this->dual_residuals);
+   iterate.residuals.feasibility_stationarity = 0.;
+   iterate.residuals.infeasibility = norm_inf(this->primal_residuals);
+   iterate.residuals.optimality_complementarity = complementarity_error;
+   iterate.residuals.feasibility_complementarity = 0.;
+
+   // scaling of the residuals by the norm of the multipliers
+   const double multiplier_norm = norm_1(this->lower_multipliers) + norm_1(this->upper_multipliers);
+   const size_t number_multipliers = this->number_bounds + this->number_constraints;
+   iterate.residuals.stationarity_scaling = (number_multipliers == 0) ? 1. : std::max(1., (multiplier_norm +
+         norm_1(view(iterate.multipliers.constraints, this->number_constraints))) / (this->residual_scaling_threshold * static_cast<double>(number_multipliers)));
+   iterate.residuals.complementarity_scaling = (this->number_bounds == 0) ? 1. : std::max(1., multiplier_norm /
+         (this->residual_scaling_threshold * static_cast<double>(this->number_bounds)));
+   const double objective = iterate.evaluations.objective;
+   iterate.progress = {iterate.residuals.infeasibility, [=](double objective_multiplier) {
+      return objective_multiplier * objective;
+   }, 0.};
+   const bool is_optimal = iterate.residuals.optimality_stationarity / iterate.residuals.stationarity_scaling <= this->tolerance &&
+         iterate.residuals.infeasibility <= this->tolerance &&
+         iterate.residuals.optimality_complementarity / iterate.residuals.complementarity_scaling <= this->tolerance;
+   iterate.status = is_optimal ? TerminationStatus::FEASIBLE_KKT_POINT : TerminationStatus::NOT_OPTIMAL;
+}
+
+// average complementarity at the point reached along the current direction
+double ConvexQPSolver::compute_complementarity(const Iterate& iterate, double primal_step_length, double dual_step_length) const {
+   if (this->number_bounds == 0) {
+      return 0.;
+   }
+   double complementarity = 0.;
+   for (size_t i: Range(this->number_variables)) {
+      const double x_i = iterate.primals[i] + primal_step_length * this->primal_direction[i];
+      if (is_finite(this->lower_bounds[i])) {
+         complementarity += (x_i - this->lower_bounds[i]) * (this->lower_multipliers[i] + dual_step_length * this->lower_multipliers_direction[i]);
+      }
+      if (is_finite(this->upper_bounds[i])) {
+         complementarity += (this->upper_bounds[i] - x_i) * (this->upper_multipliers[i] + dual_step_length * this->upper_multipliers_direction[i]);
+      }
+   }
+   return complementarity / static_cast<double>(this->number_bounds);
+}
+
+// augmented matrix [[Q + D, J^T], [J, 0]] with a diagonal D, inertia-corrected
+void ConvexQPSolver::assemble_augmented_system(Statistics& statistics, const Model& model, const Iterate& iterate,
+      const std::function<double(size_t)>& diagonal_term, double barrier_parameter) {
+   this->barrier_hessian->reset();
+   size_t entry_index = 0;
+   for (size_t column_index: Range(this->number_variables)) {
+      while (entry_index < this->hessian_entries.size() && std::get<1>(this->hessian_entries[entry_index]) == column_index) {
+         this->barrier_hessian->insert(std::get<2>(this->hessian_entries[entry_index]), std::get<0>(this->hessian_entries[entry_index]), column_index);
+         entry_index++;
+      }
+      this->barrier_hessian->insert(diagonal_term(column_index), column_index, column_index);
+      this->barrier_hessian->finalize_column(column_index);
+   }
+   this->augmented_system.assemble_matrix(*this->barrier_hessian, iterate.evaluations.constraint_jacobian, this->number_variables,
+         this->number_constraints);
+   this->augmented_system.factorize_matrix(model, *this->linear_solver);
+   this->augmented_system.regularize_matrix(statistics, model, *this->linear_solver, this->number_variables, this->number_constraints,
+         barrier_parameter);
+}
+
+// diagonal barrier term Sigma_ii
+double ConvexQPSolver::compute_barrier_term(const Iterate& iterate, size_t variable_index) const {
+   double barrier_term = 0.;
+   if (is_finite(this->lower_bounds[variable_index])) {
+      barrier_term += this->lower_multipliers[variable_index] / (iterate.primals[variable_index] - this->lower_bounds[variable_index]);
+   }
+   if (is_finite(this->upper_bounds[variable_index])) {
+      barrier_term += this->upper_multipliers[variable_index] / (this->upper_bounds[variable_index] - iterate.primals[variable_index]);
+   }
+   return barrier_term;
+}
+
+// solve the factorized augmented system with the current complementarity targets
+void ConvexQPSolver::compute_direction(const Iterate& iterate) {
+   for (size_t i: Range(this->number_variables)) {
+      double rhs = -this->dual_residuals[i];
+      if (is_finite(this->lower_bounds[i])) {
+         rhs += this->lower_targets[i] / (iterate.primals[i] - this->lower_bounds[i]) - this->lower_multipliers[i];
+      }
+      if (is_finite(this->upper_bounds[i])) {
+         rhs -= this->upper_targets[i] / (this->upper_bounds[i] - iterate.primals[i]) - this->upper_multipliers[i];
+      }
+      this->augmented_system.rhs[i] = rhs;
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      this->augmented_system.rhs[this->number_variables + j] = -this->primal_residuals[j];
+   }
+   this->augmented_system.solve(*this->linear_solver);
+
+   for (size_t i: Range(this->number_variables)) {
+      const double primal_direction = this->augmented_system.solution[i];
+      this->primal_direction[i] = primal_direction;
+      if (is_finite(this->lower_bounds[i])) {
+         const double distance = iterate.primals[i] - this->lower_bounds[i];
+         this->lower_multipliers_direction[i] = (this->lower_targets[i] - this->lower_multipliers[i] * (distance + primal_direction)) / distance;
+      }
+      else {
+         this->lower_multipliers_direction[i] = 0.;
+      }
+      if (is_finite(this->upper_bounds[i])) {
+         const double distance = this->upper_bounds[i] - iterate.primals[i];
+         this->upper_multipliers_direction[i] = (this->upper_targets[i] - this->upper_multipliers[i] * (distance - primal_direction)) / distance;
+      }
+      else {
+         this->upper_multipliers_direction[i] = 0.;
+      }
+   }
+   // the dual part of the solution is the opposite of the direction of the constraint multipliers
+   for (size_t j: Range(this->number_constraints)) {
+      this->constraint_multipliers_direction[j] = -this->augmented_system.solution[this->number_variables + j];
+   }
+}
+
+// fraction to the boundary rule. The step lengths are equal for quadratic programs
+std::pair<double, double> ConvexQPSolver::compute_step_lengths(const Iterate& iterate, double fraction_to_boundary) const {
+   double primal_step_length = 1.;
+   double dual_step_length = 1.;
+   for (size_t i: Range(this->number_variables)) {
+      const double direction = this->primal_direction[i];
+      if (is_finite(this->lower_bounds[i]) && direction < 0.) {
+         primal_step_length = std::min(primal_step_length, -fraction_to_boundary * (iterate.primals[i] - this->lower_bounds[i]) / direction);
+      }
+      if (is_finite(this->upper_bounds[i]) && 0. < direction) {
+         primal_step_length = std::min(primal_step_length, fraction_to_boundary * (this->upper_bounds[i] - iterate.primals[i]) / direction);
+      }
+      if (this->lower_multipliers_direction[i] < 0.) {
+         dual_step_length = std::min(dual_step_length, -fraction_to_boundary * this->lower_multipliers[i] / this->lower_multipliers_direction[i]);
+      }
+      if (this->upper_multipliers_direction[i] < 0.) {
+         dual_step_length = std::min(dual_step_length, -fraction_to_boundary * this->upper_multipliers[i] / this->upper_multipliers_direction[i]);
+      }
+   }
+   if (not this->is_linear_program) {
+      const double step_length = std::min(primal_step_length, dual_step_length);
+      return {step_length, step_length};
+   }
+   return {primal_step_length, dual_step_length};
+}
+
+void ConvexQPSolver::update_iterate(Iterate& iterate, double primal_step_length, double dual_step_length) {
+   for (size_t i: Range(this->number_variables)) {
+      iterate.primals[i] += primal_step_length * this->primal_direction[i];
+      this->lower_multipliers[i] += dual_step_length * this->lower_multipliers_direction[i];
+      this->upper_multipliers[i] += dual_step_length * this->upper_multipliers_direction[i];
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      iterate.multipliers.constraints[j] += dual_step_length * this->constraint_multipliers_direction[j];
+   }
+   // the Jacobian is constant
+   iterate.is_objective_computed = false;
+   iterate.are_constraints_computed = false;
+   iterate.is_objective_gradient_computed = false;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CONVEXQPSOLVER_H
+#define UNO_CONVEXQPSOLVER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "optimization/Model.hpp"
+#include "optimization/Result.hpp"
+#include "solvers/linear/SymmetricIndefiniteLinearSolver.hpp"
+#include "tools/Options.hpp"
+#include "tools/Statistics.hpp"
+
+/*! \class ConvexQPSolver
+ * \brief Mehrotra predictor-corrector interior-point method for linear and convex quadratic programs
+ *
+ *  The model is its own quadratic model: the Hessian and the Jacobian are evaluated once, and each iteration factorizes
+ *  the augmented matrix [[Q + Sigma, J^T], [J, 0]] once and solves it twice (affine and centering-corrector directions).
+ *  There is no globalization (no line search, no merit function): the steps are only restricted by the fraction to the
+ *  boundary rule. The primal and dual step lengths are distinct for linear programs.
+ *  The starting point is Mehrotra's: least-squares primal and dual estimates, shifted into the interior of the bounds.
+ *  The model must be equality constrained (c(x) = c_L, with slacks) and its bounds must have a nonempty interior.
+ */
+class ConvexQPSolver {
+public:
+   ConvexQPSolver(const Model& model, const Options& options);
+
+   // the model is a linear or a quadratic program whose Hessian is positive semidefinite
+   [[nodiscard]] static bool is_applicable(const Model& model, const Options& options);
+   [[nodiscard]] static Statistics create_statistics(const Options& options);
+   [[nodiscard]] Result solve(Statistics& statistics, const Model& model, Iterate& current_iterate);
+
+private:
+   const size_t number_variables;
+   const size_t number_constraints;
+   const size_t max_iterations;
+   const double time_limit;
+   const std::string trace_file_name; /*!< Chrome trace-event file of the solver phases ("none": no trace) */
+   const double tolerance;
+   const double unbounded_objective_threshold;
+   const double residual_scaling_threshold;
+   std::vector<double> lower_bounds;
+   std::vector<double> upper_bounds;
+   std::vector<double> constraint_targets;
+   size_t number_bounds{0};
+   // entries of the (constant) Hessian, sorted by column
+   std::vector<std::tuple<size_t, size_t, double>> hessian_entries{};
+   bool is_linear_program{true};
+   const std::unique_ptr<SymmetricMatrix<double>> barrier_hessian;
+   SymmetricIndefiniteLinearSystem<double> augmented_system;
+   const std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> linear_solver;
+   // bound multipliers: lower >= 0, upper >= 0 (the multipliers of Uno are -upper_multipliers)
+   std::vector<double> lower_multipliers;
+   std::vector<double> upper_multipliers;
+   std::vector<double> dual_residuals;
+   std::vector<double> primal_residuals;
+   std::vector<double> lower_targets;
+   std::vector<double> upper_targets;
+   std::vector<double> primal_direction;
+   std::vector<double> constraint_multipliers_direction;
+   std::vector<double> lower_multipliers_direction;
+   std::vector<double> upper_multipliers_direction;
+
+   void evaluate_hessian(const Model& model, const Iterate& iterate);
+   void initialize_iterate(const Model& model, Iterate& iterate);
+   void compute_starting_point(Statistics& statistics, const Model& model, Iterate& iterate);
+   void for_each_bound(const Iterate& iterate, const std::function<void(double, double)>& function) const;
+   void compute_residuals(const Model& model, Iterate& iterate);
+   [[nodiscard]] double compute_complementarity(const Iterate& iterate, double primal_step_length, double dual_step_length) const;
+   void assemble_augmented_system(Statistics& statistics, const Model& model, const Iterate& iterate,
+         const std::function<double(size_t)>& diagonal_term, double barrier_parameter);
+   [[nodiscard]] double compute_barrier_term(const Iterate& iterate, size_t variable_index) const;
+   void compute_direction(const Iterate& iterate);
+   [[nodiscard]] std::pair<double, double> compute_step_lengths(const Iterate& iterate, double fraction_to_boundary) const;
+   void update_iterate(Iterate& iterate, double primal_step_length, double dual_step_length);
+};
+
+#endif // UNO_CONVEXQPSOLVER_H
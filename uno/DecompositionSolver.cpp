@@ -0,0 +1,157 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include "DecompositionSolver.hpp"
+#include "Uno.hpp"
+#include "optimization/SubModel.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+#include "tools/Tracer.hpp"
+
+DecompositionSolver::DecompositionSolver(ModelLoader model_loader, size_t number_workers):
+      model_loader(std::move(model_loader)),
+      number_workers((0 < number_workers) ? number_workers : std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency()))) {
+}
+
+Result DecompositionSolver::solve(const Options& options) const {
+   const Timer timer{};
+   std::unique_ptr<Model> model = this->model_loader();
+   std::vector<double> initial_point(model->number_variables);
+   model->get_initial_primal_point(initial_point);
+   model->project_primals_onto_bounds(initial_point);
+   const std::vector<ModelComponent> components = Decomposition::compute_components(*model, initial_point);
+   INFO << "Decomposition: " << components.size() << " independent components\n";
+   if (components.size() <= 1) {
+      return Uno::solve_model(std::move(model), options);
+   }
+
+   // the model is shared (read only) by the components (non-owning pointer: the model outlives the workers). A model
+   // that is not reentrant is evaluated by a single worker: the components are solved one after the other
+   const std::shared_ptr<const Model> shared_model(std::shared_ptr<const Model>(), model.get());
+   const size_t number_threads = model->is_reentrant() ? std::min(this->number_workers, components.size()) : 1;
+   if (number_threads == 1) {
+      INFO << "Decomposition: the components are solved sequentially\n";
+   }
+
+   // the components run concurrently: no output. Their solves join the trace of the decomposition
+   Options component_options = options;
+   component_options["logger"] = "ERROR";
+   component_options["statistics_sink"] = "none";
+
+   std::vector<std::optional<Result>> component_results(components.size());
+   std::atomic<size_t> next_component{0};
+   std::atomic<bool> failure{false};
+   const auto worker = [&]() {
+      Logger::set_logger("ERROR");
+      for (size_t component_index = next_component++; component_index < components.size() && not failure; component_index = next_component++) {
+         const ModelComponent& component = components[component_index];
+         try {
+            std::vector<Interval> variable_bounds(component.variables.size());
+            for (size_t i: Range(component.variables.size())) {
+               const size_t original_i = component.variables[i];
+               variable_bounds[i] = {model->get_variable_lower_bound(original_i), model->get_variable_upper_bound(original_i)};
+            }
+            std::string name = model->name + "_component" + std::to_string(component_index);
+            auto component_model = std::make_unique<SubModel>(std::move(name), shared_model, component.variables,
+                  component.constraints, initial_point, std::move(variable_bounds));
+            Result result = Uno::solve_model(std::move(component_model), component_options);
+            const TerminationStatus status = result.solution.status;
+            if (status != TerminationStatus::FEASIBLE_KKT_POINT && status != TerminationStatus::FEASIBLE_FJ_POINT) {
+               failure = true;
+            }
+            component_results[component_index].emplace(std::move(result));
+         }
+         catch (const std::exception&) {
+            failure = true;
+         }
+      }
+   };
+   // the trace is closed once the workers are joined
+   {
+      const TraceSession trace_session(options.get_string("trace_file"));
+      std::vector<std::thread> threads;
+      threads.reserve(number_threads);
+      for (size_t thread_index = 0; thread_index < number_threads; thread_index++) {
+         threads.emplace_back(worker);
+      }
+      for (std::thread& thread: threads) {
+         thread.join();
+      }
+   }
+
+   if (failure) {
+      WARNING << YELLOW << "Decomposition: a component did not converge, solving the monolithic model\n" << RESET;
+      return Uno::solve_model(std::move(model), options);
+   }
+   std::vector<Result> results;
+   results.reserve(components.size());
+   for (std::optional<Result>& result: component_results) {
+      results.push_back(std::move(*result));
+   }
+   return DecompositionSolver::merge_results(*model, initial_point, components, results, timer.get_duration());
+}
+
+Result DecompositionSolver::merge_results(const Model& model, const std::vector<double>& initial_point, const std::vector<ModelComponent>& components,
+      std::vector<Result>& component_results, double wall_time) {
+   Iterate solution(model.number_variables, model.number_constraints);
+   solution.primals = initial_point;
+   solution.status = TerminationStatus::FEASIBLE_KKT_POINT;
+   solution.residuals = {0., 0., 0., 0., 0., 0., 0.};
+   solution.progress.infeasibility = 0.;
+   solution.progress.auxiliary_terms = 0.;
+   size_t iterations = 0, hessian_evaluations = 0, number_subproblems_solved = 0;
+   for (size_t component_index: Range(components.size())) {
+      const ModelComponent& component = components[component_index];
+      const Iterate& component_solution = component_results[component_index].solution;
+      for (size_t i: Range(component.variables.size())) {
+         solution.primals[component.variables[i]] = component_solution.primals[i];
+         solution.multipliers.lower_bounds[component.variables[i]] = component_solution.multipliers.lower_bounds[i];
+         solution.multipliers.upper_bounds[component.variables[i]] = component_solution.multipliers.upper_bounds[i];
+      }
+      for (size_t j: Range(component.constraints.size())) {
+         solution.multipliers.constraints[component.constraints[j]] = component_solution.multipliers.constraints[j];
+      }
+      if (component_solution.status == TerminationStatus::FEASIBLE_FJ_POINT) {
+         solution.status = TerminationStatus::FEASIBLE_FJ_POINT;
+      }
+      // the residuals of the model are the largest residuals of the components
+      PrimalDualResiduals& residuals = solution.residuals;
+      residuals.optimality_stationarity = std::max(residuals.optimality_stationarity, component_solution.residuals.optimality_stationarity);
+      residuals.feasibility_stationarity = std::max(residuals.feasibility_stationarity, component_solution.residuals.feasibility_stationarity);
+      residuals.infeasibility = std::max(residuals.infeasibility, component_solution.residuals.infeasibility);
+      residuals.optimality_complementarity = std::max(residuals.optimality_complementarity, component_solution.residuals.optimality_complementarity);
+      residuals.feasibility_complementarity = std::max(residuals.feasibility_complementarity,
+            component_solution.residuals.feasibility_complementarity);
+      solution.progress.infeasibility += component_solution.progress.infeasibility;
+      solution.progress.auxiliary_terms += component_solution.progress.auxiliary_terms;
+      iterations = std::max(iterations, component_results[component_index].iteration);
+      hessian_evaluations += component_results[component_index].hessian_evaluations;
+      number_subproblems_solved += component_results[component_index].number_subproblems_solved;
+   }
+   // the objective of the model at the merged point
+   solution.evaluate_objective(model);
+   solution.evaluate_constraints(model);
+   const double objective = solution.evaluations.objective;
+   solution.progress.optimality = [=](double objective_multiplier) {
+      return objective_multiplier * objective;
+   };
+   model.postprocess_solution(solution, solution.status);
+
+   size_t objective_evaluations = 0, constraint_evaluations = 0, objective_gradient_evaluations = 0, jacobian_evaluations = 0;
+   size_t evaluation_cache_hits = 0, evaluation_cache_misses = 0;
+   for (const Result& result: component_results) {
+      objective_evaluations += result.objective_evaluations;
+      constraint_evaluations += result.constraint_evaluations;
+      objective_gradient_evaluations += result.objective_gradient_evaluations;
+      jacobian_evaluations += result.jacobian_evaluations;
+      evaluation_cache_hits += result.evaluation_cache_hits;
+      evaluation_cache_misses += result.evaluation_cache_misses;
+   }
+   return {std::move(solution), model.number_variables, model.number_constraints, iterations, wall_time, objective_evaluations,
+         constraint_evaluations, objective_gradient_evaluations, jacobian_evaluations, hessian_evaluations, number_subproblems_solved,
+         evaluation_cache_hits, evaluation_cache_misses};
+}
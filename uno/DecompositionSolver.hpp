@@ -0,0 +1,41 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DECOMPOSITIONSOLVER_H
+#define UNO_DECOMPOSITIONSOLVER_H
+
+#include <functional>
+#include <memory>
+#include "optimization/Model.hpp"
+#include "optimization/Result.hpp"
+#include "preprocessing/Decomposition.hpp"
+#include "tools/Options.hpp"
+
+/*! \class DecompositionSolver
+ * \brief Solves the independent blocks of a model concurrently
+ *
+ *  The connected components of the Jacobian and Hessian sparsity patterns are independent subproblems. Each component
+ *  is solved as a SubModel on a pool of workers. The submodels share the model: if it is not reentrant, the pool has a
+ *  single worker and the components are solved one after the other.
+ *  The component solutions are merged into a solution of the model. If the model has a single component, or if a
+ *  component does not converge, the model is solved as a whole.
+ */
+class DecompositionSolver {
+public:
+   using ModelLoader = std::function<std::unique_ptr<Model>()>;
+
+   // number_workers = 0: number of hardware threads
+   DecompositionSolver(ModelLoader model_loader, size_t number_workers);
+
+   // the components are solved without output, the monolithic solve with the given options
+   [[nodiscard]] Result solve(const Options& options) const;
+
+private:
+   const ModelLoader model_loader;
+   const size_t number_workers;
+
+   [[nodiscard]] static Result merge_results(const Model& model, const std::vector<double>& initial_point,
+         const std::vector<ModelComponent>& components, std::vector<Result>& component_results, double wall_time);
+};
+
+#endif // UNO_DECOMPOSITIONSOLVER_H
@@ -0,0 +1,88 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include "PortfolioSolver.hpp"
+#include "Uno.hpp"
+#include "tools/Cancellation.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Timer.hpp"
+
+PortfolioSolver::PortfolioSolver(ModelLoader model_loader): model_loader(std::move(model_loader)) {
+}
+
+PortfolioResult PortfolioSolver::solve(const std::vector<std::pair<std::string, Options>>& configurations) const {
+   PortfolioResult portfolio_result;
+   portfolio_result.runs.resize(configurations.size());
+   std::atomic<bool> cancellation_flag{false};
+   std::mutex mutex;
+   const Timer timer{};
+
+   const auto run_configuration = [&](size_t configuration_index) {
+      const auto& [configuration, options] = configurations[configuration_index];
+      PortfolioRun& run = portfolio_result.runs[configuration_index];
+      run.configuration = configuration;
+      Cancellation::set_flag(&cancellation_flag);
+      try {
+         // the verbosity is per thread
+         Logger::set_logger(options.get_string("logger"));
+         // a cancelled solve stops at the next boundary and returns its current iterate
+         Result result = Uno::solve_model(this->model_loader(), options);
+         const double duration = timer.get_duration();
+         const TerminationStatus status = result.solution.status;
+         const bool converged = (status == TerminationStatus::FEASIBLE_KKT_POINT || status == TerminationStatus::FEASIBLE_FJ_POINT);
+
+         std::lock_guard<std::mutex> lock(mutex);
+         run.status = to_string(status);
+         run.iterations = result.iteration;
+         run.wall_time = duration;
+         if (converged && portfolio_result.winner.empty()) {
+            portfolio_result.winner = configuration;
+            portfolio_result.time_to_solution = duration;
+            portfolio_result.result.emplace(std::move(result));
+            cancellation_flag = true;
+         }
+         else if (not converged && cancellation_flag) {
+            run.status = "cancelled";
+            run.cancelled = true;
+         }
+         else if (portfolio_result.winner.empty() && not portfolio_result.result.has_value()) {
+            // fallback if no configuration converges
+            portfolio_result.result.emplace(std::move(result));
+            portfolio_result.time_to_solution = duration;
+         }
+      }
+      catch (const std::exception& exception) {
+         std::lock_guard<std::mutex> lock(mutex);
+         run.status = std::string("error: ") + exception.what();
+         run.wall_time = timer.get_duration();
+      }
+      Cancellation::set_flag(nullptr);
+   };
+
+   std::vector<std::thread> threads;
+   threads.reserve(configurations.size());
+   for (size_t configuration_index = 0; configuration_index < configurations.size(); configuration_index++) {
+      threads.emplace_back(run_configuration, configuration_index);
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   return portfolio_result;
+}
+
+void PortfolioResult::print(std::ostream& stream) const {
+   if (this->winner.empty()) {
+      stream << "Portfolio: no configuration converged\n";
+   }
+   else {
+      stream << "Portfolio winner:\t\t\t" << this->winner << " (time to solution " << this->time_to_solution << " s)\n";
+   }
+   for (const PortfolioRun& run: this->runs) {
+      stream << "  " << std::left << std::setw(20) << run.configuration << std::setw(30) << run.status << std::right << std::setw(8) <<
+            run.iterations << " iterations " << run.wall_time << " s\n";
+   }
+}
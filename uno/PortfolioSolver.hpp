@@ -0,0 +1,55 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PORTFOLIOSOLVER_H
+#define UNO_PORTFOLIOSOLVER_H
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "optimization/Model.hpp"
+#include "optimization/Result.hpp"
+#include "tools/Options.hpp"
+
+// outcome of one configuration of the portfolio
+struct PortfolioRun {
+   std::string configuration;
+   std::string status{"not solved"};
+   size_t iterations{0};
+   double wall_time{0.};
+   bool cancelled{false};
+};
+
+struct PortfolioResult {
+   std::optional<Result> result{}; // result of the winner (of the first configuration to terminate if none converged)
+   std::string winner{}; // empty if no configuration converged
+   double time_to_solution{0.};
+   std::vector<PortfolioRun> runs{};
+
+   void print(std::ostream& stream) const;
+};
+
+/*! \class PortfolioSolver
+ * \brief Races several configurations on the same model
+ *
+ *  Each configuration runs on its own thread with its own copy of the model, reformulations and ingredients.
+ *  The first configuration that converges to a feasible stationary point wins; the others are cancelled at their
+ *  next iteration or subproblem boundary. The BQPD subproblems of the SQP configurations are solved one at a time,
+ *  since BQPD is not reentrant.
+ */
+class PortfolioSolver {
+public:
+   using ModelLoader = std::function<std::unique_ptr<Model>()>;
+
+   explicit PortfolioSolver(ModelLoader model_loader);
+
+   [[nodiscard]] PortfolioResult solve(const std::vector<std::pair<std::string, Options>>& configurations) const;
+
+private:
+   const ModelLoader model_loader;
+};
+
+#endif // UNO_PORTFOLIOSOLVER_H
@@ -3,88 +3,176 @@
 
 #include <cmath>
 #include "Uno.hpp"
+#include "BoundConstrainedSolver.hpp"
+#include "ConvexQPSolver.hpp"
 #include "ingredients/constraint_relaxation_strategy/ConstraintRelaxationStrategyFactory.hpp"
 #include "ingredients/globalization_mechanism/GlobalizationMechanismFactory.hpp"
 #include "ingredients/globalization_strategy/GlobalizationStrategyFactory.hpp"
 #include "ingredients/subproblem/SubproblemFactory.hpp"
+#include "optimization/BoundRelaxedModel.hpp"
+#include "optimization/CachedModel.hpp"
+#include "optimization/EqualityConstrainedModel.hpp"
 #include "optimization/Iterate.hpp"
+#include "optimization/ModelFactory.hpp"
+#include "preprocessing/Preprocessing.hpp"
+#include "tools/Cancellation.hpp"
 #include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
 #include "tools/Statistics.hpp"
 #include "tools/Timer.hpp"
 
 Uno::Uno(GlobalizationMechanism& globalization_mechanism, const Options& options) :
       globalization_mechanism(globalization_mechanism),
       max_iterations(options.get_unsigned_int("max_iterations")),
-      time_limit(options.get_double("time_limit")) {
+      time_limit(options.get_double("time_limit")),
+      trace_file_name(options.get_string("trace_file")) {
 }
 
 Result Uno::solve(Statistics& statistics, const Model& model, Iterate& current_iterate) {
    Timer timer{};
-   size_t major_iterations = 0;
-
-   std::cout << "\nProblem " << model.name << '\n';
-   std::cout << model.number_variables << " variables, " << model.number_constraints << " constraints\n\n";
-
-   // use the current point to initialize the strategies and generate the initial iterate
-   try {
-      this->globalization_mechanism.initialize(current_iterate);
+   // the profile is only printed at the INFO level: silent (e.g. concurrent) solves do not reset the global tree
+   if (INFO <= Logger::level) {
+      Profiler::reset();
    }
-   catch (const std::exception& e) {
-      ERROR << RED << "An error occurred at the initial iterate: " << e.what() << RESET;
-      throw;
-   }
-
-   bool termination = false;
-   try {
-      // check for termination
-      while (not termination) {
-         statistics.new_line();
-         major_iterations++;
-         DEBUG << "### Outer iteration " << major_iterations << '\n';
-
-         // compute an acceptable iterate by solving a subproblem at the current point
-         current_iterate = this->globalization_mechanism.compute_next_iterate(statistics, model, current_iterate);
+   Uno::reset_evaluation_counters();
+   size_t major_iterations = 0;
 
-         // compute the status of the next iterate
-         Uno::add_statistics(statistics, current_iterate, major_iterations);
-         if (Logger::level == INFO) statistics.print_current_line();
+   INFO << "\nProblem " << model.name << '\n';
+   INFO << model.number_variables << " variables, " << model.number_constraints << " constraints\n\n";
 
-         statistics.add_iteration();
-         // add iteration to map, if planned to serialize
-         // if (statistics.serialize_iterations == true){
-         // }
+   // the solve scope and the trace end before the summary is printed
+   {
+      const TraceSession trace_session(this->trace_file_name);
+      PROFILE_SCOPE("solve");
+      // use the current point to initialize the strategies and generate the initial iterate
+      try {
+         this->globalization_mechanism.initialize(current_iterate);
+      }
+      catch (const std::exception& e) {
+         ERROR << RED << "An error occurred at the initial iterate: " << e.what() << RESET;
+         throw;
+      }
 
-         termination = this->termination_criteria(current_iterate.status, major_iterations, timer.get_duration());
+      bool termination = false;
+      try {
+         // check for termination
+         while (not termination) {
+            PROFILE_SCOPE("iteration");
+            Cancellation::check();
+            statistics.new_line();
+            major_iterations++;
+            DEBUG << "### Outer iteration " << major_iterations << '\n';
+
+            // compute an acceptable iterate by solving a subproblem at the current point
+            current_iterate = this->globalization_mechanism.compute_next_iterate(statistics, model, current_iterate);
+
+            // compute the status of the next iterate
+            Uno::add_statistics(statistics, current_iterate, major_iterations);
+            if (statistics.is_enabled()) {
+               PROFILE_SCOPE("statistics output");
+               statistics.print_current_line();
+            }
+
+            termination = this->termination_criteria(current_iterate.status, major_iterations, timer.get_duration());
+         }
       }
+      catch (const std::runtime_error& e) {
+         ERROR << RED << e.what() << RESET;
+         throw;
+      }
+      catch (const SolveCancelled& exception) {
+         DEBUG << exception.what();
+      }
+      catch (std::exception& exception) {
+         ERROR << RED << exception.what() << RESET;
+      }
+      Uno::postprocess_iterate(model, current_iterate, current_iterate.status);
    }
-   catch (const std::runtime_error& e) {
-      ERROR << RED << e.what() << RESET;
-      throw;
-   }
-   catch (std::exception& exception) {
-      ERROR << RED << exception.what() << RESET;
-   }
-   statistics.serialize();
-   Uno::postprocess_iterate(model, current_iterate, current_iterate.status);
 
-   if (Logger::level == INFO) statistics.print_footer();
+   statistics.close();
+#ifndef UNO_DISABLE_PROFILER
+   if (INFO <= Logger::level) {
+      Profiler::print_summary(std::cout);
+   }
+#endif
 
    const size_t number_subproblems_solved = this->globalization_mechanism.get_number_subproblems_solved();
    const size_t hessian_evaluation_count = this->globalization_mechanism.get_hessian_evaluation_count();
    Result result = {std::move(current_iterate), model.number_variables, model.number_constraints, major_iterations, timer.get_duration(),
          Iterate::number_eval_objective, Iterate::number_eval_constraints, Iterate::number_eval_objective_gradient,
-         Iterate::number_eval_jacobian, hessian_evaluation_count, number_subproblems_solved};
+         Iterate::number_eval_jacobian, hessian_evaluation_count, number_subproblems_solved, CachedModel::number_hits, CachedModel::number_misses};
    return result;
 }
 
+Result Uno::solve_model(std::unique_ptr<Model> model, const Options& options) {
+   // remove the fixed variables and the trivial linear constraints if necessary
+   model = ModelFactory::presolve(std::move(model), options);
+
+   // initialize initial primal and dual points
+   Iterate initial_iterate(model->number_variables, model->number_constraints);
+   model->get_initial_primal_point(initial_iterate.primals);
+   model->get_initial_dual_point(initial_iterate.multipliers.constraints);
+   model->project_primals_onto_bounds(initial_iterate.primals);
+
+   // a model without general constraints does not need the reformulations nor the constraint relaxation strategy
+   if (BoundConstrainedSolver::is_applicable(*model, options)) {
+      Statistics statistics = BoundConstrainedSolver::create_statistics(options);
+      BoundConstrainedSolver solver(*model, options);
+      return solver.solve(statistics, *model, initial_iterate);
+   }
+
+   // a linear or convex quadratic program is its own quadratic model: no globalization nor outer loop. The interior-point
+   // method needs the slacks and the relaxed bounds
+   if (ConvexQPSolver::is_applicable(*model, options)) {
+      model = std::make_unique<EqualityConstrainedModel>(std::move(model));
+      model = std::make_unique<BoundRelaxedModel>(std::move(model), options);
+      initial_iterate.set_number_variables(model->number_variables);
+      Statistics statistics = ConvexQPSolver::create_statistics(options);
+      ConvexQPSolver solver(*model, options);
+      return solver.solve(statistics, *model, initial_iterate);
+   }
+
+   // reformulate (scale, add slacks, relax the bounds, ...) if necessary
+   model = ModelFactory::reformulate(std::move(model), initial_iterate, options);
+
+   // create the statistics
+   Statistics statistics = Uno::create_statistics(*model, options);
+
+   // enforce linear constraints at initial point
+   if (options.get_bool("enforce_linear_constraints")) {
+      Preprocessing::enforce_linear_constraints(options, *model, initial_iterate.primals, initial_iterate.multipliers);
+   }
+
+   // create the constraint relaxation strategy
+   auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(statistics, *model, options);
+
+   // create the globalization mechanism
+   auto mechanism = GlobalizationMechanismFactory::create(statistics, *constraint_relaxation_strategy, options);
+
+   // instantiate the combination of ingredients and solve the problem
+   Uno uno = Uno(*mechanism, options);
+   return uno.solve(statistics, *model, initial_iterate);
+}
+
+Statistics Uno::create_statistics(const Model& model, const Options& options) {
+   Statistics statistics(options);
+   statistics.add_column("iters", ColumnType::INTEGER, options.get_int("statistics_major_column_order"));
+   statistics.add_column("step norm", ColumnType::DOUBLE, options.get_int("statistics_step_norm_column_order"));
+   statistics.add_column("objective", ColumnType::DOUBLE, options.get_int("statistics_objective_column_order"));
+   if (model.is_constrained()) {
+      statistics.add_column("primal infeas.", ColumnType::DOUBLE, options.get_int("statistics_primal_infeasibility_column_order"));
+   }
+   statistics.add_column("complementarity", ColumnType::DOUBLE, options.get_int("statistics_complementarity_column_order"));
+   statistics.add_column("stationarity", ColumnType::DOUBLE, options.get_int("statistics_stationarity_column_order"));
+   return statistics;
+}
+
 void Uno::add_statistics(Statistics& statistics, const Iterate& iterate, size_t major_iterations) {
    statistics.add_statistic(std::string("iters"), major_iterations);
+   // the objective cell stays unset if the objective was not evaluated
    if (iterate.is_objective_computed) {
       statistics.add_statistic("objective", iterate.evaluations.objective);
    }
-   else {
-      statistics.add_statistic("objective", "-");
-   }
 }
 
 bool Uno::termination_criteria(TerminationStatus current_status, size_t iteration, double current_time) const {
@@ -121,4 +209,13 @@ void Uno::print_available_strategies() {
    std::cout << "Subproblems: ";
    join(SubproblemFactory::available_strategies(), ',');
    std::cout << '\n';
-}
\ No newline at end of file
+}
+
+void Uno::reset_evaluation_counters() {
+   Iterate::number_eval_objective = 0;
+   Iterate::number_eval_constraints = 0;
+   Iterate::number_eval_objective_gradient = 0;
+   Iterate::number_eval_jacobian = 0;
+   CachedModel::number_hits = 0;
+   CachedModel::number_misses = 0;
+}
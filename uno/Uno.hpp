@@ -4,6 +4,7 @@
 #ifndef UNO_H
 #define UNO_H
 
+#include <memory>
 #include "optimization/Model.hpp"
 #include "optimization/Result.hpp"
 #include "optimization/TerminationStatus.hpp"
@@ -20,13 +21,19 @@ public:
    Uno(GlobalizationMechanism& globalization_mechanism, const Options& options);
 
    [[nodiscard]] Result solve(Statistics& statistics, const Model& model, Iterate& initial_iterate);
+   // reformulate the model, assemble the ingredients selected in the options and solve
+   [[nodiscard]] static Result solve_model(std::unique_ptr<Model> model, const Options& options);
    static void print_available_strategies();
+   // the evaluation counters are per thread: each solve resets them
+   static void reset_evaluation_counters();
 
 private:
    GlobalizationMechanism& globalization_mechanism; /*!< Globalization mechanism */
    const size_t max_iterations; /*!< Maximum number of iterations */
-   const double time_limit; /*!< CPU time limit (can be inf) */
+   const double time_limit; /*!< Wall-clock time limit (can be inf) */
+   const std::string trace_file_name; /*!< Chrome trace-event file of the solver phases ("none": no trace) */
 
+   [[nodiscard]] static Statistics create_statistics(const Model& model, const Options& options);
    static void add_statistics(Statistics& statistics, const Iterate& iterate, size_t major_iterations);
    [[nodiscard]] bool termination_criteria(TerminationStatus current_status, size_t iteration, double current_time) const;
    static void postprocess_iterate(const Model& model, Iterate& iterate, TerminationStatus termination_status);
@@ -0,0 +1,131 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include "BatchSolver.hpp"
+#ifdef HAS_AMPLSOLVER
+#include "interfaces/AMPL/AMPLModel.hpp"
+#endif
+#include "interfaces/NL/NLModel.hpp"
+#include "interfaces/MPS/MPSModel.hpp"
+#include "tools/Logger.hpp"
+#include "tools/Options.hpp"
+#include "tools/Timer.hpp"
+
+thread_local Level Logger::level = INFO;
+
+// a directory contributes its .nl (and MPS/QPS) files, a model file itself, any other file the paths it lists (one per line)
+std::vector<std::string> collect_model_files(const std::string& path) {
+   std::vector<std::string> model_files;
+   if (std::filesystem::is_directory(path)) {
+      for (const auto& entry: std::filesystem::directory_iterator(path)) {
+         if (entry.is_regular_file() && (entry.path().extension() == ".nl" || MPSReader::is_mps_file(entry.path().string()))) {
+            model_files.push_back(entry.path().string());
+         }
+      }
+      std::sort(model_files.begin(), model_files.end());
+   }
+   else if (std::filesystem::path(path).extension() == ".nl" || MPSReader::is_mps_file(path)) {
+      model_files.push_back(path);
+   }
+   else {
+      std::ifstream file(path);
+      if (not file) {
+         throw std::invalid_argument("The model list " + path + " could not be opened");
+      }
+      std::string line;
+      while (std::getline(file, line)) {
+         if (not line.empty() && line[0] != '#') {
+            model_files.push_back(line);
+         }
+      }
+   }
+   return model_files;
+}
+
+void print_usage() {
+   std::cout << "To solve a batch of AMPL models, type ./uno_batch [-option value ...] path [path ...]\n";
+   std::cout << "A path is a .nl file, a directory of .nl files or a file that lists .nl files (one per line)\n";
+   std::cout << "Each model is solved with each option set of the file given by -batch_option_sets (one \"name option value ...\" per line)\n";
+   std::cout << "The results are written to the file given by -batch_results_file\n";
+}
+
+int main(int argc, char* argv[]) {
+   if (argc < 2) {
+      print_usage();
+      return EXIT_SUCCESS;
+   }
+   // get the default options. By default, the individual solves are silent
+   Options options = get_default_options("uno.options");
+   options["logger"] = "ERROR";
+   options["statistics_sink"] = "none";
+   options["trace_file"] = "none";
+
+   // the arguments are either (-option, value) pairs or paths
+   std::vector<std::string> paths;
+   for (int i = 1; i < argc; i++) {
+      const std::string argument = std::string(argv[i]);
+      if (argument[0] == '-' && i < argc - 1) {
+         const std::string name = argument.substr(1);
+         const std::string value = std::string(argv[i + 1]);
+         if (name == "preset") {
+            find_preset(value, options);
+         }
+         else {
+            options[name] = value;
+         }
+         i++;
+      }
+      else {
+         paths.push_back(argument);
+      }
+   }
+
+   try {
+      std::vector<BatchJob> jobs;
+      const std::vector<std::pair<std::string, Options>> option_sets = read_option_sets(options.get_string("batch_option_sets"), options);
+      for (const std::string& path: paths) {
+         for (const std::string& model_file: collect_model_files(path)) {
+            for (const auto& [option_set_name, option_set]: option_sets) {
+               jobs.push_back({model_file, option_set_name, option_set});
+            }
+         }
+      }
+
+      // the ASL is not reentrant (AMPLModel serializes its calls), the native .nl reader is. Without the ASL, the .nl files
+      // are read by the native reader
+      [[maybe_unused]] const bool native_reader = (options.get_string("nl_reader") == "native");
+      const MPSFormat mps_format = MPSReader::get_format(options.get_string("mps_format"));
+      const BatchSolver batch_solver([&](const std::string& model_file) -> std::unique_ptr<Model> {
+         if (MPSReader::is_mps_file(model_file)) {
+            return std::make_unique<MPSModel>(model_file, mps_format);
+         }
+#ifdef HAS_AMPLSOLVER
+         if (not native_reader) {
+            return std::make_unique<AMPLModel>(model_file);
+         }
+#endif
+         return std::make_unique<NLModel>(model_file);
+      }, options.get_unsigned_int("batch_workers"), options.get_unsigned_int("batch_memory_limit"));
+
+      Timer timer{};
+      const std::vector<BatchResult> results = batch_solver.solve(jobs);
+      const double duration = timer.get_duration();
+
+      const std::string& results_file_name = options.get_string("batch_results_file");
+      std::ofstream results_file(results_file_name);
+      BatchSolver::write_results(results_file, results);
+      const size_t number_converged = static_cast<size_t>(std::count_if(results.cbegin(), results.cend(), [](const BatchResult& result) {
+         return result.status == "feasible KKT point";
+      }));
+      std::cout << jobs.size() << " jobs solved in " << duration << " s (" << number_converged << " feasible KKT points). Results written to " <<
+            results_file_name << '\n';
+   }
+   catch (const std::exception& exception) {
+      std::cout << "Uno batch terminated with an error: " << exception.what() << '\n';
+      return EXIT_FAILURE;
+   }
+   return EXIT_SUCCESS;
+}
@@ -7,6 +7,7 @@
 #include "ingredients/subproblem/SubproblemFactory.hpp"
 #include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
 #include "linear_algebra/view.hpp"
+#include "tools/Profiler.hpp"
 
 FeasibilityRestoration::FeasibilityRestoration(Statistics& statistics, const Model& model, const Options& options) :
       ConstraintRelaxationStrategy(model, options),
@@ -21,7 +22,7 @@ FeasibilityRestoration::FeasibilityRestoration(Statistics& statistics, const Mod
       optimality_phase_strategy(GlobalizationStrategyFactory::create(statistics, options.get_string("globalization_strategy"), true, options)),
       tolerance(options.get_double("tolerance")),
       test_linearized_feasibility(options.get_bool("feasibility_restoration_test_linearized_feasibility")) {
-   statistics.add_column("phase", Statistics::int_width, options.get_int("statistics_restoration_phase_column_order"));
+   statistics.add_column("phase", ColumnType::INTEGER, options.get_int("statistics_restoration_phase_column_order"));
 }
 
 void FeasibilityRestoration::initialize(Iterate& initial_iterate) {
@@ -76,6 +77,7 @@ void FeasibilityRestoration::switch_to_feasibility_problem(Iterate& current_iter
       throw std::runtime_error("FeasibilityRestoration::switch_to_feasibility_problem: already in feasibility restoration.\n");
    }
    DEBUG << "Switching from optimality to restoration phase\n";
+   TRACE_INSTANT_EVENT("switch to restoration phase");
    this->current_phase = Phase::FEASIBILITY_RESTORATION;
    this->optimality_phase_strategy->register_current_progress(current_iterate.progress);
    this->subproblem->initialize_feasibility_problem();
@@ -93,6 +95,7 @@ void FeasibilityRestoration::switch_to_feasibility_problem(Iterate& current_iter
 
 Direction FeasibilityRestoration::solve_subproblem(Statistics& statistics, const NonlinearProblem& problem, Iterate& current_iterate,
       WarmstartInformation& warmstart_information) {
+   PROFILE_SCOPE("subproblem solve");
    if (this->switched_to_optimality_phase) {
       this->switched_to_optimality_phase = false;
       warmstart_information.set_cold_start();
@@ -139,6 +142,7 @@ void FeasibilityRestoration::compute_progress_measures(Iterate& current_iterate,
 
 void FeasibilityRestoration::switch_to_optimality(Iterate& current_iterate, Iterate& trial_iterate) {
    DEBUG << "Switching from restoration to optimality phase\n";
+   TRACE_INSTANT_EVENT("switch to optimality phase");
    this->current_phase = Phase::OPTIMALITY;
    current_iterate.set_number_variables(this->optimality_problem.number_variables);
    trial_iterate.set_number_variables(this->optimality_problem.number_variables);
@@ -214,7 +218,7 @@ void FeasibilityRestoration::set_trust_region_radius(double trust_region_radius)
 double FeasibilityRestoration::compute_complementarity_error(const std::vector<double>& primals, const std::vector<double>& constraints,
       const Multipliers& multipliers) const {
    // bound constraints
-   VectorExpression<double> variable_complementarity(this->original_model.number_variables, [&](size_t i) {
+   const VectorExpression variable_complementarity(this->original_model.number_variables, [&](size_t i) {
       if (0. < multipliers.lower_bounds[i]) {
          return multipliers.lower_bounds[i] * (primals[i] - this->original_model.get_variable_lower_bound(i));
       }
@@ -225,8 +229,7 @@ double FeasibilityRestoration::compute_complementarity_error(const std::vector<d
    });
 
    // constraints
-   VectorExpression<double> constraint_complementarity(this->original_model.inequality_constraints.size(), [&](size_t inequality_index) {
-      const size_t j = this->original_model.inequality_constraints[inequality_index];
+   const VectorExpression constraint_complementarity(this->original_model.number_constraints, [&](size_t j) {
       if (0. < multipliers.constraints[j]) { // lower bound
          return multipliers.constraints[j] * (constraints[j] - this->original_model.get_constraint_lower_bound(j));
       }
@@ -235,7 +238,7 @@ double FeasibilityRestoration::compute_complementarity_error(const std::vector<d
       }
       return 0.;
    });
-   return norm(this->residual_norm, variable_complementarity, constraint_complementarity);
+   return norm(this->residual_norm, variable_complementarity, subset(constraint_complementarity, this->original_model.inequality_constraints));
 }
 
 void FeasibilityRestoration::add_statistics(Statistics& statistics, const Iterate& trial_iterate) const {
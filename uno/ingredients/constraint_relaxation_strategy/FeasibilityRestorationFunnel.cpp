@@ -7,6 +7,7 @@
 #include "ingredients/subproblem/SubproblemFactory.hpp"
 #include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
 #include "linear_algebra/view.hpp"
+#include "tools/Profiler.hpp"
 
 FeasibilityRestorationFunnel::FeasibilityRestorationFunnel(Statistics& statistics, const Model& model, const Options& options) :
       ConstraintRelaxationStrategy(model, options),
@@ -22,7 +23,7 @@ FeasibilityRestorationFunnel::FeasibilityRestorationFunnel(Statistics& statistic
       // create tolerance and test for linearized feasibility
       tolerance(options.get_double("tolerance")),
       test_linearized_feasibility(options.get_bool("feasibility_restoration_test_linearized_feasibility")) {
-   statistics.add_column("phase", Statistics::int_width, options.get_int("statistics_restoration_phase_column_order"));
+   statistics.add_column("phase", ColumnType::INTEGER, options.get_int("statistics_restoration_phase_column_order"));
 }
 
 void FeasibilityRestorationFunnel::initialize(Iterate& initial_iterate) {
@@ -90,6 +91,7 @@ void FeasibilityRestorationFunnel::switch_to_feasibility_problem(Iterate& curren
       throw std::runtime_error("FeasibilityRestorationFunnel::switch_to_feasibility_problem: already in feasibility restoration.\n");
    }
    DEBUG << "Switching from optimality to restoration phase\n";
+   TRACE_INSTANT_EVENT("switch to restoration phase");
    this->synchronize_from_optimality_to_restoration_phase();
 
    this->current_phase = Phase::FEASIBILITY_RESTORATION;
@@ -109,6 +111,7 @@ void FeasibilityRestorationFunnel::switch_to_feasibility_problem(Iterate& curren
 
 Direction FeasibilityRestorationFunnel::solve_subproblem(Statistics& statistics, const NonlinearProblem& problem, Iterate& current_iterate,
       WarmstartInformation& warmstart_information) {
+   PROFILE_SCOPE("subproblem solve");
    if (this->switched_to_optimality_phase) {
       this->switched_to_optimality_phase = false;
       warmstart_information.set_cold_start();
@@ -165,6 +168,7 @@ void FeasibilityRestorationFunnel::compute_progress_measures(Iterate& current_it
 
 void FeasibilityRestorationFunnel::switch_to_optimality(Iterate& current_iterate, Iterate& trial_iterate) {
    DEBUG << "Switching from restoration to optimality phase\n";
+   TRACE_INSTANT_EVENT("switch to optimality phase");
    this->synchronize_from_restoration_to_optimality_phase();
 
    this->current_phase = Phase::OPTIMALITY;
@@ -242,7 +246,7 @@ void FeasibilityRestorationFunnel::set_trust_region_radius(double trust_region_r
 double FeasibilityRestorationFunnel::compute_complementarity_error(const std::vector<double>& primals, const std::vector<double>& constraints,
       const Multipliers& multipliers) const {
    // bound constraints
-   VectorExpression<double> variable_complementarity(this->original_model.number_variables, [&](size_t i) {
+   const VectorExpression variable_complementarity(this->original_model.number_variables, [&](size_t i) {
       if (0. < multipliers.lower_bounds[i]) {
          return multipliers.lower_bounds[i] * (primals[i] - this->original_model.get_variable_lower_bound(i));
       }
@@ -253,8 +257,7 @@ double FeasibilityRestorationFunnel::compute_complementarity_error(const std::ve
    });
 
    // constraints
-   VectorExpression<double> constraint_complementarity(this->original_model.inequality_constraints.size(), [&](size_t inequality_index) {
-      const size_t j = this->original_model.inequality_constraints[inequality_index];
+   const VectorExpression constraint_complementarity(this->original_model.number_constraints, [&](size_t j) {
       if (0. < multipliers.constraints[j]) { // lower bound
          return multipliers.constraints[j] * (constraints[j] - this->original_model.get_constraint_lower_bound(j));
       }
@@ -263,7 +266,7 @@ double FeasibilityRestorationFunnel::compute_complementarity_error(const std::ve
       }
       return 0.;
    });
-   return norm(this->residual_norm, variable_complementarity, constraint_complementarity);
+   return norm(this->residual_norm, variable_complementarity, subset(constraint_complementarity, this->original_model.inequality_constraints));
 }
 
 void FeasibilityRestorationFunnel::add_statistics(Statistics& statistics, const Iterate& trial_iterate) const {
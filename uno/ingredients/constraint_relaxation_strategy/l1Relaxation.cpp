@@ -6,6 +6,7 @@
 #include "ingredients/globalization_strategy/GlobalizationStrategyFactory.hpp"
 #include "ingredients/subproblem/SubproblemFactory.hpp"
 #include "linear_algebra/view.hpp"
+#include "tools/Profiler.hpp"
 
 /*
  * Infeasibility detection and SQP methods for nonlinear optimization
@@ -33,7 +34,7 @@ l1Relaxation::l1Relaxation(Statistics& statistics, const Model& model, const Opt
       }),
       small_duals_threshold(options.get_double("l1_small_duals_threshold")),
       trial_multipliers(this->l1_relaxed_problem.number_variables, model.number_constraints) {
-   statistics.add_column("penalty param.", Statistics::double_width, options.get_int("statistics_penalty_parameter_column_order"));
+   statistics.add_column("penalty param.", ColumnType::DOUBLE, options.get_int("statistics_penalty_parameter_column_order"));
 }
 
 void l1Relaxation::initialize(Iterate& initial_iterate) {
@@ -124,6 +125,8 @@ Direction l1Relaxation::solve_sequence_of_relaxed_subproblems(Statistics& statis
 Direction l1Relaxation::solve_subproblem(Statistics& statistics, const NonlinearProblem& problem, Iterate& current_iterate,
       const WarmstartInformation& warmstart_information) {
    DEBUG << "Solving the subproblem with penalty parameter " << problem.get_objective_multiplier() << "\n\n";
+   PROFILE_SCOPE("subproblem solve");
+   TRACE_COUNTER("penalty parameter", problem.get_objective_multiplier());
 
    // solve the subproblem
    Direction direction = this->subproblem->solve(statistics, problem, current_iterate, warmstart_information);
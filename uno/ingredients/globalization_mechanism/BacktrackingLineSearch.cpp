@@ -5,7 +5,9 @@
 #include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
 #include "BacktrackingLineSearch.hpp"
 #include "optimization/WarmstartInformation.hpp"
+#include "tools/Cancellation.hpp"
 #include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
 
 BacktrackingLineSearch::BacktrackingLineSearch(Statistics& statistics, ConstraintRelaxationStrategy& constraint_relaxation_strategy,
          const Options& options):
@@ -17,8 +19,8 @@ BacktrackingLineSearch::BacktrackingLineSearch(Statistics& statistics, Constrain
    assert(0 < this->backtracking_ratio && this->backtracking_ratio < 1. && "The LS backtracking ratio should be in (0, 1)");
    assert(0 < this->minimum_step_length && this->minimum_step_length < 1. && "The LS minimum step length should be in (0, 1)");
 
-   statistics.add_column("LS iters", Statistics::int_width + 3, options.get_int("statistics_minor_column_order"));
-   statistics.add_column("LS step length", Statistics::double_width, options.get_int("statistics_LS_step_length_column_order"));
+   statistics.add_column("LS iters", ColumnType::INTEGER, options.get_int("statistics_minor_column_order"));
+   statistics.add_column("LS step length", ColumnType::DOUBLE, options.get_int("statistics_LS_step_length_column_order"));
 }
 
 void BacktrackingLineSearch::initialize(Iterate& initial_iterate) {
@@ -31,10 +33,15 @@ Iterate BacktrackingLineSearch::compute_next_iterate(Statistics& statistics, con
    DEBUG2 << "Current iterate\n" << current_iterate << '\n';
 
    // compute the direction
-   Direction direction = this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, warmstart_information);
+   Cancellation::check();
+   Direction direction = [&]() {
+      PROFILE_SCOPE("direction computation");
+      return this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, warmstart_information);
+   }();
    BacktrackingLineSearch::check_unboundedness(direction);
 
    // backtrack along the direction
+   PROFILE_SCOPE("line search");
    this->total_number_iterations = 0;
    return this->backtrack_along_direction(statistics, model, current_iterate, direction, warmstart_information);
 }
@@ -84,6 +91,7 @@ Iterate BacktrackingLineSearch::backtrack_along_direction(Statistics& statistics
    }
 
    // reached a small step length: revert to solving the feasibility problem
+   Cancellation::check();
    warmstart_information.set_cold_start();
    this->constraint_relaxation_strategy.switch_to_feasibility_problem(current_iterate, warmstart_information);
    Direction direction_feasibility = this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate,
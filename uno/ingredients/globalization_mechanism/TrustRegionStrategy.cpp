@@ -5,7 +5,9 @@
 #include <cassert>
 #include "TrustRegionStrategy.hpp"
 #include "optimization/WarmstartInformation.hpp"
+#include "tools/Cancellation.hpp"
 #include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
 
 TrustRegionStrategy::TrustRegionStrategy(Statistics& statistics, ConstraintRelaxationStrategy& constraint_relaxation_strategy,
          const Options& options) :
@@ -21,8 +23,8 @@ TrustRegionStrategy::TrustRegionStrategy(Statistics& statistics, ConstraintRelax
    assert(1. < this->increase_factor && "The trust-region increase factor should be > 1");
    assert(1. < this->decrease_factor && "The trust-region decrease factor should be > 1");
 
-   statistics.add_column("TR iters", Statistics::int_width + 3, options.get_int("statistics_minor_column_order"));
-   statistics.add_column("TR radius", Statistics::double_width, options.get_int("statistics_TR_radius_column_order"));
+   statistics.add_column("TR iters", ColumnType::INTEGER, options.get_int("statistics_minor_column_order"));
+   statistics.add_column("TR radius", ColumnType::DOUBLE, options.get_int("statistics_TR_radius_column_order"));
 }
 
 void TrustRegionStrategy::initialize(Iterate& initial_iterate) {
@@ -35,6 +37,7 @@ Iterate TrustRegionStrategy::compute_next_iterate(Statistics& statistics, const
    warmstart_information.set_hot_start();
    DEBUG2 << "Current iterate\n" << current_iterate << '\n';
 
+   PROFILE_SCOPE("trust-region iterations");
    bool reached_small_radius = false;
    size_t number_iterations = 0;
    while (not reached_small_radius) {
@@ -43,8 +46,13 @@ Iterate TrustRegionStrategy::compute_next_iterate(Statistics& statistics, const
          this->print_iteration(number_iterations);
 
          // compute the direction within the trust region
+         Cancellation::check();
          this->constraint_relaxation_strategy.set_trust_region_radius(this->radius);
-         Direction direction = this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, warmstart_information);
+         TRACE_COUNTER("trust-region radius", this->radius);
+         Direction direction = [&]() {
+            PROFILE_SCOPE("direction computation");
+            return this->constraint_relaxation_strategy.compute_feasible_direction(statistics, current_iterate, warmstart_information);
+         }();
 
          // deal with errors in the subproblem
          if (direction.status == SubproblemStatus::UNBOUNDED_PROBLEM) {
@@ -19,7 +19,7 @@ FunnelMethod::FunnelMethod(Statistics& statistics, const Options& options) :
          options.get_double("funnel_beta"),
          options.get_double("funnel_gamma")
       }) {
-   statistics.add_column("funnel width", Statistics::double_width, options.get_int("statistics_funnel_size_column_order"));
+   statistics.add_column("funnel width", ColumnType::DOUBLE, options.get_int("statistics_funnel_size_column_order"));
 
 }
 
@@ -4,7 +4,7 @@
 #include "l1MeritFunction.hpp"
 
 l1MeritFunction::l1MeritFunction(Statistics& statistics, const Options& options): GlobalizationStrategy(options) {
-   statistics.add_column("penalty param.", Statistics::double_width, options.get_int("statistics_penalty_parameter_column_order"));
+   statistics.add_column("penalty param.", ColumnType::DOUBLE, options.get_int("statistics_penalty_parameter_column_order"));
 }
 
 void l1MeritFunction::initialize(const Iterate& /*initial_iterate*/) {
@@ -1,24 +1,44 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
+#include <cmath>
 #include "HessianModel.hpp"
 #include "linear_algebra/SymmetricMatrixFactory.hpp"
 #include "solvers/linear/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Profiler.hpp"
+
+extern "C" {
+   // LAPACK: solution of a general dense linear system
+   void dgesv_(int* n, int* nrhs, double* a, int* lda, int* ipiv, double* b, int* ldb, int* info);
+}
 
 HessianModel::HessianModel(size_t dimension, size_t maximum_number_nonzeros, const std::string& sparse_format, bool use_regularization) :
       hessian(SymmetricMatrixFactory<double>::create(sparse_format, dimension, maximum_number_nonzeros, use_regularization)) {
 }
 
+double HessianModel::quadratic_product(const std::vector<double>& x, const std::vector<double>& y) const {
+   return this->hessian->quadratic_product(x, y);
+}
+
+void HessianModel::solve_linear_system(SymmetricIndefiniteLinearSolver<double>& linear_solver, const SymmetricMatrix<double>& matrix,
+      const std::vector<double>& rhs, std::vector<double>& result) {
+   PROFILE_SCOPE("triangular solve");
+   linear_solver.solve_indefinite_system(matrix, rhs, result);
+}
+
 // Exact Hessian
 ExactHessian::ExactHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options) :
    HessianModel(dimension, maximum_number_nonzeros, options.get_string("sparse_format"), /* use_regularization = */false) {
 }
 
-void ExactHessian::evaluate(Statistics& /*statistics*/, const NonlinearProblem& problem, const std::vector<double>& primal_variables,
+void ExactHessian::evaluate(Statistics& /*statistics*/, const NonlinearProblem& problem, Iterate& iterate,
       const std::vector<double>& constraint_multipliers) {
+   PROFILE_SCOPE("Hessian evaluation");
    // evaluate Lagrangian Hessian
    this->hessian->dimension = problem.number_variables;
-   problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, *this->hessian);
+   problem.evaluate_lagrangian_hessian(iterate.primals, constraint_multipliers, *this->hessian);
    this->evaluation_count++;
 }
 
@@ -26,17 +46,23 @@ void ExactHessian::evaluate(Statistics& /*statistics*/, const NonlinearProblem&
 ConvexifiedHessian::ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options):
       HessianModel(dimension, maximum_number_nonzeros, options.get_string("sparse_format"), /* use_regularization = */true),
       // inertia-based convexification needs a linear solver
-      linear_solver(SymmetricIndefiniteLinearSolverFactory::create(options.get_string("linear_solver"), dimension, maximum_number_nonzeros)),
+      linear_solver(SymmetricIndefiniteLinearSolverFactory::create(dimension, maximum_number_nonzeros, options)),
       regularization_initial_value(options.get_double("regularization_initial_value")),
-      regularization_increase_factor(options.get_double("regularization_increase_factor")) {
+      regularization_increase_factor(options.get_double("regularization_increase_factor")),
+      number_lanczos_iterations(options.get_unsigned_int("regularization_lanczos_iterations")),
+      lanczos_vector(dimension), previous_lanczos_vector(dimension), lanczos_product(dimension) {
 }
 
-void ConvexifiedHessian::evaluate(Statistics& statistics, const NonlinearProblem& problem, const std::vector<double>& primal_variables,
+void ConvexifiedHessian::evaluate(Statistics& statistics, const NonlinearProblem& problem, Iterate& iterate,
       const std::vector<double>& constraint_multipliers) {
-   // evaluate Lagrangian Hessian
-   this->hessian->dimension = problem.number_variables;
-   problem.evaluate_lagrangian_hessian(primal_variables, constraint_multipliers, *this->hessian);
-   this->evaluation_count++;
+   {
+      PROFILE_SCOPE("Hessian evaluation");
+      // evaluate Lagrangian Hessian
+      this->hessian->dimension = problem.number_variables;
+      problem.evaluate_lagrangian_hessian(iterate.primals, constraint_multipliers, *this->hessian);
+      this->evaluation_count++;
+   }
+   PROFILE_SCOPE("Hessian convexification");
    // regularize (only on the original variables) to convexify the problem
    DEBUG2 << "hessian before convexification: " << *this->hessian;
    this->regularize(statistics, *this->hessian, problem.get_number_original_variables());
@@ -46,10 +72,12 @@ void ConvexifiedHessian::evaluate(Statistics& statistics, const NonlinearProblem
 void ConvexifiedHessian::regularize(Statistics& statistics, SymmetricMatrix<double>& hessian, size_t number_original_variables) {
    //assert(size_block_to_regularize <= matrix.dimension && "The block to regularize is larger than the matrix");
 
-   const double smallest_diagonal_entry = hessian.smallest_diagonal_entry();
-   DEBUG << "The minimal diagonal entry of the matrix is " << hessian.smallest_diagonal_entry() << '\n';
+   // bounds on the smallest eigenvalue of the original block: Gershgorin (lower bound) and Lanczos (upper bound)
+   const double eigenvalue_lower_bound = ConvexifiedHessian::compute_gershgorin_lower_bound(hessian, number_original_variables);
+   const double eigenvalue_estimate = this->estimate_smallest_eigenvalue(hessian, number_original_variables);
+   DEBUG << "The smallest eigenvalue of the matrix lies in [" << eigenvalue_lower_bound << ", " << eigenvalue_estimate << "]\n";
 
-   double regularization_factor = (smallest_diagonal_entry <= 0.) ? this->regularization_initial_value - smallest_diagonal_entry : 0.;
+   double regularization_factor = (eigenvalue_estimate <= 0.) ? this->regularization_initial_value - eigenvalue_estimate : 0.;
    bool good_inertia = false;
    while (not good_inertia) {
       DEBUG << "Testing factorization with regularization factor " << regularization_factor << '\n';
@@ -58,26 +86,499 @@ void ConvexifiedHessian::regularize(Statistics& statistics, SymmetricMatrix<doub
             return (i < number_original_variables) ? regularization_factor : 0.;
          });
       }
-      // TODO check if sparsity pattern changes. If not, perform symbolic factorization once
-      this->linear_solver->do_symbolic_factorization(hessian);
-      this->linear_solver->do_numerical_factorization(hessian);
-
-      if (this->linear_solver->rank() == number_original_variables && this->linear_solver->number_negative_eigenvalues() == 0) {
+      if (0. < eigenvalue_lower_bound + regularization_factor) {
+         // the regularized matrix is strictly diagonally dominant with a positive diagonal: no need to factorize
          good_inertia = true;
-         DEBUG << "Factorization was a success\n";
+         DEBUG << "The Gershgorin bound guarantees positive definiteness\n";
       }
       else {
-         DEBUG << "rank: " << this->linear_solver->rank() << ", negative eigenvalues: " << this->linear_solver->number_negative_eigenvalues() << '\n';
-         regularization_factor = (regularization_factor == 0.) ? this->regularization_initial_value : this->regularization_increase_factor * regularization_factor;
-         assert(is_finite(regularization_factor) && "The regularization coefficient diverged");
+         this->factorize(hessian);
+         if (this->linear_solver->rank() == number_original_variables && this->linear_solver->number_negative_eigenvalues() == 0) {
+            good_inertia = true;
+            DEBUG << "Factorization was a success\n";
+         }
+         else {
+            DEBUG << "rank: " << this->linear_solver->rank() << ", negative eigenvalues: " << this->linear_solver->number_negative_eigenvalues() << '\n';
+            regularization_factor = (regularization_factor == 0.) ? this->regularization_initial_value : this->regularization_increase_factor * regularization_factor;
+            assert(is_finite(regularization_factor) && "The regularization coefficient diverged");
+         }
       }
    }
    statistics.add_statistic("regularization", regularization_factor);
 }
 
+// the regularization terms are preallocated: the sparsity pattern does not change during the regularization loop
+void ConvexifiedHessian::factorize(const SymmetricMatrix<double>& hessian) {
+   const size_t pattern_hash = hessian.compute_sparsity_pattern_hash();
+   if (not this->symbolic_factorization_available || pattern_hash != this->sparsity_pattern_hash) {
+      PROFILE_SCOPE("symbolic factorization");
+      this->linear_solver->do_symbolic_factorization(hessian);
+      this->symbolic_factorization_available = true;
+      this->sparsity_pattern_hash = pattern_hash;
+   }
+   PROFILE_SCOPE("numerical factorization");
+   this->linear_solver->do_numerical_factorization(hessian);
+}
+
+// min_i (a_ii - sum_{j != i} |a_ij|) over the original block
+double ConvexifiedHessian::compute_gershgorin_lower_bound(const SymmetricMatrix<double>& hessian, size_t number_original_variables) {
+   std::vector<double> diagonal(number_original_variables, 0.);
+   std::vector<double> radius(number_original_variables, 0.);
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      if (i < number_original_variables && j < number_original_variables) {
+         if (i == j) {
+            diagonal[i] += entry;
+         }
+         else {
+            radius[i] += std::abs(entry);
+            radius[j] += std::abs(entry);
+         }
+      }
+   });
+   double lower_bound = INF<double>;
+   for (size_t i: Range(number_original_variables)) {
+      lower_bound = std::min(lower_bound, diagonal[i] - radius[i]);
+   }
+   return lower_bound;
+}
+
+// a few Lanczos iterations on the original block. The smallest Ritz value (computed by bisection on the tridiagonal matrix)
+// is an upper bound on the smallest eigenvalue, and so is the smallest diagonal entry
+double ConvexifiedHessian::estimate_smallest_eigenvalue(const SymmetricMatrix<double>& hessian, size_t number_original_variables) {
+   double smallest_diagonal_entry = INF<double>;
+   std::vector<double> diagonal(number_original_variables, 0.);
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      if (i == j && i < number_original_variables) {
+         diagonal[i] += entry;
+      }
+   });
+   for (size_t i: Range(number_original_variables)) {
+      smallest_diagonal_entry = std::min(smallest_diagonal_entry, diagonal[i]);
+   }
+   if (this->number_lanczos_iterations == 0 || number_original_variables == 0) {
+      return smallest_diagonal_entry;
+   }
+
+   // deterministic starting vector
+   auto& q = this->lanczos_vector;
+   auto& previous_q = this->previous_lanczos_vector;
+   auto& w = this->lanczos_product;
+   double norm = 0.;
+   for (size_t i: Range(number_original_variables)) {
+      q[i] = 1. + static_cast<double>(i % 10) / 10.;
+      previous_q[i] = 0.;
+      norm += q[i] * q[i];
+   }
+   norm = std::sqrt(norm);
+   for (size_t i: Range(number_original_variables)) {
+      q[i] /= norm;
+   }
+
+   // tridiagonal matrix T: diagonal alpha and off-diagonal beta
+   std::vector<double> alpha{};
+   std::vector<double> beta{};
+   double previous_beta = 0.;
+   for ([[maybe_unused]] size_t iteration: Range(std::min(this->number_lanczos_iterations, number_original_variables))) {
+      // w = A q
+      for (size_t i: Range(number_original_variables)) {
+         w[i] = 0.;
+      }
+      hessian.for_each([&](size_t i, size_t j, double entry) {
+         if (i < number_original_variables && j < number_original_variables) {
+            w[i] += entry * q[j];
+            if (i != j) {
+               w[j] += entry * q[i];
+            }
+         }
+      });
+      double alpha_k = 0.;
+      for (size_t i: Range(number_original_variables)) {
+         alpha_k += q[i] * w[i];
+      }
+      alpha.push_back(alpha_k);
+      double beta_k = 0.;
+      for (size_t i: Range(number_original_variables)) {
+         w[i] -= alpha_k * q[i] + previous_beta * previous_q[i];
+         beta_k += w[i] * w[i];
+      }
+      beta_k = std::sqrt(beta_k);
+      // invariant subspace
+      if (beta_k <= 1e-12) {
+         break;
+      }
+      beta.push_back(beta_k);
+      for (size_t i: Range(number_original_variables)) {
+         previous_q[i] = q[i];
+         q[i] = w[i] / beta_k;
+      }
+      previous_beta = beta_k;
+   }
+   beta.resize(alpha.size() - 1);
+
+   // bisection on [a, b] (Gershgorin interval of T) using Sturm sequences
+   const size_t m = alpha.size();
+   double a = INF<double>;
+   double b = -INF<double>;
+   for (size_t k: Range(m)) {
+      const double radius = (0 < k ? std::abs(beta[k - 1]) : 0.) + (k + 1 < m ? std::abs(beta[k]) : 0.);
+      a = std::min(a, alpha[k] - radius);
+      b = std::max(b, alpha[k] + radius);
+   }
+   // number of eigenvalues of T smaller than x
+   const auto sturm_count = [&](double x) {
+      size_t count = 0;
+      double d = 1.;
+      for (size_t k: Range(m)) {
+         d = alpha[k] - x - ((0 < k) ? beta[k - 1] * beta[k - 1] / d : 0.);
+         if (d == 0.) {
+            d = -std::numeric_limits<double>::epsilon();
+         }
+         if (d < 0.) {
+            count++;
+         }
+      }
+      return count;
+   };
+   const double tolerance = 1e-8 * std::max(1., std::max(std::abs(a), std::abs(b)));
+   while (tolerance < b - a) {
+      const double midpoint = (a + b) / 2.;
+      if (0 < sturm_count(midpoint)) {
+         b = midpoint;
+      }
+      else {
+         a = midpoint;
+      }
+   }
+   return std::min(smallest_diagonal_entry, b);
+}
+
+// L-BFGS Hessian
+// dense (p x p) matrix stored column-major. On exit, rhs contains the solution and matrix is overwritten
+static void solve_dense_linear_system(std::vector<double>& matrix, std::vector<double>& rhs, size_t dimension, size_t number_rhs) {
+   int n = static_cast<int>(dimension);
+   int nrhs = static_cast<int>(number_rhs);
+   std::vector<int> pivots(dimension);
+   int info = 0;
+   dgesv_(&n, &nrhs, matrix.data(), &n, pivots.data(), rhs.data(), &n, &info);
+   if (info != 0) {
+      throw std::runtime_error("The dense linear system of the L-BFGS compact representation could not be solved");
+   }
+}
+
+LBFGSHessian::LBFGSHessian(size_t dimension, bool use_compact_representation, const Options& options):
+      // the explicit representation is dense. The compact representation stores delta I and the diagonal barrier terms
+      HessianModel(dimension, use_compact_representation ? 2*dimension : (dimension * (dimension + 1)) / 2, options.get_string("sparse_format"),
+            /* use_regularization = */false),
+      memory_size(options.get_unsigned_int("quasi_newton_memory_size")),
+      damping_threshold(options.get_double("quasi_newton_damping_threshold")),
+      use_compact_representation(use_compact_representation),
+      previous_primals(dimension),
+      previous_objective_gradient(dimension),
+      current_lagrangian_gradient(dimension),
+      previous_lagrangian_gradient(dimension) {
+   this->S.reserve(this->memory_size);
+   this->Y.reserve(this->memory_size);
+}
+
+void LBFGSHessian::evaluate(Statistics& /*statistics*/, const NonlinearProblem& problem, Iterate& iterate,
+      const std::vector<double>& constraint_multipliers) {
+   // the quasi-Newton matrix only approximates the Hessian wrt the original variables
+   this->number_original_variables = problem.get_number_original_variables();
+   this->step.resize(this->number_original_variables);
+   this->gradient_difference.resize(this->number_original_variables);
+   this->hessian_step.resize(this->number_original_variables);
+
+   // gradients of the Lagrangian at the current and previous points (with the current multipliers)
+   this->evaluate_lagrangian_gradients(problem, iterate, constraint_multipliers);
+   if (this->has_previous_point) {
+      this->update_curvature_pairs(iterate.primals, problem.get_objective_multiplier());
+   }
+
+   // the current point becomes the previous point
+   copy_from(this->previous_primals, iterate.primals, this->number_original_variables);
+   copy_from(this->previous_objective_gradient, this->current_lagrangian_gradient.objective_contribution, this->number_original_variables);
+   this->save_previous_constraint_jacobian(iterate.evaluations.constraint_jacobian, problem.model.number_constraints);
+   this->has_previous_point = true;
+
+   // form the quasi-Newton matrix
+   this->hessian->dimension = problem.number_variables;
+   if (this->use_compact_representation) {
+      this->form_compact_hessian(problem.number_variables);
+   }
+   else {
+      this->form_explicit_hessian(problem.number_variables);
+   }
+   this->evaluation_count++;
+}
+
+// Lagrangian gradients "objective_multiplier * objective_contribution + constraints_contribution" at the current and previous points.
+// The derivatives at the current point are those of the iterate: they are only evaluated if the iterate does not hold them yet
+void LBFGSHessian::evaluate_lagrangian_gradients(const NonlinearProblem& problem, Iterate& iterate,
+      const std::vector<double>& constraint_multipliers) {
+   const size_t number_constraints = problem.model.number_constraints;
+   iterate.evaluate_objective_gradient(problem.model);
+   iterate.evaluate_constraint_jacobian(problem.model);
+
+   // objective contributions
+   initialize_vector(this->current_lagrangian_gradient.objective_contribution, 0.);
+   iterate.evaluations.objective_gradient.for_each([&](size_t i, double derivative) {
+      this->current_lagrangian_gradient.objective_contribution[i] += derivative;
+   });
+   copy_from(this->previous_lagrangian_gradient.objective_contribution, this->previous_objective_gradient, this->number_original_variables);
+
+   // constraints contributions (both evaluated with the current multipliers)
+   initialize_vector(this->current_lagrangian_gradient.constraints_contribution, 0.);
+   initialize_vector(this->previous_lagrangian_gradient.constraints_contribution, 0.);
+   for (size_t j: Range(number_constraints)) {
+      if (constraint_multipliers[j] != 0.) {
+         iterate.evaluations.constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+            this->current_lagrangian_gradient.constraints_contribution[i] -= constraint_multipliers[j] * derivative;
+         });
+         if (this->has_previous_point) {
+            this->previous_constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+               this->previous_lagrangian_gradient.constraints_contribution[i] -= constraint_multipliers[j] * derivative;
+            });
+         }
+      }
+   }
+}
+
+// the rows keep their capacity from one iteration to the next
+void LBFGSHessian::save_previous_constraint_jacobian(const RectangularMatrix<double>& constraint_jacobian, size_t number_constraints) {
+   this->previous_constraint_jacobian.resize(number_constraints, SparseVector<double>(this->number_original_variables));
+   for (size_t j: Range(number_constraints)) {
+      this->previous_constraint_jacobian[j].clear();
+      constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+         this->previous_constraint_jacobian[j].insert(i, derivative);
+      });
+   }
+}
+
+// damped BFGS update (Nocedal and Wright, Procedure 18.2)
+void LBFGSHessian::update_curvature_pairs(const std::vector<double>& primal_variables, double objective_multiplier) {
+   // s = x - x_previous, y = gradient of the Lagrangian at x - gradient of the Lagrangian at x_previous
+   for (size_t i: Range(this->number_original_variables)) {
+      this->step[i] = primal_variables[i] - this->previous_primals[i];
+      this->gradient_difference[i] = objective_multiplier * (this->current_lagrangian_gradient.objective_contribution[i] -
+            this->previous_lagrangian_gradient.objective_contribution[i]) + (this->current_lagrangian_gradient.constraints_contribution[i] -
+            this->previous_lagrangian_gradient.constraints_contribution[i]);
+   }
+   if (norm_inf(this->step) == 0.) {
+      DEBUG << "L-BFGS: the step is zero, the curvature pairs are not updated\n";
+      return;
+   }
+
+   // damping: replace y with theta y + (1 - theta) B s to guarantee positive definiteness
+   this->compute_hessian_vector_product(this->step, this->hessian_step);
+   const double sBs = dot(this->step, this->hessian_step);
+   double sy = dot(this->step, this->gradient_difference);
+   if (sy < this->damping_threshold * sBs) {
+      const double theta = (1. - this->damping_threshold) * sBs / (sBs - sy);
+      for (size_t i: Range(this->number_original_variables)) {
+         this->gradient_difference[i] = theta * this->gradient_difference[i] + (1. - theta) * this->hessian_step[i];
+      }
+      sy = dot(this->step, this->gradient_difference);
+      DEBUG << "L-BFGS: damped update with theta = " << theta << '\n';
+   }
+   if (sy <= 0.) {
+      WARNING << YELLOW << "L-BFGS: the curvature condition does not hold, the curvature pairs are not updated\n" << RESET;
+      return;
+   }
+
+   // discard the oldest pair if the memory is full
+   if (this->S.size() == this->memory_size) {
+      std::rotate(this->S.begin(), this->S.begin() + 1, this->S.end());
+      std::rotate(this->Y.begin(), this->Y.begin() + 1, this->Y.end());
+      this->S.back() = this->step;
+      this->Y.back() = this->gradient_difference;
+   }
+   else {
+      this->S.push_back(this->step);
+      this->Y.push_back(this->gradient_difference);
+   }
+   // B0 = delta I with delta = y^T y / s^T y
+   this->scaling_factor = dot(this->gradient_difference, this->gradient_difference) / sy;
+   DEBUG << "L-BFGS: " << this->number_pairs() << " curvature pairs, delta = " << this->scaling_factor << '\n';
+   this->compute_middle_matrix_inverse();
+}
+
+// M^{-1} = [delta S^T S    L]
+//          [L^T           -D]
+// with L the strictly lower triangular part of S^T Y and D its diagonal part
+void LBFGSHessian::compute_middle_matrix_inverse() {
+   const size_t k = this->number_pairs();
+   const size_t p = 2*k;
+   this->middle_matrix_inverse.resize(p*p);
+   initialize_vector(this->middle_matrix_inverse, 0.);
+   for (size_t i: Range(k)) {
+      for (size_t j: Range(k)) {
+         this->middle_matrix_inverse[i + j*p] = this->scaling_factor * dot(this->S[i], this->S[j]);
+         if (j < i) {
+            const double sy = dot(this->S[i], this->Y[j]);
+            this->middle_matrix_inverse[i + (k + j)*p] = sy;
+            this->middle_matrix_inverse[(k + j) + i*p] = sy;
+         }
+         else if (i == j) {
+            this->middle_matrix_inverse[(k + i) + (k + i)*p] = -dot(this->S[i], this->Y[i]);
+         }
+      }
+   }
+}
+
+size_t LBFGSHessian::number_pairs() const {
+   return this->S.size();
+}
+
+// W = [delta S, Y]
+double LBFGSHessian::W_entry(size_t i, size_t column) const {
+   const size_t k = this->number_pairs();
+   return (column < k) ? this->scaling_factor * this->S[column][i] : this->Y[column - k][i];
+}
+
+// solve M^{-1} X = rhs in place, where rhs has number_rhs columns
+void LBFGSHessian::solve_with_middle_matrix_inverse(std::vector<double>& rhs, size_t number_rhs) const {
+   std::vector<double> matrix = this->middle_matrix_inverse;
+   solve_dense_linear_system(matrix, rhs, 2*this->number_pairs(), number_rhs);
+}
+
+// B x = delta x - W M W^T x
+void LBFGSHessian::compute_hessian_vector_product(const std::vector<double>& x, std::vector<double>& result) const {
+   const size_t p = 2*this->number_pairs();
+   std::vector<double> low_rank_product(p, 0.);
+   for (size_t column: Range(p)) {
+      for (size_t i: Range(this->number_original_variables)) {
+         low_rank_product[column] += this->W_entry(i, column) * x[i];
+      }
+   }
+   if (0 < p) {
+      this->solve_with_middle_matrix_inverse(low_rank_product, 1);
+   }
+   for (size_t i: Range(this->number_original_variables)) {
+      result[i] = this->scaling_factor * x[i];
+      for (size_t column: Range(p)) {
+         result[i] -= this->W_entry(i, column) * low_rank_product[column];
+      }
+   }
+}
+
+// x^T W M W^T y
+double LBFGSHessian::low_rank_quadratic_product(const std::vector<double>& x, const std::vector<double>& y) const {
+   const size_t p = 2*this->number_pairs();
+   if (p == 0) {
+      return 0.;
+   }
+   std::vector<double> WTx(p, 0.);
+   std::vector<double> WTy(p, 0.);
+   for (size_t column: Range(p)) {
+      for (size_t i: Range(this->number_original_variables)) {
+         WTx[column] += this->W_entry(i, column) * x[i];
+         WTy[column] += this->W_entry(i, column) * y[i];
+      }
+   }
+   this->solve_with_middle_matrix_inverse(WTy, 1);
+   return dot(WTx, WTy);
+}
+
+double LBFGSHessian::quadratic_product(const std::vector<double>& x, const std::vector<double>& y) const {
+   if (this->use_compact_representation) {
+      // the matrix only contains the diagonal terms
+      return this->hessian->quadratic_product(x, y) - this->low_rank_quadratic_product(x, y);
+   }
+   return this->hessian->quadratic_product(x, y);
+}
+
+// dense upper triangular part of B = delta I - W M W^T
+void LBFGSHessian::form_explicit_hessian(size_t number_variables) {
+   const size_t n = this->number_original_variables;
+   const size_t p = 2*this->number_pairs();
+   // X = M W^T (p x n)
+   std::vector<double> X(p*n);
+   for (size_t i: Range(n)) {
+      for (size_t column: Range(p)) {
+         X[column + i*p] = this->W_entry(i, column);
+      }
+   }
+   if (0 < p) {
+      this->solve_with_middle_matrix_inverse(X, n);
+   }
+
+   this->hessian->reset();
+   for (size_t j: Range(number_variables)) {
+      if (j < n) {
+         for (size_t i: Range(j + 1)) {
+            double entry = (i == j) ? this->scaling_factor : 0.;
+            for (size_t column: Range(p)) {
+               entry -= this->W_entry(i, column) * X[column + j*p];
+            }
+            if (entry != 0.) {
+               this->hessian->insert(entry, i, j);
+            }
+         }
+      }
+      this->hessian->finalize_column(j);
+   }
+}
+
+// diagonal part delta I of the compact representation
+void LBFGSHessian::form_compact_hessian(size_t number_variables) {
+   this->hessian->reset();
+   for (size_t j: Range(number_variables)) {
+      if (j < this->number_original_variables) {
+         this->hessian->insert(this->scaling_factor, j, j);
+      }
+      this->hessian->finalize_column(j);
+   }
+}
+
+// Sherman-Morrison-Woodbury formula: the linear solver holds the factorization of K0 (with diagonal Hessian block).
+// The actual matrix is K = K0 - U M U^T with U = [W; 0]:
+// K^{-1} rhs = z + Z (M^{-1} - U^T Z)^{-1} U^T z with z = K0^{-1} rhs and Z = K0^{-1} U
+void LBFGSHessian::solve_linear_system(SymmetricIndefiniteLinearSolver<double>& linear_solver, const SymmetricMatrix<double>& matrix,
+      const std::vector<double>& rhs, std::vector<double>& result) {
+   PROFILE_SCOPE("triangular solve");
+   linear_solver.solve_indefinite_system(matrix, rhs, result);
+   const size_t p = 2*this->number_pairs();
+   if (not this->use_compact_representation || p == 0) {
+      return;
+   }
+
+   // Z = K0^{-1} U
+   std::vector<std::vector<double>> Z(p, std::vector<double>(rhs.size()));
+   std::vector<double> U_column(rhs.size());
+   for (size_t column: Range(p)) {
+      initialize_vector(U_column, 0.);
+      for (size_t i: Range(this->number_original_variables)) {
+         U_column[i] = this->W_entry(i, column);
+      }
+      linear_solver.solve_indefinite_system(matrix, U_column, Z[column]);
+   }
+
+   // capacitance matrix M^{-1} - U^T Z and U^T z
+   std::vector<double> capacitance_matrix(this->middle_matrix_inverse);
+   std::vector<double> UTz(p, 0.);
+   for (size_t row: Range(p)) {
+      for (size_t i: Range(this->number_original_variables)) {
+         UTz[row] += this->W_entry(i, row) * result[i];
+      }
+      for (size_t column: Range(p)) {
+         for (size_t i: Range(this->number_original_variables)) {
+            capacitance_matrix[row + column*p] -= this->W_entry(i, row) * Z[column][i];
+         }
+      }
+   }
+   solve_dense_linear_system(capacitance_matrix, UTz, p, 1);
+
+   // correction
+   for (size_t column: Range(p)) {
+      for (size_t i: Range(rhs.size())) {
+         result[i] += Z[column][i] * UTz[column];
+      }
+   }
+}
+
 // Factory
 std::unique_ptr<HessianModel> HessianModelFactory::create(const std::string& hessian_model, size_t dimension, size_t maximum_number_nonzeros,
-      bool convexify, const Options& options) {
+      bool convexify, bool use_compact_representation, const Options& options) {
    if (hessian_model == "exact") {
       if (convexify) {
          return std::make_unique<ConvexifiedHessian>(dimension, maximum_number_nonzeros, options);
@@ -86,5 +587,9 @@ std::unique_ptr<HessianModel> HessianModelFactory::create(const std::string& hes
          return std::make_unique<ExactHessian>(dimension, maximum_number_nonzeros, options);
       }
    }
+   else if (hessian_model == "BFGS") {
+      // the damped updates are positive definite: no convexification is needed
+      return std::make_unique<LBFGSHessian>(dimension, use_compact_representation, options);
+   }
    throw std::invalid_argument("Hessian model " + hessian_model + " does not exist");
 }
@@ -7,6 +7,7 @@
 #include <memory>
 #include <vector>
 #include "reformulation/NonlinearProblem.hpp"
+#include "optimization/LagrangianGradient.hpp"
 #include "solvers/linear/SymmetricIndefiniteLinearSolver.hpp"
 #include "tools/Options.hpp"
 #include "tools/Statistics.hpp"
@@ -19,8 +20,13 @@ public:
    std::unique_ptr<SymmetricMatrix<double>> hessian;
    size_t evaluation_count{0};
 
-   virtual void evaluate(Statistics& statistics, const NonlinearProblem& problem, const std::vector<double>& primal_variables,
+   // the derivatives of the iterate are evaluated (and cached) if the model needs them
+   virtual void evaluate(Statistics& statistics, const NonlinearProblem& problem, Iterate& iterate,
          const std::vector<double>& constraint_multipliers) = 0;
+   [[nodiscard]] virtual double quadratic_product(const std::vector<double>& x, const std::vector<double>& y) const;
+   // solve a linear system whose top left block is the Hessian. The linear solver holds the factorization of "matrix"
+   virtual void solve_linear_system(SymmetricIndefiniteLinearSolver<double>& linear_solver, const SymmetricMatrix<double>& matrix,
+         const std::vector<double>& rhs, std::vector<double>& result);
 };
 
 // Exact Hessian
@@ -28,7 +34,7 @@ class ExactHessian : public HessianModel {
 public:
    explicit ExactHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options);
 
-   void evaluate(Statistics& statistics, const NonlinearProblem& problem, const std::vector<double>& primal_variables,
+   void evaluate(Statistics& statistics, const NonlinearProblem& problem, Iterate& iterate,
          const std::vector<double>& constraint_multipliers) override;
 };
 
@@ -37,22 +43,85 @@ class ConvexifiedHessian : public HessianModel {
 public:
    ConvexifiedHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options);
 
-   void evaluate(Statistics& statistics, const NonlinearProblem& problem, const std::vector<double>& primal_variables,
+   void evaluate(Statistics& statistics, const NonlinearProblem& problem, Iterate& iterate,
          const std::vector<double>& constraint_multipliers) override;
 
 protected:
    std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> linear_solver; /*!< Solver that computes the inertia */
    const double regularization_initial_value{};
    const double regularization_increase_factor{};
+   const size_t number_lanczos_iterations;
+   // the symbolic factorization is performed once per sparsity pattern
+   bool symbolic_factorization_available{false};
+   size_t sparsity_pattern_hash{0};
+   // preallocated Lanczos vectors
+   std::vector<double> lanczos_vector;
+   std::vector<double> previous_lanczos_vector;
+   std::vector<double> lanczos_product;
 
    void regularize(Statistics& statistics, SymmetricMatrix<double>& hessian, size_t number_original_variables);
+   [[nodiscard]] static double compute_gershgorin_lower_bound(const SymmetricMatrix<double>& hessian, size_t number_original_variables);
+   [[nodiscard]] double estimate_smallest_eigenvalue(const SymmetricMatrix<double>& hessian, size_t number_original_variables);
+   void factorize(const SymmetricMatrix<double>& hessian);
+};
+
+// limited-memory BFGS Hessian with damped updates
+// compact representation (Byrd, Nocedal and Schnabel, 1994): B = delta I - W M W^T with W = [delta S, Y]
+// - explicit representation: B is formed as a dense matrix (for QP solvers)
+// - compact representation: "hessian" contains delta I only. The low-rank term is handled by the Sherman-Morrison-Woodbury formula
+class LBFGSHessian : public HessianModel {
+public:
+   LBFGSHessian(size_t dimension, bool use_compact_representation, const Options& options);
+
+   void evaluate(Statistics& statistics, const NonlinearProblem& problem, Iterate& iterate,
+         const std::vector<double>& constraint_multipliers) override;
+   [[nodiscard]] double quadratic_product(const std::vector<double>& x, const std::vector<double>& y) const override;
+   void solve_linear_system(SymmetricIndefiniteLinearSolver<double>& linear_solver, const SymmetricMatrix<double>& matrix,
+         const std::vector<double>& rhs, std::vector<double>& result) override;
+
+protected:
+   const size_t memory_size;
+   const double damping_threshold;
+   const bool use_compact_representation;
+   size_t number_original_variables{0};
+   double scaling_factor{1.}; /*!< delta */
+   // curvature pairs, from oldest to newest
+   std::vector<std::vector<double>> S{};
+   std::vector<std::vector<double>> Y{};
+   // inverse of the middle matrix M (column-major)
+   std::vector<double> middle_matrix_inverse{};
+
+   // previous point
+   bool has_previous_point{false};
+   std::vector<double> previous_primals;
+   std::vector<double> previous_objective_gradient;
+   RectangularMatrix<double> previous_constraint_jacobian{};
+   LagrangianGradient<double> current_lagrangian_gradient;
+   LagrangianGradient<double> previous_lagrangian_gradient;
+
+   // preallocated vectors
+   std::vector<double> step;
+   std::vector<double> gradient_difference;
+   std::vector<double> hessian_step;
+
+   void evaluate_lagrangian_gradients(const NonlinearProblem& problem, Iterate& iterate, const std::vector<double>& constraint_multipliers);
+   void save_previous_constraint_jacobian(const RectangularMatrix<double>& constraint_jacobian, size_t number_constraints);
+   void update_curvature_pairs(const std::vector<double>& primal_variables, double objective_multiplier);
+   void compute_middle_matrix_inverse();
+   [[nodiscard]] size_t number_pairs() const;
+   [[nodiscard]] double W_entry(size_t i, size_t column) const;
+   void compute_hessian_vector_product(const std::vector<double>& x, std::vector<double>& result) const;
+   [[nodiscard]] double low_rank_quadratic_product(const std::vector<double>& x, const std::vector<double>& y) const;
+   void solve_with_middle_matrix_inverse(std::vector<double>& rhs, size_t number_rhs) const;
+   void form_explicit_hessian(size_t number_variables);
+   void form_compact_hessian(size_t number_variables);
 };
 
 // HessianModel factory
 class HessianModelFactory {
 public:
    static std::unique_ptr<HessianModel> create(const std::string& hessian_model, size_t dimension, size_t maximum_number_nonzeros,
-         bool convexify, const Options& options);
+         bool convexify, bool use_compact_representation, const Options& options);
 };
 
 #endif // UNO_HESSIANMODEL_H
@@ -48,7 +48,10 @@ public:
 
 protected:
    Direction direction;
-   Evaluations evaluations;
+   Evaluations evaluations; /*!< Storage of the evaluations that the reformulation modifies */
+   // views on the derivatives at the current iterate: the evaluations of the iterate or the storage above
+   const SparseVector<double>* objective_gradient{&this->evaluations.objective_gradient};
+   const RectangularMatrix<double>* constraint_jacobian{&this->evaluations.constraint_jacobian};
    double trust_region_radius{INF<double>};
 };
 
@@ -1,9 +1,9 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
-#include <linear_algebra/COOSymmetricMatrix.hpp>
 #include "LPSubproblem.hpp"
 #include "solvers/LP/LPSolverFactory.hpp"
+#include "tools/Profiler.hpp"
 
 LPSubproblem::LPSubproblem(size_t max_number_variables, size_t max_number_constraints, const Options& options) :
       InequalityConstrainedMethod(max_number_variables, max_number_constraints),
@@ -13,12 +13,13 @@ LPSubproblem::LPSubproblem(size_t max_number_variables, size_t max_number_constr
 void LPSubproblem::evaluate_functions(const NonlinearProblem& problem, Iterate& current_iterate, const WarmstartInformation& warmstart_information) {
    // objective gradient
    if (warmstart_information.objective_changed) {
-      problem.evaluate_objective_gradient(current_iterate, this->evaluations.objective_gradient);
+      this->objective_gradient = &problem.evaluate_objective_gradient(current_iterate, this->evaluations.objective_gradient);
    }
    // constraints and constraint Jacobian
    if (warmstart_information.constraints_changed) {
       problem.evaluate_constraints(current_iterate, this->evaluations.constraints);
-      problem.evaluate_constraint_jacobian(current_iterate, this->evaluations.constraint_jacobian);
+      // the elastic columns (if any) are materialized for the solver
+      this->constraint_jacobian = &problem.evaluate_constraint_jacobian(current_iterate, this->evaluations.constraint_jacobian);
    }
 }
 
@@ -38,8 +39,9 @@ Direction LPSubproblem::solve(Statistics& /*statistics*/, const NonlinearProblem
    }
 
    // solve the LP
+   PROFILE_SCOPE("LP solve");
    Direction direction = this->solver->solve_LP(problem.number_variables, problem.number_constraints, this->direction_bounds,
-         this->linearized_constraint_bounds, this->evaluations.objective_gradient, this->evaluations.constraint_jacobian,
+         this->linearized_constraint_bounds, *this->objective_gradient, *this->constraint_jacobian,
          this->initial_point, warmstart_information);
    InequalityConstrainedMethod::compute_dual_displacements(problem, current_iterate, direction);
    this->number_subproblems_solved++;
@@ -50,8 +52,7 @@ Direction LPSubproblem::solve(Statistics& /*statistics*/, const NonlinearProblem
 
 std::function<double(double)> LPSubproblem::compute_predicted_optimality_reduction_model(const NonlinearProblem& problem,
       const Iterate& current_iterate, const Direction& direction, double step_length) const {
-   return problem.compute_predicted_optimality_reduction_model(current_iterate, direction, step_length,
-         COOSymmetricMatrix<double>::zero(direction.number_variables));
+   return problem.compute_predicted_optimality_reduction_model(current_iterate, direction, step_length, 0.);
 }
 
 size_t LPSubproblem::get_hessian_evaluation_count() const {
@@ -3,6 +3,7 @@
 
 #include "QPSubproblem.hpp"
 #include "solvers/QP/QPSolverFactory.hpp"
+#include "tools/Profiler.hpp"
 
 QPSubproblem::QPSubproblem(Statistics& statistics, size_t max_number_variables, size_t max_number_constraints, size_t max_number_hessian_nonzeros,
          const Options& options) :
@@ -10,28 +11,33 @@ QPSubproblem::QPSubproblem(Statistics& statistics, size_t max_number_variables,
       use_regularization(options.get_string("globalization_mechanism") != "TR" || options.get_bool("convexify_QP")),
       // if no trust region is used, the problem should be convexified to guarantee boundedness
       hessian_model(HessianModelFactory::create(options.get_string("hessian_model"), max_number_variables,
-            max_number_hessian_nonzeros + max_number_variables, this->use_regularization, options)),
+            max_number_hessian_nonzeros + max_number_variables, this->use_regularization, /* use_compact_representation = */false, options)),
       // maximum number of Hessian nonzeros = number nonzeros + possible diagonal inertia correction
       solver(QPSolverFactory::create(options.get_string("QP_solver"), max_number_variables, max_number_constraints,
-            hessian_model->hessian->capacity, true, options)) {
+            hessian_model->hessian->capacity, true, options)),
+      exact_hessian(options.get_string("hessian_model") == "exact") {
    if (this->use_regularization) {
-      statistics.add_column("regularization", Statistics::double_width, options.get_int("statistics_regularization_column_order"));
+      statistics.add_column("regularization", ColumnType::DOUBLE, options.get_int("statistics_regularization_column_order"));
    }
 }
 
 void QPSubproblem::evaluate_functions(Statistics& statistics, const NonlinearProblem& problem, Iterate& current_iterate,
       const WarmstartInformation& warmstart_information) {
    // Lagrangian Hessian
-   if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-      this->hessian_model->evaluate(statistics, problem, current_iterate.primals, current_iterate.multipliers.constraints);
+   this->hessian_changed = false;
+   if ((warmstart_information.objective_changed || warmstart_information.constraints_changed) && not this->is_hessian_unchanged(problem)) {
+      this->hessian_model->evaluate(statistics, problem, current_iterate, current_iterate.multipliers.constraints);
+      this->hessian_objective_multiplier = problem.get_objective_multiplier();
+      this->hessian_changed = true;
    }
    // objective gradient, constraints and constraint Jacobian
    if (warmstart_information.objective_changed) {
-      problem.evaluate_objective_gradient(current_iterate, this->evaluations.objective_gradient);
+      this->objective_gradient = &problem.evaluate_objective_gradient(current_iterate, this->evaluations.objective_gradient);
    }
    if (warmstart_information.constraints_changed) {
       problem.evaluate_constraints(current_iterate, this->evaluations.constraints);
-      problem.evaluate_constraint_jacobian(current_iterate, this->evaluations.constraint_jacobian);
+      // the elastic columns (if any) are materialized for the solver
+      this->constraint_jacobian = &problem.evaluate_constraint_jacobian(current_iterate, this->evaluations.constraint_jacobian);
    }
 }
 
@@ -50,10 +56,13 @@ Direction QPSubproblem::solve(Statistics& statistics, const NonlinearProblem& pr
       this->set_linearized_constraint_bounds(problem, this->evaluations.constraints);
    }
 
-   // solve the QP
+   // solve the QP. The solver keeps its copy of the Hessian if the latter was not reevaluated
+   PROFILE_SCOPE("QP solve");
+   WarmstartInformation solver_warmstart_information = warmstart_information;
+   solver_warmstart_information.hessian_changed = warmstart_information.hessian_changed && this->hessian_changed;
    Direction direction = this->solver->solve_QP(problem.number_variables, problem.number_constraints, this->direction_bounds,
-         this->linearized_constraint_bounds, this->evaluations.objective_gradient, this->evaluations.constraint_jacobian,
-         *this->hessian_model->hessian, this->initial_point, warmstart_information);
+         this->linearized_constraint_bounds, *this->objective_gradient, *this->constraint_jacobian,
+         *this->hessian_model->hessian, this->initial_point, solver_warmstart_information);
    
    // Analysis not over yet ......
    DEBUG << "OUTSIDE: direction multipliers ub: \n";
@@ -79,9 +88,16 @@ Direction QPSubproblem::solve(Statistics& statistics, const NonlinearProblem& pr
 
 std::function<double(double)> QPSubproblem::compute_predicted_optimality_reduction_model(const NonlinearProblem& problem,
       const Iterate& current_iterate, const Direction& direction, double step_length) const {
-   return problem.compute_predicted_optimality_reduction_model(current_iterate, direction, step_length, *this->hessian_model->hessian);
+   const double quadratic_product = this->hessian_model->quadratic_product(direction.primals, direction.primals);
+   return problem.compute_predicted_optimality_reduction_model(current_iterate, direction, step_length, quadratic_product);
 }
 
 size_t QPSubproblem::get_hessian_evaluation_count() const {
    return this->hessian_model->evaluation_count;
-}
\ No newline at end of file
+}
+
+// the Hessian of a quadratic program is constant for a given objective multiplier (the elastic variables do not contribute)
+bool QPSubproblem::is_hessian_unchanged(const NonlinearProblem& problem) const {
+   return this->exact_hessian && problem.model.is_quadratic_program() && this->hessian_objective_multiplier.has_value() &&
+         *this->hessian_objective_multiplier == problem.get_objective_multiplier() && this->hessian_model->hessian->dimension == problem.number_variables;
+}
@@ -4,6 +4,7 @@
 #ifndef UNO_QPSUBPROBLEM_H
 #define UNO_QPSUBPROBLEM_H
 
+#include <optional>
 #include "InequalityConstrainedMethod.hpp"
 #include "ingredients/subproblem/HessianModel.hpp"
 #include "solvers/QP/QPSolver.hpp"
@@ -25,6 +26,12 @@ protected:
    // pointers to allow polymorphism
    const std::unique_ptr<HessianModel> hessian_model; /*!< Strategy to evaluate or approximate the Hessian */
    const std::unique_ptr<QPSolver> solver; /*!< Solver that solves the subproblem */
+   // the exact Hessian of a quadratic program only depends on the objective multiplier
+   const bool exact_hessian;
+   std::optional<double> hessian_objective_multiplier{};
+   bool hessian_changed{true};
+
+   [[nodiscard]] bool is_hessian_unchanged(const NonlinearProblem& problem) const;
 
    void evaluate_functions(Statistics& statistics, const NonlinearProblem& problem, Iterate& current_iterate,
          const WarmstartInformation& warmstart_information);
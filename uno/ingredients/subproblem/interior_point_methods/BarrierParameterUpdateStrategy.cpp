@@ -59,7 +59,7 @@ bool BarrierParameterUpdateStrategy::update_barrier_parameter(const NonlinearPro
 
 double BarrierParameterUpdateStrategy::compute_shifted_complementarity_error(const NonlinearProblem& problem, const Iterate& iterate,
       double shift_value) {
-   VectorExpression<double> shifted_bound_complementarity(problem.number_variables, [&](size_t i) {
+   const VectorExpression shifted_bound_complementarity(problem.number_variables, [&](size_t i) {
       double result = 0.;
       if (0. < iterate.multipliers.lower_bounds[i]) { // lower bound
          result = std::max(result, std::abs(iterate.multipliers.lower_bounds[i] * (iterate.primals[i] - problem.get_variable_lower_bound(i)) - shift_value));
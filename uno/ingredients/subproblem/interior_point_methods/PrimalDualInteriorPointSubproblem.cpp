@@ -7,6 +7,7 @@
 #include "linear_algebra/SymmetricMatrixFactory.hpp"
 #include "preprocessing/Preprocessing.hpp"
 #include "tools/Infinity.hpp"
+#include "tools/Profiler.hpp"
 
 PrimalDualInteriorPointSubproblem::PrimalDualInteriorPointSubproblem(Statistics& statistics, size_t max_number_variables, size_t max_number_constraints,
          size_t max_number_jacobian_nonzeros, size_t max_number_hessian_nonzeros, const Options& options):
@@ -14,16 +15,19 @@ PrimalDualInteriorPointSubproblem::PrimalDualInteriorPointSubproblem(Statistics&
       augmented_system(options.get_string("sparse_format"), max_number_variables + max_number_constraints,
             max_number_hessian_nonzeros
             + max_number_variables /* diagonal barrier terms for bound constraints */
-            + max_number_jacobian_nonzeros /* Jacobian */,
+            + max_number_jacobian_nonzeros /* Jacobian */
+            + max_number_constraints /* elastic terms in the dual block */,
             true, /* use regularization */
             options),
       // the Hessian is not convexified. Instead, the augmented system will be.
-      hessian_model(HessianModelFactory::create(options.get_string("hessian_model"), max_number_variables, max_number_hessian_nonzeros, false, options)),
-      linear_solver(SymmetricIndefiniteLinearSolverFactory::create(options.get_string("linear_solver"), max_number_variables + max_number_constraints,
+      // quasi-Newton models are kept in compact form to preserve the sparsity of the augmented system
+      hessian_model(HessianModelFactory::create(options.get_string("hessian_model"), max_number_variables, max_number_hessian_nonzeros, false,
+            /* use_compact_representation = */true, options)),
+      linear_solver(SymmetricIndefiniteLinearSolverFactory::create(max_number_variables + max_number_constraints,
             max_number_hessian_nonzeros
             + max_number_variables + max_number_constraints /* regularization */
             + 2 * max_number_variables /* diagonal barrier terms */
-            + max_number_jacobian_nonzeros /* Jacobian */)),
+            + max_number_jacobian_nonzeros /* Jacobian */, options)),
       barrier_parameter_update_strategy(options),
       previous_barrier_parameter(options.get_double("barrier_initial_parameter")),
       default_multiplier(options.get_double("barrier_default_multiplier")),
@@ -37,9 +41,11 @@ PrimalDualInteriorPointSubproblem::PrimalDualInteriorPointSubproblem(Statistics&
       }),
       least_square_multiplier_max_norm(options.get_double("least_square_multiplier_max_norm")),
       damping_factor(options.get_double("barrier_damping_factor")),
-      lower_delta_z(max_number_variables), upper_delta_z(max_number_variables) {
-   statistics.add_column("regularization", Statistics::double_width, options.get_int("statistics_regularization_column_order"));
-   statistics.add_column("barrier param.", Statistics::double_width, options.get_int("statistics_barrier_parameter_column_order"));
+      barrier_gradient(max_number_variables), lower_delta_z(max_number_variables), upper_delta_z(max_number_variables),
+      elastic_diagonal(max_number_variables), dual_diagonal(max_number_constraints),
+      condensed_rhs(max_number_variables + max_number_constraints), condensed_solution(max_number_variables + max_number_constraints) {
+   statistics.add_column("regularization", ColumnType::DOUBLE, options.get_int("statistics_regularization_column_order"));
+   statistics.add_column("barrier param.", ColumnType::DOUBLE, options.get_int("statistics_barrier_parameter_column_order"));
 }
 
 inline void PrimalDualInteriorPointSubproblem::generate_initial_iterate(const NonlinearProblem& problem, Iterate& initial_iterate) {
@@ -102,7 +108,7 @@ void PrimalDualInteriorPointSubproblem::evaluate_functions(Statistics& statistic
    // barrier Lagrangian Hessian
    if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
       // original Lagrangian Hessian
-      this->hessian_model->evaluate(statistics, problem, current_iterate.primals, current_iterate.multipliers.constraints);
+      this->hessian_model->evaluate(statistics, problem, current_iterate, current_iterate.multipliers.constraints);
 
       // diagonal barrier terms (grouped by variable)
       for (size_t i: Range(problem.number_variables)) {
@@ -119,11 +125,10 @@ void PrimalDualInteriorPointSubproblem::evaluate_functions(Statistics& statistic
 
    // barrier objective gradient
    if (warmstart_information.objective_changed) {
-      // original objective gradient
-      problem.evaluate_objective_gradient(current_iterate, this->evaluations.objective_gradient);
+      // original objective gradient (a view, not modified)
+      this->objective_gradient = &problem.evaluate_objective_gradient(current_iterate, this->evaluations.objective_gradient);
 
-      // barrier terms
-      // TODO: the allocated size for objective_gradient is probably too small
+      // barrier terms (stored separately)
       for (size_t i: Range(problem.number_variables)) {
          double barrier_term = 0.;
          if (is_finite(problem.get_variable_lower_bound(i))) { // lower bounded
@@ -140,14 +145,15 @@ void PrimalDualInteriorPointSubproblem::evaluate_functions(Statistics& statistic
                barrier_term -= this->damping_factor * this->barrier_parameter();
             }
          }
-         this->evaluations.objective_gradient.insert(i, barrier_term);
+         this->barrier_gradient[i] = barrier_term;
       }
    }
 
    // constraints and Jacobian
    if (warmstart_information.constraints_changed) {
       problem.evaluate_constraints(current_iterate, this->evaluations.constraints);
-      problem.evaluate_constraint_jacobian(current_iterate, this->evaluations.constraint_jacobian);
+      // the elastic variables (if any) are handled implicitly: their unit columns are not stored
+      this->constraint_jacobian = &problem.evaluate_original_constraint_jacobian(current_iterate);
    }
 }
 
@@ -165,14 +171,24 @@ Direction PrimalDualInteriorPointSubproblem::solve(Statistics& statistics, const
       this->update_barrier_parameter(problem, current_iterate);
    }
 
+   TRACE_COUNTER("barrier parameter", this->barrier_parameter());
+
    // evaluate the functions at the current iterate
    this->evaluate_functions(statistics, problem, current_iterate, warmstart_information);
 
    // set up the augmented system (with the correct inertia)
    this->assemble_augmented_system(statistics, problem, current_iterate);
 
-   // compute the primal-dual solution
-   this->augmented_system.solve(*this->linear_solver);
+   // compute the primal-dual solution (the Hessian model may apply a low-rank correction)
+   if (problem.elastic_variables.size() == 0) {
+      this->hessian_model->solve_linear_system(*this->linear_solver, *this->augmented_system.matrix, this->augmented_system.rhs,
+            this->augmented_system.solution);
+   }
+   else {
+      this->hessian_model->solve_linear_system(*this->linear_solver, *this->augmented_system.matrix, this->condensed_rhs,
+            this->condensed_solution);
+      this->recover_elastic_variables(problem);
+   }
    assert(this->direction.status == SubproblemStatus::OPTIMAL && "The primal-dual perturbed subproblem was not solved to optimality");
    this->number_subproblems_solved++;
    this->assemble_primal_dual_direction(problem, current_iterate);
@@ -188,18 +204,48 @@ Direction PrimalDualInteriorPointSubproblem::solve(Statistics& statistics, const
 
 void PrimalDualInteriorPointSubproblem::assemble_augmented_system(Statistics& statistics, const NonlinearProblem& problem,
       const Iterate& current_iterate) {
+   // the elastic variables (if any) are eliminated: the augmented matrix has a primal block of the remaining variables
+   const size_t number_primal_variables = problem.number_variables - problem.elastic_variables.size();
+
    // assemble, factorize and regularize the augmented matrix
-   this->augmented_system.assemble_matrix(*this->hessian_model->hessian, this->evaluations.constraint_jacobian,
-         problem.number_variables, problem.number_constraints);
+   {
+      PROFILE_SCOPE("augmented system assembly");
+      if (problem.elastic_variables.size() == 0) {
+         this->augmented_system.assemble_matrix(*this->hessian_model->hessian, *this->constraint_jacobian,
+               problem.number_variables, problem.number_constraints);
+      }
+      else {
+         // the elastic variables have a positive diagonal Hessian (barrier terms) and a unit Jacobian column:
+         // their elimination adds -1/diagonal to the diagonal of the dual block
+         initialize_vector(this->elastic_diagonal, 0.);
+         this->hessian_model->hessian->for_each([&](size_t i, size_t j, double entry) {
+            if (number_primal_variables <= i && i == j) {
+               this->elastic_diagonal[i] += entry;
+            }
+         });
+         initialize_vector(this->dual_diagonal, 0.);
+         const auto add_elastic_term = [&](size_t j, size_t elastic_index) {
+            assert(0. < this->elastic_diagonal[elastic_index] && "The diagonal term of the elastic variable is not positive");
+            this->dual_diagonal[j] -= 1. / this->elastic_diagonal[elastic_index];
+         };
+         problem.elastic_variables.positive.for_each(add_elastic_term);
+         problem.elastic_variables.negative.for_each(add_elastic_term);
+         this->augmented_system.assemble_condensed_matrix(*this->hessian_model->hessian, *this->constraint_jacobian,
+               number_primal_variables, problem.number_constraints, this->dual_diagonal);
+      }
+   }
    this->augmented_system.factorize_matrix(problem.model, *this->linear_solver);
    const double dual_regularization_parameter = std::pow(this->barrier_parameter(), this->parameters.regularization_exponent);
-   this->augmented_system.regularize_matrix(statistics, problem.model, *this->linear_solver, problem.number_variables, problem.number_constraints,
+   this->augmented_system.regularize_matrix(statistics, problem.model, *this->linear_solver, number_primal_variables, problem.number_constraints,
          dual_regularization_parameter);
    [[maybe_unused]] auto[number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = this->linear_solver->get_inertia();
-   assert(number_pos_eigenvalues == problem.number_variables && number_neg_eigenvalues == problem.number_constraints && number_zero_eigenvalues == 0);
+   assert(number_pos_eigenvalues == number_primal_variables && number_neg_eigenvalues == problem.number_constraints && number_zero_eigenvalues == 0);
 
    // assemble the right-hand side
    this->generate_augmented_rhs(problem, current_iterate);
+   if (problem.elastic_variables.size() > 0) {
+      this->condense_elastic_variables(problem);
+   }
 }
 
 void PrimalDualInteriorPointSubproblem::initialize_feasibility_problem() {
@@ -245,7 +291,9 @@ void PrimalDualInteriorPointSubproblem::exit_feasibility_problem(const Nonlinear
 
 std::function<double(double)> PrimalDualInteriorPointSubproblem::compute_predicted_optimality_reduction_model(const NonlinearProblem& problem,
       const Iterate& current_iterate, const Direction& direction, double step_length) const {
-   return problem.compute_predicted_optimality_reduction_model(current_iterate, direction, step_length, *this->hessian_model->hessian);
+   // the quadratic product of the Hessian model includes the low-rank term of a compact quasi-Newton representation
+   const double quadratic_product = this->hessian_model->quadratic_product(direction.primals, direction.primals);
+   return problem.compute_predicted_optimality_reduction_model(current_iterate, direction, step_length, quadratic_product);
 }
 
 void PrimalDualInteriorPointSubproblem::set_auxiliary_measure(const NonlinearProblem& problem, Iterate& iterate) {
@@ -305,7 +353,7 @@ void PrimalDualInteriorPointSubproblem::update_barrier_parameter(const Nonlinear
 
 // Section 3.9 in IPOPT paper
 bool PrimalDualInteriorPointSubproblem::is_small_step(const NonlinearProblem& problem, const Iterate& current_iterate, const Direction& direction) const {
-   VectorExpression<double> relative_direction_size(problem.number_variables, [&](size_t i) {
+   const VectorExpression relative_direction_size(problem.number_variables, [&](size_t i) {
       return direction.primals[i] / (1 + std::abs(current_iterate.primals[i]));
    });
    static double machine_epsilon = std::numeric_limits<double>::epsilon();
@@ -313,8 +361,11 @@ bool PrimalDualInteriorPointSubproblem::is_small_step(const NonlinearProblem& pr
 }
 
 double PrimalDualInteriorPointSubproblem::evaluate_subproblem_objective() const {
-   const double linear_term = dot(this->direction.primals, this->evaluations.objective_gradient);
-   const double quadratic_term = this->hessian_model->hessian->quadratic_product(this->direction.primals, this->direction.primals) / 2.;
+   double linear_term = dot(this->direction.primals, *this->objective_gradient);
+   for (size_t i: Range(this->direction.number_variables)) {
+      linear_term += this->barrier_gradient[i] * this->direction.primals[i];
+   }
+   const double quadratic_term = this->hessian_model->quadratic_product(this->direction.primals, this->direction.primals) / 2.;
    return linear_term + quadratic_term;
 }
 
@@ -367,24 +418,77 @@ void PrimalDualInteriorPointSubproblem::generate_augmented_rhs(const NonlinearPr
    initialize_vector(this->augmented_system.rhs, 0.);
 
    // objective gradient
-   this->evaluations.objective_gradient.for_each([&](size_t i, double derivative) {
+   this->objective_gradient->for_each([&](size_t i, double derivative) {
       this->augmented_system.rhs[i] -= derivative;
    });
+   for (size_t i: Range(problem.number_variables)) {
+      this->augmented_system.rhs[i] -= this->barrier_gradient[i];
+   }
 
    // constraint: evaluations and gradients
    for (size_t j: Range(problem.number_constraints)) {
       // Lagrangian
       if (current_iterate.multipliers.constraints[j] != 0.) {
-         this->evaluations.constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+         (*this->constraint_jacobian)[j].for_each([&](size_t i, double derivative) {
             this->augmented_system.rhs[i] += current_iterate.multipliers.constraints[j] * derivative;
          });
       }
       // constraints
       this->augmented_system.rhs[problem.number_variables + j] = -this->evaluations.constraints[j];
    }
+   // unit columns of the elastic variables
+   problem.elastic_variables.positive.for_each([&](size_t j, size_t elastic_index) {
+      this->augmented_system.rhs[elastic_index] -= current_iterate.multipliers.constraints[j];
+   });
+   problem.elastic_variables.negative.for_each([&](size_t j, size_t elastic_index) {
+      this->augmented_system.rhs[elastic_index] += current_iterate.multipliers.constraints[j];
+   });
    DEBUG2 << "RHS: "; print_vector(DEBUG2, this->augmented_system.rhs, 0, problem.number_variables + problem.number_constraints); DEBUG << '\n';
 }
 
+// eliminate the elastic variables from the right-hand side. The row of an elastic variable e with coefficient a in constraint j is
+// d_e Δe + a Δy_j = r_e, hence Δe = (r_e - a Δy_j)/d_e, and the row of constraint j becomes ... - Δy_j/d_e = r_j - a r_e/d_e
+void PrimalDualInteriorPointSubproblem::condense_elastic_variables(const NonlinearProblem& problem) {
+   const size_t number_primal_variables = problem.number_variables - problem.elastic_variables.size();
+   for (size_t i: Range(number_primal_variables)) {
+      this->condensed_rhs[i] = this->augmented_system.rhs[i];
+   }
+   for (size_t j: Range(problem.number_constraints)) {
+      this->condensed_rhs[number_primal_variables + j] = this->augmented_system.rhs[problem.number_variables + j];
+   }
+   const auto condense = [&](size_t j, size_t elastic_index, double jacobian_coefficient) {
+      this->condensed_rhs[number_primal_variables + j] -= jacobian_coefficient * this->augmented_system.rhs[elastic_index] /
+            this->elastic_diagonal[elastic_index];
+   };
+   problem.elastic_variables.positive.for_each([&](size_t j, size_t elastic_index) {
+      condense(j, elastic_index, -1.);
+   });
+   problem.elastic_variables.negative.for_each([&](size_t j, size_t elastic_index) {
+      condense(j, elastic_index, 1.);
+   });
+}
+
+// expand the solution of the condensed system into the solution of the augmented system
+void PrimalDualInteriorPointSubproblem::recover_elastic_variables(const NonlinearProblem& problem) {
+   const size_t number_primal_variables = problem.number_variables - problem.elastic_variables.size();
+   for (size_t i: Range(number_primal_variables)) {
+      this->augmented_system.solution[i] = this->condensed_solution[i];
+   }
+   for (size_t j: Range(problem.number_constraints)) {
+      this->augmented_system.solution[problem.number_variables + j] = this->condensed_solution[number_primal_variables + j];
+   }
+   const auto recover = [&](size_t j, size_t elastic_index, double jacobian_coefficient) {
+      this->augmented_system.solution[elastic_index] = (this->augmented_system.rhs[elastic_index] -
+            jacobian_coefficient * this->augmented_system.solution[problem.number_variables + j]) / this->elastic_diagonal[elastic_index];
+   };
+   problem.elastic_variables.positive.for_each([&](size_t j, size_t elastic_index) {
+      recover(j, elastic_index, -1.);
+   });
+   problem.elastic_variables.negative.for_each([&](size_t j, size_t elastic_index) {
+      recover(j, elastic_index, 1.);
+   });
+}
+
 void PrimalDualInteriorPointSubproblem::assemble_primal_dual_direction(const NonlinearProblem& problem, const Iterate& current_iterate) {
    this->direction.set_dimensions(problem.number_variables, problem.number_constraints);
 
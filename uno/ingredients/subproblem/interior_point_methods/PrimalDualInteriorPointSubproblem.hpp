@@ -57,10 +57,18 @@ protected:
    const double least_square_multiplier_max_norm;
    const double damping_factor; // (Section 3.7 in IPOPT paper)
 
+   // gradient of the barrier terms (the objective gradient of the problem is a view)
+   std::vector<double> barrier_gradient{};
    // preallocated vectors for bound multiplier displacements
    std::vector<double> lower_delta_z{};
    std::vector<double> upper_delta_z{};
 
+   // the elastic variables (if any) are eliminated from the augmented system
+   std::vector<double> elastic_diagonal{}; // diagonal Hessian terms of the elastic variables
+   std::vector<double> dual_diagonal{}; // contribution of the elastic variables to the dual block
+   std::vector<double> condensed_rhs{};
+   std::vector<double> condensed_solution{};
+
    bool solving_feasibility_problem{false};
 
    [[nodiscard]] double barrier_parameter() const;
@@ -76,6 +84,8 @@ protected:
    [[nodiscard]] double dual_fraction_to_boundary(const NonlinearProblem& problem, const Iterate& current_iterate, double tau);
    void assemble_augmented_system(Statistics& statistics, const NonlinearProblem& problem, const Iterate& current_iterate);
    void generate_augmented_rhs(const NonlinearProblem& problem, const Iterate& current_iterate);
+   void condense_elastic_variables(const NonlinearProblem& problem);
+   void recover_elastic_variables(const NonlinearProblem& problem);
    void assemble_primal_dual_direction(const NonlinearProblem& problem, const Iterate& current_iterate);
    void compute_bound_dual_direction(const NonlinearProblem& problem, const Iterate& current_iterate);
    void compute_least_square_multipliers(const NonlinearProblem& problem, Iterate& iterate);
@@ -28,8 +28,14 @@ ASL* generate_asl(std::string file_name) {
    return asl;
 }
 
+std::mutex AMPLModel::asl_mutex;
+
+// the lock is held until the construction is complete
+AMPLModel::AMPLModel(const std::string& file_name) : AMPLModel(file_name, std::unique_lock<std::mutex>(AMPLModel::asl_mutex)) {
+}
+
 // generate the ASL object and call the private constructor
-AMPLModel::AMPLModel(const std::string& file_name) : AMPLModel(file_name, generate_asl(file_name)) {
+AMPLModel::AMPLModel(const std::string& file_name, std::unique_lock<std::mutex> /*lock*/) : AMPLModel(file_name, generate_asl(file_name)) {
 }
 
 AMPLModel::AMPLModel(const std::string& file_name, ASL* asl) :
@@ -63,10 +69,12 @@ AMPLModel::AMPLModel(const std::string& file_name, ASL* asl) :
    // compute number of nonzeros
    this->number_objective_gradient_nonzeros = static_cast<size_t>(this->asl->i.nzo_);
    this->number_jacobian_nonzeros = static_cast<size_t>(this->asl->i.nzc_);
+   this->generate_jacobian_map();
    this->set_number_hessian_nonzeros();
 }
 
 AMPLModel::~AMPLModel() {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
    ASL_free(&this->asl);
 }
 
@@ -99,6 +107,7 @@ void AMPLModel::generate_variables() {
 }
 
 double AMPLModel::evaluate_objective(const std::vector<double>& x) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
    int error_flag = 0;
    double result = this->objective_sign * (*(this->asl)->p.Objval)(this->asl, 0, const_cast<double*>(x.data()), &error_flag);
    if (0 < error_flag) {
@@ -109,6 +118,7 @@ double AMPLModel::evaluate_objective(const std::vector<double>& x) const {
 
 // sparse gradient
 void AMPLModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
    int error_flag = 0;
    // prevent ASL to crash by catching all evaluation errors
    Jmp_buf err_jmp_uno;
@@ -134,18 +144,8 @@ void AMPLModel::evaluate_objective_gradient(const std::vector<double>& x, Sparse
    }
 }
 
-/*
-double AMPLModel::evaluate_constraint(int j, const std::vector<double>& x) const {
-   int error_flag = 0;
-   double result = (*(this->asl)->p.Conival)(this->asl_, j, const_cast<double*>(x.data()), &error_flag);
-   if (0 < error_flag) {
-      throw FunctionNumericalError();
-   }
-   return result;
-}
-*/
-
 void AMPLModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
    int error_flag = 0;
    (*(this->asl)->p.Conval)(this->asl, const_cast<double*>(x.data()), constraints.data(), &error_flag);
    if (0 < error_flag) {
@@ -153,8 +153,21 @@ void AMPLModel::evaluate_constraints(const std::vector<double>& x, std::vector<d
    }
 }
 
+void AMPLModel::evaluate_constraint_subset(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+      std::vector<double>& constraints) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
+   for (size_t j: constraint_indices) {
+      int error_flag = 0;
+      constraints[j] = (*(this->asl)->p.Conival)(this->asl, static_cast<int>(j), const_cast<double*>(x.data()), &error_flag);
+      if (0 < error_flag) {
+         throw FunctionEvaluationError();
+      }
+   }
+}
+
 // sparse gradient
 void AMPLModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
    const int congrd_mode_backup = this->asl->i.congrd_mode;
    this->asl->i.congrd_mode = 1; // sparse computation
 
@@ -178,10 +191,39 @@ void AMPLModel::evaluate_constraint_gradient(const std::vector<double>& x, size_
    this->asl->i.congrd_mode = congrd_mode_backup;
 }
 
+void AMPLModel::generate_jacobian_map() {
+   // the partial derivatives of constraint j are stored by jacval at the positions goff of the list Cgrad_[j]
+   this->ampl_tmp_jacobian.resize(this->number_jacobian_nonzeros);
+   this->jacobian_row_pointers.reserve(this->number_constraints + 1);
+   this->jacobian_column_indices.reserve(this->number_jacobian_nonzeros);
+   this->jacobian_ampl_positions.reserve(this->number_jacobian_nonzeros);
+   this->jacobian_row_pointers.push_back(0);
+   for (size_t j: Range(this->number_constraints)) {
+      cgrad* ampl_variables_tmp = this->asl->i.Cgrad_[j];
+      while (ampl_variables_tmp != nullptr) {
+         this->jacobian_column_indices.push_back(static_cast<size_t>(ampl_variables_tmp->varno));
+         this->jacobian_ampl_positions.push_back(static_cast<size_t>(ampl_variables_tmp->goff));
+         ampl_variables_tmp = ampl_variables_tmp->next;
+      }
+      this->jacobian_row_pointers.push_back(this->jacobian_column_indices.size());
+   }
+}
+
 void AMPLModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
+   // evaluate the whole Jacobian in a single pass
+   int error_flag = 0;
+   (*(this->asl)->p.Jacval)(this->asl, const_cast<double*>(x.data()), this->ampl_tmp_jacobian.data(), &error_flag);
+   if (0 < error_flag) {
+      throw GradientEvaluationError();
+   }
+
+   // scatter the flat Jacobian into the rows
    for (size_t j: Range(this->number_constraints)) {
       constraint_jacobian[j].clear();
-      this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+      for (size_t k: Range(this->jacobian_row_pointers[j], this->jacobian_row_pointers[j + 1])) {
+         constraint_jacobian[j].insert(this->jacobian_column_indices[k], this->ampl_tmp_jacobian[this->jacobian_ampl_positions[k]]);
+      }
    }
 }
 
@@ -228,6 +270,7 @@ size_t AMPLModel::compute_hessian_number_nonzeros(double objective_multiplier, c
 
 void AMPLModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
       SymmetricMatrix<double>& hessian) const {
+   const std::lock_guard<std::mutex> lock(AMPLModel::asl_mutex);
    // register the vector of variables
    (*(this->asl)->p.Xknown)(this->asl, const_cast<double*>(x.data()), nullptr);
 
@@ -320,6 +363,12 @@ const std::vector<size_t>& AMPLModel::get_linear_constraints() const {
    return this->linear_constraints;
 }
 
+// the ASL only reports the linearity of the functions (nlo: number of nonlinear objectives, nlc: number of nonlinear
+// constraints): linear programs are detected, quadratic objectives are not
+bool AMPLModel::is_quadratic_program() const {
+   return this->asl->i.nlo_ == 0 && this->asl->i.nlc_ == 0;
+}
+
 void AMPLModel::generate_constraints() {
    for (size_t j: Range(this->number_constraints)) {
       double lb = (this->asl->i.LUrhs_ != nullptr) ? this->asl->i.LUrhs_[2 * j] : -INF<double>;
@@ -4,6 +4,7 @@
 #ifndef UNO_AMPLMODEL_H
 #define UNO_AMPLMODEL_H
 
+#include <mutex>
 #include <vector>
 #include "optimization/Model.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
@@ -17,7 +18,8 @@ extern "C" {
 /*! \class AMPLModel
  * \brief AMPL model
  *
- *  Description of an AMPL model
+ *  Description of an AMPL model. The ASL is not reentrant, even across instances: the reading of the models and all
+ *  the evaluations are serialized by a process-wide mutex. Concurrent solves should use the native .nl reader (NLModel).
  */
 class AMPLModel: public Model {
 public:
@@ -31,6 +33,8 @@ public:
    void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
    void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
    void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_constraint_subset(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+         std::vector<double>& constraints) const override;
    // Hessian
    void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
          SymmetricMatrix<double>& hessian) const override;
@@ -52,15 +56,26 @@ public:
    void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
 
    [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
 
 private:
-   // private constructor to pass the dimensions to the Model base constructor
+   // private constructors: the ASL is read under the lock, then the dimensions are passed to the Model base constructor
+   AMPLModel(const std::string& file_name, std::unique_lock<std::mutex> lock);
    AMPLModel(const std::string& file_name, ASL* asl);
 
+   // guards all the calls to the ASL
+   static std::mutex asl_mutex;
+
    // mutable: can be modified by const methods (internal state not seen by user)
    mutable ASL* asl; /*!< Instance of the AMPL Solver Library class */
    mutable std::vector<double> ampl_tmp_gradient{};
    mutable std::vector<double> ampl_tmp_hessian{};
+   mutable std::vector<double> ampl_tmp_jacobian{};
+
+   // fixed map from the flat Jacobian of jacval (column-wise goff layout) to the rows of Uno's Jacobian (CSR format)
+   std::vector<size_t> jacobian_row_pointers{};
+   std::vector<size_t> jacobian_column_indices{};
+   std::vector<size_t> jacobian_ampl_positions{};
 
    std::vector<Interval> variables_bounds;
    std::vector<Interval> constraint_bounds;
@@ -73,6 +88,7 @@ private:
 
    void generate_variables();
    void generate_constraints();
+   void generate_jacobian_map();
 
    void set_number_hessian_nonzeros();
    [[nodiscard]] size_t compute_hessian_number_nonzeros(double objective_multiplier, const std::vector<double>& multipliers) const;
@@ -0,0 +1,204 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include "MPSModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "tools/Logger.hpp"
+
+// read the MPS file and call the private constructor
+MPSModel::MPSModel(const std::string& file_name, MPSFormat format) : MPSModel(MPSReader::read(file_name, format)) {
+}
+
+MPSModel::MPSModel(MPSProblem&& problem) :
+      Model(problem.name, problem.number_variables, problem.number_constraints),
+      problem(std::move(problem)),
+      variable_status(this->number_variables),
+      constraint_status(this->number_constraints) {
+   this->objective_sign = this->problem.objective_sign;
+   this->generate_variables();
+   this->generate_constraints();
+
+   // sparsity of the objective gradient: linear variables and variables of the quadratic part
+   this->problem.objective_linear_part.for_each([&](size_t i, double /*coefficient*/) {
+      this->objective_gradient_sparsity.push_back(i);
+   });
+   this->number_hessian_nonzeros = 0;
+   for (size_t column_index: Range(this->number_variables)) {
+      for (const auto& [row_index, entry]: this->problem.hessian_columns[column_index]) {
+         this->objective_gradient_sparsity.push_back(row_index);
+         this->objective_gradient_sparsity.push_back(column_index);
+         this->number_hessian_nonzeros++;
+      }
+   }
+   std::sort(this->objective_gradient_sparsity.begin(), this->objective_gradient_sparsity.end());
+   this->objective_gradient_sparsity.erase(std::unique(this->objective_gradient_sparsity.begin(), this->objective_gradient_sparsity.end()),
+         this->objective_gradient_sparsity.end());
+   this->number_objective_gradient_nonzeros = this->objective_gradient_sparsity.size();
+   this->number_jacobian_nonzeros = 0;
+   for (const SparseVector<double>& row: this->problem.constraint_rows) {
+      this->number_jacobian_nonzeros += row.size();
+   }
+}
+
+void MPSModel::generate_variables() {
+   std::vector<Interval> variable_bounds(this->problem.variable_bounds);
+   Model::determine_bounds_types(variable_bounds, this->variable_status);
+   // figure out the bounded variables
+   for (size_t i: Range(this->number_variables)) {
+      const BoundType status = this->get_variable_bound_type(i);
+      if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
+         this->lower_bounded_variables.push_back(i);
+         if (status == BOUNDED_LOWER) {
+            this->single_lower_bounded_variables.push_back(i);
+         }
+      }
+      if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
+         this->upper_bounded_variables.push_back(i);
+         if (status == BOUNDED_UPPER) {
+            this->single_upper_bounded_variables.push_back(i);
+         }
+      }
+   }
+}
+
+void MPSModel::generate_constraints() {
+   std::vector<Interval> constraint_bounds(this->problem.constraint_bounds);
+   Model::determine_bounds_types(constraint_bounds, this->constraint_status);
+
+   // partition equality and inequality constraints. All constraints are linear
+   for (size_t j: Range(this->number_constraints)) {
+      if (this->get_constraint_bound_type(j) == EQUAL_BOUNDS) {
+         this->equality_constraints.push_back(j);
+      }
+      else {
+         this->inequality_constraints.push_back(j);
+      }
+      this->linear_constraints.push_back(j);
+   }
+}
+
+double MPSModel::evaluate_objective(const std::vector<double>& x) const {
+   // c0 + c^T x + 1/2 x^T Q x (the off-diagonal entries are stored once)
+   double quadratic_term = 0.;
+   for (size_t column_index: Range(this->number_variables)) {
+      for (const auto& [row_index, entry]: this->problem.hessian_columns[column_index]) {
+         quadratic_term += (row_index == column_index ? 0.5 : 1.) * entry * x[row_index] * x[column_index];
+      }
+   }
+   return this->objective_sign * (this->problem.objective_constant + dot(x, this->problem.objective_linear_part) + quadratic_term);
+}
+
+void MPSModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   // c + Q x
+   std::vector<double> dense_gradient(this->number_variables, 0.);
+   this->problem.objective_linear_part.for_each([&](size_t i, double coefficient) {
+      dense_gradient[i] += coefficient;
+   });
+   for (size_t column_index: Range(this->number_variables)) {
+      for (const auto& [row_index, entry]: this->problem.hessian_columns[column_index]) {
+         dense_gradient[row_index] += entry * x[column_index];
+         if (row_index != column_index) {
+            dense_gradient[column_index] += entry * x[row_index];
+         }
+      }
+   }
+   for (size_t i: this->objective_gradient_sparsity) {
+      gradient.insert(i, this->objective_sign * dense_gradient[i]);
+   }
+}
+
+void MPSModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   for (size_t j: Range(this->number_constraints)) {
+      constraints[j] = dot(x, this->problem.constraint_rows[j]);
+   }
+}
+
+void MPSModel::evaluate_constraint_gradient(const std::vector<double>& /*x*/, size_t j, SparseVector<double>& gradient) const {
+   gradient.clear();
+   this->problem.constraint_rows[j].for_each([&](size_t i, double coefficient) {
+      gradient.insert(i, coefficient);
+   });
+}
+
+void MPSModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   for (size_t j: Range(this->number_constraints)) {
+      this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+   }
+}
+
+// the constraints are linear: the Hessian of the Lagrangian is the Hessian of the objective
+void MPSModel::evaluate_lagrangian_hessian(const std::vector<double>& /*x*/, double objective_multiplier, const std::vector<double>& /*multipliers*/,
+      SymmetricMatrix<double>& hessian) const {
+   hessian.reset();
+   for (size_t column_index: Range(this->number_variables)) {
+      for (const auto& [row_index, entry]: this->problem.hessian_columns[column_index]) {
+         hessian.insert(this->objective_sign * objective_multiplier * entry, row_index, column_index);
+      }
+      hessian.finalize_column(column_index);
+   }
+}
+
+double MPSModel::get_variable_lower_bound(size_t i) const {
+   return this->problem.variable_bounds[i].lb;
+}
+
+double MPSModel::get_variable_upper_bound(size_t i) const {
+   return this->problem.variable_bounds[i].ub;
+}
+
+BoundType MPSModel::get_variable_bound_type(size_t i) const {
+   return this->variable_status[i];
+}
+
+double MPSModel::get_constraint_lower_bound(size_t j) const {
+   return this->problem.constraint_bounds[j].lb;
+}
+
+double MPSModel::get_constraint_upper_bound(size_t j) const {
+   return this->problem.constraint_bounds[j].ub;
+}
+
+FunctionType MPSModel::get_constraint_type(size_t /*j*/) const {
+   return LINEAR;
+}
+
+BoundType MPSModel::get_constraint_bound_type(size_t j) const {
+   return this->constraint_status[j];
+}
+
+size_t MPSModel::get_number_objective_gradient_nonzeros() const {
+   return this->number_objective_gradient_nonzeros;
+}
+
+size_t MPSModel::get_number_jacobian_nonzeros() const {
+   return this->number_jacobian_nonzeros;
+}
+
+size_t MPSModel::get_number_hessian_nonzeros() const {
+   return this->number_hessian_nonzeros;
+}
+
+// the MPS format has no initial point
+void MPSModel::get_initial_primal_point(std::vector<double>& x) const {
+   assert(x.size() >= this->number_variables);
+   std::fill(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(this->number_variables), 0.);
+}
+
+void MPSModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   assert(multipliers.size() >= this->number_constraints);
+   std::fill(multipliers.begin(), multipliers.begin() + static_cast<std::ptrdiff_t>(this->number_constraints), 0.);
+}
+
+void MPSModel::postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const {
+   // do nothing
+}
+
+const std::vector<size_t>& MPSModel::get_linear_constraints() const {
+   return this->linear_constraints;
+}
+
+bool MPSModel::is_quadratic_program() const {
+   return true;
+}
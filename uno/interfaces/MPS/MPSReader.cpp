@@ -0,0 +1,440 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+#include "MPSReader.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+// values beyond this threshold are infinite bounds
+constexpr double MPS_INFINITY = 1e20;
+// (start, length) of the fields of the fixed format: columns 2-3, 5-12, 15-22, 25-36, 40-47 and 50-61
+constexpr std::pair<size_t, size_t> FIXED_FIELDS[] = {{1, 2}, {4, 8}, {14, 8}, {24, 12}, {39, 8}, {49, 12}};
+
+std::string trim(const std::string& string) {
+   const size_t start = string.find_first_not_of(" \t\r");
+   if (start == std::string::npos) {
+      return "";
+   }
+   const size_t end = string.find_last_not_of(" \t\r");
+   return string.substr(start, end - start + 1);
+}
+
+MPSProblem MPSReader::read(const std::string& file_name, MPSFormat format) {
+   std::ifstream file(file_name);
+   if (not file) {
+      throw std::runtime_error("MPSReader: the file " + file_name + " could not be opened");
+   }
+   MPSProblem problem;
+   problem.name = file_name;
+   MPSReader reader(std::move(file), format, problem);
+   reader.read_sections();
+   reader.generate_problem();
+   return problem;
+}
+
+MPSFormat MPSReader::get_format(const std::string& format_name) {
+   if (format_name == "free") {
+      return MPSFormat::FREE;
+   }
+   else if (format_name == "fixed") {
+      return MPSFormat::FIXED;
+   }
+   throw std::invalid_argument("The MPS format " + format_name + " does not exist");
+}
+
+bool MPSReader::is_mps_file(const std::string& file_name) {
+   const std::string extension = std::filesystem::path(file_name).extension().string();
+   return extension == ".mps" || extension == ".qps" || extension == ".MPS" || extension == ".QPS";
+}
+
+MPSReader::MPSReader(std::ifstream&& file, MPSFormat format, MPSProblem& problem): file(std::move(file)), format(format), problem(problem) {
+}
+
+void MPSReader::read_sections() {
+   std::string line;
+   while (this->section != Section::END && std::getline(this->file, line)) {
+      this->line_number++;
+      // empty lines and comments
+      if (trim(line).empty() || line[0] == '*') {
+         continue;
+      }
+      // the section headers start in the first column
+      if (line[0] != ' ' && line[0] != '\t') {
+         std::istringstream stream(line);
+         std::vector<std::string> fields{};
+         std::string field;
+         while (stream >> field) {
+            fields.push_back(field);
+         }
+         this->read_header(fields);
+         // the name may contain spaces
+         if (this->section == Section::NAME) {
+            const std::string name = trim(line.substr(4));
+            if (not name.empty()) {
+               this->problem.name = name;
+            }
+         }
+         continue;
+      }
+      const std::vector<std::string> fields = this->split_line(line);
+      switch (this->section) {
+         case Section::OBJSENSE:
+            this->read_header({"OBJSENSE", fields[0]});
+            break;
+         case Section::OBJNAME:
+            this->objective_name = fields[0];
+            break;
+         case Section::ROWS:
+            this->read_row(fields);
+            break;
+         case Section::COLUMNS:
+            this->read_column(fields);
+            break;
+         case Section::RHS:
+            this->read_right_hand_side(fields, false);
+            break;
+         case Section::RANGES:
+            this->read_right_hand_side(fields, true);
+            break;
+         case Section::BOUNDS:
+            this->read_bound(fields);
+            break;
+         case Section::QUADRATIC_TRIANGLE:
+         case Section::QUADRATIC_MATRIX:
+            this->read_quadratic_entry(fields);
+            break;
+         default:
+            throw this->error("data line outside of a section");
+      }
+   }
+   if (this->section != Section::END) {
+      throw this->error("the ENDATA section is missing");
+   }
+}
+
+void MPSReader::read_header(const std::vector<std::string>& fields) {
+   const std::string& keyword = fields[0];
+   if (keyword == "NAME") {
+      this->section = Section::NAME;
+   }
+   else if (keyword == "OBJSENSE" || keyword == "OBJSENS") {
+      this->section = Section::OBJSENSE;
+      // the sense may be on the same line
+      if (1 < fields.size()) {
+         if (fields[1] == "MAX" || fields[1] == "MAXIMIZE") {
+            this->problem.objective_sign = -1.;
+         }
+         else if (fields[1] == "MIN" || fields[1] == "MINIMIZE") {
+            this->problem.objective_sign = 1.;
+         }
+         else {
+            throw this->error("unknown objective sense " + fields[1]);
+         }
+      }
+   }
+   else if (keyword == "OBJNAME") {
+      this->section = Section::OBJNAME;
+      if (1 < fields.size()) {
+         this->objective_name = fields[1];
+      }
+   }
+   else if (keyword == "ROWS") {
+      this->section = Section::ROWS;
+   }
+   else if (keyword == "COLUMNS") {
+      this->section = Section::COLUMNS;
+   }
+   else if (keyword == "RHS") {
+      this->section = Section::RHS;
+   }
+   else if (keyword == "RANGES") {
+      this->section = Section::RANGES;
+   }
+   else if (keyword == "BOUNDS") {
+      this->section = Section::BOUNDS;
+   }
+   else if (keyword == "QUADOBJ") {
+      this->section = Section::QUADRATIC_TRIANGLE;
+   }
+   else if (keyword == "QMATRIX" || keyword == "QSECTION") {
+      this->section = Section::QUADRATIC_MATRIX;
+   }
+   else if (keyword == "ENDATA") {
+      this->section = Section::END;
+   }
+   else {
+      throw this->error("the section " + keyword + " is not supported");
+   }
+}
+
+void MPSReader::read_row(const std::vector<std::string>& fields) {
+   if (fields.size() < 2) {
+      throw this->error("a row needs a type and a name");
+   }
+   const char type = fields[0][0];
+   const std::string& name = fields[1];
+   if (type == 'N') {
+      // the first N row is the objective (unless given by OBJNAME), the other ones are discarded
+      if (this->objective_name.empty()) {
+         this->objective_name = name;
+      }
+      else if (name != this->objective_name) {
+         this->free_rows.insert(name);
+      }
+   }
+   else if (type == 'E' || type == 'L' || type == 'G') {
+      this->row_indices[name] = this->row_types.size();
+      this->row_types.push_back(type);
+   }
+   else {
+      throw this->error("unknown row type " + fields[0]);
+   }
+}
+
+void MPSReader::read_column(const std::vector<std::string>& fields) {
+   // integrality markers
+   if (3 <= fields.size() && fields[1] == "'MARKER'") {
+      if (fields[2] == "'INTORG'") {
+         this->is_integer_block = true;
+      }
+      else if (fields[2] == "'INTEND'") {
+         this->is_integer_block = false;
+      }
+      return;
+   }
+   if (fields.size() < 3 || fields.size() % 2 == 0) {
+      throw this->error("a column entry needs a column name and (row name, value) pairs");
+   }
+   const std::string& column_name = fields[0];
+   auto column = this->column_indices.find(column_name);
+   if (column == this->column_indices.end()) {
+      column = this->column_indices.emplace(column_name, this->columns.size()).first;
+      this->columns.emplace_back();
+      this->problem.variable_bounds.push_back({0., INF<double>});
+      if (this->is_integer_block) {
+         this->number_integer_variables++;
+      }
+   }
+   const size_t column_index = column->second;
+   for (size_t field_index = 1; field_index + 1 < fields.size(); field_index += 2) {
+      const std::string& row_name = fields[field_index];
+      const double value = this->read_number(fields[field_index + 1]);
+      if (row_name == this->objective_name) {
+         this->problem.objective_linear_part.insert(column_index, value);
+      }
+      else if (this->free_rows.find(row_name) == this->free_rows.end()) {
+         const auto row = this->row_indices.find(row_name);
+         if (row == this->row_indices.end()) {
+            throw this->error("unknown row " + row_name);
+         }
+         this->columns[column_index].emplace_back(row->second, value);
+      }
+   }
+}
+
+// the name of the set is optional: (row name, value) pairs, possibly preceded by the name of the set
+void MPSReader::read_right_hand_side(const std::vector<std::string>& fields, bool is_range) {
+   if (fields.size() < 2) {
+      throw this->error("a right-hand side entry needs (row name, value) pairs");
+   }
+   if (this->right_hand_sides.empty()) {
+      this->right_hand_sides.resize(this->row_types.size(), 0.);
+      this->ranges.resize(this->row_types.size(), 0.);
+   }
+   for (size_t field_index = fields.size() % 2; field_index + 1 < fields.size(); field_index += 2) {
+      const std::string& row_name = fields[field_index];
+      const double value = this->read_number(fields[field_index + 1]);
+      if (row_name == this->objective_name) {
+         // the right-hand side of the objective is the opposite of its constant
+         if (not is_range) {
+            this->problem.objective_constant = -value;
+         }
+      }
+      else if (this->free_rows.find(row_name) == this->free_rows.end()) {
+         const auto row = this->row_indices.find(row_name);
+         if (row == this->row_indices.end()) {
+            throw this->error("unknown row " + row_name);
+         }
+         (is_range ? this->ranges : this->right_hand_sides)[row->second] = value;
+      }
+   }
+}
+
+void MPSReader::read_bound(const std::vector<std::string>& fields) {
+   if (fields.size() < 2) {
+      throw this->error("a bound needs a type and a column name");
+   }
+   const std::string& type = fields[0];
+   const bool has_value = (type == "UP" || type == "LO" || type == "FX" || type == "LI" || type == "UI");
+   // the name of the bound set is optional
+   size_t column_field = 1;
+   if (has_value) {
+      if (fields.size() < 3) {
+         throw this->error("the bound " + type + " needs a value");
+      }
+      column_field = (fields.size() == 3) ? 1 : 2;
+   }
+   else if (3 <= fields.size() && this->column_indices.find(fields[2]) != this->column_indices.end()) {
+      column_field = 2;
+   }
+   const size_t i = this->get_column_index(fields[column_field]);
+   const double value = has_value ? this->read_number(fields[column_field + 1]) : 0.;
+   Interval& bounds = this->problem.variable_bounds[i];
+   if (type == "UP" || type == "UI") {
+      bounds.ub = value;
+      // historical convention: a negative upper bound makes the default lower bound infinite
+      if (value < 0. && bounds.lb == 0.) {
+         WARNING << "MPSReader: the negative upper bound of " << fields[column_field] << " makes its lower bound infinite\n";
+         bounds.lb = -INF<double>;
+      }
+   }
+   else if (type == "LO" || type == "LI") {
+      bounds.lb = value;
+   }
+   else if (type == "FX") {
+      bounds = {value, value};
+   }
+   else if (type == "FR") {
+      bounds = {-INF<double>, INF<double>};
+   }
+   else if (type == "MI") {
+      bounds.lb = -INF<double>;
+   }
+   else if (type == "PL") {
+      bounds.ub = INF<double>;
+   }
+   else if (type == "BV") {
+      bounds = {0., 1.};
+   }
+   else {
+      throw this->error("the bound type " + type + " is not supported");
+   }
+   if (type == "LI" || type == "UI" || type == "BV") {
+      this->number_integer_variables++;
+   }
+}
+
+void MPSReader::read_quadratic_entry(const std::vector<std::string>& fields) {
+   if (fields.size() < 3) {
+      throw this->error("a quadratic entry needs two column names and a value");
+   }
+   const size_t i = this->get_column_index(fields[0]);
+   const size_t j = this->get_column_index(fields[1]);
+   const double value = this->read_number(fields[2]);
+   if (this->section == Section::QUADRATIC_TRIANGLE) {
+      // each off-diagonal entry is given once, in either triangle
+      this->hessian_entries[{std::max(i, j), std::min(i, j)}] += value;
+   }
+   else if (i <= j) {
+      // the full matrix is given: keep its upper triangle
+      this->hessian_entries[{j, i}] += value;
+   }
+}
+
+void MPSReader::generate_problem() {
+   if (0 < this->number_integer_variables) {
+      WARNING << "MPSReader: the integrality of " << this->number_integer_variables << " variables is relaxed\n";
+   }
+   this->problem.number_variables = this->columns.size();
+   this->problem.number_constraints = this->row_types.size();
+   this->right_hand_sides.resize(this->problem.number_constraints, 0.);
+   this->ranges.resize(this->problem.number_constraints, 0.);
+
+   // infinite bounds
+   for (Interval& bounds: this->problem.variable_bounds) {
+      if (bounds.lb <= -MPS_INFINITY) {
+         bounds.lb = -INF<double>;
+      }
+      if (MPS_INFINITY <= bounds.ub) {
+         bounds.ub = INF<double>;
+      }
+   }
+
+   // constraints: the ranges of the E rows are signed
+   this->problem.constraint_bounds.resize(this->problem.number_constraints);
+   for (size_t j: Range(this->problem.number_constraints)) {
+      const double rhs = this->right_hand_sides[j];
+      const double range = this->ranges[j];
+      Interval& bounds = this->problem.constraint_bounds[j];
+      if (this->row_types[j] == 'E') {
+         bounds = {(range < 0.) ? rhs + range : rhs, (0. < range) ? rhs + range : rhs};
+      }
+      else if (this->row_types[j] == 'L') {
+         bounds = {(range != 0.) ? rhs - std::abs(range) : -INF<double>, rhs};
+      }
+      else {
+         bounds = {rhs, (range != 0.) ? rhs + std::abs(range) : INF<double>};
+      }
+      if (bounds.lb <= -MPS_INFINITY) {
+         bounds.lb = -INF<double>;
+      }
+      if (MPS_INFINITY <= bounds.ub) {
+         bounds.ub = INF<double>;
+      }
+   }
+
+   // transpose the columns into the constraint rows
+   this->problem.constraint_rows.resize(this->problem.number_constraints);
+   for (size_t i: Range(this->problem.number_variables)) {
+      for (const auto& [j, value]: this->columns[i]) {
+         this->problem.constraint_rows[j].insert(i, value);
+      }
+   }
+
+   // the map is sorted by column, then by row
+   this->problem.hessian_columns.resize(this->problem.number_variables);
+   for (const auto& [indices, value]: this->hessian_entries) {
+      this->problem.hessian_columns[indices.first].emplace_back(indices.second, value);
+   }
+}
+
+std::vector<std::string> MPSReader::split_line(const std::string& line) const {
+   std::vector<std::string> fields{};
+   if (this->format == MPSFormat::FIXED) {
+      for (const auto& [start, length]: FIXED_FIELDS) {
+         if (start < line.size()) {
+            std::string field = trim(line.substr(start, length));
+            if (not field.empty()) {
+               fields.push_back(std::move(field));
+            }
+         }
+      }
+   }
+   else {
+      std::istringstream stream(line);
+      std::string field;
+      while (stream >> field) {
+         fields.push_back(field);
+      }
+   }
+   if (fields.empty()) {
+      throw this->error("empty data line");
+   }
+   return fields;
+}
+
+size_t MPSReader::get_column_index(const std::string& name) const {
+   const auto column = this->column_indices.find(name);
+   if (column == this->column_indices.end()) {
+      throw this->error("unknown column " + name);
+   }
+   return column->second;
+}
+
+double MPSReader::read_number(const std::string& field) const {
+   char* end = nullptr;
+   const double value = std::strtod(field.c_str(), &end);
+   if (end == field.c_str() || *end != '\0') {
+      throw this->error(field + " is not a number");
+   }
+   return value;
+}
+
+std::runtime_error MPSReader::error(const std::string& message) const {
+   return std::runtime_error("MPSReader: " + message + " (line " + std::to_string(this->line_number) + ")");
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MPSREADER_H
+#define UNO_MPSREADER_H
+
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "linear_algebra/SparseVector.hpp"
+#include "optimization/Model.hpp"
+
+enum class MPSFormat {FREE, FIXED};
+
+// linear constraints and quadratic objective c0 + c^T x + 1/2 x^T Q x of an MPS/QPS file
+struct MPSProblem {
+   std::string name;
+   size_t number_variables{0};
+   size_t number_constraints{0};
+   double objective_sign{1.};
+   double objective_constant{0.};
+   SparseVector<double> objective_linear_part{};
+   std::vector<SparseVector<double>> constraint_rows{};
+   // upper triangle of Q: sorted (row index, entry) pairs of each column
+   std::vector<std::vector<std::pair<size_t, double>>> hessian_columns{};
+   std::vector<Interval> variable_bounds{};
+   std::vector<Interval> constraint_bounds{};
+};
+
+/*! \class MPSReader
+ * \brief Reader of the MPS (linear) and QPS (quadratic objective) files, in free or fixed format
+ *
+ *  Sections: NAME, OBJSENSE, ROWS, COLUMNS, RHS, RANGES, BOUNDS, QUADOBJ (upper or lower triangle of Q), QMATRIX and
+ *  QSECTION (full Q). Only the first N row is the objective, the other ones are discarded. The integrality of the
+ *  variables (markers, BV, LI and UI bounds) is relaxed. In fixed format, the fields are read at their columns and the
+ *  names may contain spaces.
+ */
+class MPSReader {
+public:
+   [[nodiscard]] static MPSProblem read(const std::string& file_name, MPSFormat format);
+   // format given by the option mps_format (free|fixed)
+   [[nodiscard]] static MPSFormat get_format(const std::string& format_name);
+   // .mps or .qps extension
+   [[nodiscard]] static bool is_mps_file(const std::string& file_name);
+
+private:
+   enum class Section {NONE, NAME, OBJSENSE, OBJNAME, ROWS, COLUMNS, RHS, RANGES, BOUNDS, QUADRATIC_TRIANGLE, QUADRATIC_MATRIX, END};
+
+   std::ifstream file;
+   const MPSFormat format;
+   MPSProblem& problem;
+   Section section{Section::NONE};
+   std::string objective_name{};
+   std::unordered_set<std::string> free_rows{};
+   std::unordered_map<std::string, size_t> row_indices{};
+   std::unordered_map<std::string, size_t> column_indices{};
+   std::vector<char> row_types{};
+   std::vector<double> right_hand_sides{};
+   std::vector<double> ranges{};
+   std::vector<std::vector<std::pair<size_t, double>>> columns{};
+   std::map<std::pair<size_t, size_t>, double> hessian_entries{}; // (column, row) with row <= column
+   bool is_integer_block{false};
+   size_t number_integer_variables{0};
+   size_t line_number{0};
+
+   MPSReader(std::ifstream&& file, MPSFormat format, MPSProblem& problem);
+
+   void read_sections();
+   void read_header(const std::vector<std::string>& fields);
+   void read_row(const std::vector<std::string>& fields);
+   void read_column(const std::vector<std::string>& fields);
+   void read_right_hand_side(const std::vector<std::string>& fields, bool is_range);
+   void read_bound(const std::vector<std::string>& fields);
+   void read_quadratic_entry(const std::vector<std::string>& fields);
+   void generate_problem();
+
+   [[nodiscard]] std::vector<std::string> split_line(const std::string& line) const;
+   [[nodiscard]] size_t get_column_index(const std::string& name) const;
+   [[nodiscard]] double read_number(const std::string& field) const;
+   [[nodiscard]] std::runtime_error error(const std::string& message) const;
+};
+
+#endif // UNO_MPSREADER_H
@@ -0,0 +1,402 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include "ModelBuilder.hpp"
+#include "interfaces/NL/NLModel.hpp"
+#include "tools/Range.hpp"
+
+constexpr size_t NO_NODE = static_cast<size_t>(-1);
+constexpr size_t PENDING_NODE = NO_NODE - 1;
+
+Expression::Expression(double constant): constant(constant) {
+}
+
+Expression::Expression(ModelBuilder& builder, size_t node): builder(&builder), node(node) {
+}
+
+bool Expression::is_constant() const {
+   return (this->builder == nullptr);
+}
+
+double Expression::get_constant() const {
+   if (not this->is_constant()) {
+      throw std::logic_error("Expression::get_constant: the expression depends on the variables");
+   }
+   return this->constant;
+}
+
+Expression& Expression::operator+=(const Expression& other) {
+   *this = *this + other;
+   return *this;
+}
+
+Expression& Expression::operator-=(const Expression& other) {
+   *this = *this - other;
+   return *this;
+}
+
+Expression& Expression::operator*=(const Expression& other) {
+   *this = *this * other;
+   return *this;
+}
+
+Expression& Expression::operator/=(const Expression& other) {
+   *this = *this / other;
+   return *this;
+}
+
+// value of an operation on constants (same semantics as the evaluation of the graph)
+double fold(Operator op, const std::vector<Expression>& expression_operands, double value) {
+   ExpressionGraph graph(0);
+   std::vector<size_t> operand_nodes{};
+   for (const Expression& operand: expression_operands) {
+      operand_nodes.push_back(graph.add_constant(operand.get_constant()));
+   }
+   const size_t root = graph.add_operation(op, operand_nodes, value);
+   std::vector<double> values(graph.number_nodes());
+   graph.evaluate({}, graph.compute_tape({root}), values);
+   return values[root];
+}
+
+// the operation is recorded on the tape of the (common) builder of its operands, or folded if they are all constants
+Expression record_operation(Operator op, const std::vector<Expression>& expression_operands, double value) {
+   ModelBuilder* builder = nullptr;
+   for (const Expression& operand: expression_operands) {
+      if (operand.builder != nullptr) {
+         if (builder != nullptr && builder != operand.builder) {
+            throw std::invalid_argument("Expression: the operands belong to different models");
+         }
+         builder = operand.builder;
+      }
+   }
+   if (builder == nullptr) {
+      return {fold(op, expression_operands, value)};
+   }
+   std::vector<size_t> operand_nodes{};
+   operand_nodes.reserve(expression_operands.size());
+   for (const Expression& operand: expression_operands) {
+      operand_nodes.push_back(builder->record_operand(operand));
+   }
+   return {*builder, builder->record(op, operand_nodes, value)};
+}
+
+bool is_constant(const Expression& expression, double value) {
+   return expression.is_constant() && expression.get_constant() == value;
+}
+
+Expression operator+(const Expression& first, const Expression& second) {
+   if (is_constant(first, 0.)) {
+      return second;
+   }
+   else if (is_constant(second, 0.)) {
+      return first;
+   }
+   return record_operation(Operator::ADD, {first, second}, 0.);
+}
+
+Expression operator-(const Expression& first, const Expression& second) {
+   if (is_constant(second, 0.)) {
+      return first;
+   }
+   else if (is_constant(first, 0.)) {
+      return -second;
+   }
+   return record_operation(Operator::SUBTRACT, {first, second}, 0.);
+}
+
+Expression operator*(const Expression& first, const Expression& second) {
+   if (is_constant(first, 1.)) {
+      return second;
+   }
+   else if (is_constant(second, 1.)) {
+      return first;
+   }
+   return record_operation(Operator::MULTIPLY, {first, second}, 0.);
+}
+
+Expression operator/(const Expression& first, const Expression& second) {
+   if (is_constant(second, 1.)) {
+      return first;
+   }
+   return record_operation(Operator::DIVIDE, {first, second}, 0.);
+}
+
+Expression operator-(const Expression& expression) {
+   return record_operation(Operator::NEGATE, {expression}, 0.);
+}
+
+Expression pow(const Expression& base, const Expression& exponent) {
+   if (not base.is_constant() && exponent.is_constant()) {
+      if (exponent.get_constant() == 1.) {
+         return base;
+      }
+      return record_operation(Operator::POWER_CONSTANT_EXPONENT, {base}, exponent.get_constant());
+   }
+   else if (base.is_constant() && not exponent.is_constant()) {
+      return record_operation(Operator::CONSTANT_POWER, {exponent}, base.get_constant());
+   }
+   return record_operation(Operator::POWER, {base, exponent}, 0.);
+}
+
+// the constant terms are gathered into a single operand
+Expression sum(const std::vector<Expression>& terms) {
+   double constant = 0.;
+   std::vector<Expression> operands{};
+   for (const Expression& term: terms) {
+      if (term.is_constant()) {
+         constant += term.get_constant();
+      }
+      else {
+         operands.push_back(term);
+      }
+   }
+   if (operands.empty()) {
+      return {constant};
+   }
+   if (constant != 0.) {
+      operands.emplace_back(constant);
+   }
+   return (operands.size() == 1) ? operands[0] : record_operation(Operator::SUM, operands, 0.);
+}
+
+Expression sqrt(const Expression& expression) { return record_operation(Operator::SQRT, {expression}, 0.); }
+Expression exp(const Expression& expression) { return record_operation(Operator::EXP, {expression}, 0.); }
+Expression log(const Expression& expression) { return record_operation(Operator::LOG, {expression}, 0.); }
+Expression log10(const Expression& expression) { return record_operation(Operator::LOG10, {expression}, 0.); }
+Expression sin(const Expression& expression) { return record_operation(Operator::SIN, {expression}, 0.); }
+Expression cos(const Expression& expression) { return record_operation(Operator::COS, {expression}, 0.); }
+Expression tan(const Expression& expression) { return record_operation(Operator::TAN, {expression}, 0.); }
+Expression asin(const Expression& expression) { return record_operation(Operator::ASIN, {expression}, 0.); }
+Expression acos(const Expression& expression) { return record_operation(Operator::ACOS, {expression}, 0.); }
+Expression atan(const Expression& expression) { return record_operation(Operator::ATAN, {expression}, 0.); }
+Expression sinh(const Expression& expression) { return record_operation(Operator::SINH, {expression}, 0.); }
+Expression cosh(const Expression& expression) { return record_operation(Operator::COSH, {expression}, 0.); }
+Expression tanh(const Expression& expression) { return record_operation(Operator::TANH, {expression}, 0.); }
+
+ModelBuilder::ModelBuilder(std::string name): name(std::move(name)) {
+}
+
+Expression ModelBuilder::add_variable(double lower_bound, double upper_bound, double initial_value) {
+   if (upper_bound < lower_bound) {
+      throw std::invalid_argument("ModelBuilder::add_variable: the lower bound is larger than the upper bound");
+   }
+   const size_t variable_index = this->variable_bounds.size();
+   this->variable_bounds.push_back({lower_bound, upper_bound});
+   this->initial_primals.push_back(initial_value);
+   return {*this, this->record(Operator::VARIABLE, {}, static_cast<double>(variable_index))};
+}
+
+std::vector<Expression> ModelBuilder::add_variables(size_t number_variables, double lower_bound, double upper_bound, double initial_value) {
+   std::vector<Expression> variables{};
+   variables.reserve(number_variables);
+   for ([[maybe_unused]] size_t i: Range(number_variables)) {
+      variables.push_back(this->add_variable(lower_bound, upper_bound, initial_value));
+   }
+   return variables;
+}
+
+size_t ModelBuilder::add_constraint(const Expression& function, double lower_bound, double upper_bound) {
+   this->check_owner(function);
+   if (upper_bound < lower_bound) {
+      throw std::invalid_argument("ModelBuilder::add_constraint: the lower bound is larger than the upper bound");
+   }
+   this->constraints.push_back(function);
+   this->constraint_bounds.push_back({lower_bound, upper_bound});
+   return this->constraints.size() - 1;
+}
+
+void ModelBuilder::minimize(const Expression& objective) {
+   this->check_owner(objective);
+   this->objective = objective;
+   this->objective_sign = 1.;
+}
+
+// the model minimizes -objective
+void ModelBuilder::maximize(const Expression& objective) {
+   this->check_owner(objective);
+   this->objective = objective;
+   this->objective_sign = -1.;
+}
+
+size_t ModelBuilder::number_variables() const {
+   return this->variable_bounds.size();
+}
+
+size_t ModelBuilder::number_constraints() const {
+   return this->constraints.size();
+}
+
+size_t ModelBuilder::tape_size() const {
+   return this->tape.size();
+}
+
+size_t ModelBuilder::record(Operator op, const std::vector<size_t>& node_operands, double value) {
+   this->tape.push_back({op, value, this->operands.size(), node_operands.size()});
+   this->operands.insert(this->operands.end(), node_operands.cbegin(), node_operands.cend());
+   return this->tape.size() - 1;
+}
+
+// the constant operands of a recorded operation are recorded as CONSTANT nodes
+size_t ModelBuilder::record_operand(const Expression& expression) {
+   return expression.is_constant() ? this->record(Operator::CONSTANT, {}, expression.get_constant()) : expression.node;
+}
+
+void ModelBuilder::check_owner(const Expression& expression) const {
+   if (not expression.is_constant() && expression.builder != this) {
+      throw std::invalid_argument("ModelBuilder: the expression belongs to another model");
+   }
+}
+
+std::unique_ptr<Model> ModelBuilder::build() const {
+   NLProblem problem(this->number_variables());
+   problem.name = this->name;
+   problem.number_variables = this->number_variables();
+   problem.number_constraints = this->number_constraints();
+   problem.objective_sign = this->objective_sign;
+   problem.variable_bounds = this->variable_bounds;
+   problem.constraint_bounds = this->constraint_bounds;
+   problem.initial_primals = this->initial_primals;
+   problem.initial_duals.resize(this->number_constraints(), 0.);
+
+   // graph node of each tape node (shared by all the functions)
+   std::vector<size_t> graph_nodes(this->tape.size(), NO_NODE);
+   problem.objective_root = this->translate_function(this->objective, problem.graph, graph_nodes, problem.objective_linear_part);
+   problem.constraint_roots.reserve(this->number_constraints());
+   problem.constraint_linear_parts.resize(this->number_constraints());
+   for (size_t j: Range(this->number_constraints())) {
+      problem.constraint_roots.push_back(this->translate_function(this->constraints[j], problem.graph, graph_nodes,
+            problem.constraint_linear_parts[j]));
+   }
+   return std::make_unique<NLModel>(std::move(problem));
+}
+
+// the affine part (variables and constants scaled by sums, differences, negations and products/quotients by constants) is
+// extracted from the top of the expression. The other subexpressions are the nonlinear terms.
+// The tape is a DAG whose operands precede their operations: the coefficients are accumulated per node in a single
+// reverse topological pass (decreasing node indices), so that a shared subexpression is visited once
+size_t ModelBuilder::translate_function(const Expression& function, ExpressionGraph& graph, std::vector<size_t>& graph_nodes,
+      SparseVector<double>& linear_part) const {
+   double constant = 0.;
+   std::map<size_t, double> linear_coefficients{};
+   std::map<size_t, double> nonlinear_terms{};
+   if (function.is_constant()) {
+      constant = function.get_constant();
+   }
+   else {
+      // coefficient of each reached node, by decreasing index: the coefficient of the first node is final
+      std::map<size_t, double, std::greater<>> coefficients{{function.node, 1.}};
+      while (not coefficients.empty()) {
+         const auto [node_index, coefficient] = *coefficients.begin();
+         coefficients.erase(coefficients.begin());
+         const ExpressionNode& node = this->tape[node_index];
+         const auto operand = [&](size_t position) {
+            return this->operands[node.first_child + position];
+         };
+         const auto is_constant_operand = [&](size_t position) {
+            return this->tape[operand(position)].op == Operator::CONSTANT;
+         };
+         switch (node.op) {
+            case Operator::VARIABLE:
+               linear_coefficients[static_cast<size_t>(node.value)] += coefficient;
+               break;
+            case Operator::CONSTANT:
+               constant += coefficient * node.value;
+               break;
+            case Operator::ADD:
+            case Operator::SUM:
+               for (size_t position: Range(node.number_children)) {
+                  coefficients[operand(position)] += coefficient;
+               }
+               break;
+            case Operator::SUBTRACT:
+               coefficients[operand(0)] += coefficient;
+               coefficients[operand(1)] -= coefficient;
+               break;
+            case Operator::NEGATE:
+               coefficients[operand(0)] -= coefficient;
+               break;
+            case Operator::MULTIPLY:
+               if (is_constant_operand(0)) {
+                  coefficients[operand(1)] += coefficient * this->tape[operand(0)].value;
+               }
+               else if (is_constant_operand(1)) {
+                  coefficients[operand(0)] += coefficient * this->tape[operand(1)].value;
+               }
+               else {
+                  nonlinear_terms[node_index] += coefficient;
+               }
+               break;
+            case Operator::DIVIDE:
+               if (is_constant_operand(1)) {
+                  coefficients[operand(0)] += coefficient / this->tape[operand(1)].value;
+               }
+               else {
+                  nonlinear_terms[node_index] += coefficient;
+               }
+               break;
+            default:
+               nonlinear_terms[node_index] += coefficient;
+         }
+      }
+   }
+
+   for (const auto& [variable_index, coefficient]: linear_coefficients) {
+      if (coefficient != 0.) {
+         linear_part.insert(variable_index, coefficient);
+      }
+   }
+   // nonlinear part: sum of the scaled nonlinear terms and the constant
+   std::vector<size_t> terms{};
+   for (const auto& [node_index, coefficient]: nonlinear_terms) {
+      if (coefficient != 0.) {
+         const size_t term = this->translate_node(node_index, graph, graph_nodes);
+         terms.push_back((coefficient == 1.) ? term : graph.add_operation(Operator::MULTIPLY, {graph.add_constant(coefficient), term}));
+      }
+   }
+   if (constant != 0. || terms.empty()) {
+      terms.push_back(graph.add_constant(constant));
+   }
+   return (terms.size() == 1) ? terms[0] : graph.add_operation(Operator::SUM, terms);
+}
+
+// the nodes reachable from the tape node that are not in the graph yet are added in increasing (topological) order
+size_t ModelBuilder::translate_node(size_t node_index, ExpressionGraph& graph, std::vector<size_t>& graph_nodes) const {
+   std::vector<size_t> reachable_nodes{};
+   std::vector<size_t> stack{node_index};
+   while (not stack.empty()) {
+      const size_t current_node = stack.back();
+      stack.pop_back();
+      if (graph_nodes[current_node] != NO_NODE) {
+         continue;
+      }
+      graph_nodes[current_node] = PENDING_NODE;
+      reachable_nodes.push_back(current_node);
+      const ExpressionNode& node = this->tape[current_node];
+      for (size_t position: Range(node.number_children)) {
+         stack.push_back(this->operands[node.first_child + position]);
+      }
+   }
+   std::sort(reachable_nodes.begin(), reachable_nodes.end());
+
+   for (size_t current_node: reachable_nodes) {
+      const ExpressionNode& node = this->tape[current_node];
+      if (node.op == Operator::VARIABLE) {
+         graph_nodes[current_node] = static_cast<size_t>(node.value);
+      }
+      else if (node.op == Operator::CONSTANT) {
+         graph_nodes[current_node] = graph.add_constant(node.value);
+      }
+      else {
+         std::vector<size_t> children(node.number_children);
+         for (size_t position: Range(node.number_children)) {
+            children[position] = graph_nodes[this->operands[node.first_child + position]];
+         }
+         graph_nodes[current_node] = graph.add_operation(node.op, children, node.value);
+      }
+   }
+   return graph_nodes[node_index];
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MODELBUILDER_H
+#define UNO_MODELBUILDER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "interfaces/NL/ExpressionGraph.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "optimization/Model.hpp"
+#include "tools/Infinity.hpp"
+
+class ModelBuilder;
+
+/*! \class Expression
+ * \brief Handle on a node of the tape of a ModelBuilder
+ *
+ *  The arithmetic operators and the elementary functions record their result on the tape of their operands. The
+ *  expressions that do not depend on a variable are constants and are folded without being recorded.
+ */
+class Expression {
+public:
+   Expression(double constant); // NOLINT(google-explicit-constructor): constants are promoted implicitly
+
+   [[nodiscard]] bool is_constant() const;
+   [[nodiscard]] double get_constant() const;
+
+   Expression& operator+=(const Expression& other);
+   Expression& operator-=(const Expression& other);
+   Expression& operator*=(const Expression& other);
+   Expression& operator/=(const Expression& other);
+
+private:
+   ModelBuilder* builder{nullptr}; // nullptr for constants
+   size_t node{0};
+   double constant{0.};
+
+   Expression(ModelBuilder& builder, size_t node);
+
+   friend class ModelBuilder;
+   friend Expression record_operation(Operator op, const std::vector<Expression>& expression_operands, double value);
+};
+
+Expression operator+(const Expression& first, const Expression& second);
+Expression operator-(const Expression& first, const Expression& second);
+Expression operator*(const Expression& first, const Expression& second);
+Expression operator/(const Expression& first, const Expression& second);
+Expression operator-(const Expression& expression);
+Expression pow(const Expression& base, const Expression& exponent);
+Expression sum(const std::vector<Expression>& terms);
+Expression sqrt(const Expression& expression);
+Expression exp(const Expression& expression);
+Expression log(const Expression& expression);
+Expression log10(const Expression& expression);
+Expression sin(const Expression& expression);
+Expression cos(const Expression& expression);
+Expression tan(const Expression& expression);
+Expression asin(const Expression& expression);
+Expression acos(const Expression& expression);
+Expression atan(const Expression& expression);
+Expression sinh(const Expression& expression);
+Expression cosh(const Expression& expression);
+Expression tanh(const Expression& expression);
+
+/*! \class ModelBuilder
+ * \brief Embedded modeling API: variables, objective and constraints built from overloaded expressions
+ *
+ *  The expressions are recorded once on a tape. build() splits each function into its affine part and its nonlinear
+ *  terms (a constraint without nonlinear terms is linear) and translates the nonlinear terms into an ExpressionGraph.
+ *  The resulting NLModel computes the gradients and the Jacobian by reverse mode and the Lagrangian Hessian by edge
+ *  pushing, and detects the sparsity of the derivatives from the graph. The builder must outlive its expressions.
+ */
+class ModelBuilder {
+public:
+   explicit ModelBuilder(std::string name);
+   ModelBuilder(const ModelBuilder&) = delete;
+   ModelBuilder& operator=(const ModelBuilder&) = delete;
+
+   [[nodiscard]] Expression add_variable(double lower_bound = -INF<double>, double upper_bound = INF<double>, double initial_value = 0.);
+   [[nodiscard]] std::vector<Expression> add_variables(size_t number_variables, double lower_bound = -INF<double>,
+         double upper_bound = INF<double>, double initial_value = 0.);
+   // index of the constraint lower_bound <= function <= upper_bound
+   size_t add_constraint(const Expression& function, double lower_bound, double upper_bound);
+   void minimize(const Expression& objective);
+   void maximize(const Expression& objective);
+
+   [[nodiscard]] size_t number_variables() const;
+   [[nodiscard]] size_t number_constraints() const;
+   [[nodiscard]] size_t tape_size() const;
+   [[nodiscard]] std::unique_ptr<Model> build() const;
+
+private:
+   const std::string name;
+   // tape: the operands of a node are recorded before the node. The VARIABLE nodes store the index of their variable
+   std::vector<ExpressionNode> tape{};
+   std::vector<size_t> operands{};
+   std::vector<Interval> variable_bounds{};
+   std::vector<double> initial_primals{};
+   Expression objective{0.};
+   double objective_sign{1.};
+   std::vector<Expression> constraints{};
+   std::vector<Interval> constraint_bounds{};
+
+   [[nodiscard]] size_t record(Operator op, const std::vector<size_t>& node_operands, double value = 0.);
+   [[nodiscard]] size_t record_operand(const Expression& expression);
+   void check_owner(const Expression& expression) const;
+   // function = affine part + nonlinear part (root of the graph)
+   [[nodiscard]] size_t translate_function(const Expression& function, ExpressionGraph& graph, std::vector<size_t>& graph_nodes,
+         SparseVector<double>& linear_part) const;
+   [[nodiscard]] size_t translate_node(size_t node_index, ExpressionGraph& graph, std::vector<size_t>& graph_nodes) const;
+
+   friend Expression record_operation(Operator op, const std::vector<Expression>& expression_operands, double value);
+};
+
+#endif // UNO_MODELBUILDER_H
@@ -0,0 +1,624 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "ExpressionGraph.hpp"
+#include "tools/Range.hpp"
+
+constexpr size_t NOT_MERGED = std::numeric_limits<size_t>::max();
+
+ExpressionGraph::ExpressionGraph(size_t number_variables): number_variables(number_variables) {
+   this->nodes.reserve(number_variables);
+   for (size_t i: Range(number_variables)) {
+      this->nodes.push_back({Operator::VARIABLE, static_cast<double>(i), 0, 0});
+   }
+}
+
+size_t ExpressionGraph::add_constant(double value) {
+   this->nodes.push_back({Operator::CONSTANT, value, this->children.size(), 0});
+   return this->nodes.size() - 1;
+}
+
+size_t ExpressionGraph::add_operation(Operator op, const std::vector<size_t>& node_children, double value) {
+   for (size_t child: node_children) {
+      if (this->nodes.size() <= child) {
+         throw std::invalid_argument("ExpressionGraph::add_operation: the children must be created before their parent");
+      }
+   }
+   this->nodes.push_back({op, value, this->children.size(), node_children.size()});
+   this->children.insert(this->children.end(), node_children.cbegin(), node_children.cend());
+   return this->nodes.size() - 1;
+}
+
+size_t ExpressionGraph::number_nodes() const {
+   return this->nodes.size();
+}
+
+const ExpressionNode& ExpressionGraph::get_node(size_t node_index) const {
+   return this->nodes[node_index];
+}
+
+bool ExpressionGraph::is_constant(size_t node_index) const {
+   return this->nodes[node_index].op == Operator::CONSTANT;
+}
+
+std::vector<size_t> ExpressionGraph::compute_tape(const std::vector<size_t>& roots) const {
+   std::vector<bool> is_reached(this->nodes.size(), false);
+   std::vector<size_t> stack(roots);
+   std::vector<size_t> tape{};
+   while (not stack.empty()) {
+      const size_t node_index = stack.back();
+      stack.pop_back();
+      if (not is_reached[node_index]) {
+         is_reached[node_index] = true;
+         tape.push_back(node_index);
+         const ExpressionNode& node = this->nodes[node_index];
+         for (size_t k: Range(node.number_children)) {
+            stack.push_back(this->children[node.first_child + k]);
+         }
+      }
+   }
+   // the children have smaller indices than their parents
+   std::sort(tape.begin(), tape.end());
+   return tape;
+}
+
+std::vector<size_t> ExpressionGraph::compute_terms(size_t root) const {
+   std::vector<size_t> stack{root};
+   std::vector<size_t> terms{};
+   while (not stack.empty()) {
+      const size_t node_index = stack.back();
+      stack.pop_back();
+      const ExpressionNode& node = this->nodes[node_index];
+      if (node.op == Operator::SUM || node.op == Operator::ADD) {
+         for (size_t k: Range(node.number_children)) {
+            stack.push_back(this->children[node.first_child + k]);
+         }
+      }
+      else {
+         terms.push_back(node_index);
+      }
+   }
+   return terms;
+}
+
+void ExpressionGraph::evaluate(const std::vector<double>& x, const std::vector<size_t>& tape, std::vector<double>& values) const {
+   assert(values.size() == this->nodes.size() && "ExpressionGraph::evaluate: the values do not have the size of the graph");
+   for (size_t node_index: tape) {
+      const ExpressionNode& node = this->nodes[node_index];
+      values[node_index] = (node.op == Operator::VARIABLE) ? x[node_index] : this->evaluate_node(node, values);
+   }
+}
+
+void ExpressionGraph::compute_adjoints(const std::vector<size_t>& tape, const std::vector<double>& values, std::vector<double>& adjoints) const {
+   std::vector<double> derivatives;
+   for (auto position = tape.crbegin(); position != tape.crend(); ++position) {
+      const ExpressionNode& node = this->nodes[*position];
+      const double adjoint = adjoints[*position];
+      if (node.number_children == 0 || adjoint == 0.) {
+         continue;
+      }
+      this->compute_partial_derivatives(node, values, derivatives);
+      for (size_t k: Range(node.number_children)) {
+         adjoints[this->children[node.first_child + k]] += adjoint * derivatives[k];
+      }
+   }
+}
+
+// edge pushing (Gower and Mello, 2012): the nodes are eliminated in reverse topological order. The second-order
+// entries of an eliminated node are pushed onto its children (chain rule), then its own second-order partial
+// derivatives are created, weighted by its adjoint
+void ExpressionGraph::compute_hessian(const std::vector<size_t>& tape, const std::vector<double>& values, std::vector<double>& adjoints,
+      NodeMatrix& entries, bool structural) const {
+   assert(entries.size() == this->nodes.size() && "ExpressionGraph::compute_hessian: the entries do not have the size of the graph");
+   const auto add_entry = [&](size_t first_node, size_t second_node, double value) {
+      // the constants are never eliminated: their entries never reach the variables
+      if (this->is_constant(first_node) || this->is_constant(second_node)) {
+         return;
+      }
+      if (structural) {
+         entries[first_node][second_node] = 1.;
+         entries[second_node][first_node] = 1.;
+      }
+      else {
+         entries[first_node][second_node] += value;
+         if (first_node != second_node) {
+            entries[second_node][first_node] += value;
+         }
+      }
+   };
+
+   std::vector<double> derivatives;
+   std::vector<SecondPartialDerivative> second_derivatives;
+   // partial derivatives with respect to the distinct children
+   std::vector<std::pair<size_t, double>> merged_derivatives;
+   std::vector<size_t> merged_position(this->nodes.size(), NOT_MERGED);
+   std::vector<std::pair<size_t, double>> neighbors;
+   for (auto position = tape.crbegin(); position != tape.crend(); ++position) {
+      const size_t node_index = *position;
+      const ExpressionNode& node = this->nodes[node_index];
+      if (node.number_children == 0) {
+         continue;
+      }
+      const double adjoint = structural ? 1. : adjoints[node_index];
+      if (not structural) {
+         this->compute_partial_derivatives(node, values, derivatives);
+      }
+      merged_derivatives.clear();
+      for (size_t k: Range(node.number_children)) {
+         const size_t child = this->children[node.first_child + k];
+         const double derivative = structural ? 1. : derivatives[k];
+         if (merged_position[child] == NOT_MERGED) {
+            merged_position[child] = merged_derivatives.size();
+            merged_derivatives.emplace_back(child, derivative);
+         }
+         else {
+            merged_derivatives[merged_position[child]].second += derivative;
+         }
+      }
+      for (const auto& [child, derivative]: merged_derivatives) {
+         merged_position[child] = NOT_MERGED;
+      }
+
+      // pushing: eliminate the entries of the node
+      neighbors.assign(entries[node_index].cbegin(), entries[node_index].cend());
+      entries[node_index].clear();
+      for (const auto& [neighbor, weight]: neighbors) {
+         if (neighbor == node_index) {
+            for (size_t k: Range(merged_derivatives.size())) {
+               const auto& [first_child, first_derivative] = merged_derivatives[k];
+               for (size_t l: Range(k, merged_derivatives.size())) {
+                  const auto& [second_child, second_derivative] = merged_derivatives[l];
+                  add_entry(first_child, second_child, weight * first_derivative * second_derivative);
+               }
+            }
+         }
+         else {
+            entries[neighbor].erase(node_index);
+            for (const auto& [child, derivative]: merged_derivatives) {
+               add_entry(child, neighbor, (child == neighbor ? 2. : 1.) * weight * derivative);
+            }
+         }
+      }
+
+      // creating: second-order partial derivatives of the node
+      if (adjoint != 0.) {
+         this->compute_second_partial_derivatives(node, values, second_derivatives, structural);
+         for (const SecondPartialDerivative& second_derivative: second_derivatives) {
+            const size_t first_child = this->children[node.first_child + second_derivative.first_position];
+            const size_t second_child = this->children[node.first_child + second_derivative.second_position];
+            // an off-diagonal derivative with respect to the same child appears twice in the symmetric matrix
+            const double factor = (second_derivative.first_position != second_derivative.second_position && first_child == second_child) ? 2. : 1.;
+            add_entry(first_child, second_child, factor * adjoint * second_derivative.value);
+         }
+      }
+
+      // adjoints
+      if (not structural) {
+         for (const auto& [child, derivative]: merged_derivatives) {
+            adjoints[child] += adjoint * derivative;
+         }
+      }
+   }
+}
+
+// degrees of the nodes of the tape, capped at 3 (not quadratic)
+bool ExpressionGraph::is_quadratic(const std::vector<size_t>& tape, size_t root) const {
+   constexpr size_t NOT_QUADRATIC = 3;
+   std::vector<size_t> degrees(this->nodes.size(), 0);
+   for (size_t node_index: tape) {
+      const ExpressionNode& node = this->nodes[node_index];
+      const auto child_degree = [&](size_t k) {
+         return degrees[this->children[node.first_child + k]];
+      };
+      size_t max_child_degree = 0;
+      for (size_t k: Range(node.number_children)) {
+         max_child_degree = std::max(max_child_degree, child_degree(k));
+      }
+      size_t degree = 0;
+      switch (node.op) {
+         case Operator::VARIABLE:
+            degree = 1;
+            break;
+         case Operator::CONSTANT:
+            break;
+         case Operator::ADD:
+         case Operator::SUBTRACT:
+         case Operator::SUM:
+         case Operator::NEGATE:
+            degree = max_child_degree;
+            break;
+         case Operator::MULTIPLY:
+            degree = child_degree(0) + child_degree(1);
+            break;
+         case Operator::DIVIDE:
+            degree = (child_degree(1) == 0) ? child_degree(0) : NOT_QUADRATIC;
+            break;
+         case Operator::POWER_CONSTANT_EXPONENT:
+            // nonnegative integer exponent
+            if (child_degree(0) == 0 || node.value == 0.) {
+               degree = 0;
+            }
+            else if (0. < node.value && node.value <= 2. && node.value == std::floor(node.value)) {
+               degree = child_degree(0) * static_cast<size_t>(node.value);
+            }
+            else {
+               degree = NOT_QUADRATIC;
+            }
+            break;
+         default:
+            // any other operation of a nonconstant expression
+            degree = (max_child_degree == 0) ? 0 : NOT_QUADRATIC;
+      }
+      degrees[node_index] = std::min(degree, NOT_QUADRATIC);
+   }
+   return degrees[root] < NOT_QUADRATIC;
+}
+
+double ExpressionGraph::evaluate_node(const ExpressionNode& node, const std::vector<double>& values) const {
+   const auto child = [&](size_t k) {
+      return values[this->children[node.first_child + k]];
+   };
+   switch (node.op) {
+      case Operator::CONSTANT:
+         return node.value;
+      case Operator::ADD:
+         return child(0) + child(1);
+      case Operator::SUBTRACT:
+         return child(0) - child(1);
+      case Operator::MULTIPLY:
+         return child(0) * child(1);
+      case Operator::DIVIDE:
+         return child(0) / child(1);
+      case Operator::REMAINDER:
+         return std::fmod(child(0), child(1));
+      case Operator::POWER:
+         return std::pow(child(0), child(1));
+      case Operator::POWER_CONSTANT_EXPONENT:
+         return (node.value == 2.) ? child(0) * child(0) : std::pow(child(0), node.value);
+      case Operator::CONSTANT_POWER:
+         return std::pow(node.value, child(0));
+      case Operator::SUM: {
+         double result = 0.;
+         for (size_t k: Range(node.number_children)) {
+            result += child(k);
+         }
+         return result;
+      }
+      case Operator::NEGATE:
+         return -child(0);
+      case Operator::MIN: {
+         double result = child(0);
+         for (size_t k: Range(1, node.number_children)) {
+            result = std::min(result, child(k));
+         }
+         return result;
+      }
+      case Operator::MAX: {
+         double result = child(0);
+         for (size_t k: Range(1, node.number_children)) {
+            result = std::max(result, child(k));
+         }
+         return result;
+      }
+      case Operator::ABS:
+         return std::abs(child(0));
+      case Operator::FLOOR:
+         return std::floor(child(0));
+      case Operator::CEIL:
+         return std::ceil(child(0));
+      case Operator::IF:
+         return (child(0) != 0.) ? child(1) : child(2);
+      case Operator::SQRT:
+         return std::sqrt(child(0));
+      case Operator::EXP:
+         return std::exp(child(0));
+      case Operator::LOG:
+         return std::log(child(0));
+      case Operator::LOG10:
+         return std::log10(child(0));
+      case Operator::SIN:
+         return std::sin(child(0));
+      case Operator::COS:
+         return std::cos(child(0));
+      case Operator::TAN:
+         return std::tan(child(0));
+      case Operator::SINH:
+         return std::sinh(child(0));
+      case Operator::COSH:
+         return std::cosh(child(0));
+      case Operator::TANH:
+         return std::tanh(child(0));
+      case Operator::ASIN:
+         return std::asin(child(0));
+      case Operator::ACOS:
+         return std::acos(child(0));
+      case Operator::ATAN:
+         return std::atan(child(0));
+      case Operator::ASINH:
+         return std::asinh(child(0));
+      case Operator::ACOSH:
+         return std::acosh(child(0));
+      case Operator::ATANH:
+         return std::atanh(child(0));
+      case Operator::ATAN2:
+         return std::atan2(child(0), child(1));
+      case Operator::OR:
+         return (child(0) != 0. || child(1) != 0.) ? 1. : 0.;
+      case Operator::AND:
+         return (child(0) != 0. && child(1) != 0.) ? 1. : 0.;
+      case Operator::NOT:
+         return (child(0) == 0.) ? 1. : 0.;
+      case Operator::LESS_THAN:
+         return (child(0) < child(1)) ? 1. : 0.;
+      case Operator::LESS_EQUAL:
+         return (child(0) <= child(1)) ? 1. : 0.;
+      case Operator::EQUAL:
+         return (child(0) == child(1)) ? 1. : 0.;
+      case Operator::GREATER_EQUAL:
+         return (child(0) >= child(1)) ? 1. : 0.;
+      case Operator::GREATER_THAN:
+         return (child(0) > child(1)) ? 1. : 0.;
+      case Operator::NOT_EQUAL:
+         return (child(0) != child(1)) ? 1. : 0.;
+      default:
+         throw std::invalid_argument("ExpressionGraph::evaluate_node: the operator cannot be evaluated");
+   }
+}
+
+void ExpressionGraph::compute_partial_derivatives(const ExpressionNode& node, const std::vector<double>& values,
+      std::vector<double>& derivatives) const {
+   const auto child = [&](size_t k) {
+      return values[this->children[node.first_child + k]];
+   };
+   derivatives.assign(node.number_children, 0.);
+   switch (node.op) {
+      case Operator::ADD:
+      case Operator::SUM:
+         std::fill(derivatives.begin(), derivatives.end(), 1.);
+         break;
+      case Operator::SUBTRACT:
+         derivatives[0] = 1.;
+         derivatives[1] = -1.;
+         break;
+      case Operator::MULTIPLY:
+         derivatives[0] = child(1);
+         derivatives[1] = child(0);
+         break;
+      case Operator::DIVIDE:
+         derivatives[0] = 1. / child(1);
+         derivatives[1] = -child(0) / (child(1) * child(1));
+         break;
+      case Operator::REMAINDER:
+         derivatives[0] = 1.;
+         derivatives[1] = -std::trunc(child(0) / child(1));
+         break;
+      case Operator::POWER: {
+         const double power = std::pow(child(0), child(1));
+         derivatives[0] = child(1) * std::pow(child(0), child(1) - 1.);
+         derivatives[1] = power * std::log(child(0));
+         break;
+      }
+      case Operator::POWER_CONSTANT_EXPONENT:
+         derivatives[0] = (node.value == 2.) ? 2. * child(0) : node.value * std::pow(child(0), node.value - 1.);
+         break;
+      case Operator::CONSTANT_POWER:
+         derivatives[0] = std::pow(node.value, child(0)) * std::log(node.value);
+         break;
+      case Operator::NEGATE:
+         derivatives[0] = -1.;
+         break;
+      case Operator::MIN:
+      case Operator::MAX: {
+         // the first active child
+         size_t active_child = 0;
+         for (size_t k: Range(1, node.number_children)) {
+            if ((node.op == Operator::MIN) ? (child(k) < child(active_child)) : (child(active_child) < child(k))) {
+               active_child = k;
+            }
+         }
+         derivatives[active_child] = 1.;
+         break;
+      }
+      case Operator::ABS:
+         derivatives[0] = (0. <= child(0)) ? 1. : -1.;
+         break;
+      case Operator::IF:
+         derivatives[(child(0) != 0.) ? 1 : 2] = 1.;
+         break;
+      case Operator::SQRT:
+         derivatives[0] = 0.5 / std::sqrt(child(0));
+         break;
+      case Operator::EXP:
+         derivatives[0] = std::exp(child(0));
+         break;
+      case Operator::LOG:
+         derivatives[0] = 1. / child(0);
+         break;
+      case Operator::LOG10:
+         derivatives[0] = 1. / (child(0) * std::log(10.));
+         break;
+      case Operator::SIN:
+         derivatives[0] = std::cos(child(0));
+         break;
+      case Operator::COS:
+         derivatives[0] = -std::sin(child(0));
+         break;
+      case Operator::TAN: {
+         const double tangent = std::tan(child(0));
+         derivatives[0] = 1. + tangent * tangent;
+         break;
+      }
+      case Operator::SINH:
+         derivatives[0] = std::cosh(child(0));
+         break;
+      case Operator::COSH:
+         derivatives[0] = std::sinh(child(0));
+         break;
+      case Operator::TANH: {
+         const double hyperbolic_tangent = std::tanh(child(0));
+         derivatives[0] = 1. - hyperbolic_tangent * hyperbolic_tangent;
+         break;
+      }
+      case Operator::ASIN:
+         derivatives[0] = 1. / std::sqrt(1. - child(0) * child(0));
+         break;
+      case Operator::ACOS:
+         derivatives[0] = -1. / std::sqrt(1. - child(0) * child(0));
+         break;
+      case Operator::ATAN:
+         derivatives[0] = 1. / (1. + child(0) * child(0));
+         break;
+      case Operator::ASINH:
+         derivatives[0] = 1. / std::sqrt(child(0) * child(0) + 1.);
+         break;
+      case Operator::ACOSH:
+         derivatives[0] = 1. / std::sqrt(child(0) * child(0) - 1.);
+         break;
+      case Operator::ATANH:
+         derivatives[0] = 1. / (1. - child(0) * child(0));
+         break;
+      case Operator::ATAN2: {
+         const double squared_norm = child(0) * child(0) + child(1) * child(1);
+         derivatives[0] = child(1) / squared_norm;
+         derivatives[1] = -child(0) / squared_norm;
+         break;
+      }
+      default:
+         // piecewise constant: FLOOR, CEIL and the logical operators
+         break;
+   }
+}
+
+void ExpressionGraph::compute_second_partial_derivatives(const ExpressionNode& node, const std::vector<double>& values,
+      std::vector<SecondPartialDerivative>& derivatives, bool structural) const {
+   const auto child = [&](size_t k) {
+      return values[this->children[node.first_child + k]];
+   };
+   // second derivative of a univariate function
+   const auto add_univariate = [&](const auto& compute_value) {
+      derivatives.push_back({0, 0, structural ? 1. : compute_value(child(0))});
+   };
+   derivatives.clear();
+   switch (node.op) {
+      case Operator::MULTIPLY:
+         derivatives.push_back({0, 1, 1.});
+         break;
+      case Operator::DIVIDE:
+         if (structural) {
+            derivatives.push_back({0, 1, 1.});
+            derivatives.push_back({1, 1, 1.});
+         }
+         else {
+            const double denominator = child(1);
+            derivatives.push_back({0, 1, -1. / (denominator * denominator)});
+            derivatives.push_back({1, 1, 2. * child(0) / (denominator * denominator * denominator)});
+         }
+         break;
+      case Operator::POWER:
+         if (structural) {
+            derivatives.push_back({0, 0, 1.});
+            derivatives.push_back({0, 1, 1.});
+            derivatives.push_back({1, 1, 1.});
+         }
+         else {
+            const double base = child(0);
+            const double exponent = child(1);
+            const double logarithm = std::log(base);
+            const double power = std::pow(base, exponent);
+            derivatives.push_back({0, 0, exponent * (exponent - 1.) * std::pow(base, exponent - 2.)});
+            derivatives.push_back({0, 1, std::pow(base, exponent - 1.) * (1. + exponent * logarithm)});
+            derivatives.push_back({1, 1, power * logarithm * logarithm});
+         }
+         break;
+      case Operator::POWER_CONSTANT_EXPONENT:
+         if (node.value != 0. && node.value != 1.) {
+            add_univariate([&](double u) {
+               return (node.value == 2.) ? 2. : node.value * (node.value - 1.) * std::pow(u, node.value - 2.);
+            });
+         }
+         break;
+      case Operator::CONSTANT_POWER:
+         add_univariate([&](double u) {
+            const double logarithm = std::log(node.value);
+            return std::pow(node.value, u) * logarithm * logarithm;
+         });
+         break;
+      case Operator::SQRT:
+         add_univariate([](double u) { return -0.25 / (u * std::sqrt(u)); });
+         break;
+      case Operator::EXP:
+         add_univariate([](double u) { return std::exp(u); });
+         break;
+      case Operator::LOG:
+         add_univariate([](double u) { return -1. / (u * u); });
+         break;
+      case Operator::LOG10:
+         add_univariate([](double u) { return -1. / (u * u * std::log(10.)); });
+         break;
+      case Operator::SIN:
+         add_univariate([](double u) { return -std::sin(u); });
+         break;
+      case Operator::COS:
+         add_univariate([](double u) { return -std::cos(u); });
+         break;
+      case Operator::TAN:
+         add_univariate([](double u) {
+            const double tangent = std::tan(u);
+            return 2. * tangent * (1. + tangent * tangent);
+         });
+         break;
+      case Operator::SINH:
+         add_univariate([](double u) { return std::sinh(u); });
+         break;
+      case Operator::COSH:
+         add_univariate([](double u) { return std::cosh(u); });
+         break;
+      case Operator::TANH:
+         add_univariate([](double u) {
+            const double hyperbolic_tangent = std::tanh(u);
+            return -2. * hyperbolic_tangent * (1. - hyperbolic_tangent * hyperbolic_tangent);
+         });
+         break;
+      case Operator::ASIN:
+         add_univariate([](double u) { return u / std::pow(1. - u * u, 1.5); });
+         break;
+      case Operator::ACOS:
+         add_univariate([](double u) { return -u / std::pow(1. - u * u, 1.5); });
+         break;
+      case Operator::ATAN:
+         add_univariate([](double u) { return -2. * u / ((1. + u * u) * (1. + u * u)); });
+         break;
+      case Operator::ASINH:
+         add_univariate([](double u) { return -u / std::pow(u * u + 1., 1.5); });
+         break;
+      case Operator::ACOSH:
+         add_univariate([](double u) { return -u / std::pow(u * u - 1., 1.5); });
+         break;
+      case Operator::ATANH:
+         add_univariate([](double u) { return 2. * u / ((1. - u * u) * (1. - u * u)); });
+         break;
+      case Operator::ATAN2:
+         if (structural) {
+            derivatives.push_back({0, 0, 1.});
+            derivatives.push_back({0, 1, 1.});
+            derivatives.push_back({1, 1, 1.});
+         }
+         else {
+            const double u = child(0);
+            const double v = child(1);
+            const double squared_norm = u * u + v * v;
+            derivatives.push_back({0, 0, -2. * u * v / (squared_norm * squared_norm)});
+            derivatives.push_back({0, 1, (u * u - v * v) / (squared_norm * squared_norm)});
+            derivatives.push_back({1, 1, 2. * u * v / (squared_norm * squared_norm)});
+         }
+         break;
+      default:
+         // linear or piecewise linear
+         break;
+   }
+}
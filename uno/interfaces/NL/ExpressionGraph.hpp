@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_EXPRESSIONGRAPH_H
+#define UNO_EXPRESSIONGRAPH_H
+
+#include <unordered_map>
+#include <vector>
+
+enum class Operator {
+   VARIABLE, CONSTANT,
+   // arithmetic
+   ADD, SUBTRACT, MULTIPLY, DIVIDE, REMAINDER, POWER, POWER_CONSTANT_EXPONENT /* u^c */, CONSTANT_POWER /* c^u */, SUM, NEGATE,
+   // piecewise
+   MIN, MAX, ABS, FLOOR, CEIL, IF,
+   // elementary functions
+   SQRT, EXP, LOG, LOG10, SIN, COS, TAN, SINH, COSH, TANH, ASIN, ACOS, ATAN, ASINH, ACOSH, ATANH, ATAN2,
+   // logical
+   OR, AND, NOT, LESS_THAN, LESS_EQUAL, EQUAL, GREATER_EQUAL, GREATER_THAN, NOT_EQUAL
+};
+
+struct ExpressionNode {
+   Operator op;
+   double value; // constant, or constant of POWER_CONSTANT_EXPONENT and CONSTANT_POWER
+   size_t first_child;
+   size_t number_children;
+};
+
+// second-order partial derivative of a node with respect to two of its children (positions in the list of children)
+struct SecondPartialDerivative {
+   size_t first_position;
+   size_t second_position;
+   double value;
+};
+
+// symmetric matrix indexed by the nodes: entries[a][b] = entries[b][a]
+using NodeMatrix = std::vector<std::unordered_map<size_t, double>>;
+
+/*! \class ExpressionGraph
+ * \brief Expression DAG of the nonlinear parts of the functions of a model
+ *
+ *  The first nodes are the variables. A node is always created after its children, therefore the increasing order of
+ *  the nodes is a topological order. Common subexpressions (e.g. the defined variables of the .nl format) are shared.
+ *  The functions are evaluated on a tape (the sorted nodes reachable from a set of roots): forward sweep for the values,
+ *  reverse sweep for the gradients and edge pushing (second-order reverse sweep) for the Hessians.
+ *  The graph is immutable once built and all the workspace is passed by the caller: it can be evaluated concurrently.
+ */
+class ExpressionGraph {
+public:
+   explicit ExpressionGraph(size_t number_variables);
+
+   const size_t number_variables;
+
+   [[nodiscard]] size_t add_constant(double value);
+   [[nodiscard]] size_t add_operation(Operator op, const std::vector<size_t>& children, double value = 0.);
+   [[nodiscard]] size_t number_nodes() const;
+   [[nodiscard]] const ExpressionNode& get_node(size_t node_index) const;
+   [[nodiscard]] bool is_constant(size_t node_index) const;
+
+   // sorted nodes reachable from the roots
+   [[nodiscard]] std::vector<size_t> compute_tape(const std::vector<size_t>& roots) const;
+   // terms of the root: operands of the nested SUM and ADD nodes (the root itself if it is not a sum)
+   [[nodiscard]] std::vector<size_t> compute_terms(size_t root) const;
+   // values: size number_nodes()
+   void evaluate(const std::vector<double>& x, const std::vector<size_t>& tape, std::vector<double>& values) const;
+   // adjoints: size number_nodes(), seeded at the roots. The adjoints of the variable nodes are the partial derivatives
+   void compute_adjoints(const std::vector<size_t>& tape, const std::vector<double>& values, std::vector<double>& adjoints) const;
+   // adjoints: seeded at the roots. Upon return, the entries between variable nodes form the Hessian of the weighted roots.
+   // In structural mode, the values are ignored and the entries form a (conservative) sparsity pattern
+   void compute_hessian(const std::vector<size_t>& tape, const std::vector<double>& values, std::vector<double>& adjoints,
+         NodeMatrix& entries, bool structural) const;
+   // the root is a polynomial of degree at most 2 in the variables
+   [[nodiscard]] bool is_quadratic(const std::vector<size_t>& tape, size_t root) const;
+
+private:
+   std::vector<ExpressionNode> nodes{};
+   std::vector<size_t> children{};
+
+   [[nodiscard]] double evaluate_node(const ExpressionNode& node, const std::vector<double>& values) const;
+   void compute_partial_derivatives(const ExpressionNode& node, const std::vector<double>& values, std::vector<double>& derivatives) const;
+   void compute_second_partial_derivatives(const ExpressionNode& node, const std::vector<double>& values,
+         std::vector<SecondPartialDerivative>& derivatives, bool structural) const;
+};
+
+#endif // UNO_EXPRESSIONGRAPH_H
@@ -0,0 +1,471 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "NLModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/EvaluationErrors.hpp"
+#include "tools/Logger.hpp"
+
+// read the .nl file and call the private constructor
+NLModel::NLModel(const std::string& file_name) : NLModel(NLReader::read(file_name)) {
+}
+
+NLModel::NLModel(NLProblem&& problem) :
+      Model(problem.name, problem.number_variables, problem.number_constraints),
+      problem(std::move(problem)),
+      variable_status(this->number_variables),
+      constraint_type(this->number_constraints),
+      constraint_status(this->number_constraints) {
+   this->objective_sign = this->problem.objective_sign;
+   this->compute_sparsity_patterns();
+   this->generate_variables();
+   this->generate_constraints();
+}
+
+void NLModel::generate_variables() {
+   for (size_t i: Range(this->number_variables)) {
+      if (this->problem.variable_bounds[i].lb == this->problem.variable_bounds[i].ub) {
+         WARNING << "Variable x" << i << " has identical bounds\n";
+      }
+   }
+   std::vector<Interval> variable_bounds(this->problem.variable_bounds);
+   Model::determine_bounds_types(variable_bounds, this->variable_status);
+   // figure out the bounded variables
+   for (size_t i: Range(this->number_variables)) {
+      const BoundType status = this->get_variable_bound_type(i);
+      if (status == BOUNDED_LOWER || status == BOUNDED_BOTH_SIDES) {
+         this->lower_bounded_variables.push_back(i);
+         if (status == BOUNDED_LOWER) {
+            this->single_lower_bounded_variables.push_back(i);
+         }
+      }
+      if (status == BOUNDED_UPPER || status == BOUNDED_BOTH_SIDES) {
+         this->upper_bounded_variables.push_back(i);
+         if (status == BOUNDED_UPPER) {
+            this->single_upper_bounded_variables.push_back(i);
+         }
+      }
+   }
+}
+
+void NLModel::generate_constraints() {
+   std::vector<Interval> constraint_bounds(this->problem.constraint_bounds);
+   Model::determine_bounds_types(constraint_bounds, this->constraint_status);
+
+   // partition equality and inequality constraints
+   for (size_t j: Range(this->number_constraints)) {
+      if (this->get_constraint_bound_type(j) == EQUAL_BOUNDS) {
+         this->equality_constraints.push_back(j);
+      }
+      else {
+         this->inequality_constraints.push_back(j);
+      }
+   }
+
+   // a constraint is linear if its nonlinear part does not depend on the variables
+   for (size_t j: Range(this->number_constraints)) {
+      const bool is_linear = std::none_of(this->constraint_tapes[j].cbegin(), this->constraint_tapes[j].cend(), [&](size_t node_index) {
+         return node_index < this->number_variables;
+      });
+      this->constraint_type[j] = is_linear ? LINEAR : NONLINEAR;
+      if (is_linear) {
+         this->linear_constraints.push_back(j);
+      }
+   }
+   this->quadratic_program = (this->linear_constraints.size() == this->number_constraints) &&
+         this->problem.graph.is_quadratic(this->objective_tape, this->problem.objective_root);
+}
+
+// linear variables and variables of the nonlinear part
+std::vector<size_t> compute_gradient_sparsity(const std::vector<size_t>& tape, const SparseVector<double>& linear_part, size_t number_variables) {
+   std::vector<size_t> sparsity{};
+   for (size_t node_index: tape) {
+      if (node_index < number_variables) {
+         sparsity.push_back(node_index);
+      }
+   }
+   linear_part.for_each([&](size_t i, double /*coefficient*/) {
+      sparsity.push_back(i);
+   });
+   std::sort(sparsity.begin(), sparsity.end());
+   sparsity.erase(std::unique(sparsity.begin(), sparsity.end()), sparsity.end());
+   return sparsity;
+}
+
+void NLModel::compute_sparsity_patterns() {
+   const ExpressionGraph& graph = this->problem.graph;
+   // tapes
+   this->objective_tape = graph.compute_tape({this->problem.objective_root});
+   this->constraint_tapes.reserve(this->number_constraints);
+   for (size_t j: Range(this->number_constraints)) {
+      this->constraint_tapes.push_back(graph.compute_tape({this->problem.constraint_roots[j]}));
+   }
+   this->constraints_tape = graph.compute_tape(this->problem.constraint_roots);
+   std::vector<size_t> roots(this->problem.constraint_roots);
+   roots.push_back(this->problem.objective_root);
+   this->lagrangian_tape = graph.compute_tape(roots);
+   // objective terms
+   this->objective_terms = graph.compute_terms(this->problem.objective_root);
+   this->variable_objective_terms.resize(this->number_variables);
+   this->objective_term_tapes.reserve(this->objective_terms.size());
+   for (size_t term_index: Range(this->objective_terms.size())) {
+      this->objective_term_tapes.push_back(graph.compute_tape({this->objective_terms[term_index]}));
+      for (size_t node_index: this->objective_term_tapes[term_index]) {
+         if (node_index < this->number_variables) {
+            this->variable_objective_terms[node_index].push_back(term_index);
+         }
+      }
+   }
+   this->objective_linear_coefficients.resize(this->number_variables, 0.);
+   this->problem.objective_linear_part.for_each([&](size_t i, double coefficient) {
+      this->objective_linear_coefficients[i] += coefficient;
+   });
+
+   // gradients
+   this->objective_gradient_sparsity = compute_gradient_sparsity(this->objective_tape, this->problem.objective_linear_part, this->number_variables);
+   this->number_objective_gradient_nonzeros = this->objective_gradient_sparsity.size();
+   this->jacobian_sparsity.reserve(this->number_constraints);
+   this->number_jacobian_nonzeros = 0;
+   for (size_t j: Range(this->number_constraints)) {
+      this->jacobian_sparsity.push_back(compute_gradient_sparsity(this->constraint_tapes[j], this->problem.constraint_linear_parts[j],
+            this->number_variables));
+      this->number_jacobian_nonzeros += this->jacobian_sparsity[j].size();
+   }
+
+   // Hessian: structural edge pushing, provided that all multipliers are nonzero
+   std::vector<double> values(graph.number_nodes());
+   std::vector<double> adjoints(graph.number_nodes());
+   NodeMatrix entries(graph.number_nodes());
+   graph.compute_hessian(this->lagrangian_tape, values, adjoints, entries, true);
+   this->hessian_sparsity.resize(this->number_variables);
+   this->number_hessian_nonzeros = 0;
+   for (size_t column_index: Range(this->number_variables)) {
+      for (const auto& [row_index, entry]: entries[column_index]) {
+         if (row_index <= column_index) {
+            assert(row_index < this->number_variables && "NLModel: a Hessian entry does not correspond to a variable");
+            this->hessian_sparsity[column_index].push_back(row_index);
+         }
+      }
+      std::sort(this->hessian_sparsity[column_index].begin(), this->hessian_sparsity[column_index].end());
+      this->number_hessian_nonzeros += this->hessian_sparsity[column_index].size();
+   }
+}
+
+// workspace of the evaluations, allocated once per thread: the model has no mutable state and stays reentrant.
+// Invariant: the adjoints and the entries are zero between two evaluations
+struct EvaluationWorkspace {
+   std::vector<double> values{};
+   std::vector<double> adjoints{};
+   NodeMatrix entries{};
+};
+
+static EvaluationWorkspace& get_workspace(size_t number_nodes) {
+   thread_local EvaluationWorkspace workspace{};
+   // the graphs of different models may have different sizes
+   if (workspace.values.size() != number_nodes) {
+      workspace.values.resize(number_nodes);
+      workspace.adjoints.resize(number_nodes, 0.);
+      workspace.entries.resize(number_nodes);
+   }
+   return workspace;
+}
+
+double NLModel::evaluate_objective(const std::vector<double>& x) const {
+   std::vector<double>& values = get_workspace(this->problem.graph.number_nodes()).values;
+   this->problem.graph.evaluate(x, this->objective_tape, values);
+   const double result = this->objective_sign * (values[this->problem.objective_root] + dot(x, this->problem.objective_linear_part));
+   if (not std::isfinite(result)) {
+      throw FunctionEvaluationError();
+   }
+   return result;
+}
+
+void NLModel::compute_gradient(const std::vector<size_t>& tape, size_t root, const SparseVector<double>& linear_part, double scaling,
+      const std::vector<size_t>& sparsity, const std::vector<double>& values, std::vector<double>& adjoints, SparseVector<double>& gradient) const {
+   adjoints[root] = 1.;
+   this->problem.graph.compute_adjoints(tape, values, adjoints);
+   linear_part.for_each([&](size_t i, double coefficient) {
+      adjoints[i] += coefficient;
+   });
+   bool is_finite = true;
+   for (size_t i: sparsity) {
+      const double derivative = scaling * adjoints[i];
+      is_finite = is_finite && std::isfinite(derivative);
+      gradient.insert(i, derivative);
+   }
+   // reset the adjoints (also before throwing, since the workspace is reused)
+   for (size_t node_index: tape) {
+      adjoints[node_index] = 0.;
+   }
+   for (size_t i: sparsity) {
+      adjoints[i] = 0.;
+   }
+   adjoints[root] = 0.;
+   if (not is_finite) {
+      throw GradientEvaluationError();
+   }
+}
+
+void NLModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   EvaluationWorkspace& workspace = get_workspace(this->problem.graph.number_nodes());
+   this->problem.graph.evaluate(x, this->objective_tape, workspace.values);
+   this->compute_gradient(this->objective_tape, this->problem.objective_root, this->problem.objective_linear_part, this->objective_sign,
+         this->objective_gradient_sparsity, workspace.values, workspace.adjoints, gradient);
+}
+
+void NLModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   std::vector<double>& values = get_workspace(this->problem.graph.number_nodes()).values;
+   this->problem.graph.evaluate(x, this->constraints_tape, values);
+   for (size_t j: Range(this->number_constraints)) {
+      constraints[j] = values[this->problem.constraint_roots[j]] + dot(x, this->problem.constraint_linear_parts[j]);
+      if (not std::isfinite(constraints[j])) {
+         throw FunctionEvaluationError();
+      }
+   }
+}
+
+// the tapes of the constraints of the subset are evaluated separately
+void NLModel::evaluate_constraint_subset(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+      std::vector<double>& constraints) const {
+   std::vector<double>& values = get_workspace(this->problem.graph.number_nodes()).values;
+   for (size_t j: constraint_indices) {
+      this->problem.graph.evaluate(x, this->constraint_tapes[j], values);
+      constraints[j] = values[this->problem.constraint_roots[j]] + dot(x, this->problem.constraint_linear_parts[j]);
+      if (not std::isfinite(constraints[j])) {
+         throw FunctionEvaluationError();
+      }
+   }
+}
+
+void NLModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   EvaluationWorkspace& workspace = get_workspace(this->problem.graph.number_nodes());
+   this->problem.graph.evaluate(x, this->constraint_tapes[j], workspace.values);
+   gradient.clear();
+   this->compute_gradient(this->constraint_tapes[j], this->problem.constraint_roots[j], this->problem.constraint_linear_parts[j], 1.,
+         this->jacobian_sparsity[j], workspace.values, workspace.adjoints, gradient);
+}
+
+void NLModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   // a single forward sweep, then a reverse sweep per constraint
+   EvaluationWorkspace& workspace = get_workspace(this->problem.graph.number_nodes());
+   this->problem.graph.evaluate(x, this->constraints_tape, workspace.values);
+   for (size_t j: Range(this->number_constraints)) {
+      constraint_jacobian[j].clear();
+      this->compute_gradient(this->constraint_tapes[j], this->problem.constraint_roots[j], this->problem.constraint_linear_parts[j], 1.,
+            this->jacobian_sparsity[j], workspace.values, workspace.adjoints, constraint_jacobian[j]);
+   }
+}
+
+void NLModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+      SymmetricMatrix<double>& hessian) const {
+   const ExpressionGraph& graph = this->problem.graph;
+   EvaluationWorkspace& workspace = get_workspace(graph.number_nodes());
+   std::vector<double>& adjoints = workspace.adjoints;
+   NodeMatrix& entries = workspace.entries;
+   graph.evaluate(x, this->lagrangian_tape, workspace.values);
+   // Lagrangian sigma*f - y^T c (the objective is scaled by its sign)
+   adjoints[this->problem.objective_root] += this->objective_sign * objective_multiplier;
+   for (size_t j: Range(this->number_constraints)) {
+      adjoints[this->problem.constraint_roots[j]] -= multipliers[j];
+   }
+   graph.compute_hessian(this->lagrangian_tape, workspace.values, adjoints, entries, false);
+
+   // copy the entries in the fixed sparsity pattern. The entries left by the edge pushing are those between variables
+   hessian.reset();
+   for (size_t column_index: Range(this->number_variables)) {
+      for (size_t row_index: this->hessian_sparsity[column_index]) {
+         const auto entry = entries[column_index].find(row_index);
+         hessian.insert((entry != entries[column_index].end()) ? entry->second : 0., row_index, column_index);
+      }
+      hessian.finalize_column(column_index);
+      entries[column_index].clear();
+   }
+   // reset the adjoints
+   for (size_t node_index: this->lagrangian_tape) {
+      adjoints[node_index] = 0.;
+   }
+   adjoints[this->problem.objective_root] = 0.;
+   for (size_t j: Range(this->number_constraints)) {
+      adjoints[this->problem.constraint_roots[j]] = 0.;
+   }
+}
+
+std::vector<size_t> NLModel::compute_subset_tape(const std::vector<size_t>& variable_indices, const std::vector<size_t>& constraint_indices,
+      std::vector<size_t>& terms) const {
+   terms.clear();
+   for (size_t i: variable_indices) {
+      terms.insert(terms.end(), this->variable_objective_terms[i].cbegin(), this->variable_objective_terms[i].cend());
+   }
+   std::sort(terms.begin(), terms.end());
+   terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+   std::vector<size_t> tape{};
+   for (size_t term_index: terms) {
+      tape.insert(tape.end(), this->objective_term_tapes[term_index].cbegin(), this->objective_term_tapes[term_index].cend());
+   }
+   for (size_t j: constraint_indices) {
+      tape.insert(tape.end(), this->constraint_tapes[j].cbegin(), this->constraint_tapes[j].cend());
+   }
+   // the nodes of a tape are sorted in topological order
+   std::sort(tape.begin(), tape.end());
+   tape.erase(std::unique(tape.begin(), tape.end()), tape.end());
+   return tape;
+}
+
+// the terms that do not depend on the subset are left out
+double NLModel::evaluate_objective_subset(const std::vector<double>& x, const std::vector<size_t>& variable_indices) const {
+   std::vector<double>& values = get_workspace(this->problem.graph.number_nodes()).values;
+   std::vector<size_t> terms{};
+   const std::vector<size_t> tape = this->compute_subset_tape(variable_indices, {}, terms);
+   this->problem.graph.evaluate(x, tape, values);
+   double objective = 0.;
+   for (size_t term_index: terms) {
+      objective += values[this->objective_terms[term_index]];
+   }
+   for (size_t i: variable_indices) {
+      objective += this->objective_linear_coefficients[i] * x[i];
+   }
+   const double result = this->objective_sign * objective;
+   if (not std::isfinite(result)) {
+      throw FunctionEvaluationError();
+   }
+   return result;
+}
+
+void NLModel::evaluate_objective_subset_gradient(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+      SparseVector<double>& gradient) const {
+   EvaluationWorkspace& workspace = get_workspace(this->problem.graph.number_nodes());
+   std::vector<double>& adjoints = workspace.adjoints;
+   std::vector<size_t> terms{};
+   const std::vector<size_t> tape = this->compute_subset_tape(variable_indices, {}, terms);
+   this->problem.graph.evaluate(x, tape, workspace.values);
+   for (size_t term_index: terms) {
+      adjoints[this->objective_terms[term_index]] += 1.;
+   }
+   this->problem.graph.compute_adjoints(tape, workspace.values, adjoints);
+   bool is_finite = true;
+   for (size_t i: variable_indices) {
+      if (not this->variable_objective_terms[i].empty() || this->objective_linear_coefficients[i] != 0.) {
+         const double derivative = this->objective_sign * (adjoints[i] + this->objective_linear_coefficients[i]);
+         is_finite = is_finite && std::isfinite(derivative);
+         gradient.insert(i, derivative);
+      }
+   }
+   // reset the adjoints (also before throwing, since the workspace is reused)
+   for (size_t node_index: tape) {
+      adjoints[node_index] = 0.;
+   }
+   if (not is_finite) {
+      throw GradientEvaluationError();
+   }
+}
+
+// edge pushing on the tapes of the subset. The Hessian is indexed by the positions in the subset
+void NLModel::evaluate_lagrangian_subset_hessian(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+      const std::vector<size_t>& constraint_indices, double objective_multiplier, const std::vector<double>& multipliers,
+      SymmetricMatrix<double>& hessian) const {
+   const ExpressionGraph& graph = this->problem.graph;
+   EvaluationWorkspace& workspace = get_workspace(graph.number_nodes());
+   std::vector<double>& adjoints = workspace.adjoints;
+   NodeMatrix& entries = workspace.entries;
+   std::vector<size_t> terms{};
+   const std::vector<size_t> tape = this->compute_subset_tape(variable_indices, constraint_indices, terms);
+   graph.evaluate(x, tape, workspace.values);
+   for (size_t term_index: terms) {
+      adjoints[this->objective_terms[term_index]] += this->objective_sign * objective_multiplier;
+   }
+   for (size_t j: constraint_indices) {
+      adjoints[this->problem.constraint_roots[j]] -= multipliers[j];
+   }
+   graph.compute_hessian(tape, workspace.values, adjoints, entries, false);
+
+   // copy the entries of the subset in the fixed sparsity pattern. The positions in the subset are increasing
+   hessian.reset();
+   for (size_t reduced_column: Range(variable_indices.size())) {
+      const size_t column_index = variable_indices[reduced_column];
+      for (size_t row_index: this->hessian_sparsity[column_index]) {
+         const auto position = std::lower_bound(variable_indices.cbegin(), variable_indices.cend(), row_index);
+         if (position != variable_indices.cend() && *position == row_index) {
+            const auto entry = entries[column_index].find(row_index);
+            hessian.insert((entry != entries[column_index].end()) ? entry->second : 0., static_cast<size_t>(position - variable_indices.cbegin()),
+                  reduced_column);
+         }
+      }
+      hessian.finalize_column(reduced_column);
+   }
+   // reset the entries of the variables and the adjoints
+   for (size_t node_index: tape) {
+      if (node_index < this->number_variables) {
+         entries[node_index].clear();
+      }
+      adjoints[node_index] = 0.;
+   }
+}
+
+double NLModel::get_variable_lower_bound(size_t i) const {
+   return this->problem.variable_bounds[i].lb;
+}
+
+double NLModel::get_variable_upper_bound(size_t i) const {
+   return this->problem.variable_bounds[i].ub;
+}
+
+BoundType NLModel::get_variable_bound_type(size_t i) const {
+   return this->variable_status[i];
+}
+
+double NLModel::get_constraint_lower_bound(size_t j) const {
+   return this->problem.constraint_bounds[j].lb;
+}
+
+double NLModel::get_constraint_upper_bound(size_t j) const {
+   return this->problem.constraint_bounds[j].ub;
+}
+
+FunctionType NLModel::get_constraint_type(size_t j) const {
+   return this->constraint_type[j];
+}
+
+BoundType NLModel::get_constraint_bound_type(size_t j) const {
+   return this->constraint_status[j];
+}
+
+size_t NLModel::get_number_objective_gradient_nonzeros() const {
+   return this->number_objective_gradient_nonzeros;
+}
+
+size_t NLModel::get_number_jacobian_nonzeros() const {
+   return this->number_jacobian_nonzeros;
+}
+
+size_t NLModel::get_number_hessian_nonzeros() const {
+   return this->number_hessian_nonzeros;
+}
+
+void NLModel::get_initial_primal_point(std::vector<double>& x) const {
+   assert(x.size() >= this->number_variables);
+   std::copy(this->problem.initial_primals.cbegin(), this->problem.initial_primals.cend(), x.begin());
+}
+
+void NLModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   assert(multipliers.size() >= this->number_constraints);
+   std::copy(this->problem.initial_duals.cbegin(), this->problem.initial_duals.cend(), multipliers.begin());
+}
+
+void NLModel::postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const {
+   // do nothing
+}
+
+const std::vector<size_t>& NLModel::get_linear_constraints() const {
+   return this->linear_constraints;
+}
+
+bool NLModel::is_quadratic_program() const {
+   return this->quadratic_program;
+}
+
+bool NLModel::is_reentrant() const {
+   return true;
+}
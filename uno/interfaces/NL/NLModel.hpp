@@ -0,0 +1,100 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NLMODEL_H
+#define UNO_NLMODEL_H
+
+#include <vector>
+#include "NLReader.hpp"
+#include "optimization/Model.hpp"
+
+/*! \class NLModel
+ * \brief AMPL model read by the native .nl reader
+ *
+ *  The derivatives are computed by reverse mode on the expression graph (gradients, Jacobian) and by edge pushing
+ *  (Hessian of the Lagrangian). The model has no mutable state: it can be evaluated by several threads concurrently.
+ *  The workspace of the evaluations (values, adjoints and Hessian entries of the nodes) is allocated once per thread.
+ */
+class NLModel: public Model {
+public:
+   explicit NLModel(const std::string& file_name);
+   // problem read from a file or built in memory (e.g. by the ModelBuilder)
+   explicit NLModel(NLProblem&& problem);
+
+   // objective
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override;
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override;
+   // constraints
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_constraint_subset(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+         std::vector<double>& constraints) const override;
+   // Hessian
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+   // subset of the variables: only the objective terms that depend on the subset are evaluated
+   [[nodiscard]] double evaluate_objective_subset(const std::vector<double>& x, const std::vector<size_t>& variable_indices) const override;
+   void evaluate_objective_subset_gradient(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+         SparseVector<double>& gradient) const override;
+   void evaluate_lagrangian_subset_hessian(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+         const std::vector<size_t>& constraint_indices, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override;
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override;
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override;
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override;
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override;
+
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override;
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override;
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override;
+
+   void get_initial_primal_point(std::vector<double>& x) const override;
+   void get_initial_dual_point(std::vector<double>& multipliers) const override;
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
+   [[nodiscard]] bool is_reentrant() const override;
+
+private:
+   const NLProblem problem;
+   std::vector<BoundType> variable_status; /*!< Status of the variables (EQUALITY, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES) */
+   std::vector<FunctionType> constraint_type; /*!< Types of the constraints (LINEAR, NONLINEAR) */
+   std::vector<BoundType> constraint_status; /*!< Status of the constraints (EQUAL_BOUNDS, BOUNDED_LOWER, BOUNDED_UPPER, BOUNDED_BOTH_SIDES,
+ * UNBOUNDED) */
+   std::vector<size_t> linear_constraints{};
+   bool quadratic_program{false};
+
+   // tapes of the nonlinear parts
+   std::vector<size_t> objective_tape{};
+   std::vector<std::vector<size_t>> constraint_tapes{};
+   std::vector<size_t> constraints_tape{}; // union of the constraint tapes
+   std::vector<size_t> lagrangian_tape{}; // union of all the tapes
+   // terms of the objective (operands of the sums at its root), their tapes and the terms that depend on each variable
+   std::vector<size_t> objective_terms{};
+   std::vector<std::vector<size_t>> objective_term_tapes{};
+   std::vector<std::vector<size_t>> variable_objective_terms{};
+   std::vector<double> objective_linear_coefficients{};
+   // sparsity patterns: linear and nonlinear variables
+   std::vector<size_t> objective_gradient_sparsity{};
+   std::vector<std::vector<size_t>> jacobian_sparsity{};
+   std::vector<std::vector<size_t>> hessian_sparsity{}; // upper triangle: sorted row indices of each column
+
+   void generate_variables();
+   void generate_constraints();
+   void compute_sparsity_patterns();
+   // sorted union of the tapes of the objective terms that depend on the subset (and of the given constraints)
+   [[nodiscard]] std::vector<size_t> compute_subset_tape(const std::vector<size_t>& variable_indices, const std::vector<size_t>& constraint_indices,
+         std::vector<size_t>& terms) const;
+   // the values of the tape must be evaluated. The adjoints must be zero, and are reset to zero upon return
+   void compute_gradient(const std::vector<size_t>& tape, size_t root, const SparseVector<double>& linear_part, double scaling,
+         const std::vector<size_t>& sparsity, const std::vector<double>& values, std::vector<double>& adjoints,
+         SparseVector<double>& gradient) const;
+};
+
+#endif // UNO_NLMODEL_H
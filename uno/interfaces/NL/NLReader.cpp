@@ -0,0 +1,436 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "NLReader.hpp"
+#include "tools/Infinity.hpp"
+
+constexpr size_t UNDEFINED = std::numeric_limits<size_t>::max();
+
+// integers of a header line (the comment is ignored)
+std::vector<long> read_header_line(std::ifstream& file) {
+   std::string line;
+   if (not std::getline(file, line)) {
+      throw std::runtime_error("NLReader: the header is incomplete");
+   }
+   std::istringstream stream(line.substr(0, line.find('#')));
+   std::vector<long> values{};
+   long value;
+   while (stream >> value) {
+      values.push_back(value);
+   }
+   return values;
+}
+
+NLProblem NLReader::read(const std::string& file_name) {
+   std::ifstream file(file_name, std::ios::binary);
+   if (not file) {
+      throw std::runtime_error("NLReader: the file " + file_name + " could not be opened");
+   }
+   // the header (10 lines) is in text format
+   std::string first_line;
+   std::getline(file, first_line);
+   if (first_line.empty() || (first_line[0] != 'g' && first_line[0] != 'b')) {
+      throw std::runtime_error("NLReader: " + file_name + " is not an .nl file");
+   }
+   const bool is_binary = (first_line[0] == 'b');
+   const std::vector<long> dimensions = read_header_line(file);
+   if (dimensions.size() < 3) {
+      throw std::runtime_error("NLReader: the dimensions of " + file_name + " are missing");
+   }
+   if (5 < dimensions.size() && 0 < dimensions[5]) {
+      throw std::runtime_error("NLReader: the logical constraints are not supported");
+   }
+   for (size_t line = 0; line < 7; line++) {
+      (void) read_header_line(file);
+   }
+   // common expressions (defined variables): in constraints and objectives, in constraints only, in objectives only, ...
+   const std::vector<long> common_expressions = read_header_line(file);
+   size_t number_defined_variables = 0;
+   for (long number: common_expressions) {
+      number_defined_variables += static_cast<size_t>(number);
+   }
+
+   const size_t number_variables = static_cast<size_t>(dimensions[0]);
+   const size_t number_constraints = static_cast<size_t>(dimensions[1]);
+   NLProblem problem(number_variables);
+   problem.name = file_name;
+   problem.number_variables = number_variables;
+   problem.number_constraints = number_constraints;
+   problem.objective_root = problem.graph.add_constant(0.);
+   problem.constraint_roots.resize(number_constraints, problem.objective_root);
+   problem.constraint_linear_parts.resize(number_constraints);
+   problem.variable_bounds.resize(number_variables, {-INF<double>, INF<double>});
+   problem.constraint_bounds.resize(number_constraints, {-INF<double>, INF<double>});
+   problem.initial_primals.resize(number_variables, 0.);
+   problem.initial_duals.resize(number_constraints, 0.);
+
+   NLReader reader(std::move(file), is_binary, problem, number_defined_variables);
+   reader.read_segments();
+   return problem;
+}
+
+NLReader::NLReader(std::ifstream&& file, bool is_binary, NLProblem& problem, size_t number_defined_variables):
+      file(std::move(file)), is_binary(is_binary), problem(problem), defined_variable_nodes(number_defined_variables, UNDEFINED) {
+}
+
+void NLReader::read_segments() {
+   char letter;
+   while (this->read_letter(letter)) {
+      switch (letter) {
+         case 'C': {
+            const size_t constraint_index = this->read_index(this->problem.number_constraints);
+            this->skip_line();
+            this->problem.constraint_roots[constraint_index] = this->read_expression();
+            break;
+         }
+         case 'O': {
+            const int32_t objective_index = this->read_integer();
+            const int32_t sense = this->read_integer();
+            this->skip_line();
+            const size_t root = this->read_expression();
+            // only the first objective is kept
+            if (objective_index == 0) {
+               this->problem.objective_root = root;
+               this->problem.objective_sign = (sense == 1) ? -1. : 1.;
+            }
+            break;
+         }
+         case 'V': {
+            const int32_t index = this->read_integer();
+            const int32_t number_linear_terms = this->read_integer();
+            (void) this->read_integer();
+            this->skip_line();
+            const size_t defined_variable = static_cast<size_t>(index) - this->problem.number_variables;
+            if (index < 0 || this->defined_variable_nodes.size() <= defined_variable) {
+               throw std::runtime_error("NLReader: the defined variable " + std::to_string(index) + " is out of range");
+            }
+            SparseVector<double> linear_part(static_cast<size_t>(number_linear_terms));
+            this->read_linear_part(static_cast<size_t>(number_linear_terms), linear_part);
+            const size_t expression = this->read_expression();
+            if (linear_part.empty()) {
+               this->defined_variable_nodes[defined_variable] = expression;
+            }
+            else {
+               // linear terms + nonlinear expression
+               std::vector<size_t> terms{expression};
+               linear_part.for_each([&](size_t variable_index, double coefficient) {
+                  const size_t coefficient_node = this->problem.graph.add_constant(coefficient);
+                  terms.push_back(this->problem.graph.add_operation(Operator::MULTIPLY, {coefficient_node, variable_index}));
+               });
+               this->defined_variable_nodes[defined_variable] = this->problem.graph.add_operation(Operator::SUM, terms);
+            }
+            break;
+         }
+         case 'r':
+            this->skip_line();
+            this->read_bounds(this->problem.constraint_bounds);
+            break;
+         case 'b':
+            this->skip_line();
+            this->read_bounds(this->problem.variable_bounds);
+            break;
+         case 'x':
+            this->read_initial_point(this->problem.initial_primals);
+            break;
+         case 'd':
+            this->read_initial_point(this->problem.initial_duals);
+            break;
+         case 'k': {
+            // cumulative column counts of the Jacobian: redundant with the J segments
+            const int32_t number_columns = this->read_integer();
+            this->skip_line();
+            for (int32_t column = 0; column < number_columns; column++) {
+               (void) this->read_integer();
+               this->skip_line();
+            }
+            break;
+         }
+         case 'J': {
+            const size_t constraint_index = this->read_index(this->problem.number_constraints);
+            const int32_t number_terms = this->read_integer();
+            this->skip_line();
+            this->read_linear_part(static_cast<size_t>(number_terms), this->problem.constraint_linear_parts[constraint_index]);
+            break;
+         }
+         case 'G': {
+            const int32_t objective_index = this->read_integer();
+            const int32_t number_terms = this->read_integer();
+            this->skip_line();
+            SparseVector<double> discarded_linear_part{};
+            this->read_linear_part(static_cast<size_t>(number_terms), (objective_index == 0) ? this->problem.objective_linear_part :
+               discarded_linear_part);
+            break;
+         }
+         case 'S':
+            this->skip_suffix();
+            break;
+         case 'F':
+            throw std::runtime_error("NLReader: the imported functions are not supported");
+         case 'L':
+            throw std::runtime_error("NLReader: the logical constraints are not supported");
+         default:
+            throw std::runtime_error(std::string("NLReader: unknown segment ") + letter);
+      }
+   }
+}
+
+size_t NLReader::read_expression() {
+   const char letter = this->read_letter();
+   switch (letter) {
+      case 'n': {
+         const double value = this->read_double();
+         this->skip_line();
+         return this->problem.graph.add_constant(value);
+      }
+      case 's':
+      case 'l': {
+         // integer constants
+         double value;
+         if (this->is_binary) {
+            if (letter == 's') {
+               int16_t short_value;
+               this->file.read(reinterpret_cast<char*>(&short_value), sizeof(short_value));
+               value = short_value;
+            }
+            else {
+               value = this->read_integer();
+            }
+         }
+         else {
+            value = this->read_double();
+         }
+         this->skip_line();
+         return this->problem.graph.add_constant(value);
+      }
+      case 'v': {
+         const int32_t index = this->read_integer();
+         this->skip_line();
+         const size_t variable_index = static_cast<size_t>(index);
+         if (0 <= index && variable_index < this->problem.number_variables) {
+            return variable_index;
+         }
+         const size_t defined_variable = variable_index - this->problem.number_variables;
+         if (index < 0 || this->defined_variable_nodes.size() <= defined_variable || this->defined_variable_nodes[defined_variable] == UNDEFINED) {
+            throw std::runtime_error("NLReader: the variable " + std::to_string(index) + " is undefined");
+         }
+         return this->defined_variable_nodes[defined_variable];
+      }
+      case 'o':
+         break;
+      case 'f':
+         throw std::runtime_error("NLReader: the imported functions are not supported");
+      case 'h':
+         throw std::runtime_error("NLReader: the string expressions are not supported");
+      default:
+         throw std::runtime_error(std::string("NLReader: unknown expression ") + letter);
+   }
+
+   // operations (AMPL opcodes)
+   static const std::unordered_map<int32_t, Operator> unary_operators{
+      {13, Operator::FLOOR}, {14, Operator::CEIL}, {15, Operator::ABS}, {16, Operator::NEGATE}, {34, Operator::NOT},
+      {37, Operator::TANH}, {38, Operator::TAN}, {39, Operator::SQRT}, {40, Operator::SINH}, {41, Operator::SIN},
+      {42, Operator::LOG10}, {43, Operator::LOG}, {44, Operator::EXP}, {45, Operator::COSH}, {46, Operator::COS},
+      {47, Operator::ATANH}, {49, Operator::ATAN}, {50, Operator::ASINH}, {51, Operator::ASIN}, {52, Operator::ACOSH},
+      {53, Operator::ACOS}
+   };
+   static const std::unordered_map<int32_t, Operator> binary_operators{
+      {0, Operator::ADD}, {1, Operator::SUBTRACT}, {2, Operator::MULTIPLY}, {3, Operator::DIVIDE}, {4, Operator::REMAINDER},
+      {5, Operator::POWER}, {20, Operator::OR}, {21, Operator::AND}, {22, Operator::LESS_THAN}, {23, Operator::LESS_EQUAL},
+      {24, Operator::EQUAL}, {28, Operator::GREATER_EQUAL}, {29, Operator::GREATER_THAN}, {30, Operator::NOT_EQUAL},
+      {48, Operator::ATAN2}, {76, Operator::POWER}, {78, Operator::POWER}
+   };
+   static const std::unordered_map<int32_t, Operator> nary_operators{
+      {11, Operator::MIN}, {12, Operator::MAX}, {54, Operator::SUM}
+   };
+   const int32_t opcode = this->read_integer();
+   this->skip_line();
+   ExpressionGraph& graph = this->problem.graph;
+   if (const auto operator_it = unary_operators.find(opcode); operator_it != unary_operators.end()) {
+      const size_t operand = this->read_expression();
+      return graph.add_operation(operator_it->second, {operand});
+   }
+   else if (const auto operator_it = binary_operators.find(opcode); operator_it != binary_operators.end()) {
+      const size_t first_operand = this->read_expression();
+      const size_t second_operand = this->read_expression();
+      if (operator_it->second == Operator::POWER) {
+         // powers with a constant exponent or a constant base have cheaper derivatives
+         if (graph.is_constant(second_operand)) {
+            return graph.add_operation(Operator::POWER_CONSTANT_EXPONENT, {first_operand}, graph.get_node(second_operand).value);
+         }
+         else if (graph.is_constant(first_operand)) {
+            return graph.add_operation(Operator::CONSTANT_POWER, {second_operand}, graph.get_node(first_operand).value);
+         }
+      }
+      return graph.add_operation(operator_it->second, {first_operand, second_operand});
+   }
+   else if (const auto operator_it = nary_operators.find(opcode); operator_it != nary_operators.end()) {
+      const int32_t number_operands = this->read_integer();
+      this->skip_line();
+      std::vector<size_t> operands(static_cast<size_t>(number_operands));
+      for (size_t& operand: operands) {
+         operand = this->read_expression();
+      }
+      return graph.add_operation(operator_it->second, operands);
+   }
+   else if (opcode == 35) { // if-then-else
+      const size_t condition = this->read_expression();
+      const size_t then_expression = this->read_expression();
+      const size_t else_expression = this->read_expression();
+      return graph.add_operation(Operator::IF, {condition, then_expression, else_expression});
+   }
+   else if (opcode == 77) { // square
+      const size_t operand = this->read_expression();
+      return graph.add_operation(Operator::POWER_CONSTANT_EXPONENT, {operand}, 2.);
+   }
+   throw std::runtime_error("NLReader: the operator " + std::to_string(opcode) + " is not supported");
+}
+
+void NLReader::read_linear_part(size_t number_terms, SparseVector<double>& linear_part) {
+   for (size_t term = 0; term < number_terms; term++) {
+      const size_t variable_index = this->read_index(this->problem.number_variables);
+      const double coefficient = this->read_double();
+      this->skip_line();
+      linear_part.insert(variable_index, coefficient);
+   }
+}
+
+void NLReader::read_bounds(std::vector<Interval>& bounds) {
+   for (Interval& interval: bounds) {
+      // the type is a digit, in both formats
+      const int type = this->read_letter() - '0';
+      switch (type) {
+         case 0: // range
+            interval.lb = this->read_double();
+            interval.ub = this->read_double();
+            break;
+         case 1: // upper bound
+            interval.ub = this->read_double();
+            break;
+         case 2: // lower bound
+            interval.lb = this->read_double();
+            break;
+         case 3: // free
+            break;
+         case 4: // equality
+            interval.lb = interval.ub = this->read_double();
+            break;
+         case 5:
+            throw std::runtime_error("NLReader: the complementarity constraints are not supported");
+         default:
+            throw std::runtime_error("NLReader: unknown bound type " + std::to_string(type));
+      }
+      this->skip_line();
+   }
+}
+
+void NLReader::read_initial_point(std::vector<double>& point) {
+   const int32_t number_values = this->read_integer();
+   this->skip_line();
+   for (int32_t value = 0; value < number_values; value++) {
+      const size_t index = this->read_index(point.size());
+      point[index] = this->read_double();
+      this->skip_line();
+   }
+}
+
+void NLReader::skip_suffix() {
+   const int32_t kind = this->read_integer();
+   const int32_t number_values = this->read_integer();
+   // name
+   if (this->is_binary) {
+      const int32_t length = this->read_integer();
+      this->file.ignore(length);
+   }
+   else {
+      std::string name;
+      this->file >> name;
+   }
+   this->skip_line();
+   // the fourth bit of the kind indicates real values
+   const bool real_values = (kind & 4) != 0;
+   for (int32_t value = 0; value < number_values; value++) {
+      (void) this->read_integer();
+      if (real_values) {
+         (void) this->read_double();
+      }
+      else {
+         (void) this->read_integer();
+      }
+      this->skip_line();
+   }
+}
+
+bool NLReader::read_letter(char& letter) {
+   if (not this->is_binary) {
+      this->file >> std::ws;
+   }
+   const int character = this->file.get();
+   if (character == std::char_traits<char>::eof()) {
+      return false;
+   }
+   letter = static_cast<char>(character);
+   return true;
+}
+
+char NLReader::read_letter() {
+   char letter;
+   if (not this->read_letter(letter)) {
+      throw std::runtime_error("NLReader: unexpected end of file");
+   }
+   return letter;
+}
+
+int32_t NLReader::read_integer() {
+   int32_t value;
+   if (this->is_binary) {
+      this->file.read(reinterpret_cast<char*>(&value), sizeof(value));
+   }
+   else {
+      this->file >> value;
+   }
+   if (not this->file) {
+      throw std::runtime_error("NLReader: an integer could not be read");
+   }
+   return value;
+}
+
+size_t NLReader::read_index(size_t size) {
+   const int32_t index = this->read_integer();
+   if (index < 0 || size <= static_cast<size_t>(index)) {
+      throw std::runtime_error("NLReader: the index " + std::to_string(index) + " is out of range");
+   }
+   return static_cast<size_t>(index);
+}
+
+double NLReader::read_double() {
+   double value;
+   if (this->is_binary) {
+      this->file.read(reinterpret_cast<char*>(&value), sizeof(value));
+   }
+   else {
+      // strtod also parses the infinite values
+      std::string token;
+      this->file >> token;
+      char* end;
+      value = std::strtod(token.c_str(), &end);
+      if (token.empty() || *end != '\0') {
+         throw std::runtime_error("NLReader: " + token + " is not a number");
+      }
+   }
+   if (not this->file) {
+      throw std::runtime_error("NLReader: a number could not be read");
+   }
+   return value;
+}
+
+// the text format has one record per line, followed by an optional comment
+void NLReader::skip_line() {
+   if (not this->is_binary) {
+      this->file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+   }
+}
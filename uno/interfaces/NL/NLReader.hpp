@@ -0,0 +1,68 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NLREADER_H
+#define UNO_NLREADER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ExpressionGraph.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "optimization/Model.hpp"
+
+// functions of an .nl file: nonlinear part (root of the expression graph) + linear part
+struct NLProblem {
+   explicit NLProblem(size_t number_variables): graph(number_variables) { }
+
+   std::string name;
+   size_t number_variables{0};
+   size_t number_constraints{0};
+   double objective_sign{1.};
+   ExpressionGraph graph;
+   size_t objective_root{0};
+   SparseVector<double> objective_linear_part{};
+   std::vector<size_t> constraint_roots{};
+   std::vector<SparseVector<double>> constraint_linear_parts{};
+   std::vector<Interval> variable_bounds{};
+   std::vector<Interval> constraint_bounds{};
+   std::vector<double> initial_primals{};
+   std::vector<double> initial_duals{};
+};
+
+/*! \class NLReader
+ * \brief Reader of the AMPL .nl files (text and binary formats), independent of the ASL
+ *
+ *  The nonlinear expressions are stored in an ExpressionGraph. Only the first objective is kept. The imported functions,
+ *  the logical constraints and the complementarity constraints are not supported. The suffixes are ignored.
+ */
+class NLReader {
+public:
+   [[nodiscard]] static NLProblem read(const std::string& file_name);
+
+private:
+   std::ifstream file;
+   const bool is_binary;
+   NLProblem& problem;
+   std::vector<size_t> defined_variable_nodes{};
+
+   NLReader(std::ifstream&& file, bool is_binary, NLProblem& problem, size_t number_defined_variables);
+
+   void read_segments();
+   [[nodiscard]] size_t read_expression();
+   void read_linear_part(size_t number_terms, SparseVector<double>& linear_part);
+   void read_bounds(std::vector<Interval>& bounds);
+   void read_initial_point(std::vector<double>& point);
+   void skip_suffix();
+
+   // tokens
+   [[nodiscard]] bool read_letter(char& letter);
+   [[nodiscard]] char read_letter();
+   [[nodiscard]] int32_t read_integer();
+   [[nodiscard]] size_t read_index(size_t size);
+   [[nodiscard]] double read_double();
+   void skip_line();
+};
+
+#endif // UNO_NLREADER_H
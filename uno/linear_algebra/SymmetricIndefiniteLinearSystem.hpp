@@ -4,6 +4,7 @@
 #ifndef UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 #define UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 
+#include <fstream>
 #include <memory>
 #include "SymmetricMatrix.hpp"
 #include "SymmetricMatrixFactory.hpp"
@@ -11,6 +12,7 @@
 #include "optimization/Model.hpp"
 #include "solvers/linear/SymmetricIndefiniteLinearSolver.hpp"
 #include "tools/Options.hpp"
+#include "tools/Profiler.hpp"
 #include "tools/Statistics.hpp"
 
 struct UnstableRegularization : public std::exception {
@@ -31,6 +33,8 @@ public:
          const Options& options);
    void assemble_matrix(const SymmetricMatrix<double>& hessian, const RectangularMatrix<double>& constraint_jacobian,
          size_t number_variables, size_t number_constraints);
+   void assemble_condensed_matrix(const SymmetricMatrix<double>& hessian, const RectangularMatrix<double>& constraint_jacobian,
+         size_t number_variables, size_t number_constraints, const std::vector<T>& dual_diagonal);
    void factorize_matrix(const Model& model, SymmetricIndefiniteLinearSolver<T>& linear_solver);
    void regularize_matrix(Statistics& statistics, const Model& model, SymmetricIndefiniteLinearSolver<T>& linear_solver, size_t size_primal_block,
          size_t size_dual_block, T dual_regularization_parameter);
@@ -39,6 +43,7 @@ public:
 
 protected:
    size_t number_factorizations{0};
+   size_t sparsity_pattern_hash{0};
    T primal_regularization{0.};
    T dual_regularization{0.};
    T previous_primal_regularization{0.};
@@ -50,6 +55,7 @@ protected:
    const T primal_regularization_fast_increase_factor;
    const T primal_regularization_slow_increase_factor;
    const size_t threshold_unsuccessful_attempts;
+   const std::string dump_file_prefix;
 };
 
 template <typename T>
@@ -65,7 +71,8 @@ SymmetricIndefiniteLinearSystem<T>::SymmetricIndefiniteLinearSystem(const std::s
       primal_regularization_decrease_factor(T(options.get_double("primal_regularization_decrease_factor"))),
       primal_regularization_fast_increase_factor(T(options.get_double("primal_regularization_fast_increase_factor"))),
       primal_regularization_slow_increase_factor(T(options.get_double("primal_regularization_slow_increase_factor"))),
-      threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")) {
+      threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")),
+      dump_file_prefix(options.get_string("augmented_system_dump_prefix")) {
 }
 
 template <typename T>
@@ -93,13 +100,54 @@ void SymmetricIndefiniteLinearSystem<T>::assemble_matrix(const SymmetricMatrix<d
    }
 }
 
+// augmented matrix in which the variables with indices >= number_variables were eliminated: their Hessian and Jacobian
+// terms are discarded and their contribution to the dual block is given by dual_diagonal
+template <typename T>
+void SymmetricIndefiniteLinearSystem<T>::assemble_condensed_matrix(const SymmetricMatrix<double>& hessian,
+      const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints, const std::vector<T>& dual_diagonal) {
+   this->matrix->dimension = number_variables + number_constraints;
+   this->matrix->reset();
+   // copy the Lagrangian Hessian of the remaining variables in the top left block
+   size_t current_column = 0;
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      if (i < number_variables && j < number_variables) {
+         // finalize all empty columns
+         for (size_t column: Range(current_column, j)) {
+            this->matrix->finalize_column(column);
+            current_column++;
+         }
+         this->matrix->insert(entry, i, j);
+      }
+   });
+
+   // Jacobian of general constraints and diagonal of the dual block
+   for (size_t j: Range(number_constraints)) {
+      constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+         if (i < number_variables) {
+            this->matrix->insert(derivative, i, number_variables + j);
+         }
+      });
+      this->matrix->insert(dual_diagonal[j], number_variables + j, number_variables + j);
+      this->matrix->finalize_column(j);
+   }
+}
+
 template <typename T>
 void SymmetricIndefiniteLinearSystem<T>::factorize_matrix(const Model& model, SymmetricIndefiniteLinearSolver<T>& linear_solver) {
-   // compute the symbolic factorization only when:
-   // the problem has a non-constant augmented system (ie is not an LP or a QP) or it is the first factorization
-   if (true || this->number_factorizations == 0 || not model.fixed_hessian_sparsity) {
+   // compute the symbolic factorization only when the sparsity pattern of the augmented system changed
+   // (the regularization terms are preallocated, so the pattern does not change when regularizing)
+   const size_t pattern_hash = this->matrix->compute_sparsity_pattern_hash();
+   if (this->number_factorizations == 0 || not model.fixed_hessian_sparsity || pattern_hash != this->sparsity_pattern_hash) {
+      PROFILE_SCOPE("symbolic factorization");
       linear_solver.do_symbolic_factorization(*this->matrix);
+      this->sparsity_pattern_hash = pattern_hash;
+   }
+   // write the matrix in the Matrix Market format (e.g. to benchmark the linear solvers)
+   if (this->dump_file_prefix != "none") {
+      std::ofstream file(this->dump_file_prefix + "_" + std::to_string(this->number_factorizations) + ".mtx");
+      this->matrix->write_matrix_market(file);
    }
+   PROFILE_SCOPE("numerical factorization");
    linear_solver.do_numerical_factorization(*this->matrix);
    this->number_factorizations++;
 }
@@ -145,6 +193,8 @@ void SymmetricIndefiniteLinearSystem<T>::regularize_matrix(Statistics& statistic
    while (not good_inertia) {
       DEBUG << "Testing factorization with regularization factors (" << this->primal_regularization << ", " << this->dual_regularization << ")\n";
       DEBUG2 << *this->matrix << '\n';
+      TRACE_COUNTER("primal regularization", this->primal_regularization);
+      TRACE_COUNTER("dual regularization", this->dual_regularization);
       this->factorize_matrix(model, linear_solver);
       number_attempts++;
 
@@ -181,6 +231,7 @@ void SymmetricIndefiniteLinearSystem<T>::regularize_matrix(Statistics& statistic
 
 template <typename T>
 void SymmetricIndefiniteLinearSystem<T>::solve(SymmetricIndefiniteLinearSolver<T>& linear_solver) {
+   PROFILE_SCOPE("triangular solve");
    linear_solver.solve_indefinite_system(*this->matrix, this->rhs, this->solution);
 }
 
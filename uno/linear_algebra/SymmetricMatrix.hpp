@@ -23,6 +23,7 @@ public:
    virtual void reset();
 
    T quadratic_product(const std::vector<T>& x, const std::vector<T>& y) const;
+   [[nodiscard]] size_t compute_sparsity_pattern_hash() const;
 
    virtual void for_each(const std::function<void (size_t, size_t, T)>& f) const = 0;
    // build the matrix incrementally
@@ -34,6 +35,7 @@ public:
    [[nodiscard]] const T* data_raw_pointer() const;
 
    virtual void print(std::ostream& stream) const = 0;
+   void write_matrix_market(std::ostream& stream) const;
    template <typename U>
    friend std::ostream& operator<<(std::ostream& stream, const SymmetricMatrix<U>& matrix);
 
@@ -71,11 +73,40 @@ T SymmetricMatrix<T>::quadratic_product(const std::vector<T>& x, const std::vect
    return result;
 }
 
+// hash of the dimension and of the positions of the nonzeros (the values are ignored)
+template <typename T>
+size_t SymmetricMatrix<T>::compute_sparsity_pattern_hash() const {
+   size_t hash = std::hash<size_t>{}(this->dimension);
+   const auto combine = [&](size_t value) {
+      hash ^= std::hash<size_t>{}(value) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+   };
+   this->for_each([&](size_t i, size_t j, T /*entry*/) {
+      combine(i);
+      combine(j);
+   });
+   return hash;
+}
+
 template <typename T>
 const T* SymmetricMatrix<T>::data_raw_pointer() const {
    return this->entries.data();
 }
 
+// coordinate format, upper triangle stored as lower triangle (1-based indices), duplicates are kept
+template <typename T>
+void SymmetricMatrix<T>::write_matrix_market(std::ostream& stream) const {
+   size_t number_entries = 0;
+   this->for_each([&](size_t /*i*/, size_t /*j*/, T /*entry*/) {
+      number_entries++;
+   });
+   stream << "%%MatrixMarket matrix coordinate real symmetric\n";
+   stream << this->dimension << ' ' << this->dimension << ' ' << number_entries << '\n';
+   stream.precision(17);
+   this->for_each([&](size_t i, size_t j, T entry) {
+      stream << std::max(i, j) + 1 << ' ' << std::min(i, j) + 1 << ' ' << entry << '\n';
+   });
+}
+
 template <typename T>
 std::ostream& operator<<(std::ostream& stream, const SymmetricMatrix<T>& matrix) {
    stream << "Dimension: " << matrix.dimension << ", number of nonzeros: " << matrix.number_nonzeros << '\n';
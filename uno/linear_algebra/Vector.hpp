@@ -9,6 +9,9 @@
 #include <vector>
 #include <functional>
 #include <cmath>
+#include <type_traits>
+#include "VectorKernels.hpp"
+#include "view.hpp"
 #include "tools/Logger.hpp"
 #include "tools/Range.hpp"
 
@@ -27,14 +30,23 @@ inline Norm norm_from_string(const std::string& norm_string) {
    throw std::invalid_argument("The norm " + norm_string + " is not known");
 }
 
+// contiguous arrays of doubles are processed by the vectorized kernels
+template <typename ARRAY>
+constexpr bool is_contiguous_double_array = std::is_same_v<ARRAY, std::vector<double>> || std::is_same_v<ARRAY, view<double>>;
+
 // result <- x + scaling_factor * y
 template <typename T>
 void add_vectors(const std::vector<T>& x, const std::vector<T>& y, T scaling_factor, std::vector<T>& result) {
    assert(x.size() <= y.size() && "Vector.add_vectors: x is longer than y");
    assert(x.size() <= result.size() && "Vector.add_vectors: result is not long enough");
 
-   for (size_t i: Range(x.size())) {
-      result[i] = x[i] + scaling_factor * y[i];
+   if constexpr (std::is_same_v<T, double>) {
+      VectorKernels::add_vectors(x.data(), y.data(), scaling_factor, result.data(), x.size());
+   }
+   else {
+      for (size_t i: Range(x.size())) {
+         result[i] = x[i] + scaling_factor * y[i];
+      }
    }
 }
 
@@ -45,27 +57,31 @@ void initialize_vector(std::vector<T>& x, T value) {
    }
 }
 
-/*
 template <typename T>
 void scale(std::vector<T>& x, T scaling_factor) {
-   for (T& xi: x) {
-      xi *= scaling_factor;
+   if constexpr (std::is_same_v<T, double>) {
+      VectorKernels::scale(x.data(), scaling_factor, x.size());
+   }
+   else {
+      for (T& xi: x) {
+         xi *= scaling_factor;
+      }
    }
 }
-*/
 
-/*
 template <typename T>
 T dot(const std::vector<T>& x, const std::vector<T>& y) {
    assert(x.size() == y.size() && "The vectors do not have the same size.");
 
+   if constexpr (std::is_same_v<T, double>) {
+      return VectorKernels::dot(x.data(), y.data(), x.size());
+   }
    T dot_product = 0.;
-   for (size_t i: range(x.size())) {
+   for (size_t i: Range(x.size())) {
       dot_product += x[i]*y[i];
    }
    return dot_product;
 }
-*/
 
 template <typename T>
 void copy_from(std::vector<T>& destination, const std::vector<T>& source, size_t length = std::numeric_limits<size_t>::max()) {
@@ -81,6 +97,9 @@ void copy_from(std::vector<T>& destination, const std::vector<T>& source, size_t
 // compute l1 norm = sum |x|_i
 template <typename ARRAY, typename T = typename ARRAY::value_type>
 T norm_1(const ARRAY& x) {
+   if constexpr (is_contiguous_double_array<ARRAY>) {
+      return VectorKernels::norm_1(x.data(), x.size());
+   }
    T norm{0};
    for (size_t i = 0; i < x.size(); i++) {
       norm += std::abs(x[i]);
@@ -90,13 +109,16 @@ T norm_1(const ARRAY& x) {
 
 // l1 norm of several arrays
 template<typename ARRAY, typename... ARRAYS, typename T = typename ARRAY::value_type>
-T norm_1(const ARRAY& x, ARRAYS... other_arrays) {
+T norm_1(const ARRAY& x, const ARRAYS&... other_arrays) {
    return norm_1(x) + norm_1(other_arrays...);
 }
 
 // compute l2 squared norm = sum x_i^2
 template <typename ARRAY, typename T = typename ARRAY::value_type>
 T norm_2_squared(const ARRAY& x) {
+   if constexpr (is_contiguous_double_array<ARRAY>) {
+      return VectorKernels::norm_2_squared(x.data(), x.size());
+   }
    T norm_squared{0};
    for (size_t i = 0; i < x.size(); i++) {
       const T xi = x[i];
@@ -107,7 +129,7 @@ T norm_2_squared(const ARRAY& x) {
 
 // l2 squared norm of several arrays
 template<typename ARRAY, typename... ARRAYS, typename T = typename ARRAY::value_type>
-T norm_2_squared(const ARRAY& x, ARRAYS... other_arrays) {
+T norm_2_squared(const ARRAY& x, const ARRAYS&... other_arrays) {
    return norm_2_squared(x) + norm_2_squared(other_arrays...);
 }
 
@@ -119,24 +141,33 @@ T norm_2(const ARRAY& x) {
 
 // l2 norm of several arrays
 template<typename ARRAY, typename... ARRAYS, typename T = typename ARRAY::value_type>
-T norm_2(const ARRAY& x, ARRAYS... other_arrays) {
+T norm_2(const ARRAY& x, const ARRAYS&... other_arrays) {
    return std::sqrt(norm_2_squared(x) + norm_2_squared(other_arrays...));
 }
 
-// compute ||x||_inf
+// compute ||x||_inf (NaN if an entry is NaN, like the vectorized kernels)
 template <typename ARRAY, typename T = typename ARRAY::value_type>
 T norm_inf(const ARRAY& x) {
+   if constexpr (is_contiguous_double_array<ARRAY>) {
+      return VectorKernels::norm_inf(x.data(), x.size());
+   }
    T norm{0};
    for (size_t i = 0; i < x.size(); i++) {
-      norm = std::max(norm, std::abs(x[i]));
+      const T absolute_value = std::abs(x[i]);
+      if (std::isnan(absolute_value)) {
+         return absolute_value;
+      }
+      norm = std::max(norm, absolute_value);
    }
    return norm;
 }
 
 // inf norm of several arrays
 template<typename ARRAY, typename... ARRAYS, typename T = typename ARRAY::value_type>
-T norm_inf(const ARRAY& x, ARRAYS... other_arrays) {
-   return std::max(norm_inf(x), norm_inf(other_arrays...));
+T norm_inf(const ARRAY& x, const ARRAYS&... other_arrays) {
+   const T first_norm = norm_inf(x);
+   // std::max returns its first argument if one of them is NaN
+   return std::isnan(first_norm) ? first_norm : std::max(norm_inf(other_arrays...), first_norm);
 }
 
 // inf norm where the indices live in a given set
@@ -144,14 +175,18 @@ template <typename T, typename ARRAY>
 T norm_inf(const std::vector<T>& x, const ARRAY& indices) {
    T norm = T(0);
    for (size_t i: indices) {
-      norm = std::max(norm, std::abs(x[i]));
+      const T absolute_value = std::abs(x[i]);
+      if (std::isnan(absolute_value)) {
+         return absolute_value;
+      }
+      norm = std::max(norm, absolute_value);
    }
    return norm;
 }
 
 // norm of at least one array
 template<typename ARRAY, typename... ARRAYS, typename T = typename ARRAY::value_type>
-T norm(Norm norm, const ARRAY& x, ARRAYS... other_arrays) {
+T norm(Norm norm, const ARRAY& x, const ARRAYS&... other_arrays) {
    // choose the right norm
    if (norm == Norm::L1) {
       return norm_1(x, other_arrays...);
@@ -4,35 +4,143 @@
 #ifndef UNO_VECTOREXPRESSION_H
 #define UNO_VECTOREXPRESSION_H
 
-#include <functional>
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
 
-template <typename T>
-class VectorExpression {
-public:
+// Lazy vector expressions: the nodes are statically typed, therefore an expression is evaluated component-wise
+// in a single fused loop (e.g. by the norm functions) in which every access is inlined.
+// The operands are arrays (std::vector, view) held by reference or expressions held by value. The indices of a subset
+// are held by reference if they are a std::vector, by value otherwise.
+
+// base of all the expression nodes
+struct BaseExpression {
    // compatible with algorithms that query the type of the elements
-   using value_type = T;
+   using value_type = double;
+};
+
+template <typename E>
+constexpr bool is_expression = std::is_base_of_v<BaseExpression, std::decay_t<E>>;
+
+// expressions are stored by value (they are lightweight), arrays by reference
+template <typename E>
+using ExpressionOperand = std::conditional_t<is_expression<E>, const std::decay_t<E>, const std::decay_t<E>&>;
 
-   VectorExpression(size_t size, const std::function<T(size_t)>& ith_component);
-   [[nodiscard]] size_t size() const;
-   [[nodiscard]] T operator[](size_t i) const;
+// the indices of a subset: owning containers (std::vector) are stored by reference, the small index views (e.g. view)
+// by value, since they are often temporaries
+template <typename Indices>
+struct is_owning_container: std::false_type {};
+
+template <typename T, typename Allocator>
+struct is_owning_container<std::vector<T, Allocator>>: std::true_type {};
+
+template <typename Indices>
+using IndicesOperand = std::conditional_t<is_owning_container<std::decay_t<Indices>>::value, const std::decay_t<Indices>&,
+      const std::decay_t<Indices>>;
+
+// leaf: the i-th component is computed by a callable
+template <typename Callable>
+class VectorExpression: public BaseExpression {
+public:
+   VectorExpression(size_t size, Callable ith_component): length(size), ith_component(std::move(ith_component)) { }
+   [[nodiscard]] size_t size() const { return this->length; }
+   [[nodiscard]] double operator[](size_t i) const { return this->ith_component(i); }
 
 protected:
    const size_t length;
-   const std::function<T (size_t)> ith_component;
+   const Callable ith_component;
+};
+
+// component-wise operation on one operand
+template <typename E, typename Operation>
+class UnaryExpression: public BaseExpression {
+public:
+   UnaryExpression(const E& operand, Operation operation): operand(operand), operation(std::move(operation)) { }
+   [[nodiscard]] size_t size() const { return this->operand.size(); }
+   [[nodiscard]] double operator[](size_t i) const { return this->operation(this->operand[i]); }
+
+protected:
+   ExpressionOperand<E> operand;
+   const Operation operation;
+};
+
+// component-wise operation on two operands of the same size
+template <typename E1, typename E2, typename Operation>
+class BinaryExpression: public BaseExpression {
+public:
+   BinaryExpression(const E1& operand1, const E2& operand2, Operation operation): operand1(operand1), operand2(operand2),
+         operation(std::move(operation)) {
+      assert(operand1.size() == operand2.size() && "BinaryExpression: the operands do not have the same size");
+   }
+   [[nodiscard]] size_t size() const { return this->operand1.size(); }
+   [[nodiscard]] double operator[](size_t i) const { return this->operation(this->operand1[i], this->operand2[i]); }
+
+protected:
+   ExpressionOperand<E1> operand1;
+   ExpressionOperand<E2> operand2;
+   const Operation operation;
 };
 
-template <typename T>
-VectorExpression<T>::VectorExpression(size_t size, const std::function<T(size_t)>& ith_component): length(size), ith_component(ith_component) {
+// subset of the components of an operand: k-th component is operand[indices[k]]
+template <typename E, typename Indices>
+class SubsetExpression: public BaseExpression {
+public:
+   SubsetExpression(const E& operand, const Indices& indices): operand(operand), indices(indices) { }
+   [[nodiscard]] size_t size() const { return this->indices.size(); }
+   [[nodiscard]] double operator[](size_t k) const { return this->operand[this->indices[k]]; }
+
+protected:
+   ExpressionOperand<E> operand;
+   IndicesOperand<Indices> indices;
+};
+
+// operations
+
+// at least one of the operands is an expression (leaves the operators of the standard library untouched)
+template <typename E1, typename E2>
+using EnableIfExpression = std::enable_if_t<is_expression<E1> || is_expression<E2>, bool>;
+
+template <typename E1, typename E2, EnableIfExpression<E1, E2> = true>
+auto operator+(const E1& operand1, const E2& operand2) {
+   return BinaryExpression(operand1, operand2, [](double x, double y) { return x + y; });
+}
+
+template <typename E1, typename E2, EnableIfExpression<E1, E2> = true>
+auto operator-(const E1& operand1, const E2& operand2) {
+   return BinaryExpression(operand1, operand2, [](double x, double y) { return x - y; });
+}
+
+template <typename E, EnableIfExpression<E, E> = true>
+auto operator*(double scaling_factor, const E& operand) {
+   return UnaryExpression(operand, [=](double x) { return scaling_factor * x; });
+}
+
+// scaling of an array
+template <typename E>
+auto scale(double scaling_factor, const E& operand) {
+   return UnaryExpression(operand, [=](double x) { return scaling_factor * x; });
+}
+
+template <typename E1, typename E2>
+auto componentwise_min(const E1& operand1, const E2& operand2) {
+   return BinaryExpression(operand1, operand2, [](double x, double y) { return std::min(x, y); });
+}
+
+template <typename E1, typename E2>
+auto componentwise_max(const E1& operand1, const E2& operand2) {
+   return BinaryExpression(operand1, operand2, [](double x, double y) { return std::max(x, y); });
 }
 
-template <typename T>
-size_t VectorExpression<T>::size() const {
-   return this->length;
+// projection onto the interval [lower_bound, upper_bound]
+template <typename E>
+auto project(const E& operand, double lower_bound, double upper_bound) {
+   return UnaryExpression(operand, [=](double x) { return std::min(std::max(x, lower_bound), upper_bound); });
 }
 
-template <typename T>
-T VectorExpression<T>::operator[](size_t i) const {
-   return this->ith_component(i);
+template <typename E, typename Indices>
+auto subset(const E& operand, const Indices& indices) {
+   return SubsetExpression<E, Indices>(operand, indices);
 }
 
-#endif // UNO_VECTOREXPRESSION_H
\ No newline at end of file
+#endif // UNO_VECTOREXPRESSION_H
@@ -0,0 +1,338 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "VectorKernels.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define UNO_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+enum class InstructionSet {SCALAR, AVX2, AVX512};
+
+// detected once
+static InstructionSet detect_instruction_set() {
+#ifdef UNO_X86_KERNELS
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512f")) {
+      return InstructionSet::AVX512;
+   }
+   if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return InstructionSet::AVX2;
+   }
+#endif
+   return InstructionSet::SCALAR;
+}
+
+static const InstructionSet selected_instruction_set = detect_instruction_set();
+
+// scalar kernels (also used for the remainders of the vectorized loops)
+
+static double norm_1_scalar(const double* x, size_t length) {
+   double norm = 0.;
+   for (size_t i = 0; i < length; i++) {
+      norm += std::abs(x[i]);
+   }
+   return norm;
+}
+
+static double norm_2_squared_scalar(const double* x, size_t length) {
+   double norm_squared = 0.;
+   for (size_t i = 0; i < length; i++) {
+      norm_squared += x[i] * x[i];
+   }
+   return norm_squared;
+}
+
+// the inf norm is NaN if an entry is NaN, whatever the instruction set
+static double norm_inf_scalar(const double* x, size_t length) {
+   double norm = 0.;
+   for (size_t i = 0; i < length; i++) {
+      const double absolute_value = std::abs(x[i]);
+      if (std::isnan(absolute_value)) {
+         return absolute_value;
+      }
+      norm = std::max(norm, absolute_value);
+   }
+   return norm;
+}
+
+
+static double dot_scalar(const double* x, const double* y, size_t length) {
+   double dot_product = 0.;
+   for (size_t i = 0; i < length; i++) {
+      dot_product += x[i] * y[i];
+   }
+   return dot_product;
+}
+
+static void add_vectors_scalar(const double* x, const double* y, double scaling_factor, double* result, size_t length) {
+   for (size_t i = 0; i < length; i++) {
+      result[i] = x[i] + scaling_factor * y[i];
+   }
+}
+
+static void scale_scalar(double* x, double scaling_factor, size_t length) {
+   for (size_t i = 0; i < length; i++) {
+      x[i] *= scaling_factor;
+   }
+}
+
+#ifdef UNO_X86_KERNELS
+// combination of the vectorized part and of the remainder. std::max returns its first argument if one of them is NaN
+static double norm_inf_combine(bool has_nan, double vectorized_norm, double remainder_norm) {
+   return has_nan ? std::numeric_limits<double>::quiet_NaN() : std::max(remainder_norm, vectorized_norm);
+}
+
+// AVX2 kernels: 4 doubles per register, two accumulators to hide the latency of the additions
+
+__attribute__((target("avx2,fma")))
+static double horizontal_sum_avx2(__m256d x) {
+   const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+   return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+__attribute__((target("avx2,fma")))
+static double horizontal_max_avx2(__m256d x) {
+   const __m128d maximum = _mm_max_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+   return _mm_cvtsd_f64(_mm_max_sd(maximum, _mm_unpackhi_pd(maximum, maximum)));
+}
+
+__attribute__((target("avx2,fma")))
+static double norm_1_avx2(const double* x, size_t length) {
+   const __m256d sign_mask = _mm256_set1_pd(-0.);
+   __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+   size_t i = 0;
+   for (; i + 8 <= length; i += 8) {
+      sum0 = _mm256_add_pd(sum0, _mm256_andnot_pd(sign_mask, _mm256_loadu_pd(x + i)));
+      sum1 = _mm256_add_pd(sum1, _mm256_andnot_pd(sign_mask, _mm256_loadu_pd(x + i + 4)));
+   }
+   return horizontal_sum_avx2(_mm256_add_pd(sum0, sum1)) + norm_1_scalar(x + i, length - i);
+}
+
+__attribute__((target("avx2,fma")))
+static double norm_2_squared_avx2(const double* x, size_t length) {
+   __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+   size_t i = 0;
+   for (; i + 8 <= length; i += 8) {
+      const __m256d x0 = _mm256_loadu_pd(x + i);
+      const __m256d x1 = _mm256_loadu_pd(x + i + 4);
+      sum0 = _mm256_fmadd_pd(x0, x0, sum0);
+      sum1 = _mm256_fmadd_pd(x1, x1, sum1);
+   }
+   return horizontal_sum_avx2(_mm256_add_pd(sum0, sum1)) + norm_2_squared_scalar(x + i, length - i);
+}
+
+__attribute__((target("avx2,fma")))
+static double norm_inf_avx2(const double* x, size_t length) {
+   const __m256d sign_mask = _mm256_set1_pd(-0.);
+   // _mm256_max_pd does not propagate the NaNs: they are detected by unordered comparisons
+   __m256d max0 = _mm256_setzero_pd(), max1 = _mm256_setzero_pd(), nan_mask = _mm256_setzero_pd();
+   size_t i = 0;
+   for (; i + 8 <= length; i += 8) {
+      const __m256d x0 = _mm256_loadu_pd(x + i);
+      const __m256d x1 = _mm256_loadu_pd(x + i + 4);
+      max0 = _mm256_max_pd(max0, _mm256_andnot_pd(sign_mask, x0));
+      max1 = _mm256_max_pd(max1, _mm256_andnot_pd(sign_mask, x1));
+      nan_mask = _mm256_or_pd(nan_mask, _mm256_cmp_pd(x0, x1, _CMP_UNORD_Q));
+   }
+   return norm_inf_combine(_mm256_movemask_pd(nan_mask) != 0, horizontal_max_avx2(_mm256_max_pd(max0, max1)),
+         norm_inf_scalar(x + i, length - i));
+}
+
+__attribute__((target("avx2,fma")))
+static double dot_avx2(const double* x, const double* y, size_t length) {
+   __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+   size_t i = 0;
+   for (; i + 8 <= length; i += 8) {
+      sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+      sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), sum1);
+   }
+   return horizontal_sum_avx2(_mm256_add_pd(sum0, sum1)) + dot_scalar(x + i, y + i, length - i);
+}
+
+__attribute__((target("avx2,fma")))
+static void add_vectors_avx2(const double* x, const double* y, double scaling_factor, double* result, size_t length) {
+   const __m256d factor = _mm256_set1_pd(scaling_factor);
+   size_t i = 0;
+   for (; i + 4 <= length; i += 4) {
+      _mm256_storeu_pd(result + i, _mm256_fmadd_pd(factor, _mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i)));
+   }
+   add_vectors_scalar(x + i, y + i, scaling_factor, result + i, length - i);
+}
+
+__attribute__((target("avx2,fma")))
+static void scale_avx2(double* x, double scaling_factor, size_t length) {
+   const __m256d factor = _mm256_set1_pd(scaling_factor);
+   size_t i = 0;
+   for (; i + 4 <= length; i += 4) {
+      _mm256_storeu_pd(x + i, _mm256_mul_pd(factor, _mm256_loadu_pd(x + i)));
+   }
+   scale_scalar(x + i, scaling_factor, length - i);
+}
+
+// AVX-512 kernels: 8 doubles per register
+
+__attribute__((target("avx512f")))
+static double norm_1_avx512(const double* x, size_t length) {
+   __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+   size_t i = 0;
+   for (; i + 16 <= length; i += 16) {
+      sum0 = _mm512_add_pd(sum0, _mm512_abs_pd(_mm512_loadu_pd(x + i)));
+      sum1 = _mm512_add_pd(sum1, _mm512_abs_pd(_mm512_loadu_pd(x + i + 8)));
+   }
+   return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1)) + norm_1_scalar(x + i, length - i);
+}
+
+__attribute__((target("avx512f")))
+static double norm_2_squared_avx512(const double* x, size_t length) {
+   __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+   size_t i = 0;
+   for (; i + 16 <= length; i += 16) {
+      const __m512d x0 = _mm512_loadu_pd(x + i);
+      const __m512d x1 = _mm512_loadu_pd(x + i + 8);
+      sum0 = _mm512_fmadd_pd(x0, x0, sum0);
+      sum1 = _mm512_fmadd_pd(x1, x1, sum1);
+   }
+   return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1)) + norm_2_squared_scalar(x + i, length - i);
+}
+
+__attribute__((target("avx512f")))
+static double norm_inf_avx512(const double* x, size_t length) {
+   // _mm512_max_pd does not propagate the NaNs: they are detected by unordered comparisons
+   __m512d max0 = _mm512_setzero_pd(), max1 = _mm512_setzero_pd();
+   __mmask8 nan_mask = 0;
+   size_t i = 0;
+   for (; i + 16 <= length; i += 16) {
+      const __m512d x0 = _mm512_loadu_pd(x + i);
+      const __m512d x1 = _mm512_loadu_pd(x + i + 8);
+      max0 = _mm512_max_pd(max0, _mm512_abs_pd(x0));
+      max1 = _mm512_max_pd(max1, _mm512_abs_pd(x1));
+      nan_mask = static_cast<__mmask8>(nan_mask | _mm512_cmp_pd_mask(x0, x1, _CMP_UNORD_Q));
+   }
+   return norm_inf_combine(nan_mask != 0, _mm512_reduce_max_pd(_mm512_max_pd(max0, max1)), norm_inf_scalar(x + i, length - i));
+}
+
+__attribute__((target("avx512f")))
+static double dot_avx512(const double* x, const double* y, size_t length) {
+   __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+   size_t i = 0;
+   for (; i + 16 <= length; i += 16) {
+      sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+      sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), sum1);
+   }
+   return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1)) + dot_scalar(x + i, y + i, length - i);
+}
+
+__attribute__((target("avx512f")))
+static void add_vectors_avx512(const double* x, const double* y, double scaling_factor, double* result, size_t length) {
+   const __m512d factor = _mm512_set1_pd(scaling_factor);
+   size_t i = 0;
+   for (; i + 8 <= length; i += 8) {
+      _mm512_storeu_pd(result + i, _mm512_fmadd_pd(factor, _mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i)));
+   }
+   add_vectors_scalar(x + i, y + i, scaling_factor, result + i, length - i);
+}
+
+__attribute__((target("avx512f")))
+static void scale_avx512(double* x, double scaling_factor, size_t length) {
+   const __m512d factor = _mm512_set1_pd(scaling_factor);
+   size_t i = 0;
+   for (; i + 8 <= length; i += 8) {
+      _mm512_storeu_pd(x + i, _mm512_mul_pd(factor, _mm512_loadu_pd(x + i)));
+   }
+   scale_scalar(x + i, scaling_factor, length - i);
+}
+#endif // UNO_X86_KERNELS
+
+// runtime dispatch
+
+double VectorKernels::norm_1(const double* x, size_t length) {
+#ifdef UNO_X86_KERNELS
+   if (selected_instruction_set == InstructionSet::AVX512) {
+      return norm_1_avx512(x, length);
+   }
+   if (selected_instruction_set == InstructionSet::AVX2) {
+      return norm_1_avx2(x, length);
+   }
+#endif
+   return norm_1_scalar(x, length);
+}
+
+double VectorKernels::norm_2_squared(const double* x, size_t length) {
+#ifdef UNO_X86_KERNELS
+   if (selected_instruction_set == InstructionSet::AVX512) {
+      return norm_2_squared_avx512(x, length);
+   }
+   if (selected_instruction_set == InstructionSet::AVX2) {
+      return norm_2_squared_avx2(x, length);
+   }
+#endif
+   return norm_2_squared_scalar(x, length);
+}
+
+double VectorKernels::norm_inf(const double* x, size_t length) {
+#ifdef UNO_X86_KERNELS
+   if (selected_instruction_set == InstructionSet::AVX512) {
+      return norm_inf_avx512(x, length);
+   }
+   if (selected_instruction_set == InstructionSet::AVX2) {
+      return norm_inf_avx2(x, length);
+   }
+#endif
+   return norm_inf_scalar(x, length);
+}
+
+double VectorKernels::dot(const double* x, const double* y, size_t length) {
+#ifdef UNO_X86_KERNELS
+   if (selected_instruction_set == InstructionSet::AVX512) {
+      return dot_avx512(x, y, length);
+   }
+   if (selected_instruction_set == InstructionSet::AVX2) {
+      return dot_avx2(x, y, length);
+   }
+#endif
+   return dot_scalar(x, y, length);
+}
+
+void VectorKernels::add_vectors(const double* x, const double* y, double scaling_factor, double* result, size_t length) {
+#ifdef UNO_X86_KERNELS
+   if (selected_instruction_set == InstructionSet::AVX512) {
+      add_vectors_avx512(x, y, scaling_factor, result, length);
+      return;
+   }
+   if (selected_instruction_set == InstructionSet::AVX2) {
+      add_vectors_avx2(x, y, scaling_factor, result, length);
+      return;
+   }
+#endif
+   add_vectors_scalar(x, y, scaling_factor, result, length);
+}
+
+void VectorKernels::scale(double* x, double scaling_factor, size_t length) {
+#ifdef UNO_X86_KERNELS
+   if (selected_instruction_set == InstructionSet::AVX512) {
+      scale_avx512(x, scaling_factor, length);
+      return;
+   }
+   if (selected_instruction_set == InstructionSet::AVX2) {
+      scale_avx2(x, scaling_factor, length);
+      return;
+   }
+#endif
+   scale_scalar(x, scaling_factor, length);
+}
+
+std::string VectorKernels::instruction_set() {
+   switch (selected_instruction_set) {
+      case InstructionSet::AVX512:
+         return "AVX-512";
+      case InstructionSet::AVX2:
+         return "AVX2";
+      default:
+         return "scalar";
+   }
+}
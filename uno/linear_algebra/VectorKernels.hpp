@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_VECTORKERNELS_H
+#define UNO_VECTORKERNELS_H
+
+#include <cstddef>
+#include <string>
+
+/*! \class VectorKernels
+ * \brief Kernels on contiguous arrays of doubles
+ *
+ *  AVX-512 and AVX2 implementations are selected at runtime according to the instruction sets of the CPU,
+ *  with a scalar fallback on other architectures.
+ */
+class VectorKernels {
+public:
+   [[nodiscard]] static double norm_1(const double* x, size_t length);
+   [[nodiscard]] static double norm_2_squared(const double* x, size_t length);
+   [[nodiscard]] static double norm_inf(const double* x, size_t length);
+   [[nodiscard]] static double dot(const double* x, const double* y, size_t length);
+   // result <- x + scaling_factor * y
+   static void add_vectors(const double* x, const double* y, double scaling_factor, double* result, size_t length);
+   // x <- scaling_factor * x
+   static void scale(double* x, double scaling_factor, size_t length);
+
+   // name of the instruction set selected at runtime (AVX-512, AVX2 or scalar)
+   [[nodiscard]] static std::string instruction_set();
+};
+
+#endif // UNO_VECTORKERNELS_H
@@ -15,6 +15,7 @@ public:
 
    const T& operator[](size_t i) const noexcept;
    [[nodiscard]] size_t size() const noexcept;
+   [[nodiscard]] const T* data() const noexcept;
 
    const T* begin() noexcept;
    const T* end() noexcept;
@@ -40,6 +41,11 @@ size_t view<T>::size() const noexcept {
    return this->length;
 }
 
+template <typename T>
+const T* view<T>::data() const noexcept {
+   return this->array;
+}
+
 template <typename T>
 const T* view<T>::begin() noexcept {
    return this->array;
@@ -1,12 +1,17 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
-#include "preprocessing/Preprocessing.hpp"
-#include "ingredients/globalization_mechanism/GlobalizationMechanismFactory.hpp"
-#include "ingredients/constraint_relaxation_strategy/ConstraintRelaxationStrategyFactory.hpp"
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#ifdef HAS_AMPLSOLVER
 #include "interfaces/AMPL/AMPLModel.hpp"
+#endif
+#include "interfaces/NL/NLModel.hpp"
+#include "interfaces/MPS/MPSModel.hpp"
+#include "DecompositionSolver.hpp"
+#include "PortfolioSolver.hpp"
 #include "Uno.hpp"
-#include "optimization/ModelFactory.hpp"
 #include "tools/Logger.hpp"
 #include "tools/Options.hpp"
 #include "tools/Timer.hpp"
@@ -20,50 +25,83 @@ void* operator new(size_t size) {
 }
 */
 
-Statistics create_statistics(const Model& model, const Options& options) {
-   Statistics statistics(options);
-   statistics.add_column("iters", Statistics::int_width, options.get_int("statistics_major_column_order"));
-   statistics.add_column("step norm", Statistics::double_width, options.get_int("statistics_step_norm_column_order"));
-   statistics.add_column("objective", Statistics::double_width, options.get_int("statistics_objective_column_order"));
-   if (model.is_constrained()) {
-      statistics.add_column("primal infeas.", Statistics::double_width, options.get_int("statistics_primal_infeasibility_column_order"));
+// the ASL is not reentrant: AMPLModel serializes its calls, the native .nl reader does not need to.
+// Without the ASL (amplsolver library not found), the .nl files are read by the native reader
+std::unique_ptr<Model> read_model(const std::string& model_name, const Options& options) {
+   // the MPS/QPS files are read natively
+   if (MPSReader::is_mps_file(model_name)) {
+      return std::make_unique<MPSModel>(model_name, MPSReader::get_format(options.get_string("mps_format")));
    }
-   statistics.add_column("complementarity", Statistics::double_width, options.get_int("statistics_complementarity_column_order"));
-   statistics.add_column("stationarity", Statistics::double_width, options.get_int("statistics_stationarity_column_order"));
-   return statistics;
+   const std::string& nl_reader = options.get_string("nl_reader");
+   if (nl_reader == "native") {
+      return std::make_unique<NLModel>(model_name);
+   }
+   else if (nl_reader == "asl") {
+#ifdef HAS_AMPLSOLVER
+      return std::make_unique<AMPLModel>(model_name);
+#else
+      WARNING << "Uno was built without the ASL: the .nl file is read by the native reader\n";
+      return std::make_unique<NLModel>(model_name);
+#endif
+   }
+   throw std::invalid_argument("The .nl reader " + nl_reader + " does not exist");
 }
 
-void run_uno_ampl(const std::string& model_name, const Options& options) {
-   // AMPL model
-   std::unique_ptr<Model> ampl_model = std::make_unique<AMPLModel>(model_name);
-
-   // initialize initial primal and dual points
-   Iterate initial_iterate(ampl_model->number_variables, ampl_model->number_constraints);
-   ampl_model->get_initial_primal_point(initial_iterate.primals);
-   ampl_model->get_initial_dual_point(initial_iterate.multipliers.constraints);
-   ampl_model->project_primals_onto_bounds(initial_iterate.primals);
-
-   // reformulate (scale, add slacks, relax the bounds, ...) if necessary
-   std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(ampl_model), initial_iterate, options);
-
-   // create the statistics
-   Statistics statistics = create_statistics(*model, options);
-
-   // enforce linear constraints at initial point
-   if (options.get_bool("enforce_linear_constraints")) {
-      Preprocessing::enforce_linear_constraints(options, *model, initial_iterate.primals, initial_iterate.multipliers);
+// each configuration of the portfolio is a preset of the comma-separated list, or a set of the option sets file
+std::vector<std::pair<std::string, Options>> get_portfolio_configurations(const std::string& portfolio, const Options& options) {
+   if (std::filesystem::is_regular_file(portfolio)) {
+      return read_option_sets(portfolio, options);
    }
+   std::vector<std::pair<std::string, Options>> configurations;
+   std::istringstream stream(portfolio);
+   std::string preset;
+   while (std::getline(stream, preset, ',')) {
+      Options configuration_options = options;
+      find_preset(preset, configuration_options);
+      configurations.emplace_back(preset, std::move(configuration_options));
+   }
+   return configurations;
+}
 
-   // create the constraint relaxation strategy
-   auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(statistics, *model, options);
+void run_uno_ampl_portfolio(const std::string& model_name, const Options& options) {
+   // the configurations run concurrently: only the summary is printed
+   Options portfolio_options = options;
+   portfolio_options["logger"] = "ERROR";
+   portfolio_options["statistics_sink"] = "none";
+   portfolio_options["trace_file"] = "none";
+   const auto configurations = get_portfolio_configurations(options.get_string("portfolio"), portfolio_options);
+
+   // each configuration reads its own model
+   const PortfolioSolver portfolio_solver([&]() -> std::unique_ptr<Model> {
+      return read_model(model_name, options);
+   });
+   const PortfolioResult portfolio_result = portfolio_solver.solve(configurations);
+
+   std::cout << "\nUno (portfolio)\n";
+   std::cout << Timer::get_current_date();
+   std::cout << "────────────────────────────────────────\n";
+   portfolio_result.print(std::cout);
+   if (portfolio_result.result.has_value()) {
+      portfolio_result.result->print(options.get_bool("print_solution"));
+   }
+}
 
-   // create the globalization mechanism
-   auto mechanism = GlobalizationMechanismFactory::create(statistics, *constraint_relaxation_strategy, options);
+Result solve_ampl_model(const std::string& model_name, const Options& options) {
+   if (options.get_bool("decomposition")) {
+      // the components share the model (solved one after the other if the model is not reentrant)
+      const DecompositionSolver decomposition_solver([&]() -> std::unique_ptr<Model> {
+         return read_model(model_name, options);
+      }, options.get_unsigned_int("decomposition_workers"));
+      return decomposition_solver.solve(options);
+   }
+   // AMPL model
+   std::unique_ptr<Model> ampl_model = read_model(model_name, options);
+   return Uno::solve_model(std::move(ampl_model), options);
+}
 
-   // instantiate the combination of ingredients and solve the problem
-   Uno uno = Uno(*mechanism, options);
+void run_uno_ampl(const std::string& model_name, const Options& options) {
    try {
-      Result result = uno.solve(statistics, *model, initial_iterate);
+      Result result = solve_ampl_model(model_name, options);
 
       // print the optimization summary
       std::string combination = options.get_string("globalization_mechanism") + " " + options.get_string("constraint_relaxation_strategy") + " " +
@@ -80,11 +118,12 @@ void run_uno_ampl(const std::string& model_name, const Options& options) {
    }
 }
 
-Level Logger::level = INFO;
+thread_local Level Logger::level = INFO;
 
 void print_uno_version() {
    std::cout << "Welcome in Uno 1.0\n";
    std::cout << "To solve an AMPL model, type ./uno_ampl path_to_file/file.nl\n";
+   std::cout << "To solve an LP or a QP in MPS/QPS format, type ./uno_ampl path_to_file/file.mps (-mps_format [free|fixed])\n";
    std::cout << "To choose a constraint relaxation strategy, use the argument -constraint_relaxation_strategy "
                 "[feasibility_restoration|l1_relaxation]\n";
    std::cout << "To choose a subproblem method, use the argument -subproblem [QP|LP|primal_dual_interior_point]\n";
@@ -92,6 +131,7 @@ void print_uno_version() {
    std::cout << "To choose a globalization strategy, use the argument -globalization_strategy "
                 "[l1_merit|leyffer_filter_method|waechter_filter_method]\n";
    std::cout << "To choose a preset, use the argument -preset [filtersqp|ipopt|byrd]\n";
+   std::cout << "To race several presets concurrently, use the argument -portfolio ipopt,filtersqp,byrd,funnelsqp\n";
    std::cout << "The options can be combined in the same command line. Autocompletion is possible (see README).\n";
 }
 
@@ -113,7 +153,12 @@ int main(int argc, char* argv[]) {
          options.print();
          // run Uno on the .nl file (last command line argument)
          std::string model_name = std::string(argv[argc - 1]);
-         run_uno_ampl(model_name, options);
+         if (options.get_string("portfolio") != "none") {
+            run_uno_ampl_portfolio(model_name, options);
+         }
+         else {
+            run_uno_ampl(model_name, options);
+         }
       }
    }
    else {
@@ -36,6 +36,7 @@ public:
    void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
 
    [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
 
 private:
    std::unique_ptr<Model> original_model;
@@ -161,4 +162,8 @@ inline const std::vector<size_t>& BoundRelaxedModel::get_linear_constraints() co
    return this->original_model->get_linear_constraints();
 }
 
+inline bool BoundRelaxedModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
 #endif // UNO_BOUNDRELAXEDMODEL_H
@@ -0,0 +1,307 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CACHEDMODEL_H
+#define UNO_CACHEDMODEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <optional>
+#include "Model.hpp"
+#include "tools/Options.hpp"
+
+// evaluations of the functions and first-order derivatives at a primal point. The storage is kept when the entry is
+// recycled for another point, so that the sparse Jacobian is not reallocated
+struct CachedEvaluations {
+   std::vector<double> x;
+   size_t hash;
+   std::optional<double> objective{};
+   bool is_objective_gradient_computed{false};
+   SparseVector<double> objective_gradient{};
+   bool are_constraints_computed{false};
+   std::vector<double> constraints{};
+   bool is_constraint_jacobian_computed{false};
+   RectangularMatrix<double> constraint_jacobian{};
+};
+
+/*! \class CachedModel
+ * \brief Model with an LRU cache of the evaluations at the last few primal points
+ *
+ *  Two iterates at the same primal point (e.g. a copy of the current iterate in the globalization mechanism, or a
+ *  re-evaluation in the restoration phase) share the evaluations of the original model. The points are compared
+ *  exactly. The Hessian of the Lagrangian is not cached. The cache counts its hits and misses; the iterates count all
+ *  their evaluations, whether they hit the cache or not.
+ */
+class CachedModel: public Model {
+public:
+   CachedModel(std::unique_ptr<Model> original_model, size_t capacity);
+
+   // statistics of the current solve (reset by Uno::reset_evaluation_counters)
+   static thread_local size_t number_hits;
+   static thread_local size_t number_misses;
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override;
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override;
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override;
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override;
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override;
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override;
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override;
+
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override;
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override;
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override;
+
+   void get_initial_primal_point(std::vector<double>& x) const override;
+   void get_initial_dual_point(std::vector<double>& multipliers) const override;
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
+
+private:
+   std::unique_ptr<Model> original_model;
+   const size_t capacity;
+   // most recently used point first
+   mutable std::list<CachedEvaluations> cache{};
+
+   [[nodiscard]] size_t compute_hash(const std::vector<double>& x) const;
+   [[nodiscard]] CachedEvaluations& find_entry(const std::vector<double>& x) const;
+   static void count(bool is_hit);
+};
+
+inline thread_local size_t CachedModel::number_hits = 0;
+inline thread_local size_t CachedModel::number_misses = 0;
+
+inline CachedModel::CachedModel(std::unique_ptr<Model> original_model, size_t capacity):
+      Model(original_model->name, original_model->number_variables, original_model->number_constraints),
+      original_model(std::move(original_model)),
+      capacity(capacity) {
+   // the constraint repartition (inequality/equality, linear) is the same as in the original model
+   this->equality_constraints.reserve(this->number_constraints);
+   this->inequality_constraints.reserve(this->number_constraints);
+   for (size_t j: this->original_model->equality_constraints) {
+      this->equality_constraints.push_back(j);
+   }
+   for (size_t j: this->original_model->inequality_constraints) {
+      this->inequality_constraints.push_back(j);
+   }
+
+   // the slacks are the same as in the original model
+   this->original_model->slacks.for_each([&](size_t j, size_t i) {
+      this->slacks.insert(j, i);
+   });
+
+   // the bounded variables are the same as in the original model
+   for (size_t i: this->original_model->lower_bounded_variables) {
+      this->lower_bounded_variables.push_back(i);
+   }
+   for (size_t i: this->original_model->upper_bounded_variables) {
+      this->upper_bounded_variables.push_back(i);
+   }
+   for (size_t i: this->original_model->single_lower_bounded_variables) {
+      this->single_lower_bounded_variables.push_back(i);
+   }
+   for (size_t i: this->original_model->single_upper_bounded_variables) {
+      this->single_upper_bounded_variables.push_back(i);
+   }
+}
+
+// FNV-1a hash of the bit patterns of the primal variables
+inline size_t CachedModel::compute_hash(const std::vector<double>& x) const {
+   uint64_t hash = 14695981039346656037ULL;
+   for (size_t i: Range(this->number_variables)) {
+      uint64_t bits;
+      std::memcpy(&bits, &x[i], sizeof(bits));
+      hash = (hash ^ bits) * 1099511628211ULL;
+   }
+   return static_cast<size_t>(hash);
+}
+
+// find the entry of the point x, or create it (by recycling the least recently used entry if the cache is full).
+// The entry is moved to the front
+inline CachedEvaluations& CachedModel::find_entry(const std::vector<double>& x) const {
+   const size_t hash = this->compute_hash(x);
+   const auto entry = std::find_if(this->cache.begin(), this->cache.end(), [&](const CachedEvaluations& evaluations) {
+      return evaluations.hash == hash && std::equal(evaluations.x.cbegin(), evaluations.x.cend(), x.cbegin());
+   });
+   if (entry != this->cache.end()) {
+      this->cache.splice(this->cache.begin(), this->cache, entry);
+      return this->cache.front();
+   }
+   if (this->cache.size() < this->capacity) {
+      this->cache.emplace_front();
+      CachedEvaluations& new_entry = this->cache.front();
+      new_entry.objective_gradient.reserve(this->number_variables);
+      new_entry.constraints.resize(this->number_constraints);
+      new_entry.constraint_jacobian.resize(this->number_constraints);
+   }
+   else {
+      this->cache.splice(this->cache.begin(), this->cache, std::prev(this->cache.end()));
+   }
+   CachedEvaluations& new_entry = this->cache.front();
+   new_entry.x.assign(x.cbegin(), x.cbegin() + static_cast<std::ptrdiff_t>(this->number_variables));
+   new_entry.hash = hash;
+   new_entry.objective.reset();
+   new_entry.is_objective_gradient_computed = false;
+   new_entry.are_constraints_computed = false;
+   new_entry.is_constraint_jacobian_computed = false;
+   return new_entry;
+}
+
+inline void CachedModel::count(bool is_hit) {
+   if (is_hit) {
+      CachedModel::number_hits++;
+   }
+   else {
+      CachedModel::number_misses++;
+   }
+}
+
+inline double CachedModel::get_variable_lower_bound(size_t i) const {
+   return this->original_model->get_variable_lower_bound(i);
+}
+
+inline double CachedModel::get_variable_upper_bound(size_t i) const {
+   return this->original_model->get_variable_upper_bound(i);
+}
+
+inline double CachedModel::get_constraint_lower_bound(size_t j) const {
+   return this->original_model->get_constraint_lower_bound(j);
+}
+
+inline double CachedModel::get_constraint_upper_bound(size_t j) const {
+   return this->original_model->get_constraint_upper_bound(j);
+}
+
+inline double CachedModel::evaluate_objective(const std::vector<double>& x) const {
+   CachedEvaluations& entry = this->find_entry(x);
+   CachedModel::count(entry.objective.has_value());
+   if (not entry.objective.has_value()) {
+      entry.objective = this->original_model->evaluate_objective(x);
+   }
+   return *entry.objective;
+}
+
+inline void CachedModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   CachedEvaluations& entry = this->find_entry(x);
+   CachedModel::count(entry.is_objective_gradient_computed);
+   if (entry.is_objective_gradient_computed) {
+      entry.objective_gradient.for_each([&](size_t i, double derivative) {
+         gradient.insert(i, derivative);
+      });
+   }
+   else {
+      this->original_model->evaluate_objective_gradient(x, gradient);
+      entry.objective_gradient.clear();
+      gradient.for_each([&](size_t i, double derivative) {
+         entry.objective_gradient.insert(i, derivative);
+      });
+      entry.is_objective_gradient_computed = true;
+   }
+}
+
+inline void CachedModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   CachedEvaluations& entry = this->find_entry(x);
+   CachedModel::count(entry.are_constraints_computed);
+   if (entry.are_constraints_computed) {
+      std::copy(entry.constraints.cbegin(), entry.constraints.cend(), constraints.begin());
+   }
+   else {
+      this->original_model->evaluate_constraints(x, constraints);
+      std::copy(constraints.cbegin(), constraints.cbegin() + static_cast<std::ptrdiff_t>(this->number_constraints), entry.constraints.begin());
+      entry.are_constraints_computed = true;
+   }
+}
+
+inline void CachedModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   this->original_model->evaluate_constraint_gradient(x, j, gradient);
+}
+
+inline void CachedModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   CachedEvaluations& entry = this->find_entry(x);
+   CachedModel::count(entry.is_constraint_jacobian_computed);
+   if (entry.is_constraint_jacobian_computed) {
+      for (size_t j: Range(this->number_constraints)) {
+         constraint_jacobian[j].clear();
+         entry.constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+            constraint_jacobian[j].insert(i, derivative);
+         });
+      }
+   }
+   else {
+      this->original_model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      // copy the values into the rows of the entry: their capacity is kept from one point to the next
+      for (size_t j: Range(this->number_constraints)) {
+         entry.constraint_jacobian[j].clear();
+         constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+            entry.constraint_jacobian[j].insert(i, derivative);
+         });
+      }
+      entry.is_constraint_jacobian_computed = true;
+   }
+}
+
+inline void CachedModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier,
+      const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const {
+   this->original_model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+}
+
+inline BoundType CachedModel::get_variable_bound_type(size_t i) const {
+   return this->original_model->get_variable_bound_type(i);
+}
+
+inline FunctionType CachedModel::get_constraint_type(size_t j) const {
+   return this->original_model->get_constraint_type(j);
+}
+
+inline BoundType CachedModel::get_constraint_bound_type(size_t j) const {
+   return this->original_model->get_constraint_bound_type(j);
+}
+
+inline size_t CachedModel::get_number_objective_gradient_nonzeros() const {
+   return this->original_model->get_number_objective_gradient_nonzeros();
+}
+
+inline size_t CachedModel::get_number_jacobian_nonzeros() const {
+   return this->original_model->get_number_jacobian_nonzeros();
+}
+
+inline size_t CachedModel::get_number_hessian_nonzeros() const {
+   return this->original_model->get_number_hessian_nonzeros();
+}
+
+inline void CachedModel::get_initial_primal_point(std::vector<double>& x) const {
+   this->original_model->get_initial_primal_point(x);
+}
+
+inline void CachedModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   this->original_model->get_initial_dual_point(multipliers);
+}
+
+inline void CachedModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
+   this->original_model->postprocess_solution(iterate, termination_status);
+}
+
+inline const std::vector<size_t>& CachedModel::get_linear_constraints() const {
+   return this->original_model->get_linear_constraints();
+}
+
+inline bool CachedModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
+#endif // UNO_CACHEDMODEL_H
@@ -0,0 +1,245 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CONSTANTDERIVATIVESMODEL_H
+#define UNO_CONSTANTDERIVATIVESMODEL_H
+
+#include <memory>
+#include <utility>
+#include "Model.hpp"
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+
+/*! \class ConstantDerivativesModel
+ * \brief Model whose constant derivatives are evaluated once
+ *
+ *  The gradients of the linear constraints (including the slack contributions) are stored at the first evaluation of
+ *  the Jacobian; afterwards, only the rows of the nonlinear constraints are evaluated. If the model is a quadratic
+ *  program, its Hessian only depends on the objective multiplier: the Hessian of the objective is stored at the first
+ *  evaluation and scaled afterwards.
+ */
+class ConstantDerivativesModel: public Model {
+public:
+   explicit ConstantDerivativesModel(std::unique_ptr<Model> original_model);
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override;
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override;
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override;
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override;
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override;
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override;
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override;
+
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override;
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override;
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override;
+
+   void get_initial_primal_point(std::vector<double>& x) const override;
+   void get_initial_dual_point(std::vector<double>& multipliers) const override;
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
+
+private:
+   std::unique_ptr<Model> original_model;
+   std::vector<bool> is_linear_constraint;
+   std::vector<size_t> nonlinear_constraints{};
+   const bool is_hessian_constant;
+   // gradients of the linear constraints (the rows of the nonlinear constraints are empty)
+   mutable bool are_linear_gradients_stored{false};
+   mutable RectangularMatrix<double> linear_constraint_gradients{};
+   // (row index, entry) of the Hessian of the objective (with an objective multiplier of 1), per column
+   mutable bool is_hessian_stored{false};
+   mutable std::vector<std::vector<std::pair<size_t, double>>> hessian_columns{};
+};
+
+inline ConstantDerivativesModel::ConstantDerivativesModel(std::unique_ptr<Model> original_model):
+      Model(original_model->name, original_model->number_variables, original_model->number_constraints),
+      original_model(std::move(original_model)),
+      is_linear_constraint(this->number_constraints, false),
+      is_hessian_constant(this->original_model->is_quadratic_program()) {
+   // the constraint repartition (inequality/equality, linear) is the same as in the original model
+   this->equality_constraints.reserve(this->number_constraints);
+   this->inequality_constraints.reserve(this->number_constraints);
+   for (size_t j: this->original_model->equality_constraints) {
+      this->equality_constraints.push_back(j);
+   }
+   for (size_t j: this->original_model->inequality_constraints) {
+      this->inequality_constraints.push_back(j);
+   }
+
+   // the slacks are the same as in the original model
+   this->original_model->slacks.for_each([&](size_t j, size_t i) {
+      this->slacks.insert(j, i);
+   });
+
+   // the bounded variables are the same as in the original model
+   for (size_t i: this->original_model->lower_bounded_variables) {
+      this->lower_bounded_variables.push_back(i);
+   }
+   for (size_t i: this->original_model->upper_bounded_variables) {
+      this->upper_bounded_variables.push_back(i);
+   }
+   for (size_t i: this->original_model->single_lower_bounded_variables) {
+      this->single_lower_bounded_variables.push_back(i);
+   }
+   for (size_t i: this->original_model->single_upper_bounded_variables) {
+      this->single_upper_bounded_variables.push_back(i);
+   }
+
+   for (size_t j: this->original_model->get_linear_constraints()) {
+      this->is_linear_constraint[j] = true;
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      if (not this->is_linear_constraint[j]) {
+         this->nonlinear_constraints.push_back(j);
+      }
+   }
+}
+
+inline double ConstantDerivativesModel::get_variable_lower_bound(size_t i) const {
+   return this->original_model->get_variable_lower_bound(i);
+}
+
+inline double ConstantDerivativesModel::get_variable_upper_bound(size_t i) const {
+   return this->original_model->get_variable_upper_bound(i);
+}
+
+inline double ConstantDerivativesModel::get_constraint_lower_bound(size_t j) const {
+   return this->original_model->get_constraint_lower_bound(j);
+}
+
+inline double ConstantDerivativesModel::get_constraint_upper_bound(size_t j) const {
+   return this->original_model->get_constraint_upper_bound(j);
+}
+
+inline double ConstantDerivativesModel::evaluate_objective(const std::vector<double>& x) const {
+   return this->original_model->evaluate_objective(x);
+}
+
+inline void ConstantDerivativesModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   this->original_model->evaluate_objective_gradient(x, gradient);
+}
+
+inline void ConstantDerivativesModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   this->original_model->evaluate_constraints(x, constraints);
+}
+
+inline void ConstantDerivativesModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   if (this->are_linear_gradients_stored && this->is_linear_constraint[j]) {
+      gradient.clear();
+      this->linear_constraint_gradients[j].for_each([&](size_t i, double derivative) {
+         gradient.insert(i, derivative);
+      });
+   }
+   else {
+      this->original_model->evaluate_constraint_gradient(x, j, gradient);
+   }
+}
+
+inline void ConstantDerivativesModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   if (this->nonlinear_constraints.size() == this->number_constraints) {
+      this->original_model->evaluate_constraint_jacobian(x, constraint_jacobian);
+   }
+   else if (not this->are_linear_gradients_stored) {
+      // evaluate the whole Jacobian once and store the linear rows
+      this->original_model->evaluate_constraint_jacobian(x, constraint_jacobian);
+      this->linear_constraint_gradients.resize(this->number_constraints);
+      for (size_t j: this->original_model->get_linear_constraints()) {
+         this->linear_constraint_gradients[j] = constraint_jacobian[j];
+      }
+      this->are_linear_gradients_stored = true;
+   }
+   else {
+      // only the rows of the nonlinear constraints are evaluated
+      this->original_model->evaluate_constraint_subset_jacobian(x, this->nonlinear_constraints, constraint_jacobian);
+      for (size_t j: this->original_model->get_linear_constraints()) {
+         constraint_jacobian[j].clear();
+         this->linear_constraint_gradients[j].for_each([&](size_t i, double derivative) {
+            constraint_jacobian[j].insert(i, derivative);
+         });
+      }
+   }
+}
+
+inline void ConstantDerivativesModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier,
+      const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const {
+   if (not this->is_hessian_constant) {
+      this->original_model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+      return;
+   }
+   if (not this->is_hessian_stored) {
+      // the Hessian of the Lagrangian is linear in the objective multiplier: evaluate it with a multiplier of 1 (in a matrix
+      // without regularization terms)
+      COOSymmetricMatrix<double> objective_hessian(this->number_variables, this->get_number_hessian_nonzeros(), false);
+      this->original_model->evaluate_lagrangian_hessian(x, 1., multipliers, objective_hessian);
+      this->hessian_columns.resize(this->number_variables);
+      objective_hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+         this->hessian_columns[column_index].emplace_back(row_index, entry);
+      });
+      this->is_hessian_stored = true;
+   }
+   // scale the stored Hessian (the zero entries are kept to preserve the sparsity pattern)
+   hessian.reset();
+   for (size_t column_index: Range(this->number_variables)) {
+      for (const auto& [row_index, entry]: this->hessian_columns[column_index]) {
+         hessian.insert(objective_multiplier * entry, row_index, column_index);
+      }
+      hessian.finalize_column(column_index);
+   }
+}
+
+inline BoundType ConstantDerivativesModel::get_variable_bound_type(size_t i) const {
+   return this->original_model->get_variable_bound_type(i);
+}
+
+inline FunctionType ConstantDerivativesModel::get_constraint_type(size_t j) const {
+   return this->original_model->get_constraint_type(j);
+}
+
+inline BoundType ConstantDerivativesModel::get_constraint_bound_type(size_t j) const {
+   return this->original_model->get_constraint_bound_type(j);
+}
+
+inline size_t ConstantDerivativesModel::get_number_objective_gradient_nonzeros() const {
+   return this->original_model->get_number_objective_gradient_nonzeros();
+}
+
+inline size_t ConstantDerivativesModel::get_number_jacobian_nonzeros() const {
+   return this->original_model->get_number_jacobian_nonzeros();
+}
+
+inline size_t ConstantDerivativesModel::get_number_hessian_nonzeros() const {
+   return this->original_model->get_number_hessian_nonzeros();
+}
+
+inline void ConstantDerivativesModel::get_initial_primal_point(std::vector<double>& x) const {
+   this->original_model->get_initial_primal_point(x);
+}
+
+inline void ConstantDerivativesModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   this->original_model->get_initial_dual_point(multipliers);
+}
+
+inline void ConstantDerivativesModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
+   this->original_model->postprocess_solution(iterate, termination_status);
+}
+
+inline const std::vector<size_t>& ConstantDerivativesModel::get_linear_constraints() const {
+   return this->original_model->get_linear_constraints();
+}
+
+inline bool ConstantDerivativesModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
+#endif // UNO_CONSTANTDERIVATIVESMODEL_H
@@ -39,6 +39,7 @@ public:
    void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
 
    [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
 
 protected:
    std::unique_ptr<Model> original_model;
@@ -226,14 +227,18 @@ inline void EqualityConstrainedModel::get_initial_dual_point(std::vector<double>
 }
 
 inline void EqualityConstrainedModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
-   this->original_model->postprocess_solution(iterate, termination_status);
-
    // discard the slacks
    iterate.number_variables = this->original_model->number_variables;
+
+   this->original_model->postprocess_solution(iterate, termination_status);
 }
 
 inline const std::vector<size_t>& EqualityConstrainedModel::get_linear_constraints() const {
    return this->original_model->get_linear_constraints();
 }
 
+inline bool EqualityConstrainedModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
 #endif // UNO_EQUALITYCONSTRAINEDMODEL_H
\ No newline at end of file
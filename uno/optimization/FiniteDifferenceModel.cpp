@@ -0,0 +1,396 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "FiniteDifferenceModel.hpp"
+#include "preprocessing/Coloring.hpp"
+#include "tools/Logger.hpp"
+
+DerivativeSparsity DerivativeSparsity::dense(size_t number_variables, size_t number_constraints) {
+   DerivativeSparsity sparsity;
+   sparsity.objective_gradient.resize(number_variables);
+   for (size_t i: Range(number_variables)) {
+      sparsity.objective_gradient[i] = i;
+   }
+   sparsity.jacobian.assign(number_constraints, sparsity.objective_gradient);
+   return sparsity;
+}
+
+// if the Hessian sparsity is not given, every pair of variables of the objective or of a nonlinear constraint is a nonzero
+DerivativeSparsity complete_hessian_sparsity(DerivativeSparsity sparsity, const Model& model) {
+   if (sparsity.hessian.empty()) {
+      sparsity.hessian.resize(model.number_variables);
+      const auto add_pairs = [&](const std::vector<size_t>& variables) {
+         for (size_t first_variable: variables) {
+            for (size_t second_variable: variables) {
+               if (first_variable <= second_variable) {
+                  sparsity.hessian[second_variable].push_back(first_variable);
+               }
+            }
+         }
+      };
+      add_pairs(sparsity.objective_gradient);
+      for (size_t j: Range(model.number_constraints)) {
+         if (model.get_constraint_type(j) == NONLINEAR) {
+            add_pairs(sparsity.jacobian[j]);
+         }
+      }
+      for (std::vector<size_t>& column: sparsity.hessian) {
+         std::sort(column.begin(), column.end());
+         column.erase(std::unique(column.begin(), column.end()), column.end());
+      }
+   }
+   return sparsity;
+}
+
+FiniteDifferenceModel::FiniteDifferenceModel(std::unique_ptr<Model> original_model, DerivativeSparsity sparsity, const Options& options):
+      Model(original_model->name + "_finitedifferences", original_model->number_variables, original_model->number_constraints),
+      original_model(std::move(original_model)),
+      sparsity(complete_hessian_sparsity(std::move(sparsity), *this->original_model)),
+      central_differences(options.get_string("finite_difference_scheme") == "central"),
+      // optimal steps for a truncation error in O(h) (forward) or O(h^2) (central). The Hessian is a second difference of
+      // function values (rounding error in O(eps/h^2)) and uses the same step for both differences
+      gradient_step(this->central_differences ? std::cbrt(std::numeric_limits<double>::epsilon()) :
+            std::sqrt(std::numeric_limits<double>::epsilon())),
+      hessian_step(std::pow(std::numeric_limits<double>::epsilon(), 0.25)),
+      number_threads(options.get_unsigned_int("finite_difference_threads")),
+      objective_gradient_entries(this->sparsity.objective_gradient.size()),
+      jacobian_entries(this->number_constraints) {
+   if (this->sparsity.jacobian.size() != this->number_constraints || this->sparsity.hessian.size() != this->number_variables) {
+      throw std::invalid_argument("FiniteDifferenceModel: the dimensions of the sparsity patterns do not match the model");
+   }
+   this->objective_sign = this->original_model->objective_sign;
+   // the constraint repartition (inequality/equality, linear) is the same as in the original model
+   this->equality_constraints = this->original_model->equality_constraints;
+   this->inequality_constraints = this->original_model->inequality_constraints;
+   this->original_model->slacks.for_each([&](size_t j, size_t i) {
+      this->slacks.insert(j, i);
+   });
+   // the bounded variables are the same as in the original model
+   this->lower_bounded_variables = this->original_model->lower_bounded_variables;
+   this->upper_bounded_variables = this->original_model->upper_bounded_variables;
+   this->single_lower_bounded_variables = this->original_model->single_lower_bounded_variables;
+   this->single_upper_bounded_variables = this->original_model->single_upper_bounded_variables;
+
+   for (size_t j: Range(this->number_constraints)) {
+      this->jacobian_entries[j].resize(this->sparsity.jacobian[j].size());
+      if (this->original_model->get_constraint_type(j) == NONLINEAR) {
+         this->nonlinear_constraints.push_back(j);
+      }
+   }
+   this->number_objective_gradient_nonzeros = this->sparsity.objective_gradient.size();
+   for (const std::vector<size_t>& row: this->sparsity.jacobian) {
+      this->number_jacobian_nonzeros += row.size();
+   }
+   for (const std::vector<size_t>& column: this->sparsity.hessian) {
+      this->number_hessian_nonzeros += column.size();
+   }
+
+   // compression of the derivatives
+   this->jacobian_coloring = Coloring::color_columns(this->number_variables, this->sparsity.jacobian);
+   this->jacobian_colors = Coloring::group_by_color(this->jacobian_coloring);
+   this->compute_hessian_sources();
+   DEBUG << "Finite differences: " << this->jacobian_colors.size() << " Jacobian colors, " << this->hessian_colors.size() << " Hessian colors\n";
+}
+
+// star coloring: the entry (i, j) is the i-th component of the product with the color vector of j if j is the only
+// neighbor of i with this color (and symmetrically)
+void FiniteDifferenceModel::compute_hessian_sources() {
+   const std::vector<size_t> hessian_coloring = Coloring::color_star(this->number_variables, this->sparsity.hessian);
+   this->hessian_colors = Coloring::group_by_color(hessian_coloring);
+
+   std::vector<std::vector<size_t>> neighbors(this->number_variables);
+   for (size_t column_index: Range(this->number_variables)) {
+      for (size_t row_index: this->sparsity.hessian[column_index]) {
+         if (row_index != column_index) {
+            neighbors[row_index].push_back(column_index);
+            neighbors[column_index].push_back(row_index);
+         }
+      }
+   }
+   const auto number_neighbors_with_color = [&](size_t vertex, size_t color) {
+      return std::count_if(neighbors[vertex].cbegin(), neighbors[vertex].cend(), [&](size_t neighbor) {
+         return hessian_coloring[neighbor] == color;
+      });
+   };
+
+   this->hessian_sources.resize(this->number_variables);
+   for (size_t column_index: Range(this->number_variables)) {
+      for (size_t row_index: this->sparsity.hessian[column_index]) {
+         if (row_index == column_index || number_neighbors_with_color(row_index, hessian_coloring[column_index]) == 1) {
+            this->hessian_sources[column_index].push_back({hessian_coloring[column_index], row_index, column_index});
+         }
+         else if (number_neighbors_with_color(column_index, hessian_coloring[row_index]) == 1) {
+            this->hessian_sources[column_index].push_back({hessian_coloring[row_index], column_index, row_index});
+         }
+         else {
+            throw std::logic_error("FiniteDifferenceModel: the Hessian entry (" + std::to_string(row_index) + ", " +
+                  std::to_string(column_index) + ") cannot be recovered from the coloring");
+         }
+      }
+   }
+}
+
+size_t FiniteDifferenceModel::get_number_jacobian_colors() const {
+   return this->jacobian_colors.size();
+}
+
+size_t FiniteDifferenceModel::get_number_hessian_colors() const {
+   return this->hessian_colors.size();
+}
+
+// absolute perturbations of the variables. Forward differences perturb the variables at their upper bounds backwards
+std::vector<double> FiniteDifferenceModel::perturbations(const std::vector<double>& x, double relative_step) const {
+   std::vector<double> steps(this->number_variables);
+   for (size_t i: Range(this->number_variables)) {
+      steps[i] = relative_step * std::max(1., std::abs(x[i]));
+      if (not this->central_differences && this->get_variable_upper_bound(i) < x[i] + steps[i]) {
+         steps[i] = -steps[i];
+      }
+   }
+   return steps;
+}
+
+// evaluate the perturbed points (possibly concurrently). The first exception is rethrown after the loop
+void FiniteDifferenceModel::evaluate_concurrently(size_t number_points, const std::function<void(size_t point_index)>& evaluate_point) const {
+   std::exception_ptr exception = nullptr;
+   const auto number_points_signed = static_cast<std::ptrdiff_t>(number_points);
+#ifdef _OPENMP
+   const int maximum_number_threads = (0 < this->number_threads) ? static_cast<int>(this->number_threads) : omp_get_max_threads();
+   #pragma omp parallel for schedule(dynamic) num_threads(maximum_number_threads) if(1 < maximum_number_threads && 1 < number_points_signed)
+#endif
+   for (std::ptrdiff_t point_index = 0; point_index < number_points_signed; point_index++) {
+      try {
+         evaluate_point(static_cast<size_t>(point_index));
+      }
+      catch (...) {
+#ifdef _OPENMP
+         #pragma omp critical
+#endif
+         if (exception == nullptr) {
+            exception = std::current_exception();
+         }
+      }
+   }
+   if (exception != nullptr) {
+      std::rethrow_exception(exception);
+   }
+}
+
+// objective perturbations: one per variable of the objective. Constraint perturbations: one per Jacobian color. Central
+// differences evaluate each perturbation in both directions
+void FiniteDifferenceModel::compute_first_derivatives(const std::vector<double>& x, double relative_step, std::vector<double>& objective_gradient,
+      std::vector<std::vector<double>>& jacobian) const {
+   const std::vector<double> steps = this->perturbations(x, relative_step);
+   const size_t number_directions = this->central_differences ? 2 : 1;
+   const size_t number_objective_points = number_directions * this->sparsity.objective_gradient.size();
+   const size_t number_constraint_points = number_directions * this->jacobian_colors.size();
+
+   // reference point of the forward differences
+   double objective = 0.;
+   std::vector<double> constraints(this->number_constraints);
+   if (not this->central_differences) {
+      if (0 < number_objective_points) {
+         objective = this->original_model->evaluate_objective(x);
+      }
+      if (0 < number_constraint_points) {
+         this->original_model->evaluate_constraints(x, constraints);
+      }
+   }
+
+   std::vector<double> objective_values(number_objective_points);
+   std::vector<std::vector<double>> constraint_values(number_constraint_points, std::vector<double>(this->number_constraints));
+   this->evaluate_concurrently(number_objective_points + number_constraint_points, [&](size_t point_index) {
+      std::vector<double> perturbed_x(x.cbegin(), x.cbegin() + static_cast<std::ptrdiff_t>(this->number_variables));
+      const double direction = (point_index % number_directions == 0) ? 1. : -1.;
+      if (point_index < number_objective_points) {
+         const size_t i = this->sparsity.objective_gradient[point_index / number_directions];
+         perturbed_x[i] += direction * steps[i];
+         objective_values[point_index] = this->original_model->evaluate_objective(perturbed_x);
+      }
+      else {
+         const size_t constraint_point_index = point_index - number_objective_points;
+         for (size_t i: this->jacobian_colors[constraint_point_index / number_directions]) {
+            perturbed_x[i] += direction * steps[i];
+         }
+         this->original_model->evaluate_constraints(perturbed_x, constraint_values[constraint_point_index]);
+      }
+   });
+
+   for (size_t k: Range(this->sparsity.objective_gradient.size())) {
+      const size_t i = this->sparsity.objective_gradient[k];
+      objective_gradient[k] = this->central_differences ? (objective_values[2*k] - objective_values[2*k + 1]) / (2. * steps[i]) :
+            (objective_values[k] - objective) / steps[i];
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      for (size_t k: Range(this->sparsity.jacobian[j].size())) {
+         const size_t i = this->sparsity.jacobian[j][k];
+         const size_t color = this->jacobian_coloring[i];
+         jacobian[j][k] = this->central_differences ?
+               (constraint_values[2*color][j] - constraint_values[2*color + 1][j]) / (2. * steps[i]) :
+               (constraint_values[color][j] - constraints[j]) / steps[i];
+      }
+   }
+}
+
+// the objective gradient and the Jacobian are computed together, and reused at the same point
+void FiniteDifferenceModel::compute_first_derivatives(const std::vector<double>& x) const {
+   if (not this->are_derivatives_computed ||
+         not std::equal(this->derivatives_point.cbegin(), this->derivatives_point.cend(), x.cbegin())) {
+      this->compute_first_derivatives(x, this->gradient_step, this->objective_gradient_entries, this->jacobian_entries);
+      this->derivatives_point.assign(x.cbegin(), x.cbegin() + static_cast<std::ptrdiff_t>(this->number_variables));
+      this->are_derivatives_computed = true;
+   }
+}
+
+// sigma grad f(x) - sum_j y_j grad c_j(x) with the Hessian step (the linear constraints do not contribute to the Hessian)
+void FiniteDifferenceModel::compute_lagrangian_gradient(const std::vector<double>& x, double objective_multiplier,
+      const std::vector<double>& multipliers, std::vector<double>& lagrangian_gradient) const {
+   std::vector<double> objective_gradient(this->sparsity.objective_gradient.size());
+   std::vector<std::vector<double>> jacobian(this->jacobian_entries);
+   this->compute_first_derivatives(x, this->hessian_step, objective_gradient, jacobian);
+   std::fill(lagrangian_gradient.begin(), lagrangian_gradient.end(), 0.);
+   for (size_t k: Range(this->sparsity.objective_gradient.size())) {
+      lagrangian_gradient[this->sparsity.objective_gradient[k]] += objective_multiplier * objective_gradient[k];
+   }
+   for (size_t j: this->nonlinear_constraints) {
+      for (size_t k: Range(this->sparsity.jacobian[j].size())) {
+         lagrangian_gradient[this->sparsity.jacobian[j][k]] -= multipliers[j] * jacobian[j][k];
+      }
+   }
+}
+
+double FiniteDifferenceModel::get_variable_lower_bound(size_t i) const {
+   return this->original_model->get_variable_lower_bound(i);
+}
+
+double FiniteDifferenceModel::get_variable_upper_bound(size_t i) const {
+   return this->original_model->get_variable_upper_bound(i);
+}
+
+double FiniteDifferenceModel::get_constraint_lower_bound(size_t j) const {
+   return this->original_model->get_constraint_lower_bound(j);
+}
+
+double FiniteDifferenceModel::get_constraint_upper_bound(size_t j) const {
+   return this->original_model->get_constraint_upper_bound(j);
+}
+
+double FiniteDifferenceModel::evaluate_objective(const std::vector<double>& x) const {
+   return this->original_model->evaluate_objective(x);
+}
+
+void FiniteDifferenceModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   this->compute_first_derivatives(x);
+   for (size_t k: Range(this->sparsity.objective_gradient.size())) {
+      gradient.insert(this->sparsity.objective_gradient[k], this->objective_gradient_entries[k]);
+   }
+}
+
+void FiniteDifferenceModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   this->original_model->evaluate_constraints(x, constraints);
+}
+
+void FiniteDifferenceModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   this->compute_first_derivatives(x);
+   gradient.clear();
+   for (size_t k: Range(this->sparsity.jacobian[j].size())) {
+      gradient.insert(this->sparsity.jacobian[j][k], this->jacobian_entries[j][k]);
+   }
+}
+
+void FiniteDifferenceModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   for (size_t j: Range(this->number_constraints)) {
+      this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+   }
+}
+
+// columns of the Hessian: differences of Lagrangian gradients along the color vectors
+void FiniteDifferenceModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier,
+      const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const {
+   const std::vector<double> steps = this->perturbations(x, this->hessian_step);
+   std::vector<std::vector<double>> products(this->hessian_colors.size(), std::vector<double>(this->number_variables));
+   std::vector<double> reference_gradient(this->number_variables);
+   std::vector<double> perturbed_gradient(this->number_variables);
+   if (not this->central_differences && not this->hessian_colors.empty()) {
+      this->compute_lagrangian_gradient(x, objective_multiplier, multipliers, reference_gradient);
+   }
+   for (size_t color: Range(this->hessian_colors.size())) {
+      std::vector<double> perturbed_x(x.cbegin(), x.cbegin() + static_cast<std::ptrdiff_t>(this->number_variables));
+      for (size_t i: this->hessian_colors[color]) {
+         perturbed_x[i] += steps[i];
+      }
+      this->compute_lagrangian_gradient(perturbed_x, objective_multiplier, multipliers, perturbed_gradient);
+      if (this->central_differences) {
+         for (size_t i: this->hessian_colors[color]) {
+            perturbed_x[i] -= 2. * steps[i];
+         }
+         this->compute_lagrangian_gradient(perturbed_x, objective_multiplier, multipliers, reference_gradient);
+      }
+      const double denominator = this->central_differences ? 2. : 1.;
+      for (size_t i: Range(this->number_variables)) {
+         products[color][i] = (perturbed_gradient[i] - reference_gradient[i]) / denominator;
+      }
+   }
+
+   hessian.reset();
+   for (size_t column_index: Range(this->number_variables)) {
+      for (size_t k: Range(this->sparsity.hessian[column_index].size())) {
+         const HessianEntrySource& source = this->hessian_sources[column_index][k];
+         hessian.insert(products[source.color][source.row_index] / steps[source.variable_index], this->sparsity.hessian[column_index][k],
+               column_index);
+      }
+      hessian.finalize_column(column_index);
+   }
+}
+
+BoundType FiniteDifferenceModel::get_variable_bound_type(size_t i) const {
+   return this->original_model->get_variable_bound_type(i);
+}
+
+FunctionType FiniteDifferenceModel::get_constraint_type(size_t j) const {
+   return this->original_model->get_constraint_type(j);
+}
+
+BoundType FiniteDifferenceModel::get_constraint_bound_type(size_t j) const {
+   return this->original_model->get_constraint_bound_type(j);
+}
+
+size_t FiniteDifferenceModel::get_number_objective_gradient_nonzeros() const {
+   return this->number_objective_gradient_nonzeros;
+}
+
+size_t FiniteDifferenceModel::get_number_jacobian_nonzeros() const {
+   return this->number_jacobian_nonzeros;
+}
+
+size_t FiniteDifferenceModel::get_number_hessian_nonzeros() const {
+   return this->number_hessian_nonzeros;
+}
+
+void FiniteDifferenceModel::get_initial_primal_point(std::vector<double>& x) const {
+   this->original_model->get_initial_primal_point(x);
+}
+
+void FiniteDifferenceModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   this->original_model->get_initial_dual_point(multipliers);
+}
+
+void FiniteDifferenceModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
+   this->original_model->postprocess_solution(iterate, termination_status);
+}
+
+const std::vector<size_t>& FiniteDifferenceModel::get_linear_constraints() const {
+   return this->original_model->get_linear_constraints();
+}
+
+bool FiniteDifferenceModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FINITEDIFFERENCEMODEL_H
+#define UNO_FINITEDIFFERENCEMODEL_H
+
+#include <functional>
+#include <memory>
+#include "Model.hpp"
+#include "tools/Options.hpp"
+
+// sparsity of the derivatives of a model that only evaluates its functions
+struct DerivativeSparsity {
+   std::vector<size_t> objective_gradient{}; /*!< Variables of the objective */
+   std::vector<std::vector<size_t>> jacobian{}; /*!< Variables of each constraint */
+   std::vector<std::vector<size_t>> hessian{}; /*!< Rows i <= j of each column j of the Lagrangian Hessian. If empty, all the pairs of
+ * variables of the objective and of the nonlinear constraints */
+
+   [[nodiscard]] static DerivativeSparsity dense(size_t number_variables, size_t number_constraints);
+};
+
+/*! \class FiniteDifferenceModel
+ * \brief Model whose derivatives are approximated by finite differences of the function values of the original model
+ *
+ *  The Jacobian is compressed with a Curtis-Powell-Reid column coloring: the constraints are evaluated once per color
+ *  (twice with central differences). The Lagrangian Hessian is recovered directly from the differences of Lagrangian
+ *  gradients along the color vectors of a star coloring. The perturbed points can be evaluated concurrently by OpenMP
+ *  threads, in which case the original model must be thread-safe. The derivative methods of the original model are
+ *  never called.
+ */
+class FiniteDifferenceModel: public Model {
+public:
+   FiniteDifferenceModel(std::unique_ptr<Model> original_model, DerivativeSparsity sparsity, const Options& options);
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override;
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override;
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override;
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override;
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override;
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override;
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override;
+
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override;
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override;
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override;
+
+   void get_initial_primal_point(std::vector<double>& x) const override;
+   void get_initial_dual_point(std::vector<double>& multipliers) const override;
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
+
+   [[nodiscard]] size_t get_number_jacobian_colors() const;
+   [[nodiscard]] size_t get_number_hessian_colors() const;
+
+private:
+   std::unique_ptr<Model> original_model;
+   const DerivativeSparsity sparsity;
+   const bool central_differences;
+   const double gradient_step; /*!< Relative perturbation of the variables for the first derivatives */
+   const double hessian_step; /*!< Relative perturbation of the variables for the Lagrangian Hessian */
+   const size_t number_threads; /*!< 0: OpenMP default */
+   std::vector<size_t> nonlinear_constraints{};
+   // color of each variable and variables of each color
+   std::vector<size_t> jacobian_coloring{};
+   std::vector<std::vector<size_t>> jacobian_colors{};
+   std::vector<std::vector<size_t>> hessian_colors{};
+   // recovery of the Hessian entries (same order as the sparsity): color vector and row of the product, divided by the
+   // perturbation of a variable
+   struct HessianEntrySource {
+      size_t color;
+      size_t row_index;
+      size_t variable_index;
+   };
+   std::vector<std::vector<HessianEntrySource>> hessian_sources{};
+
+   // first derivatives at the last point (same order as the sparsity)
+   mutable std::vector<double> derivatives_point{};
+   mutable bool are_derivatives_computed{false};
+   mutable std::vector<double> objective_gradient_entries{};
+   mutable std::vector<std::vector<double>> jacobian_entries{};
+
+   void compute_hessian_sources();
+   [[nodiscard]] std::vector<double> perturbations(const std::vector<double>& x, double relative_step) const;
+   void compute_first_derivatives(const std::vector<double>& x) const;
+   void compute_first_derivatives(const std::vector<double>& x, double relative_step, std::vector<double>& objective_gradient,
+         std::vector<std::vector<double>>& jacobian) const;
+   void evaluate_concurrently(size_t number_points, const std::function<void(size_t point_index)>& evaluate_point) const;
+   void compute_lagrangian_gradient(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         std::vector<double>& lagrangian_gradient) const;
+};
+
+#endif // UNO_FINITEDIFFERENCEMODEL_H
@@ -1,15 +1,17 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include "Iterate.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "optimization/Model.hpp"
 #include "tools/Logger.hpp"
+#include "tools/Profiler.hpp"
 
-size_t Iterate::number_eval_objective = 0;
-size_t Iterate::number_eval_constraints = 0;
-size_t Iterate::number_eval_objective_gradient = 0;
-size_t Iterate::number_eval_jacobian = 0;
+thread_local size_t Iterate::number_eval_objective = 0;
+thread_local size_t Iterate::number_eval_constraints = 0;
+thread_local size_t Iterate::number_eval_objective_gradient = 0;
+thread_local size_t Iterate::number_eval_jacobian = 0;
 
 Iterate::Iterate(size_t max_number_variables, size_t max_number_constraints) :
       number_variables(max_number_variables), number_constraints(max_number_constraints),
@@ -20,6 +22,7 @@ Iterate::Iterate(size_t max_number_variables, size_t max_number_constraints) :
 
 void Iterate::evaluate_objective(const Model& model) {
    if (not this->is_objective_computed) {
+      PROFILE_SCOPE("objective evaluation");
       // evaluate the objective
       this->evaluations.objective = model.evaluate_objective(this->primals);
       // check finiteness
@@ -33,6 +36,7 @@ void Iterate::evaluate_objective(const Model& model) {
 
 void Iterate::evaluate_constraints(const Model& model) {
    if (not this->are_constraints_computed) {
+      PROFILE_SCOPE("constraint evaluation");
       // evaluate the constraints
       model.evaluate_constraints(this->primals, this->evaluations.constraints);
       // check finiteness
@@ -48,6 +52,7 @@ void Iterate::evaluate_constraints(const Model& model) {
 
 void Iterate::evaluate_objective_gradient(const Model& model) {
    if (not this->is_objective_gradient_computed) {
+      PROFILE_SCOPE("objective gradient evaluation");
       this->evaluations.objective_gradient.clear();
       // evaluate the objective gradient
       model.evaluate_objective_gradient(this->primals, this->evaluations.objective_gradient);
@@ -58,6 +63,7 @@ void Iterate::evaluate_objective_gradient(const Model& model) {
 
 void Iterate::evaluate_constraint_jacobian(const Model& model) {
    if (not this->is_constraint_jacobian_computed) {
+      PROFILE_SCOPE("Jacobian evaluation");
       for (auto& row: this->evaluations.constraint_jacobian) {
          row.clear();
       }
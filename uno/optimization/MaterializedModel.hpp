@@ -0,0 +1,186 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MATERIALIZEDMODEL_H
+#define UNO_MATERIALIZEDMODEL_H
+
+#include <memory>
+#include "Model.hpp"
+
+/*! \class MaterializedModel
+ * \brief Reformulation chain whose bounds and types are computed once and stored in contiguous arrays
+ *
+ *  The bounds, bound types, constraint types and numbers of nonzeros of the reformulated model (scaling, slacks,
+ *  bound relaxation, ...) are constant during the solve. A query costs a single virtual call and an array access
+ *  instead of a virtual call per reformulation. The evaluations are forwarded to the chain.
+ */
+class MaterializedModel: public Model {
+public:
+   explicit MaterializedModel(std::unique_ptr<Model> original_model);
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override;
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override;
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override;
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override;
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override;
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override;
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override;
+
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override;
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override;
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override;
+
+   void get_initial_primal_point(std::vector<double>& x) const override;
+   void get_initial_dual_point(std::vector<double>& multipliers) const override;
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
+
+private:
+   std::unique_ptr<Model> original_model;
+   std::vector<double> variable_lower_bounds;
+   std::vector<double> variable_upper_bounds;
+   std::vector<double> constraint_lower_bounds;
+   std::vector<double> constraint_upper_bounds;
+   std::vector<BoundType> variable_status;
+   std::vector<FunctionType> constraint_type;
+   std::vector<BoundType> constraint_status;
+   std::vector<size_t> linear_constraints;
+};
+
+inline MaterializedModel::MaterializedModel(std::unique_ptr<Model> original_model):
+      Model(original_model->name, original_model->number_variables, original_model->number_constraints),
+      original_model(std::move(original_model)),
+      variable_lower_bounds(this->number_variables),
+      variable_upper_bounds(this->number_variables),
+      constraint_lower_bounds(this->number_constraints),
+      constraint_upper_bounds(this->number_constraints),
+      variable_status(this->number_variables),
+      constraint_type(this->number_constraints),
+      constraint_status(this->number_constraints),
+      linear_constraints(this->original_model->get_linear_constraints()) {
+   // evaluate the bounds and types through the chain once
+   for (size_t i: Range(this->number_variables)) {
+      this->variable_lower_bounds[i] = this->original_model->get_variable_lower_bound(i);
+      this->variable_upper_bounds[i] = this->original_model->get_variable_upper_bound(i);
+      this->variable_status[i] = this->original_model->get_variable_bound_type(i);
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      this->constraint_lower_bounds[j] = this->original_model->get_constraint_lower_bound(j);
+      this->constraint_upper_bounds[j] = this->original_model->get_constraint_upper_bound(j);
+      this->constraint_type[j] = this->original_model->get_constraint_type(j);
+      this->constraint_status[j] = this->original_model->get_constraint_bound_type(j);
+   }
+   this->number_objective_gradient_nonzeros = this->original_model->get_number_objective_gradient_nonzeros();
+   this->number_jacobian_nonzeros = this->original_model->get_number_jacobian_nonzeros();
+   this->number_hessian_nonzeros = this->original_model->get_number_hessian_nonzeros();
+
+   // the index sets are those of the original model
+   this->objective_sign = this->original_model->objective_sign;
+   this->equality_constraints = this->original_model->equality_constraints;
+   this->inequality_constraints = this->original_model->inequality_constraints;
+   this->original_model->slacks.for_each([&](size_t j, size_t i) {
+      this->slacks.insert(j, i);
+   });
+   this->lower_bounded_variables = this->original_model->lower_bounded_variables;
+   this->upper_bounded_variables = this->original_model->upper_bounded_variables;
+   this->single_lower_bounded_variables = this->original_model->single_lower_bounded_variables;
+   this->single_upper_bounded_variables = this->original_model->single_upper_bounded_variables;
+}
+
+inline double MaterializedModel::get_variable_lower_bound(size_t i) const {
+   return this->variable_lower_bounds[i];
+}
+
+inline double MaterializedModel::get_variable_upper_bound(size_t i) const {
+   return this->variable_upper_bounds[i];
+}
+
+inline double MaterializedModel::get_constraint_lower_bound(size_t j) const {
+   return this->constraint_lower_bounds[j];
+}
+
+inline double MaterializedModel::get_constraint_upper_bound(size_t j) const {
+   return this->constraint_upper_bounds[j];
+}
+
+inline double MaterializedModel::evaluate_objective(const std::vector<double>& x) const {
+   return this->original_model->evaluate_objective(x);
+}
+
+inline void MaterializedModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   this->original_model->evaluate_objective_gradient(x, gradient);
+}
+
+inline void MaterializedModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   this->original_model->evaluate_constraints(x, constraints);
+}
+
+inline void MaterializedModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   this->original_model->evaluate_constraint_gradient(x, j, gradient);
+}
+
+inline void MaterializedModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   this->original_model->evaluate_constraint_jacobian(x, constraint_jacobian);
+}
+
+inline void MaterializedModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier,
+      const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const {
+   this->original_model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+}
+
+inline BoundType MaterializedModel::get_variable_bound_type(size_t i) const {
+   return this->variable_status[i];
+}
+
+inline FunctionType MaterializedModel::get_constraint_type(size_t j) const {
+   return this->constraint_type[j];
+}
+
+inline BoundType MaterializedModel::get_constraint_bound_type(size_t j) const {
+   return this->constraint_status[j];
+}
+
+inline size_t MaterializedModel::get_number_objective_gradient_nonzeros() const {
+   return this->number_objective_gradient_nonzeros;
+}
+
+inline size_t MaterializedModel::get_number_jacobian_nonzeros() const {
+   return this->number_jacobian_nonzeros;
+}
+
+inline size_t MaterializedModel::get_number_hessian_nonzeros() const {
+   return this->number_hessian_nonzeros;
+}
+
+inline void MaterializedModel::get_initial_primal_point(std::vector<double>& x) const {
+   this->original_model->get_initial_primal_point(x);
+}
+
+inline void MaterializedModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   this->original_model->get_initial_dual_point(multipliers);
+}
+
+inline void MaterializedModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
+   this->original_model->postprocess_solution(iterate, termination_status);
+}
+
+inline const std::vector<size_t>& MaterializedModel::get_linear_constraints() const {
+   return this->linear_constraints;
+}
+
+inline bool MaterializedModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
+#endif // UNO_MATERIALIZEDMODEL_H
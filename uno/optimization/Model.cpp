@@ -1,11 +1,13 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <cassert>
 #include <utility>
 #include "Model.hpp"
+#include "linear_algebra/CSCSymmetricMatrix.hpp"
 #include "linear_algebra/VectorExpression.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "tools/Infinity.hpp"
@@ -53,6 +55,65 @@ bool Model::is_constrained() const {
    return (0 < this->number_constraints);
 }
 
+void Model::evaluate_constraint_subset(const std::vector<double>& x, const std::vector<size_t>& /*constraint_indices*/,
+      std::vector<double>& constraints) const {
+   this->evaluate_constraints(x, constraints);
+}
+
+void Model::evaluate_constraint_subset_jacobian(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+      RectangularMatrix<double>& constraint_jacobian) const {
+   for (size_t j: constraint_indices) {
+      constraint_jacobian[j].clear();
+      this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+   }
+}
+
+double Model::evaluate_objective_subset(const std::vector<double>& x, const std::vector<size_t>& /*variable_indices*/) const {
+   return this->evaluate_objective(x);
+}
+
+void Model::evaluate_objective_subset_gradient(const std::vector<double>& x, const std::vector<size_t>& /*variable_indices*/,
+      SparseVector<double>& gradient) const {
+   this->evaluate_objective_gradient(x, gradient);
+}
+
+// the whole Hessian is evaluated in a temporary matrix, then the rows and columns of the subset are copied
+void Model::evaluate_lagrangian_subset_hessian(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+      const std::vector<size_t>& /*constraint_indices*/, double objective_multiplier, const std::vector<double>& multipliers,
+      SymmetricMatrix<double>& hessian) const {
+   CSCSymmetricMatrix<double> full_hessian(this->number_variables, this->get_number_hessian_nonzeros(), false);
+   this->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, full_hessian);
+
+   // the positions in the subset are increasing: the columns of the subset come in order
+   const auto position = [&](size_t i) {
+      const auto entry = std::lower_bound(variable_indices.cbegin(), variable_indices.cend(), i);
+      return (entry != variable_indices.cend() && *entry == i) ? static_cast<size_t>(entry - variable_indices.cbegin()) : variable_indices.size();
+   };
+   hessian.reset();
+   size_t current_column = 0;
+   full_hessian.for_each([&](size_t row_index, size_t column_index, double entry) {
+      const size_t reduced_row = position(row_index);
+      const size_t reduced_column = position(column_index);
+      if (reduced_row < variable_indices.size() && reduced_column < variable_indices.size()) {
+         for (; current_column < reduced_column; current_column++) {
+            hessian.finalize_column(current_column);
+         }
+         hessian.insert(entry, reduced_row, reduced_column);
+      }
+   });
+   for (; current_column < variable_indices.size(); current_column++) {
+      hessian.finalize_column(current_column);
+   }
+}
+
+bool Model::is_quadratic_program() const {
+   return false;
+}
+
+bool Model::is_reentrant() const {
+   return false;
+}
+
 double Model::compute_constraint_violation(double constraint_value, size_t j) const {
    const double lower_bound_violation = std::max(0., this->get_constraint_lower_bound(j) - constraint_value);
    const double upper_bound_violation = std::max(0., constraint_value - this->get_constraint_upper_bound(j));
@@ -61,7 +122,7 @@ double Model::compute_constraint_violation(double constraint_value, size_t j) co
 
 // compute ||c||
 double Model::compute_constraint_violation(const std::vector<double>& constraints, Norm residual_norm) const {
-   VectorExpression<double> constraint_violation(constraints.size(), [&](size_t j) {
+   const VectorExpression constraint_violation(constraints.size(), [&](size_t j) {
       return this->compute_constraint_violation(constraints[j], j);
    });
    return norm(residual_norm, constraint_violation);
@@ -70,7 +131,7 @@ double Model::compute_constraint_violation(const std::vector<double>& constraint
 double Model::compute_linearized_constraint_violation(const std::vector<double>& primal_direction, const std::vector<double>& constraints,
       const RectangularMatrix<double>& constraint_jacobian, double step_length, Norm residual_norm) const {
    // determine the linearized constraint violation term: ||c(x_k) + α ∇c(x_k)^T d||
-   VectorExpression<double> linearized_constraints(this->number_constraints, [&](size_t j) {
+   const VectorExpression linearized_constraints(this->number_constraints, [&](size_t j) {
       const double linearized_constraint_j = constraints[j] + step_length * dot(primal_direction, constraint_jacobian[j]);
       return this->compute_constraint_violation(linearized_constraint_j, j);
    });
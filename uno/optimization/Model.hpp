@@ -75,6 +75,23 @@ public:
    virtual void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const = 0;
    virtual void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
          SymmetricMatrix<double>& hessian) const = 0;
+   // functions of a subset of the constraints (e.g. a block of a decomposed model): only the entries and the rows of the
+   // subset are written. By default, all the constraints are evaluated and the gradients of the subset one by one
+   virtual void evaluate_constraint_subset(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+         std::vector<double>& constraints) const;
+   virtual void evaluate_constraint_subset_jacobian(const std::vector<double>& x, const std::vector<size_t>& constraint_indices,
+         RectangularMatrix<double>& constraint_jacobian) const;
+   // functions restricted to a subset of the variables (sorted), the other variables being fixed (e.g. a block of a
+   // decomposed model). The objective terms that do not depend on the subset may be left out: the objective is evaluated
+   // up to a constant, and at least the entries of the subset of its gradient are written. The Hessian of the Lagrangian
+   // (the multipliers of the constraints not in the subset are zero) is indexed by the positions in the subset.
+   // By default, the whole functions are evaluated
+   [[nodiscard]] virtual double evaluate_objective_subset(const std::vector<double>& x, const std::vector<size_t>& variable_indices) const;
+   virtual void evaluate_objective_subset_gradient(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+         SparseVector<double>& gradient) const;
+   virtual void evaluate_lagrangian_subset_hessian(const std::vector<double>& x, const std::vector<size_t>& variable_indices,
+         const std::vector<size_t>& constraint_indices, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const;
 
    virtual void get_initial_primal_point(std::vector<double>& x) const = 0;
    virtual void get_initial_dual_point(std::vector<double>& multipliers) const = 0;
@@ -82,6 +99,11 @@ public:
 
    // constraints
    [[nodiscard]] virtual const std::vector<size_t>& get_linear_constraints() const = 0;
+   // the objective is (at most) quadratic and the constraints are linear: the model is its own quadratic model and its
+   // Hessian only depends on the objective multiplier
+   [[nodiscard]] virtual bool is_quadratic_program() const;
+   // the model can be evaluated by several threads concurrently
+   [[nodiscard]] virtual bool is_reentrant() const;
 
    // auxiliary functions
    static void determine_bounds_types(std::vector<Interval>& variables_bounds, std::vector<BoundType>& status);
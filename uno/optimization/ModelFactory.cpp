@@ -1,14 +1,26 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
-#ifdef WITH_AMPL
-
 #include "ModelFactory.hpp"
 #include "EqualityConstrainedModel.hpp"
 #include "ScaledModel.hpp"
 #include "BoundRelaxedModel.hpp"
+#include "PresolvedModel.hpp"
+#include "CachedModel.hpp"
+#include "ConstantDerivativesModel.hpp"
+#include "MaterializedModel.hpp"
 #include "preprocessing/Scaling.hpp"
 
+// note: transfer ownership of the pointer
+std::unique_ptr<Model> ModelFactory::presolve(std::unique_ptr<Model> model, const Options& options) {
+   // optional: remove the fixed variables and the trivial linear constraints
+   if (options.get_bool("presolve")) {
+      Presolve presolve(*model, options.get_double("presolve_tolerance"), options.get_double("presolve_bound_relaxation"));
+      model = std::make_unique<PresolvedModel>(std::move(model), std::move(presolve));
+   }
+   return model;
+}
+
 // note: transfer ownership of the pointer
 std::unique_ptr<Model> ModelFactory::reformulate(std::unique_ptr<Model> model, Iterate& initial_iterate, const Options& options) {
    // optional: scale the problem using the evaluations at the first iterate
@@ -26,7 +38,21 @@ std::unique_ptr<Model> ModelFactory::reformulate(std::unique_ptr<Model> model, I
       model = std::make_unique<BoundRelaxedModel>(std::move(model), options);
       initial_iterate.set_number_variables(model->number_variables);
    }
+
+   // optional: evaluate the constant derivatives (linear constraints, Hessian of a quadratic program) once
+   if (options.get_bool("cache_constant_derivatives")) {
+      model = std::make_unique<ConstantDerivativesModel>(std::move(model));
+   }
+
+   // optional: share the evaluations between the iterates at the same primal point
+   const size_t evaluation_cache_size = options.get_unsigned_int("evaluation_cache_size");
+   if (0 < evaluation_cache_size) {
+      model = std::make_unique<CachedModel>(std::move(model), evaluation_cache_size);
+   }
+
+   // optional: compute the bounds and types of the reformulated model once
+   if (options.get_bool("materialize_model")) {
+      model = std::make_unique<MaterializedModel>(std::move(model));
+   }
    return model;
 }
-
-#endif // WITH_AMPL
\ No newline at end of file
@@ -4,20 +4,15 @@
 #ifndef UNO_MODELFACTORY_H
 #define UNO_MODELFACTORY_H
 
-#ifdef WITH_AMPL
-
 #include <memory>
 #include "Model.hpp"
 #include "Iterate.hpp"
-#include "interfaces/AMPL/AMPLModel.hpp"
 #include "tools/Options.hpp"
 
 class ModelFactory {
 public:
+   static std::unique_ptr<Model> presolve(std::unique_ptr<Model> model, const Options& options);
    static std::unique_ptr<Model> reformulate(std::unique_ptr<Model> model, Iterate& initial_iterate, const Options& options);
 };
 
-
-#endif // WITH_AMPL
-
 #endif // UNO_MODELFACTORY_H
@@ -0,0 +1,60 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PRESOLVEDMODEL_H
+#define UNO_PRESOLVEDMODEL_H
+
+#include <memory>
+#include "SubModel.hpp"
+#include "Iterate.hpp"
+#include "preprocessing/Presolve.hpp"
+
+// model without the variables and linear constraints removed by the presolve. The removed variables take their fixed values
+class PresolvedModel: public SubModel {
+public:
+   PresolvedModel(std::shared_ptr<const Model> original_model, Presolve presolve);
+
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+private:
+   const Presolve presolve;
+};
+
+// the pointer is copied: the name is read from it in the same full expression
+inline PresolvedModel::PresolvedModel(std::shared_ptr<const Model> original_model, Presolve presolve):
+      SubModel(original_model->name + "_presolved", original_model, presolve.get_original_variables(),
+            presolve.get_original_constraints(), presolve.get_fixed_values(), presolve.get_reduced_bounds()),
+      presolve(std::move(presolve)) {
+   this->presolve.print_summary();
+}
+
+// postsolve: map the primal and dual solutions back to the original model
+inline void PresolvedModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
+   this->expand_primals(iterate.primals);
+   Multipliers multipliers(this->original_model->number_variables, this->original_model->number_constraints);
+   multipliers.objective = iterate.multipliers.objective;
+   for (size_t i: Range(this->number_variables)) {
+      const size_t original_i = this->original_variable_indices[i];
+      multipliers.lower_bounds[original_i] = iterate.multipliers.lower_bounds[i];
+      multipliers.upper_bounds[original_i] = iterate.multipliers.upper_bounds[i];
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      multipliers.constraints[this->original_constraint_indices[j]] = iterate.multipliers.constraints[j];
+   }
+   this->presolve.postsolve(*this->original_model, this->full_primals, multipliers);
+
+   // resize the iterate to the dimensions of the original model
+   iterate.set_number_variables(this->original_model->number_variables);
+   iterate.number_constraints = this->original_model->number_constraints;
+   iterate.primals = this->full_primals;
+   iterate.multipliers = multipliers;
+   iterate.evaluations.constraints.resize(this->original_model->number_constraints);
+   this->original_model->evaluate_constraints(iterate.primals, iterate.evaluations.constraints);
+   // the derivatives are those of the presolved model
+   iterate.is_objective_gradient_computed = false;
+   iterate.is_constraint_jacobian_computed = false;
+
+   this->original_model->postprocess_solution(iterate, termination_status);
+}
+
+#endif // UNO_PRESOLVEDMODEL_H
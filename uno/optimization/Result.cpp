@@ -58,4 +58,5 @@ void Result::print(bool print_primal_dual_solution) const {
    std::cout << "Jacobian evaluations:\t\t\t" << this->jacobian_evaluations << '\n';
    std::cout << "Hessian evaluations:\t\t\t" << this->hessian_evaluations << '\n';
    std::cout << "Number of subproblems solved:\t\t" << this->number_subproblems_solved << '\n';
+   std::cout << "Evaluation cache hits/misses:\t\t" << this->evaluation_cache_hits << '/' << this->evaluation_cache_misses << '\n';
 }
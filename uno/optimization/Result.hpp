@@ -21,6 +21,8 @@ struct Result {
    size_t jacobian_evaluations;
    size_t hessian_evaluations;
    size_t number_subproblems_solved;
+   size_t evaluation_cache_hits;
+   size_t evaluation_cache_misses;
 
    void print(bool print_primal_dual_solution) const;
 };
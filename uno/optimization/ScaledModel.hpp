@@ -38,16 +38,19 @@ public:
    void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
 
    [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
 
 private:
    std::unique_ptr<Model> original_model;
    Scaling scaling;
+   mutable std::vector<double> scaled_multipliers;
 };
 
 inline ScaledModel::ScaledModel(std::unique_ptr<Model> original_model, Iterate& initial_iterate, const Options& options):
       Model(original_model->name + "_scaled", original_model->number_variables, original_model->number_constraints),
       original_model(std::move(original_model)),
-      scaling(this->original_model->number_constraints, options.get_double("function_scaling_threshold")) {
+      scaling(this->original_model->number_constraints, options.get_double("function_scaling_threshold")),
+      scaled_multipliers(this->number_constraints) {
    if (options.get_bool("scale_functions")) {
       // evaluate the gradients at the current point
       initial_iterate.evaluate_objective_gradient(*this->original_model);
@@ -153,13 +156,11 @@ inline void ScaledModel::evaluate_lagrangian_hessian(const std::vector<double>&
       const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const {
    // scale the objective and constraint multipliers
    const double scaled_objective_multiplier = objective_multiplier*this->scaling.get_objective_scaling();
-   // TODO preallocate this vector
    // TODO check if the multipliers should be scaled
-   static std::vector<double> scaled_multipliers(this->number_constraints);
    for (size_t j: Range(this->number_constraints)) {
-      scaled_multipliers[j] = scaling.get_constraint_scaling(j)*multipliers[j];
+      this->scaled_multipliers[j] = scaling.get_constraint_scaling(j)*multipliers[j];
    }
-   this->original_model->evaluate_lagrangian_hessian(x, scaled_objective_multiplier, scaled_multipliers, hessian);
+   this->original_model->evaluate_lagrangian_hessian(x, scaled_objective_multiplier, this->scaled_multipliers, hessian);
 }
 
 inline BoundType ScaledModel::get_variable_bound_type(size_t i) const {
@@ -195,8 +196,6 @@ inline void ScaledModel::get_initial_dual_point(std::vector<double>& multipliers
 }
 
 inline void ScaledModel::postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const {
-   this->original_model->postprocess_solution(iterate, termination_status);
-
    // unscale the objective value
    iterate.evaluations.objective /= this->scaling.get_objective_scaling();
 
@@ -210,10 +209,17 @@ inline void ScaledModel::postprocess_solution(Iterate& iterate, TerminationStatu
       iterate.multipliers.lower_bounds[i] /= this->scaling.get_objective_scaling();
       iterate.multipliers.upper_bounds[i] /= this->scaling.get_objective_scaling();
    }
+
+   // the transformations are undone from the outermost to the innermost
+   this->original_model->postprocess_solution(iterate, termination_status);
 }
 
 inline const std::vector<size_t>& ScaledModel::get_linear_constraints() const {
    return this->original_model->get_linear_constraints();
 }
 
+inline bool ScaledModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
 #endif // UNO_SCALEDMODEL_H
@@ -0,0 +1,306 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SUBMODEL_H
+#define UNO_SUBMODEL_H
+
+#include <memory>
+#include "Model.hpp"
+#include "tools/Infinity.hpp"
+
+// view of a model restricted to a subset of its variables and constraints. The functions are evaluated by the original
+// model at the full point, in which the other variables keep fixed values. The constraints keep their bounds. A small
+// subset of constraints (e.g. a block of a decomposed model) is evaluated on its own, a large subset (e.g. a presolved
+// model) in a single evaluation of all the constraints. The objective, its gradient and the Lagrangian Hessian are
+// evaluated on the subset of the variables (Model::evaluate_objective_subset): the objective terms that do not depend
+// on the subset are constant and are evaluated once. The contributions of the other constraints to the Hessian must
+// not involve the variables of the subset. The original model is only accessed through its const interface: a
+// reentrant model can be shared by several submodels
+class SubModel: public Model {
+public:
+   static constexpr size_t NOT_KEPT = static_cast<size_t>(-1);
+
+   // the variable indices are sorted in increasing order. other_values contains the values of all the original variables
+   SubModel(std::string name, std::shared_ptr<const Model> original_model, std::vector<size_t> variables, std::vector<size_t> constraints,
+         const std::vector<double>& other_values, std::vector<Interval> variable_bounds);
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override;
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override;
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override;
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override;
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override;
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override;
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override;
+
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override;
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override;
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override;
+
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override;
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override;
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override;
+
+   void get_initial_primal_point(std::vector<double>& x) const override;
+   void get_initial_dual_point(std::vector<double>& multipliers) const override;
+   // the solution stays in the space of the subset: mapping it back is the responsibility of the caller
+   void postprocess_solution(Iterate& iterate, TerminationStatus termination_status) const override;
+
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override;
+   [[nodiscard]] bool is_quadratic_program() const override;
+
+   [[nodiscard]] size_t original_variable(size_t i) const;
+   [[nodiscard]] size_t original_constraint(size_t j) const;
+
+protected:
+   const std::shared_ptr<const Model> original_model;
+   const std::vector<size_t> original_variable_indices;
+   std::vector<size_t> reduced_variable_indices; // NOT_KEPT if the variable is not in the subset
+   const std::vector<size_t> original_constraint_indices;
+   const std::vector<Interval> variable_bounds;
+   const bool evaluate_all_constraints;
+   double objective_offset{0.}; // objective terms that do not depend on the subset
+   bool evaluate_whole_objective{false};
+   std::vector<BoundType> variable_status;
+   std::vector<size_t> linear_constraints{};
+
+   // evaluations of the original model
+   mutable std::vector<double> full_primals;
+   mutable std::vector<double> full_vector;
+   mutable std::vector<double> full_multipliers; // zero outside of the Hessian evaluations
+   mutable SparseVector<double> full_gradient;
+   mutable RectangularMatrix<double> full_jacobian;
+
+   void expand_primals(const std::vector<double>& x) const;
+   void reduce_gradient(const SparseVector<double>& original_gradient, SparseVector<double>& gradient) const;
+};
+
+inline SubModel::SubModel(std::string name, std::shared_ptr<const Model> original_model, std::vector<size_t> variables, std::vector<size_t> constraints,
+      const std::vector<double>& other_values, std::vector<Interval> variable_bounds):
+      Model(std::move(name), variables.size(), constraints.size()),
+      original_model(std::move(original_model)),
+      original_variable_indices(std::move(variables)),
+      reduced_variable_indices(this->original_model->number_variables, NOT_KEPT),
+      original_constraint_indices(std::move(constraints)),
+      variable_bounds(std::move(variable_bounds)),
+      evaluate_all_constraints(this->original_model->number_constraints <= 2 * this->number_constraints),
+      variable_status(this->number_variables),
+      full_primals(other_values),
+      full_vector(this->original_model->number_constraints),
+      full_multipliers(this->original_model->number_constraints, 0.),
+      full_gradient(this->original_model->number_variables),
+      full_jacobian(this->original_model->number_constraints) {
+   for (size_t i: Range(this->number_variables)) {
+      this->reduced_variable_indices[this->original_variable_indices[i]] = i;
+   }
+
+   // bounds of the variables
+   std::vector<Interval> bounds = this->variable_bounds;
+   Model::determine_bounds_types(bounds, this->variable_status);
+   for (size_t i: Range(this->number_variables)) {
+      if (is_finite(this->variable_bounds[i].lb)) {
+         this->lower_bounded_variables.push_back(i);
+         if (not is_finite(this->variable_bounds[i].ub)) {
+            this->single_lower_bounded_variables.push_back(i);
+         }
+      }
+      if (is_finite(this->variable_bounds[i].ub)) {
+         this->upper_bounded_variables.push_back(i);
+         if (not is_finite(this->variable_bounds[i].lb)) {
+            this->single_upper_bounded_variables.push_back(i);
+         }
+      }
+   }
+
+   // the constraint repartition is the same as in the original model
+   std::vector<size_t> reduced_constraint_indices(this->original_model->number_constraints, NOT_KEPT);
+   for (size_t j: Range(this->number_constraints)) {
+      const size_t original_j = this->original_constraint_indices[j];
+      reduced_constraint_indices[original_j] = j;
+      if (this->original_model->get_constraint_bound_type(original_j) == EQUAL_BOUNDS) {
+         this->equality_constraints.push_back(j);
+      }
+      else {
+         this->inequality_constraints.push_back(j);
+      }
+   }
+   for (size_t j: this->original_model->get_linear_constraints()) {
+      if (reduced_constraint_indices[j] != NOT_KEPT) {
+         this->linear_constraints.push_back(reduced_constraint_indices[j]);
+      }
+   }
+   for (size_t original_j: this->original_constraint_indices) {
+      this->full_jacobian[original_j].reserve(this->original_model->number_variables);
+   }
+
+   // the objective terms that do not depend on the subset are evaluated at the fixed values. If they cannot be evaluated,
+   // the whole objective is
+   try {
+      this->objective_offset = this->original_model->evaluate_objective(this->full_primals) -
+            this->original_model->evaluate_objective_subset(this->full_primals, this->original_variable_indices);
+   }
+   catch (const EvaluationError&) {
+      this->evaluate_whole_objective = true;
+   }
+}
+
+inline double SubModel::get_variable_lower_bound(size_t i) const {
+   return this->variable_bounds[i].lb;
+}
+
+inline double SubModel::get_variable_upper_bound(size_t i) const {
+   return this->variable_bounds[i].ub;
+}
+
+inline double SubModel::get_constraint_lower_bound(size_t j) const {
+   return this->original_model->get_constraint_lower_bound(this->original_constraint_indices[j]);
+}
+
+inline double SubModel::get_constraint_upper_bound(size_t j) const {
+   return this->original_model->get_constraint_upper_bound(this->original_constraint_indices[j]);
+}
+
+// the other variables keep their values
+inline void SubModel::expand_primals(const std::vector<double>& x) const {
+   for (size_t i: Range(this->number_variables)) {
+      this->full_primals[this->original_variable_indices[i]] = x[i];
+   }
+}
+
+inline void SubModel::reduce_gradient(const SparseVector<double>& original_gradient, SparseVector<double>& gradient) const {
+   original_gradient.for_each([&](size_t i, double derivative) {
+      const size_t reduced_i = this->reduced_variable_indices[i];
+      if (reduced_i != NOT_KEPT) {
+         gradient.insert(reduced_i, derivative);
+      }
+   });
+}
+
+inline double SubModel::evaluate_objective(const std::vector<double>& x) const {
+   this->expand_primals(x);
+   if (this->evaluate_whole_objective) {
+      return this->original_model->evaluate_objective(this->full_primals);
+   }
+   return this->objective_offset + this->original_model->evaluate_objective_subset(this->full_primals, this->original_variable_indices);
+}
+
+inline void SubModel::evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const {
+   this->expand_primals(x);
+   this->full_gradient.clear();
+   this->original_model->evaluate_objective_subset_gradient(this->full_primals, this->original_variable_indices, this->full_gradient);
+   this->reduce_gradient(this->full_gradient, gradient);
+}
+
+inline void SubModel::evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const {
+   this->expand_primals(x);
+   if (this->evaluate_all_constraints) {
+      this->original_model->evaluate_constraints(this->full_primals, this->full_vector);
+   }
+   else {
+      this->original_model->evaluate_constraint_subset(this->full_primals, this->original_constraint_indices, this->full_vector);
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      constraints[j] = this->full_vector[this->original_constraint_indices[j]];
+   }
+}
+
+inline void SubModel::evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const {
+   this->expand_primals(x);
+   this->full_gradient.clear();
+   this->original_model->evaluate_constraint_gradient(this->full_primals, this->original_constraint_indices[j], this->full_gradient);
+   this->reduce_gradient(this->full_gradient, gradient);
+}
+
+inline void SubModel::evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+   this->expand_primals(x);
+   if (this->evaluate_all_constraints) {
+      for (auto& row: this->full_jacobian) {
+         row.clear();
+      }
+      this->original_model->evaluate_constraint_jacobian(this->full_primals, this->full_jacobian);
+   }
+   else {
+      this->original_model->evaluate_constraint_subset_jacobian(this->full_primals, this->original_constraint_indices, this->full_jacobian);
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      this->reduce_gradient(this->full_jacobian[this->original_constraint_indices[j]], constraint_jacobian[j]);
+   }
+}
+
+inline void SubModel::evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+      SymmetricMatrix<double>& hessian) const {
+   this->expand_primals(x);
+   // the other constraints have a zero multiplier
+   for (size_t j: Range(this->number_constraints)) {
+      this->full_multipliers[this->original_constraint_indices[j]] = multipliers[j];
+   }
+   this->original_model->evaluate_lagrangian_subset_hessian(this->full_primals, this->original_variable_indices, this->original_constraint_indices,
+         objective_multiplier, this->full_multipliers, hessian);
+   for (size_t original_j: this->original_constraint_indices) {
+      this->full_multipliers[original_j] = 0.;
+   }
+}
+
+inline BoundType SubModel::get_variable_bound_type(size_t i) const {
+   return this->variable_status[i];
+}
+
+inline FunctionType SubModel::get_constraint_type(size_t j) const {
+   return this->original_model->get_constraint_type(this->original_constraint_indices[j]);
+}
+
+inline BoundType SubModel::get_constraint_bound_type(size_t j) const {
+   return this->original_model->get_constraint_bound_type(this->original_constraint_indices[j]);
+}
+
+inline size_t SubModel::get_number_objective_gradient_nonzeros() const {
+   return this->original_model->get_number_objective_gradient_nonzeros();
+}
+
+inline size_t SubModel::get_number_jacobian_nonzeros() const {
+   return this->original_model->get_number_jacobian_nonzeros();
+}
+
+inline size_t SubModel::get_number_hessian_nonzeros() const {
+   return this->original_model->get_number_hessian_nonzeros();
+}
+
+inline void SubModel::get_initial_primal_point(std::vector<double>& x) const {
+   std::vector<double> full_initial_point(this->original_model->number_variables);
+   this->original_model->get_initial_primal_point(full_initial_point);
+   for (size_t i: Range(this->number_variables)) {
+      x[i] = full_initial_point[this->original_variable_indices[i]];
+   }
+}
+
+inline void SubModel::get_initial_dual_point(std::vector<double>& multipliers) const {
+   this->original_model->get_initial_dual_point(this->full_vector);
+   for (size_t j: Range(this->number_constraints)) {
+      multipliers[j] = this->full_vector[this->original_constraint_indices[j]];
+   }
+}
+
+inline void SubModel::postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const {
+}
+
+inline const std::vector<size_t>& SubModel::get_linear_constraints() const {
+   return this->linear_constraints;
+}
+
+inline bool SubModel::is_quadratic_program() const {
+   return this->original_model->is_quadratic_program();
+}
+
+inline size_t SubModel::original_variable(size_t i) const {
+   return this->original_variable_indices[i];
+}
+
+inline size_t SubModel::original_constraint(size_t j) const {
+   return this->original_constraint_indices[j];
+}
+
+#endif // UNO_SUBMODEL_H
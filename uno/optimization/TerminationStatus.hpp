@@ -4,6 +4,8 @@
 #ifndef UNO_TERMINATIONSTATUS_H
 #define UNO_TERMINATIONSTATUS_H
 
+#include <string>
+
 enum class TerminationStatus {
    NOT_OPTIMAL = 0,
    FEASIBLE_KKT_POINT, /* feasible stationary point */
@@ -14,4 +16,23 @@ enum class TerminationStatus {
    UNBOUNDED
 };
 
+[[nodiscard]] inline std::string to_string(TerminationStatus status) {
+   switch (status) {
+      case TerminationStatus::FEASIBLE_KKT_POINT:
+         return "feasible KKT point";
+      case TerminationStatus::FEASIBLE_FJ_POINT:
+         return "feasible FJ point";
+      case TerminationStatus::INFEASIBLE_STATIONARY_POINT:
+         return "infeasible stationary point";
+      case TerminationStatus::FEASIBLE_SMALL_STEP:
+         return "feasible small step";
+      case TerminationStatus::INFEASIBLE_SMALL_STEP:
+         return "infeasible small step";
+      case TerminationStatus::UNBOUNDED:
+         return "unbounded";
+      default:
+         return "suboptimal point";
+   }
+}
+
 #endif // UNO_TERMINATIONSTATUS_H
@@ -10,6 +10,8 @@ struct WarmstartInformation {
    bool constraint_bounds_changed{false};
    bool variable_bounds_changed{false};
    bool problem_changed{false};
+   // the Hessian is constant for quadratic programs: the subproblem clears this flag if it did not reevaluate it
+   bool hessian_changed{true};
 
    void display() const;
    void set_cold_start();
@@ -24,6 +26,7 @@ inline void WarmstartInformation::display() const {
    std::cout << "Constraint bounds: " << std::boolalpha << this->constraint_bounds_changed << '\n';
    std::cout << "Variable bounds: " << std::boolalpha << this->variable_bounds_changed << '\n';
    std::cout << "Problem: " << std::boolalpha << this->problem_changed << '\n';
+   std::cout << "Hessian: " << std::boolalpha << this->hessian_changed << '\n';
 }
 
 inline void WarmstartInformation::set_cold_start() {
@@ -32,6 +35,7 @@ inline void WarmstartInformation::set_cold_start() {
    this->constraint_bounds_changed = true;
    this->variable_bounds_changed = true;
    this->problem_changed = true;
+   this->hessian_changed = true;
 }
 
 inline void WarmstartInformation::set_hot_start() {
@@ -40,6 +44,7 @@ inline void WarmstartInformation::set_hot_start() {
    this->constraint_bounds_changed = true;
    this->variable_bounds_changed = true;
    this->problem_changed = false;
+   this->hessian_changed = true;
 }
 
 inline void WarmstartInformation::only_objective_changed() {
@@ -48,6 +53,7 @@ inline void WarmstartInformation::only_objective_changed() {
    this->constraint_bounds_changed = false;
    this->variable_bounds_changed = false;
    this->problem_changed = false;
+   this->hessian_changed = true;
 }
 
 inline void WarmstartInformation::only_variable_bounds_changed() {
@@ -56,6 +62,7 @@ inline void WarmstartInformation::only_variable_bounds_changed() {
    this->constraint_bounds_changed = false;
    this->variable_bounds_changed = true;
    this->problem_changed = false;
+   this->hessian_changed = false;
 }
 
 #endif // UNO_WARMSTARTINFORMATION_H
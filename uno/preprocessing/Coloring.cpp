@@ -0,0 +1,125 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <numeric>
+#include "Coloring.hpp"
+#include "tools/Range.hpp"
+
+constexpr size_t NO_COLOR = static_cast<size_t>(-1);
+
+// vertices sorted by decreasing degree (ties broken by index)
+std::vector<size_t> largest_first_order(const std::vector<size_t>& degrees) {
+   std::vector<size_t> order(degrees.size());
+   std::iota(order.begin(), order.end(), 0);
+   std::stable_sort(order.begin(), order.end(), [&](size_t first_vertex, size_t second_vertex) {
+      return degrees[first_vertex] > degrees[second_vertex];
+   });
+   return order;
+}
+
+// smallest color that is not forbidden for the vertex
+size_t smallest_allowed_color(std::vector<size_t>& forbidden_for, size_t vertex) {
+   size_t color = 0;
+   while (color < forbidden_for.size() && forbidden_for[color] == vertex) {
+      color++;
+   }
+   if (color == forbidden_for.size()) {
+      forbidden_for.push_back(NO_COLOR);
+   }
+   return color;
+}
+
+std::vector<size_t> Coloring::color_columns(size_t number_columns, const std::vector<std::vector<size_t>>& rows) {
+   // rows of each column
+   std::vector<std::vector<size_t>> column_rows(number_columns);
+   for (size_t row_index: Range(rows.size())) {
+      for (size_t column_index: rows[row_index]) {
+         column_rows[column_index].push_back(row_index);
+      }
+   }
+   std::vector<size_t> degrees(number_columns, 0);
+   for (size_t column_index: Range(number_columns)) {
+      for (size_t row_index: column_rows[column_index]) {
+         degrees[column_index] += rows[row_index].size();
+      }
+   }
+
+   std::vector<size_t> colors(number_columns, NO_COLOR);
+   // forbidden_for[c] == v: the color c cannot be given to the column v
+   std::vector<size_t> forbidden_for{};
+   for (size_t column_index: largest_first_order(degrees)) {
+      for (size_t row_index: column_rows[column_index]) {
+         for (size_t other_column_index: rows[row_index]) {
+            if (colors[other_column_index] != NO_COLOR) {
+               forbidden_for[colors[other_column_index]] = column_index;
+            }
+         }
+      }
+      colors[column_index] = smallest_allowed_color(forbidden_for, column_index);
+   }
+   return colors;
+}
+
+// Gebremedhin, Manne and Pothen, algorithm 4.1
+std::vector<size_t> Coloring::color_star(size_t dimension, const std::vector<std::vector<size_t>>& columns) {
+   // adjacency graph (without the diagonal)
+   std::vector<std::vector<size_t>> neighbors(dimension);
+   for (size_t column_index: Range(columns.size())) {
+      for (size_t row_index: columns[column_index]) {
+         if (row_index != column_index) {
+            neighbors[row_index].push_back(column_index);
+            neighbors[column_index].push_back(row_index);
+         }
+      }
+   }
+   std::vector<size_t> degrees(dimension);
+   for (size_t vertex: Range(dimension)) {
+      std::sort(neighbors[vertex].begin(), neighbors[vertex].end());
+      neighbors[vertex].erase(std::unique(neighbors[vertex].begin(), neighbors[vertex].end()), neighbors[vertex].end());
+      degrees[vertex] = neighbors[vertex].size();
+   }
+
+   std::vector<size_t> colors(dimension, NO_COLOR);
+   std::vector<size_t> forbidden_for{};
+   for (size_t vertex: largest_first_order(degrees)) {
+      for (size_t neighbor: neighbors[vertex]) {
+         // distance-1 coloring
+         if (colors[neighbor] != NO_COLOR) {
+            forbidden_for[colors[neighbor]] = vertex;
+         }
+         for (size_t second_neighbor: neighbors[neighbor]) {
+            if (second_neighbor == vertex || colors[second_neighbor] == NO_COLOR) {
+               continue;
+            }
+            if (colors[neighbor] == NO_COLOR) {
+               // the path vertex - neighbor - second_neighbor would be colored with two colors only
+               forbidden_for[colors[second_neighbor]] = vertex;
+            }
+            else {
+               // the path vertex - neighbor - second_neighbor - third_neighbor would be bicolored
+               for (size_t third_neighbor: neighbors[second_neighbor]) {
+                  if (third_neighbor != neighbor && colors[third_neighbor] == colors[neighbor]) {
+                     forbidden_for[colors[second_neighbor]] = vertex;
+                     break;
+                  }
+               }
+            }
+         }
+      }
+      colors[vertex] = smallest_allowed_color(forbidden_for, vertex);
+   }
+   return colors;
+}
+
+size_t Coloring::number_colors(const std::vector<size_t>& colors) {
+   return colors.empty() ? 0 : *std::max_element(colors.cbegin(), colors.cend()) + 1;
+}
+
+std::vector<std::vector<size_t>> Coloring::group_by_color(const std::vector<size_t>& colors) {
+   std::vector<std::vector<size_t>> groups(Coloring::number_colors(colors));
+   for (size_t vertex: Range(colors.size())) {
+      groups[colors[vertex]].push_back(vertex);
+   }
+   return groups;
+}
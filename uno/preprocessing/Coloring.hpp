@@ -0,0 +1,25 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_COLORING_H
+#define UNO_COLORING_H
+
+#include <vector>
+
+// colorings of sparsity patterns for the compression of finite differences (Gebremedhin, Manne and Pothen, 2005). The
+// colors are 0, 1, ... and the vertices are colored greedily in largest-first order
+class Coloring {
+public:
+   // Curtis-Powell-Reid column coloring: two columns that have a nonzero in the same row have different colors. The rows
+   // contain the column indices of their nonzeros
+   [[nodiscard]] static std::vector<size_t> color_columns(size_t number_columns, const std::vector<std::vector<size_t>>& rows);
+   // star coloring of a symmetric pattern (the upper triangle of each column contains the row indices i <= j): distance-1
+   // coloring in which every path on four vertices uses at least three colors. The entries of the matrix can be recovered
+   // directly from the products of the matrix with the color vectors
+   [[nodiscard]] static std::vector<size_t> color_star(size_t dimension, const std::vector<std::vector<size_t>>& columns);
+   [[nodiscard]] static size_t number_colors(const std::vector<size_t>& colors);
+   // indices of the vertices of each color
+   [[nodiscard]] static std::vector<std::vector<size_t>> group_by_color(const std::vector<size_t>& colors);
+};
+
+#endif // UNO_COLORING_H
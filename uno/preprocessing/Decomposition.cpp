@@ -0,0 +1,93 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <numeric>
+#include "Decomposition.hpp"
+#include "linear_algebra/CSCSymmetricMatrix.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+
+// disjoint-set forest with path halving and union by size
+class DisjointSets {
+public:
+   explicit DisjointSets(size_t size): parent(size), set_size(size, 1) {
+      std::iota(this->parent.begin(), this->parent.end(), 0);
+   }
+
+   size_t find(size_t element) {
+      while (this->parent[element] != element) {
+         this->parent[element] = this->parent[this->parent[element]];
+         element = this->parent[element];
+      }
+      return element;
+   }
+
+   void merge(size_t first_element, size_t second_element) {
+      size_t first_root = this->find(first_element);
+      size_t second_root = this->find(second_element);
+      if (first_root != second_root) {
+         if (this->set_size[first_root] < this->set_size[second_root]) {
+            std::swap(first_root, second_root);
+         }
+         this->parent[second_root] = first_root;
+         this->set_size[first_root] += this->set_size[second_root];
+      }
+   }
+
+private:
+   std::vector<size_t> parent;
+   std::vector<size_t> set_size;
+};
+
+std::vector<ModelComponent> Decomposition::compute_components(const Model& model, const std::vector<double>& x) {
+   DisjointSets variable_sets(model.number_variables);
+
+   // the variables of a constraint belong to the same component
+   RectangularMatrix<double> constraint_jacobian(model.number_constraints);
+   for (auto& row: constraint_jacobian) {
+      row.reserve(model.number_variables);
+   }
+   model.evaluate_constraint_jacobian(x, constraint_jacobian);
+   std::vector<size_t> first_variable_of_constraint(model.number_constraints, model.number_variables);
+   for (size_t j: Range(model.number_constraints)) {
+      constraint_jacobian[j].for_each([&](size_t i, double /*derivative*/) {
+         if (first_variable_of_constraint[j] == model.number_variables) {
+            first_variable_of_constraint[j] = i;
+         }
+         else {
+            variable_sets.merge(first_variable_of_constraint[j], i);
+         }
+      });
+   }
+
+   // the nonlinear couplings of the objective and of the constraints appear in the Lagrangian Hessian. With unit multipliers,
+   // the pattern of every function is present
+   const std::vector<double> multipliers(model.number_constraints, 1.);
+   CSCSymmetricMatrix<double> hessian(model.number_variables, model.get_number_hessian_nonzeros(), false);
+   model.evaluate_lagrangian_hessian(x, 1., multipliers, hessian);
+   hessian.for_each([&](size_t row_index, size_t column_index, double /*entry*/) {
+      variable_sets.merge(row_index, column_index);
+   });
+
+   // number the components in the order of their smallest variable
+   std::vector<size_t> component_of_root(model.number_variables, model.number_variables);
+   std::vector<ModelComponent> components;
+   std::vector<size_t> component_of_variable(model.number_variables);
+   for (size_t i: Range(model.number_variables)) {
+      const size_t root = variable_sets.find(i);
+      if (component_of_root[root] == model.number_variables) {
+         component_of_root[root] = components.size();
+         components.emplace_back();
+      }
+      component_of_variable[i] = component_of_root[root];
+      components[component_of_variable[i]].variables.push_back(i);
+   }
+   // a constraint without variables is attached to the first component
+   for (size_t j: Range(model.number_constraints)) {
+      const size_t i = first_variable_of_constraint[j];
+      const size_t component_index = (i < model.number_variables) ? component_of_variable[i] : 0;
+      if (component_index < components.size()) {
+         components[component_index].constraints.push_back(j);
+      }
+   }
+   return components;
+}
@@ -0,0 +1,23 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DECOMPOSITION_H
+#define UNO_DECOMPOSITION_H
+
+#include <vector>
+#include "optimization/Model.hpp"
+
+// independent block of a model: its variables and constraints (sorted in increasing order)
+struct ModelComponent {
+   std::vector<size_t> variables{};
+   std::vector<size_t> constraints{};
+};
+
+class Decomposition {
+public:
+   // connected components of the graph whose vertices are the variables and whose edges are the nonzeros of the Jacobian
+   // rows and of the Lagrangian Hessian. The sparsity patterns are evaluated at x
+   [[nodiscard]] static std::vector<ModelComponent> compute_components(const Model& model, const std::vector<double>& x);
+};
+
+#endif // UNO_DECOMPOSITION_H
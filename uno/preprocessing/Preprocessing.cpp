@@ -2,7 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "Preprocessing.hpp"
-#include "solvers/QP/BQPDSolver.hpp"
+#include "solvers/QP/QPSolverFactory.hpp"
 #include "linear_algebra/CSCSymmetricMatrix.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 
@@ -103,11 +103,12 @@ void Preprocessing::enforce_linear_constraints(const Options& options, const Mod
          }
 
          // solve the strictly convex QP
-         BQPDSolver solver(model.number_variables, linear_constraints.size(), model.number_variables, true, options);
+         auto solver = QPSolverFactory::create(options.get_string("QP_solver"), model.number_variables, linear_constraints.size(),
+               model.number_variables, true, options);
          std::vector<double> d0(model.number_variables); // = 0
          SparseVector<double> linear_objective; // empty
          WarmstartInformation warmstart_information{true, true, true, true};
-         Direction direction = solver.solve_QP(model.number_variables, linear_constraints.size(), variables_bounds, constraints_bounds,
+         Direction direction = solver->solve_QP(model.number_variables, linear_constraints.size(), variables_bounds, constraints_bounds,
                linear_objective, constraint_jacobian, hessian, d0, warmstart_information);
          if (direction.status == SubproblemStatus::INFEASIBLE) {
             throw std::runtime_error("Linear constraints cannot be satisfied");
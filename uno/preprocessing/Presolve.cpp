@@ -0,0 +1,389 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "Presolve.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+Presolve::Presolve(const Model& model, double tolerance, double bound_relaxation):
+      tolerance(tolerance),
+      bound_relaxation(bound_relaxation),
+      original_number_variables(model.number_variables),
+      bounds(model.number_variables),
+      fixed(model.number_variables, false),
+      fixed_values(model.number_variables, 0.),
+      fixing_row(model.number_variables, NOT_KEPT),
+      row_reductions(model.number_constraints, RowReduction::KEPT),
+      linear_rows(model.number_constraints),
+      row_bounds(model.number_constraints),
+      singleton_variable(model.number_constraints, NOT_KEPT),
+      singleton_coefficient(model.number_constraints, 0.),
+      lower_bound_row(model.number_variables, NOT_KEPT),
+      upper_bound_row(model.number_variables, NOT_KEPT),
+      reduced_variable_indices(model.number_variables, NOT_KEPT),
+      reduced_constraint_indices(model.number_constraints, NOT_KEPT) {
+   for (size_t i: Range(model.number_variables)) {
+      this->bounds[i] = {model.get_variable_lower_bound(i), model.get_variable_upper_bound(i)};
+      if (this->bounds[i].ub + this->scaled_tolerance(this->bounds[i].ub) < this->bounds[i].lb) {
+         throw std::runtime_error("Presolve: the bounds of the variable " + std::to_string(i) + " are inconsistent");
+      }
+   }
+   // remove the variables fixed by their bounds
+   for (size_t i: Range(model.number_variables)) {
+      if (this->bounds[i].ub - this->bounds[i].lb <= this->scaled_tolerance(this->bounds[i].lb)) {
+         this->fix_variable(i, this->bounds[i].lb, NOT_KEPT);
+      }
+   }
+   this->reduce_linear_rows(model);
+
+   // index mappings between the original and the reduced models
+   for (size_t i: Range(model.number_variables)) {
+      if (not this->fixed[i]) {
+         this->reduced_variable_indices[i] = this->original_variable_indices.size();
+         this->original_variable_indices.push_back(i);
+         this->reduced_bounds.push_back(this->bounds[i]);
+      }
+   }
+   for (size_t j: Range(model.number_constraints)) {
+      if (this->row_reductions[j] == RowReduction::KEPT) {
+         this->reduced_constraint_indices[j] = this->original_constraint_indices.size();
+         this->original_constraint_indices.push_back(j);
+      }
+   }
+   this->tighten_bounds(model);
+}
+
+size_t Presolve::get_number_variables() const {
+   return this->original_variable_indices.size();
+}
+
+size_t Presolve::get_number_constraints() const {
+   return this->original_constraint_indices.size();
+}
+
+size_t Presolve::original_variable(size_t i) const {
+   return this->original_variable_indices[i];
+}
+
+size_t Presolve::reduced_variable(size_t i) const {
+   return this->reduced_variable_indices[i];
+}
+
+size_t Presolve::original_constraint(size_t j) const {
+   return this->original_constraint_indices[j];
+}
+
+size_t Presolve::reduced_constraint(size_t j) const {
+   return this->reduced_constraint_indices[j];
+}
+
+const Interval& Presolve::get_variable_bounds(size_t i) const {
+   return this->reduced_bounds[i];
+}
+
+double Presolve::get_fixed_value(size_t i) const {
+   return this->fixed_values[i];
+}
+
+RowReduction Presolve::get_row_reduction(size_t j) const {
+   return this->row_reductions[j];
+}
+
+const std::vector<size_t>& Presolve::get_original_variables() const {
+   return this->original_variable_indices;
+}
+
+const std::vector<size_t>& Presolve::get_original_constraints() const {
+   return this->original_constraint_indices;
+}
+
+const std::vector<Interval>& Presolve::get_reduced_bounds() const {
+   return this->reduced_bounds;
+}
+
+const std::vector<double>& Presolve::get_fixed_values() const {
+   return this->fixed_values;
+}
+
+double Presolve::scaled_tolerance(double value) const {
+   return this->tolerance * std::max(1., is_finite(value) ? std::abs(value) : 0.);
+}
+
+void Presolve::fix_variable(size_t i, double value, size_t row_index) {
+   this->fixed[i] = true;
+   this->fixed_values[i] = value;
+   this->fixing_row[i] = row_index;
+}
+
+void Presolve::remove_row(size_t j, RowReduction reduction) {
+   this->row_reductions[j] = reduction;
+   this->removed_rows.push_back(j);
+}
+
+void Presolve::reduce_linear_rows(const Model& model) {
+   // the linear rows are evaluated at the initial point: c_j(x) = a_j^T x + b_j
+   std::vector<double> x(model.number_variables);
+   model.get_initial_primal_point(x);
+   model.project_primals_onto_bounds(x);
+   std::vector<double> constraints(model.number_constraints);
+   model.evaluate_constraints(x, constraints);
+   for (size_t j: model.get_linear_constraints()) {
+      model.evaluate_constraint_gradient(x, j, this->linear_rows[j]);
+      const double constant = constraints[j] - dot(x, this->linear_rows[j]);
+      this->row_bounds[j] = {model.get_constraint_lower_bound(j) - constant, model.get_constraint_upper_bound(j) - constant};
+   }
+
+   // removing a row may fix variables and trigger the removal of other rows
+   const size_t max_number_passes = 10;
+   size_t number_removed_rows = 0;
+   for (size_t pass = 0; pass == 0 || (number_removed_rows < this->removed_rows.size() && pass < max_number_passes); pass++) {
+      number_removed_rows = this->removed_rows.size();
+      for (size_t j: model.get_linear_constraints()) {
+         if (this->row_reductions[j] == RowReduction::KEPT) {
+            this->reduce_row(j);
+         }
+      }
+   }
+}
+
+void Presolve::reduce_row(size_t j) {
+   // split the row into the activity of the fixed variables and the free terms
+   double fixed_activity = 0.;
+   size_t number_free_variables = 0;
+   size_t free_variable = 0;
+   double free_coefficient = 0.;
+   this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+      if (this->fixed[i]) {
+         fixed_activity += coefficient * this->fixed_values[i];
+      }
+      else if (coefficient != 0.) {
+         number_free_variables++;
+         free_variable = i;
+         free_coefficient = coefficient;
+      }
+   });
+   const double lower = this->row_bounds[j].lb - fixed_activity;
+   const double upper = this->row_bounds[j].ub - fixed_activity;
+
+   if (number_free_variables == 0) {
+      if (this->scaled_tolerance(lower) < lower || upper < -this->scaled_tolerance(upper)) {
+         throw std::runtime_error("Presolve: the empty constraint " + std::to_string(j) + " is infeasible");
+      }
+      this->remove_row(j, RowReduction::EMPTY);
+   }
+   else if (number_free_variables == 1) {
+      // a x_k in [lower, upper] becomes a bound on x_k
+      const size_t k = free_variable;
+      const double implied_lb = (0. < free_coefficient) ? lower / free_coefficient : upper / free_coefficient;
+      const double implied_ub = (0. < free_coefficient) ? upper / free_coefficient : lower / free_coefficient;
+      if (this->bounds[k].lb < implied_lb) {
+         this->bounds[k].lb = implied_lb;
+         this->lower_bound_row[k] = j;
+      }
+      if (implied_ub < this->bounds[k].ub) {
+         this->bounds[k].ub = implied_ub;
+         this->upper_bound_row[k] = j;
+      }
+      if (this->bounds[k].ub + this->scaled_tolerance(this->bounds[k].ub) < this->bounds[k].lb) {
+         throw std::runtime_error("Presolve: the singleton constraint " + std::to_string(j) + " is infeasible");
+      }
+      this->singleton_variable[j] = k;
+      this->singleton_coefficient[j] = free_coefficient;
+      this->remove_row(j, RowReduction::SINGLETON);
+      if (this->bounds[k].ub - this->bounds[k].lb <= this->scaled_tolerance(this->bounds[k].lb)) {
+         this->fix_variable(k, (this->bounds[k].lb + this->bounds[k].ub) / 2., NOT_KEPT);
+      }
+   }
+   else {
+      Interval activity{0., 0.};
+      this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+         if (not this->fixed[i] && coefficient != 0.) {
+            activity.lb += coefficient * ((0. < coefficient) ? this->bounds[i].lb : this->bounds[i].ub);
+            activity.ub += coefficient * ((0. < coefficient) ? this->bounds[i].ub : this->bounds[i].lb);
+         }
+      });
+      if (upper + this->scaled_tolerance(upper) < activity.lb || activity.ub + this->scaled_tolerance(activity.ub) < lower) {
+         throw std::runtime_error("Presolve: the constraint " + std::to_string(j) + " is infeasible");
+      }
+      if (lower - this->scaled_tolerance(lower) <= activity.lb && activity.ub <= upper + this->scaled_tolerance(upper)) {
+         this->remove_row(j, RowReduction::REDUNDANT);
+      }
+      else if (is_finite(activity.ub) && activity.ub <= lower + this->scaled_tolerance(lower)) {
+         // the row can only be satisfied at its maximum activity
+         this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+            if (not this->fixed[i] && coefficient != 0.) {
+               this->fix_variable(i, (0. < coefficient) ? this->bounds[i].ub : this->bounds[i].lb, j);
+            }
+         });
+         this->remove_row(j, RowReduction::FORCING_LOWER);
+      }
+      else if (is_finite(activity.lb) && upper - this->scaled_tolerance(upper) <= activity.lb) {
+         // the row can only be satisfied at its minimum activity
+         this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+            if (not this->fixed[i] && coefficient != 0.) {
+               this->fix_variable(i, (0. < coefficient) ? this->bounds[i].lb : this->bounds[i].ub, j);
+            }
+         });
+         this->remove_row(j, RowReduction::FORCING_UPPER);
+      }
+   }
+}
+
+// the bounds implied by a row are computed from the (non-implied) bounds of the other variables of the row
+void Presolve::tighten_bounds(const Model& model) {
+   for (size_t j: model.get_linear_constraints()) {
+      if (this->row_reductions[j] != RowReduction::KEPT) {
+         continue;
+      }
+      // minimum and maximum activities: finite parts and number of infinite contributions
+      double fixed_activity = 0.;
+      double finite_min_activity = 0., finite_max_activity = 0.;
+      size_t number_infinite_min = 0, number_infinite_max = 0;
+      const auto min_contribution = [&](size_t i, double coefficient) {
+         return coefficient * ((0. < coefficient) ? this->bounds[i].lb : this->bounds[i].ub);
+      };
+      const auto max_contribution = [&](size_t i, double coefficient) {
+         return coefficient * ((0. < coefficient) ? this->bounds[i].ub : this->bounds[i].lb);
+      };
+      this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+         if (this->fixed[i]) {
+            fixed_activity += coefficient * this->fixed_values[i];
+         }
+         else if (coefficient != 0.) {
+            const double minimum = min_contribution(i, coefficient);
+            const double maximum = max_contribution(i, coefficient);
+            if (is_finite(minimum)) {
+               finite_min_activity += minimum;
+            }
+            else {
+               number_infinite_min++;
+            }
+            if (is_finite(maximum)) {
+               finite_max_activity += maximum;
+            }
+            else {
+               number_infinite_max++;
+            }
+         }
+      });
+      const double lower = this->row_bounds[j].lb - fixed_activity;
+      const double upper = this->row_bounds[j].ub - fixed_activity;
+
+      this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+         if (this->fixed[i] || coefficient == 0.) {
+            return;
+         }
+         // activities of the other variables
+         const double minimum = min_contribution(i, coefficient);
+         const double maximum = max_contribution(i, coefficient);
+         const double residual_min = is_finite(minimum) ? ((number_infinite_min == 0) ? finite_min_activity - minimum : -INF<double>) :
+               ((number_infinite_min == 1) ? finite_min_activity : -INF<double>);
+         const double residual_max = is_finite(maximum) ? ((number_infinite_max == 0) ? finite_max_activity - maximum : INF<double>) :
+               ((number_infinite_max == 1) ? finite_max_activity : INF<double>);
+         // lower - residual_max <= a x_i <= upper - residual_min
+         const double from_lower = (lower - residual_max) / coefficient;
+         const double from_upper = (upper - residual_min) / coefficient;
+         double implied_lb = (0. < coefficient) ? from_lower : from_upper;
+         double implied_ub = (0. < coefficient) ? from_upper : from_lower;
+         // relax the implied bounds so that they are never active at a feasible point
+         implied_lb -= this->bound_relaxation * std::max(1., std::abs(implied_lb));
+         implied_ub += this->bound_relaxation * std::max(1., std::abs(implied_ub));
+
+         Interval& reduced_bounds_i = this->reduced_bounds[this->reduced_variable_indices[i]];
+         if (is_finite(implied_lb) && reduced_bounds_i.lb < implied_lb) {
+            if (reduced_bounds_i.lb == this->bounds[i].lb) {
+               this->number_tightened_bounds++;
+            }
+            reduced_bounds_i.lb = implied_lb;
+         }
+         if (is_finite(implied_ub) && implied_ub < reduced_bounds_i.ub) {
+            if (reduced_bounds_i.ub == this->bounds[i].ub) {
+               this->number_tightened_bounds++;
+            }
+            reduced_bounds_i.ub = implied_ub;
+         }
+      });
+   }
+}
+
+// sign convention: the Lagrangian gradient is sigma grad f - sum_j y_j grad c_j - z_L - z_U
+void Presolve::postsolve(const Model& model, const std::vector<double>& x, Multipliers& multipliers) const {
+   // reduced costs of the variables with the multipliers of the remaining constraints
+   SparseVector<double> objective_gradient(model.number_variables);
+   model.evaluate_objective_gradient(x, objective_gradient);
+   RectangularMatrix<double> constraint_jacobian(model.number_constraints);
+   model.evaluate_constraint_jacobian(x, constraint_jacobian);
+   std::vector<double> reduced_costs(model.number_variables, 0.);
+   objective_gradient.for_each([&](size_t i, double derivative) {
+      reduced_costs[i] += multipliers.objective * derivative;
+   });
+   for (size_t j: this->original_constraint_indices) {
+      if (multipliers.constraints[j] != 0.) {
+         constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+            reduced_costs[i] -= multipliers.constraints[j] * derivative;
+         });
+      }
+   }
+
+   // the reductions are undone in the reverse order
+   for (auto row_iterator = this->removed_rows.rbegin(); row_iterator != this->removed_rows.rend(); ++row_iterator) {
+      const size_t j = *row_iterator;
+      double multiplier = 0.;
+      if (this->row_reductions[j] == RowReduction::FORCING_LOWER || this->row_reductions[j] == RowReduction::FORCING_UPPER) {
+         // the smallest multiplier that makes the reduced costs of the variables fixed by the row dual feasible
+         this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+            if (this->fixing_row[i] == j && coefficient != 0.) {
+               multiplier = (this->row_reductions[j] == RowReduction::FORCING_LOWER) ? std::max(multiplier, reduced_costs[i] / coefficient) :
+                     std::min(multiplier, reduced_costs[i] / coefficient);
+            }
+         });
+      }
+      else if (this->row_reductions[j] == RowReduction::SINGLETON) {
+         // the multiplier of a bound defined by the row is transferred to the row
+         const size_t k = this->singleton_variable[j];
+         const bool is_removed = this->fixed[k];
+         const double lower_bound_multiplier = is_removed ? std::max(0., reduced_costs[k]) : multipliers.lower_bounds[k];
+         const double upper_bound_multiplier = is_removed ? std::min(0., reduced_costs[k]) : multipliers.upper_bounds[k];
+         if (this->lower_bound_row[k] == j && 0. < lower_bound_multiplier) {
+            multiplier = lower_bound_multiplier / this->singleton_coefficient[j];
+            multipliers.lower_bounds[k] = 0.;
+         }
+         else if (this->upper_bound_row[k] == j && upper_bound_multiplier < 0.) {
+            multiplier = upper_bound_multiplier / this->singleton_coefficient[j];
+            multipliers.upper_bounds[k] = 0.;
+         }
+      }
+      // the empty and redundant rows have a zero multiplier
+      if (multiplier != 0.) {
+         multipliers.constraints[j] = multiplier;
+         this->linear_rows[j].for_each([&](size_t i, double coefficient) {
+            reduced_costs[i] -= multiplier * coefficient;
+         });
+      }
+   }
+
+   // bound multipliers of the removed variables
+   for (size_t i: Range(this->original_number_variables)) {
+      if (this->fixed[i]) {
+         multipliers.lower_bounds[i] = std::max(0., reduced_costs[i]);
+         multipliers.upper_bounds[i] = std::min(0., reduced_costs[i]);
+      }
+   }
+}
+
+void Presolve::print_summary() const {
+   size_t number_rows[6] = {0, 0, 0, 0, 0, 0};
+   for (size_t j: this->removed_rows) {
+      number_rows[static_cast<size_t>(this->row_reductions[j])]++;
+   }
+   const size_t number_fixed_variables = this->original_number_variables - this->get_number_variables();
+   INFO << "Presolve: " << number_fixed_variables << " fixed variables and " << this->removed_rows.size() << " constraints removed (" <<
+         number_rows[static_cast<size_t>(RowReduction::EMPTY)] << " empty, " << number_rows[static_cast<size_t>(RowReduction::REDUNDANT)] <<
+         " redundant, " << number_rows[static_cast<size_t>(RowReduction::SINGLETON)] << " singleton, " <<
+         (number_rows[static_cast<size_t>(RowReduction::FORCING_LOWER)] + number_rows[static_cast<size_t>(RowReduction::FORCING_UPPER)]) <<
+         " forcing), " << this->number_tightened_bounds << " bounds tightened\n";
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PRESOLVE_H
+#define UNO_PRESOLVE_H
+
+#include <vector>
+#include "optimization/Model.hpp"
+#include "optimization/Multipliers.hpp"
+
+enum class RowReduction {KEPT, EMPTY, REDUNDANT, SINGLETON, FORCING_LOWER, FORCING_UPPER};
+
+/*! \class Presolve
+ * \brief Reductions of the variables and linear constraints of a model
+ *
+ *  Removes the fixed variables, turns the singleton linear rows into bounds and drops the empty, redundant and forcing
+ *  linear rows (the variables of a forcing row are fixed at the bounds that make the row active). A trivially infeasible
+ *  row raises an exception. The bounds implied by the remaining linear rows tighten the bounds of the variables; they are
+ *  relaxed so that they are never active at a feasible point, and do not require a dual postsolve.
+ *  The nonlinear constraints are never removed.
+ */
+class Presolve {
+public:
+   static constexpr size_t NOT_KEPT = static_cast<size_t>(-1);
+
+   Presolve(const Model& model, double tolerance, double bound_relaxation);
+
+   [[nodiscard]] size_t get_number_variables() const;
+   [[nodiscard]] size_t get_number_constraints() const;
+   [[nodiscard]] size_t original_variable(size_t i) const;
+   [[nodiscard]] size_t reduced_variable(size_t i) const;
+   [[nodiscard]] size_t original_constraint(size_t j) const;
+   [[nodiscard]] size_t reduced_constraint(size_t j) const;
+   [[nodiscard]] const Interval& get_variable_bounds(size_t i) const;
+   [[nodiscard]] double get_fixed_value(size_t i) const;
+   [[nodiscard]] RowReduction get_row_reduction(size_t j) const;
+   [[nodiscard]] const std::vector<size_t>& get_original_variables() const;
+   [[nodiscard]] const std::vector<size_t>& get_original_constraints() const;
+   [[nodiscard]] const std::vector<Interval>& get_reduced_bounds() const;
+   [[nodiscard]] const std::vector<double>& get_fixed_values() const;
+
+   // recover the multipliers of the removed constraints and the bound multipliers of the removed variables
+   void postsolve(const Model& model, const std::vector<double>& x, Multipliers& multipliers) const;
+   void print_summary() const;
+
+protected:
+   const double tolerance;
+   const double bound_relaxation;
+   const size_t original_number_variables;
+   std::vector<Interval> bounds; // original indices
+   std::vector<bool> fixed;
+   std::vector<double> fixed_values;
+   std::vector<size_t> fixing_row; // forcing row that fixed a variable (NOT_KEPT if none)
+   std::vector<RowReduction> row_reductions;
+   std::vector<size_t> removed_rows{}; // in the order of removal
+   std::vector<SparseVector<double>> linear_rows; // linear part of the linear constraints
+   std::vector<Interval> row_bounds; // bounds of the linear part of the linear constraints
+   std::vector<size_t> singleton_variable;
+   std::vector<double> singleton_coefficient;
+   std::vector<size_t> lower_bound_row; // singleton row that defines the lower bound of a variable (NOT_KEPT if none)
+   std::vector<size_t> upper_bound_row; // singleton row that defines the upper bound of a variable (NOT_KEPT if none)
+
+   // reduced model
+   std::vector<size_t> original_variable_indices{};
+   std::vector<size_t> reduced_variable_indices;
+   std::vector<size_t> original_constraint_indices{};
+   std::vector<size_t> reduced_constraint_indices;
+   std::vector<Interval> reduced_bounds{}; // including the implied bounds
+   size_t number_tightened_bounds{0};
+
+   void fix_variable(size_t i, double value, size_t row_index);
+   void remove_row(size_t j, RowReduction reduction);
+   void reduce_linear_rows(const Model& model);
+   void reduce_row(size_t j);
+   void tighten_bounds(const Model& model);
+   [[nodiscard]] double scaled_tolerance(double value) const;
+};
+
+#endif // UNO_PRESOLVE_H
@@ -11,6 +11,16 @@
 #include "linear_algebra/Vector.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "ingredients/subproblem/Direction.hpp"
+#include "tools/Range.hpp"
+
+// elastic variables that relax the constraints: each one appears linearly in a single constraint j with coefficient
+// -1 (positive part p) or +1 (negative part n), is bounded below by 0 and does not enter the Hessian
+struct ElasticVariables {
+   SparseVector<size_t> positive;
+   SparseVector<size_t> negative;
+   explicit ElasticVariables(size_t capacity): positive(capacity), negative(capacity) {}
+   [[nodiscard]] size_t size() const { return this->positive.size() + this->negative.size(); }
+};
 
 class NonlinearProblem {
 public:
@@ -29,21 +39,28 @@ public:
    std::vector<size_t> upper_bounded_variables{}; // indices of the upper-bounded variables
    std::vector<size_t> single_lower_bounded_variables{}; // indices of the single lower-bounded variables
    std::vector<size_t> single_upper_bounded_variables{}; // indices of the single upper-bounded variables
+   // elastic variables (if any): their indices are the last ones. They can be eliminated analytically by the subproblem
+   ElasticVariables elastic_variables{0};
 
    // function evaluations
    [[nodiscard]] virtual double get_objective_multiplier() const = 0;
    [[nodiscard]] virtual double evaluate_objective(Iterate& iterate) const = 0;
-   virtual void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const = 0;
+   // the derivatives are returned as views: the evaluations of the iterate when the reformulation does not modify them (no copy),
+   // or the storage passed as argument, filled by the reformulation
+   [[nodiscard]] virtual const SparseVector<double>& evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const = 0;
    virtual void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const = 0;
-   virtual void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const = 0;
+   [[nodiscard]] const RectangularMatrix<double>& evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const;
+   // Jacobian of the original constraints: the unit columns of the elastic variables are not stored
+   [[nodiscard]] const RectangularMatrix<double>& evaluate_original_constraint_jacobian(Iterate& iterate) const;
    virtual void evaluate_lagrangian_hessian(const std::vector<double>& x, const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const = 0;
 
    virtual void set_infeasibility_measure(Iterate& iterate, Norm progress_norm) const = 0;
    virtual void set_optimality_measure(Iterate& iterate) const = 0;
    [[nodiscard]] virtual double compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate, const Direction& direction,
          double step_length, Norm progress_norm) const = 0;
+   // quadratic_product: "d^T H d", computed by the Hessian model
    [[nodiscard]] virtual std::function<double(double)> compute_predicted_optimality_reduction_model(const Iterate& current_iterate,
-         const Direction& direction, double step_length, const SymmetricMatrix<double>& hessian) const = 0;
+         const Direction& direction, double step_length, double quadratic_product) const = 0;
 
    [[nodiscard]] size_t get_number_original_variables() const;
    [[nodiscard]] virtual double get_variable_lower_bound(size_t i) const = 0;
@@ -72,6 +89,34 @@ inline bool NonlinearProblem::has_inequality_constraints() const {
    return (not this->model.inequality_constraints.empty());
 }
 
+// Jacobian with explicit elastic columns: the rows are copied into constraint_jacobian only if the problem has elastic variables
+inline const RectangularMatrix<double>& NonlinearProblem::evaluate_constraint_jacobian(Iterate& iterate,
+      RectangularMatrix<double>& constraint_jacobian) const {
+   const RectangularMatrix<double>& original_constraint_jacobian = this->evaluate_original_constraint_jacobian(iterate);
+   if (this->elastic_variables.size() == 0) {
+      return original_constraint_jacobian;
+   }
+   for (size_t j: Range(this->number_constraints)) {
+      constraint_jacobian[j].clear();
+      original_constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+         constraint_jacobian[j].insert(i, derivative);
+      });
+   }
+   // add the contribution of the elastics
+   this->elastic_variables.positive.for_each([&](size_t j, size_t elastic_index) {
+      constraint_jacobian[j].insert(elastic_index, -1.);
+   });
+   this->elastic_variables.negative.for_each([&](size_t j, size_t elastic_index) {
+      constraint_jacobian[j].insert(elastic_index, 1.);
+   });
+   return constraint_jacobian;
+}
+
+inline const RectangularMatrix<double>& NonlinearProblem::evaluate_original_constraint_jacobian(Iterate& iterate) const {
+   iterate.evaluate_constraint_jacobian(this->model);
+   return iterate.evaluations.constraint_jacobian;
+}
+
 inline size_t NonlinearProblem::get_number_original_variables() const {
    return this->model.number_variables;
 }
@@ -12,9 +12,8 @@ public:
 
    [[nodiscard]] double get_objective_multiplier() const override;
    [[nodiscard]] double evaluate_objective(Iterate& iterate) const override;
-   void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
+   [[nodiscard]] const SparseVector<double>& evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
    void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const override;
-   void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const override;
    void evaluate_lagrangian_hessian(const std::vector<double>& x, const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const override;
 
    void set_infeasibility_measure(Iterate& iterate, Norm progress_norm) const override;
@@ -22,7 +21,7 @@ public:
    [[nodiscard]] double compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate, const Direction& direction,
          double step_length, Norm progress_norm) const override;
    [[nodiscard]] std::function<double(double)> compute_predicted_optimality_reduction_model(const Iterate& current_iterate,
-         const Direction& direction, double step_length, const SymmetricMatrix<double>& hessian) const override;
+         const Direction& direction, double step_length, double quadratic_product) const override;
 
    [[nodiscard]] double get_variable_lower_bound(size_t i) const override;
    [[nodiscard]] double get_variable_upper_bound(size_t i) const override;
@@ -60,9 +59,10 @@ inline double OptimalityProblem::evaluate_objective(Iterate& iterate) const {
    return iterate.evaluations.objective;
 }
 
-inline void OptimalityProblem::evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const {
+inline const SparseVector<double>& OptimalityProblem::evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& /*objective_gradient*/) const {
+   // the gradient of the model is not modified
    iterate.evaluate_objective_gradient(this->model);
-   objective_gradient = iterate.evaluations.objective_gradient;
+   return iterate.evaluations.objective_gradient;
 }
 
 inline void OptimalityProblem::evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const {
@@ -70,11 +70,6 @@ inline void OptimalityProblem::evaluate_constraints(Iterate& iterate, std::vecto
    copy_from(constraints, iterate.evaluations.constraints);
 }
 
-inline void OptimalityProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
-   iterate.evaluate_constraint_jacobian(this->model);
-   constraint_jacobian = iterate.evaluations.constraint_jacobian;
-}
-
 inline void OptimalityProblem::evaluate_lagrangian_hessian(const std::vector<double>& x, const std::vector<double>& multipliers,
       SymmetricMatrix<double>& hessian) const {
    this->model.evaluate_lagrangian_hessian(x, this->get_objective_multiplier(), multipliers, hessian);
@@ -106,10 +101,9 @@ inline double OptimalityProblem::compute_predicted_infeasibility_reduction_model
 }
 
 inline std::function<double(double)> OptimalityProblem::compute_predicted_optimality_reduction_model(const Iterate& current_iterate,
-      const Direction& direction, double step_length, const SymmetricMatrix<double>& hessian) const {
+      const Direction& direction, double step_length, double quadratic_product) const {
    // predicted optimality reduction: "-∇f(x)^T (αd) - α^2/2 d^T H d"
    const double directional_derivative = dot(direction.primals, current_iterate.evaluations.objective_gradient);
-   const double quadratic_product = hessian.quadratic_product(direction.primals, direction.primals);
    return [=](double objective_multiplier) {
       return step_length * (-objective_multiplier*directional_derivative) - step_length*step_length/2. * quadratic_product;
    };
@@ -9,22 +9,14 @@
 #include "tools/Infinity.hpp"
 #include "linear_algebra/VectorExpression.hpp"
 
-struct ElasticVariables {
-   SparseVector<size_t> positive;
-   SparseVector<size_t> negative;
-   explicit ElasticVariables(size_t capacity): positive(capacity), negative(capacity) {}
-   [[nodiscard]] size_t size() const { return this->positive.size() + this->negative.size(); }
-};
-
 class l1RelaxedProblem: public RelaxedProblem {
 public:
    l1RelaxedProblem(const Model& model, double objective_multiplier, double constraint_violation_coefficient);
 
    [[nodiscard]] double get_objective_multiplier() const override;
    [[nodiscard]] double evaluate_objective(Iterate& iterate) const override;
-   void evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
+   [[nodiscard]] const SparseVector<double>& evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const override;
    void evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const override;
-   void evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const override;
    void evaluate_lagrangian_hessian(const std::vector<double>& x, const std::vector<double>& multipliers, SymmetricMatrix<double>& hessian) const override;
 
    void set_infeasibility_measure(Iterate& iterate, Norm progress_norm) const override;
@@ -32,7 +24,7 @@ public:
    [[nodiscard]] double compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate, const Direction& direction,
          double step_length, Norm progress_norm) const override;
    [[nodiscard]] std::function<double(double)> compute_predicted_optimality_reduction_model(const Iterate& current_iterate,
-         const Direction& direction, double step_length, const SymmetricMatrix<double>& hessian) const override;
+         const Direction& direction, double step_length, double quadratic_product) const override;
 
    [[nodiscard]] double compute_stationarity_error(const Iterate& iterate, Norm residual_norm) const override;
    [[nodiscard]] double compute_complementarity_error(const std::vector<double>& primals, const std::vector<double>& constraints,
@@ -55,7 +47,6 @@ public:
 protected:
    double objective_multiplier;
    const double constraint_violation_coefficient;
-   ElasticVariables elastic_variables;
 
    [[nodiscard]] static size_t count_elastic_variables(const Model& model);
    void generate_elastic_variables();
@@ -64,8 +55,7 @@ protected:
 inline l1RelaxedProblem::l1RelaxedProblem(const Model& model, double objective_multiplier, double constraint_violation_coefficient):
       RelaxedProblem(model, model.number_variables + l1RelaxedProblem::count_elastic_variables(model), model.number_constraints),
       objective_multiplier(objective_multiplier),
-      constraint_violation_coefficient(constraint_violation_coefficient),
-      elastic_variables(this->number_constraints) {
+      constraint_violation_coefficient(constraint_violation_coefficient) {
    this->generate_elastic_variables();
 
    // figure out bounded variables
@@ -109,15 +99,14 @@ inline double l1RelaxedProblem::evaluate_objective(Iterate& iterate) const {
    return objective;
 }
 
-inline void l1RelaxedProblem::evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const {
-   // scale nabla f(x) by rho
+inline const SparseVector<double>& l1RelaxedProblem::evaluate_objective_gradient(Iterate& iterate, SparseVector<double>& objective_gradient) const {
+   // scale nabla f(x) by rho (the storage of objective_gradient is reused)
+   objective_gradient.clear();
    if (this->objective_multiplier != 0.) {
       iterate.evaluate_objective_gradient(this->model);
-      objective_gradient = iterate.evaluations.objective_gradient;
-      scale(objective_gradient, this->objective_multiplier);
-   }
-   else {
-      objective_gradient.clear();
+      iterate.evaluations.objective_gradient.for_each([&](size_t i, double derivative) {
+         objective_gradient.insert(i, this->objective_multiplier * derivative);
+      });
    }
 
    // elastic contribution
@@ -126,6 +115,7 @@ inline void l1RelaxedProblem::evaluate_objective_gradient(Iterate& iterate, Spar
    };
    this->elastic_variables.positive.for_each_value(insert_elastic_derivative);
    this->elastic_variables.negative.for_each_value(insert_elastic_derivative);
+   return objective_gradient;
 }
 
 inline void l1RelaxedProblem::evaluate_constraints(Iterate& iterate, std::vector<double>& constraints) const {
@@ -140,18 +130,6 @@ inline void l1RelaxedProblem::evaluate_constraints(Iterate& iterate, std::vector
    });
 }
 
-inline void l1RelaxedProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
-   iterate.evaluate_constraint_jacobian(this->model);
-   constraint_jacobian = iterate.evaluations.constraint_jacobian;
-   // add the contribution of the elastics
-   this->elastic_variables.positive.for_each([&](size_t j, size_t elastic_index) {
-      constraint_jacobian[j].insert(elastic_index, -1.);
-   });
-   this->elastic_variables.negative.for_each([&](size_t j, size_t elastic_index) {
-      constraint_jacobian[j].insert(elastic_index, 1.);
-   });
-}
-
 inline void l1RelaxedProblem::evaluate_lagrangian_hessian(const std::vector<double>& x, const std::vector<double>& multipliers,
       SymmetricMatrix<double>& hessian) const {
    this->model.evaluate_lagrangian_hessian(x, this->objective_multiplier, multipliers, hessian);
@@ -208,8 +186,7 @@ inline double l1RelaxedProblem::compute_predicted_infeasibility_reduction_model(
 }
 
 inline std::function<double(double)> l1RelaxedProblem::compute_predicted_optimality_reduction_model(const Iterate& current_iterate,
-      const Direction& direction, double step_length, const SymmetricMatrix<double>& hessian) const {
-   const double quadratic_problem = hessian.quadratic_product(direction.primals, direction.primals);
+      const Direction& direction, double step_length, double quadratic_product) const {
    if (this->objective_multiplier == 0.) {
       // "‖c(x)‖₁ - ‖c(x) + ∇c(x)^T (αd)‖₁"
       const double current_constraint_violation = this->model.compute_constraint_violation(current_iterate.evaluations.constraints, Norm::L1);
@@ -217,14 +194,14 @@ inline std::function<double(double)> l1RelaxedProblem::compute_predicted_optimal
             current_iterate.evaluations.constraints, current_iterate.evaluations.constraint_jacobian, step_length, Norm::L1);
       return [=](double /*objective_multiplier*/) {
          return this->constraint_violation_coefficient * (current_constraint_violation - trial_linearized_constraint_violation) -
-            step_length*step_length/2. * quadratic_problem;
+            step_length*step_length/2. * quadratic_product;
       };
    }
    else { // 0. < objective_multiplier
       // "-ρ*∇f(x)^T (αd)"
       const double directional_derivative = dot(direction.primals, current_iterate.evaluations.objective_gradient);
       return [=](double objective_multiplier) {
-         return step_length * (-objective_multiplier*directional_derivative) - step_length*step_length/2. * quadratic_problem;
+         return step_length * (-objective_multiplier*directional_derivative) - step_length*step_length/2. * quadratic_product;
       };
    }
 }
@@ -238,7 +215,7 @@ inline double l1RelaxedProblem::compute_stationarity_error(const Iterate& iterat
 inline double l1RelaxedProblem::compute_complementarity_error(const std::vector<double>& primals, const std::vector<double>& constraints,
       const Multipliers& multipliers, Norm residual_norm) const {
    // construct a lazy expression for complementarity for variable bounds
-   VectorExpression<double> variable_complementarity(this->get_number_original_variables(), [&](size_t i) {
+   const VectorExpression variable_complementarity(this->get_number_original_variables(), [&](size_t i) {
       if (0. < multipliers.lower_bounds[i]) {
          return multipliers.lower_bounds[i] * (primals[i] - this->model.get_variable_lower_bound(i));
       }
@@ -249,7 +226,7 @@ inline double l1RelaxedProblem::compute_complementarity_error(const std::vector<
    });
 
    // construct a lazy expression for complementarity for constraint bounds
-   VectorExpression<double> constraint_complementarity(constraints.size(), [&](size_t j) {
+   const VectorExpression constraint_complementarity(constraints.size(), [&](size_t j) {
       // violated constraints
       if (constraints[j] < this->get_constraint_lower_bound(j)) { // lower violated
          return (this->constraint_violation_coefficient - multipliers.constraints[j]) * (constraints[j] - this->get_constraint_lower_bound(j));
@@ -338,6 +315,8 @@ inline size_t l1RelaxedProblem::count_elastic_variables(const Model& model) {
 
 inline void l1RelaxedProblem::generate_elastic_variables() {
    // generate elastic variables to relax the constraints
+   this->elastic_variables.positive.reserve(this->number_constraints);
+   this->elastic_variables.negative.reserve(this->number_constraints);
    size_t elastic_index = this->model.number_variables;
    for (size_t j: Range(this->model.number_constraints)) {
       if (is_finite(this->model.get_constraint_upper_bound(j))) {
@@ -27,6 +27,9 @@ bqpd_(const int* n, const int* m, int* k, int* kmax, double* a, int* la, double*
       int* info, int* iprint, int* nout);
 }
 
+std::mutex BQPDSolver::mutex;
+const BQPDSolver* BQPDSolver::last_solver{nullptr};
+
 // preallocate a bunch of stuff
 BQPDSolver::BQPDSolver(size_t max_number_variables, size_t number_constraints, size_t number_hessian_nonzeros, bool quadratic_programming,
          const Options& options):
@@ -48,11 +51,20 @@ BQPDSolver::BQPDSolver(size_t max_number_variables, size_t number_constraints, s
    }
 }
 
+BQPDSolver::~BQPDSolver() {
+   // a later instance allocated at the same address must not inherit the factors
+   const std::lock_guard<std::mutex> lock(BQPDSolver::mutex);
+   if (BQPDSolver::last_solver == this) {
+      BQPDSolver::last_solver = nullptr;
+   }
+}
+
 Direction BQPDSolver::solve_QP(size_t number_variables, size_t number_constraints, const std::vector<Interval>& variables_bounds,
       const std::vector<Interval>& constraint_bounds, const SparseVector<double>& linear_objective,
       const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<double>& hessian, const std::vector<double>& initial_point,
       const WarmstartInformation& warmstart_information) {
-   if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
+   // the Hessian of a quadratic program is not resent if it was not reevaluated
+   if ((warmstart_information.objective_changed || warmstart_information.constraints_changed) && warmstart_information.hessian_changed) {
       this->save_lagrangian_hessian_to_local_format(hessian);
    }
    if (this->print_subproblem) {
@@ -78,8 +90,10 @@ Direction BQPDSolver::solve_subproblem(size_t number_variables, size_t number_co
       const std::vector<Interval>& constraint_bounds, const SparseVector<double>& linear_objective,
       const RectangularMatrix<double>& constraint_jacobian, const std::vector<double>& initial_point,
       const WarmstartInformation& warmstart_information) {
+   // the COMMON blocks are shared by all the instances: one solve at a time
+   const std::lock_guard<std::mutex> lock(BQPDSolver::mutex);
    // initialize wsc_ common block (Hessian & workspace for BQPD)
-   // setting the common block here ensures that several instances of BQPD can run simultaneously
+   // setting the common block here ensures that several instances of BQPD can be used in turn
    wsc_.kk = static_cast<int>(this->number_hessian_nonzeros);
    wsc_.ll = static_cast<int>(this->size_hessian_sparsity);
    wsc_.mxws = static_cast<int>(this->size_hessian_workspace);
@@ -125,6 +139,11 @@ Direction BQPDSolver::solve_subproblem(size_t number_variables, size_t number_co
    const int m = static_cast<int>(number_constraints);
 
    BQPDMode mode = this->determine_mode(warmstart_information);
+   // the factors in the COMMON blocks belong to another instance
+   if (BQPDSolver::last_solver != this) {
+      mode = BQPDMode::ACTIVE_SET_EQUALITIES;
+      BQPDSolver::last_solver = this;
+   }
    const int mode_integer = static_cast<int>(mode);
    DEBUG << "direction initial point: \n";
    for (size_t i: Range(number_variables)) {
@@ -4,6 +4,7 @@
 #ifndef UNO_BQPDSOLVER_H
 #define UNO_BQPDSOLVER_H
 
+#include <mutex>
 #include <vector>
 #include "QPSolver.hpp"
 #include "solvers/LP/LPSolver.hpp"
@@ -36,9 +37,17 @@ enum BQPDMode {
    UNCHANGED_ACTIVE_SET_AND_JACOBIAN_AND_REDUCED_HESSIAN = 6, // warm start
 };
 
+/*! \class BQPDSolver
+ * \brief Interface to the Fortran active-set solver BQPD
+ *
+ *  BQPD is not reentrant: its workspace sizes, its inertia control and its factors live in Fortran COMMON blocks. The
+ *  solves of all the instances are therefore serialized by a process-wide mutex, and an instance whose predecessor
+ *  in the COMMON blocks was another instance is cold started.
+ */
 class BQPDSolver : public QPSolver {
 public:
    BQPDSolver(size_t max_number_variables, size_t number_constraints, size_t number_hessian_nonzeros, bool quadratic_programming, const Options& options);
+   ~BQPDSolver() override;
 
    Direction solve_LP(size_t number_variables, size_t number_constraints, const std::vector<Interval>& variables_bounds,
          const std::vector<Interval>& constraint_bounds, const SparseVector<double>& linear_objective,
@@ -76,6 +85,11 @@ private:
    size_t number_calls{0};
    const bool print_subproblem;
 
+   // guards the COMMON blocks of BQPD
+   static std::mutex mutex;
+   // instance whose factors are stored in the COMMON blocks
+   static const BQPDSolver* last_solver;
+
    Direction solve_subproblem(size_t number_variables, size_t number_constraints, const std::vector<Interval>& variables_bounds,
          const std::vector<Interval>& constraint_bounds, const SparseVector<double>& linear_objective,
          const RectangularMatrix<double>& constraint_jacobian, const std::vector<double>& initial_point,
@@ -0,0 +1,150 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include <cmath>
+#include "DenseSolver.hpp"
+#include "linear_algebra/Vector.hpp"
+
+extern "C" {
+// LAPACK
+// Bunch-Kaufman factorization of a symmetric indefinite matrix
+void dsytrf_(const char* uplo, const int* n, double a[], const int* lda, int ipiv[], double work[], const int* lwork, int* info);
+// solve using the factorization computed by dsytrf
+void dsytrs_(const char* uplo, const int* n, const int* nrhs, const double a[], const int* lda, const int ipiv[], double b[], const int* ldb,
+      int* info);
+}
+
+DenseSolver::DenseSolver(size_t max_dimension) : SymmetricIndefiniteLinearSolver<double>(max_dimension),
+      factorization(std::max(size_t(1), max_dimension * max_dimension)), pivots(std::max(size_t(1), max_dimension)) {
+   // workspace query
+   const int n = std::max(1, static_cast<int>(max_dimension));
+   const int lwork = -1;
+   double optimal_lwork = 1.;
+   int info = 0;
+   dsytrf_(&this->uplo, &n, this->factorization.data(), &n, this->pivots.data(), &optimal_lwork, &lwork, &info);
+   this->work.resize(std::max(size_t(1), static_cast<size_t>(optimal_lwork)));
+}
+
+void DenseSolver::factorize(const SymmetricMatrix<double>& matrix) {
+   // general factorization method: symbolic factorization and numerical factorization
+   this->do_symbolic_factorization(matrix);
+   this->do_numerical_factorization(matrix);
+}
+
+void DenseSolver::do_symbolic_factorization(const SymmetricMatrix<double>& matrix) {
+   // nothing to analyze for a dense matrix
+   assert(matrix.dimension <= this->max_dimension && "DenseSolver: the dimension of the matrix is larger than the preallocated size");
+   this->dimension = static_cast<int>(matrix.dimension);
+}
+
+void DenseSolver::do_numerical_factorization(const SymmetricMatrix<double>& matrix) {
+   assert(matrix.dimension <= this->max_dimension && "DenseSolver: the dimension of the matrix is larger than the preallocated size");
+   this->dimension = static_cast<int>(matrix.dimension);
+   const size_t n = matrix.dimension;
+
+   // copy the matrix into the upper triangle of the dense array (duplicate entries are summed)
+   std::fill(this->factorization.begin(), this->factorization.begin() + static_cast<std::ptrdiff_t>(n * n), 0.);
+   matrix.for_each([&](size_t i, size_t j, double entry) {
+      const size_t row = std::min(i, j);
+      const size_t column = std::max(i, j);
+      this->factorization[row + column * n] += entry;
+   });
+
+   // numerical factorization
+   if (n == 0) {
+      this->compute_inertia();
+      return;
+   }
+   const int lwork = static_cast<int>(this->work.size());
+   int info = 0;
+   dsytrf_(&this->uplo, &this->dimension, this->factorization.data(), &this->dimension, this->pivots.data(), this->work.data(), &lwork, &info);
+   assert(0 <= info && "DenseSolver: the factorization failed");
+   this->compute_inertia();
+}
+
+void DenseSolver::solve_indefinite_system(const SymmetricMatrix<double>& /*matrix*/, const std::vector<double>& rhs, std::vector<double>& result) {
+   // copy rhs into result (overwritten by LAPACK)
+   copy_from(result, rhs);
+   if (this->dimension == 0) {
+      return;
+   }
+   int info = 0;
+   dsytrs_(&this->uplo, &this->dimension, &this->nrhs, this->factorization.data(), &this->dimension, this->pivots.data(), result.data(),
+         &this->dimension, &info);
+   assert(info == 0 && "DenseSolver: the solve failed");
+}
+
+// Sylvester's law of inertia: A = U D U^T has the same inertia as D
+void DenseSolver::compute_inertia() {
+   this->number_positive = 0;
+   this->number_negative = 0;
+   this->number_zero = 0;
+   const size_t n = static_cast<size_t>(this->dimension);
+   // absolute tolerance for zero pivots (as MA57): in the augmented systems of interior-point methods, the pivots of the
+   // dual block scale like the inverse of the barrier terms and are legitimately tiny relative to the largest pivot
+   const double tolerance = this->zero_pivot_tolerance;
+
+   size_t k = 0;
+   while (k < n) {
+      if (0 < this->pivots[k] || k + 1 == n) {
+         // 1x1 block
+         const double d = this->factorization[k + k * n];
+         if (std::abs(d) <= tolerance) {
+            this->number_zero++;
+         }
+         else if (0. < d) {
+            this->number_positive++;
+         }
+         else {
+            this->number_negative++;
+         }
+         k++;
+      }
+      else {
+         // 2x2 block [a b; b c]: the eigenvalues have the sign of the trace if the determinant is positive, opposite signs otherwise
+         const double a = this->factorization[k + k * n];
+         const double b = this->factorization[k + (k + 1) * n];
+         const double c = this->factorization[(k + 1) + (k + 1) * n];
+         const double determinant = a * c - b * b;
+         if (determinant < -tolerance * tolerance) {
+            this->number_positive++;
+            this->number_negative++;
+         }
+         else if (tolerance * tolerance < determinant) {
+            if (0. < a + c) {
+               this->number_positive += 2;
+            }
+            else {
+               this->number_negative += 2;
+            }
+         }
+         else {
+            this->number_zero++;
+            if (0. < a + c) {
+               this->number_positive++;
+            }
+            else {
+               this->number_negative++;
+            }
+         }
+         k += 2;
+      }
+   }
+}
+
+std::tuple<size_t, size_t, size_t> DenseSolver::get_inertia() const {
+   return std::make_tuple(this->number_positive, this->number_negative, this->number_zero);
+}
+
+size_t DenseSolver::number_negative_eigenvalues() const {
+   return this->number_negative;
+}
+
+bool DenseSolver::matrix_is_singular() const {
+   return (0 < this->number_zero);
+}
+
+size_t DenseSolver::rank() const {
+   return this->number_positive + this->number_negative;
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSESOLVER_H
+#define UNO_DENSESOLVER_H
+
+#include <vector>
+#include "SymmetricIndefiniteLinearSolver.hpp"
+
+/*! \class DenseSolver
+ * \brief Dense symmetric indefinite solver
+ *
+ *  Bunch-Kaufman factorization (LAPACK dsytrf/dsytrs) of the upper triangle of a dense copy of the matrix.
+ *  The inertia is computed from the 1x1 and 2x2 blocks of D. Cheaper than sparse solvers for small or dense matrices
+ */
+class DenseSolver : public SymmetricIndefiniteLinearSolver<double> {
+public:
+   explicit DenseSolver(size_t max_dimension);
+   ~DenseSolver() override = default;
+
+   void factorize(const SymmetricMatrix<double>& matrix) override;
+   void do_symbolic_factorization(const SymmetricMatrix<double>& matrix) override;
+   void do_numerical_factorization(const SymmetricMatrix<double>& matrix) override;
+   void solve_indefinite_system(const SymmetricMatrix<double>& matrix, const std::vector<double>& rhs, std::vector<double>& result) override;
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+   [[nodiscard]] size_t number_negative_eigenvalues() const override;
+   [[nodiscard]] bool matrix_is_singular() const override;
+   [[nodiscard]] size_t rank() const override;
+
+private:
+   int dimension{0};
+   std::vector<double> factorization; // column-major, upper triangle
+   std::vector<int> pivots;
+   std::vector<double> work;
+   const char uplo{'U'};
+   const int nrhs{1}; // number of right hand side being solved
+   const double zero_pivot_tolerance{1e-20};
+
+   size_t number_positive{0};
+   size_t number_negative{0};
+   size_t number_zero{0};
+
+   void compute_inertia();
+};
+
+#endif // UNO_DENSESOLVER_H
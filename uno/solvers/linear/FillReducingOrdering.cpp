@@ -0,0 +1,259 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <queue>
+#include <set>
+#include <sstream>
+#include "FillReducingOrdering.hpp"
+#include "tools/Logger.hpp"
+
+#ifdef HAS_METIS
+extern "C" {
+// METIS 4: nested dissection ordering
+void METIS_NodeND(int* n, int* xadj, int* adjncy, int* numflag, int* options, int* perm, int* iperm);
+}
+#endif
+
+FillReducingOrdering::FillReducingOrdering(const std::string& ordering_method, const std::string& cache_file_name):
+      ordering_method(ordering_method), cache_file_name(cache_file_name) {
+   const std::vector<std::string> methods = FillReducingOrdering::available_methods();
+   if (std::find(methods.cbegin(), methods.cend(), ordering_method) == methods.cend()) {
+      throw std::invalid_argument("Ordering method " + ordering_method + " does not exist");
+   }
+   this->load_cache();
+}
+
+// the ordering is computed only once per sparsity pattern
+const std::vector<size_t>& FillReducingOrdering::get_permutation(const SymmetricMatrix<double>& matrix) {
+   const size_t pattern_hash = matrix.compute_sparsity_pattern_hash();
+   const auto cached_permutation = this->cache.find(pattern_hash);
+   // a hash collision between patterns of different sizes is detected
+   if (cached_permutation != this->cache.end() && cached_permutation->second.permutation.size() == matrix.dimension &&
+         cached_permutation->second.number_nonzeros == matrix.number_nonzeros) {
+      DEBUG << "Reusing the cached " << this->ordering_method << " ordering\n";
+      return cached_permutation->second.permutation;
+   }
+   DEBUG << "Computing the " << this->ordering_method << " ordering\n";
+   CachedPermutation& entry = this->cache[pattern_hash];
+   entry = {matrix.number_nonzeros, this->compute_permutation(FillReducingOrdering::compute_adjacency_graph(matrix))};
+   this->save_cache();
+   return entry.permutation;
+}
+
+size_t FillReducingOrdering::number_cached_permutations() const {
+   return this->cache.size();
+}
+
+std::vector<size_t> FillReducingOrdering::compute_permutation(const AdjacencyGraph& graph) const {
+   if (this->ordering_method == "MD") {
+      return FillReducingOrdering::minimum_degree(graph);
+   }
+   else if (this->ordering_method == "METIS") {
+      return FillReducingOrdering::nested_dissection(graph);
+   }
+   else if (this->ordering_method == "RCM") {
+      return FillReducingOrdering::reverse_cuthill_mckee(graph);
+   }
+   throw std::invalid_argument("Ordering method " + this->ordering_method + " does not exist");
+}
+
+AdjacencyGraph FillReducingOrdering::compute_adjacency_graph(const SymmetricMatrix<double>& matrix) {
+   AdjacencyGraph graph(matrix.dimension);
+   matrix.for_each([&](size_t i, size_t j, double /*entry*/) {
+      if (i != j) {
+         graph[i].push_back(j);
+         graph[j].push_back(i);
+      }
+   });
+   // remove duplicate edges
+   for (auto& neighbors: graph) {
+      std::sort(neighbors.begin(), neighbors.end());
+      neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+   }
+   return graph;
+}
+
+// exact minimum degree: eliminate a vertex of smallest degree and turn its neighbors into a clique. The degrees are
+// exact (no approximate degrees or supervariables as in AMD)
+std::vector<size_t> FillReducingOrdering::minimum_degree(const AdjacencyGraph& graph) {
+   const size_t n = graph.size();
+   std::vector<std::set<size_t>> elimination_graph(n);
+   std::set<std::pair<size_t, size_t>> degrees{}; // (degree, vertex)
+   for (size_t i: Range(n)) {
+      elimination_graph[i].insert(graph[i].cbegin(), graph[i].cend());
+      degrees.emplace(elimination_graph[i].size(), i);
+   }
+
+   std::vector<size_t> permutation{};
+   permutation.reserve(n);
+   while (not degrees.empty()) {
+      const size_t pivot = degrees.begin()->second;
+      degrees.erase(degrees.begin());
+      permutation.push_back(pivot);
+
+      const std::vector<size_t> neighbors(elimination_graph[pivot].cbegin(), elimination_graph[pivot].cend());
+      for (size_t i: neighbors) {
+         degrees.erase({elimination_graph[i].size(), i});
+         elimination_graph[i].erase(pivot);
+      }
+      // fill-in
+      for (size_t i: neighbors) {
+         for (size_t j: neighbors) {
+            if (i != j) {
+               elimination_graph[i].insert(j);
+            }
+         }
+      }
+      for (size_t i: neighbors) {
+         degrees.emplace(elimination_graph[i].size(), i);
+      }
+      elimination_graph[pivot].clear();
+   }
+   return permutation;
+}
+
+std::vector<size_t> FillReducingOrdering::nested_dissection(const AdjacencyGraph& graph) {
+#ifdef HAS_METIS
+   // compressed adjacency structure
+   int n = static_cast<int>(graph.size());
+   std::vector<int> xadj{0};
+   std::vector<int> adjncy{};
+   for (const auto& neighbors: graph) {
+      for (size_t j: neighbors) {
+         adjncy.push_back(static_cast<int>(j));
+      }
+      xadj.push_back(static_cast<int>(adjncy.size()));
+   }
+   int numflag = 0;
+   std::array<int, 8> options{}; // default options
+   std::vector<int> perm(graph.size());
+   std::vector<int> iperm(graph.size());
+   METIS_NodeND(&n, xadj.data(), adjncy.data(), &numflag, options.data(), perm.data(), iperm.data());
+
+   std::vector<size_t> permutation(graph.size());
+   for (size_t k: Range(graph.size())) {
+      permutation[k] = static_cast<size_t>(perm[k]);
+   }
+   return permutation;
+#else
+   (void) graph;
+   throw std::invalid_argument("Nested dissection requires METIS");
+#endif
+}
+
+// Cuthill-McKee breadth-first search from a vertex of minimum degree in each connected component, then reversal
+std::vector<size_t> FillReducingOrdering::reverse_cuthill_mckee(const AdjacencyGraph& graph) {
+   const size_t n = graph.size();
+   std::vector<size_t> vertices(n);
+   for (size_t i: Range(n)) {
+      vertices[i] = i;
+   }
+   const auto smaller_degree = [&](size_t i, size_t j) {
+      return graph[i].size() < graph[j].size() || (graph[i].size() == graph[j].size() && i < j);
+   };
+   std::sort(vertices.begin(), vertices.end(), smaller_degree);
+
+   std::vector<size_t> permutation{};
+   permutation.reserve(n);
+   std::vector<bool> visited(n, false);
+   for (size_t start: vertices) {
+      if (not visited[start]) {
+         std::queue<size_t> queue{};
+         queue.push(start);
+         visited[start] = true;
+         while (not queue.empty()) {
+            const size_t i = queue.front();
+            queue.pop();
+            permutation.push_back(i);
+            std::vector<size_t> neighbors{};
+            for (size_t j: graph[i]) {
+               if (not visited[j]) {
+                  visited[j] = true;
+                  neighbors.push_back(j);
+               }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), smaller_degree);
+            for (size_t j: neighbors) {
+               queue.push(j);
+            }
+         }
+      }
+   }
+   std::reverse(permutation.begin(), permutation.end());
+   return permutation;
+}
+
+std::vector<std::string> FillReducingOrdering::available_methods() {
+   std::vector<std::string> methods{"MD", "RCM"};
+#ifdef HAS_METIS
+   methods.emplace_back("METIS");
+#endif
+   return methods;
+}
+
+// file format: one permutation per line "method hash dimension number_nonzeros permutation[0] ... permutation[dimension-1]".
+// The malformed lines (e.g. of a previous format) are ignored
+void FillReducingOrdering::load_cache() {
+   if (this->cache_file_name == "none") {
+      return;
+   }
+   std::ifstream file(this->cache_file_name);
+   std::string line;
+   while (std::getline(file, line)) {
+      std::istringstream stream(line);
+      std::string method;
+      size_t pattern_hash, dimension, number_nonzeros;
+      if (not (stream >> method >> pattern_hash >> dimension >> number_nonzeros)) {
+         continue;
+      }
+      std::vector<size_t> permutation(dimension);
+      bool is_valid = true;
+      for (size_t k: Range(dimension)) {
+         is_valid = is_valid && (stream >> permutation[k]) && permutation[k] < dimension;
+      }
+      std::string remainder;
+      if (not is_valid || (stream >> remainder)) {
+         continue;
+      }
+      if (method == this->ordering_method) {
+         this->cache[pattern_hash] = {number_nonzeros, std::move(permutation)};
+      }
+      else {
+         this->other_methods_lines.push_back(line);
+      }
+   }
+   DEBUG << "Loaded " << this->cache.size() << " cached orderings from " << this->cache_file_name << '\n';
+}
+
+// the file is rewritten (in a temporary file, then renamed) with one line per permutation
+void FillReducingOrdering::save_cache() const {
+   if (this->cache_file_name == "none") {
+      return;
+   }
+   const std::string temporary_file_name = this->cache_file_name + ".tmp";
+   {
+      std::ofstream file(temporary_file_name, std::ios::trunc);
+      if (not file) {
+         WARNING << YELLOW << "The orderings could not be saved to " << this->cache_file_name << '\n' << RESET;
+         return;
+      }
+      for (const std::string& line: this->other_methods_lines) {
+         file << line << '\n';
+      }
+      for (const auto& [pattern_hash, entry]: this->cache) {
+         file << this->ordering_method << ' ' << pattern_hash << ' ' << entry.permutation.size() << ' ' << entry.number_nonzeros;
+         for (size_t i: entry.permutation) {
+            file << ' ' << i;
+         }
+         file << '\n';
+      }
+   }
+   if (std::rename(temporary_file_name.c_str(), this->cache_file_name.c_str()) != 0) {
+      WARNING << YELLOW << "The orderings could not be saved to " << this->cache_file_name << '\n' << RESET;
+      std::remove(temporary_file_name.c_str());
+   }
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FILLREDUCINGORDERING_H
+#define UNO_FILLREDUCINGORDERING_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "linear_algebra/SymmetricMatrix.hpp"
+
+// undirected adjacency graph of the off-diagonal pattern of a symmetric matrix
+using AdjacencyGraph = std::vector<std::vector<size_t>>;
+
+/*! \class FillReducingOrdering
+ * \brief Fill-reducing orderings of symmetric matrices
+ *
+ *  Computes a permutation (the k-th pivot is variable permutation[k]) of the pattern of a symmetric matrix with:
+ *  - MD: exact minimum degree, on the explicit elimination graph (no approximate degrees, no quotient graph)
+ *  - METIS: nested dissection (if available)
+ *  - RCM: reverse Cuthill-McKee
+ *  The permutations are cached by sparsity pattern hash (checked against the dimension and the number of nonzeros) and
+ *  can be persisted to a file, so that repeated solves of the same model structure skip the ordering phase. The file is
+ *  rewritten with the whole cache whenever a permutation is added.
+ */
+class FillReducingOrdering {
+public:
+   FillReducingOrdering(const std::string& ordering_method, const std::string& cache_file_name);
+
+   [[nodiscard]] const std::vector<size_t>& get_permutation(const SymmetricMatrix<double>& matrix);
+   [[nodiscard]] size_t number_cached_permutations() const;
+
+   [[nodiscard]] static AdjacencyGraph compute_adjacency_graph(const SymmetricMatrix<double>& matrix);
+   [[nodiscard]] static std::vector<size_t> minimum_degree(const AdjacencyGraph& graph);
+   [[nodiscard]] static std::vector<size_t> nested_dissection(const AdjacencyGraph& graph);
+   [[nodiscard]] static std::vector<size_t> reverse_cuthill_mckee(const AdjacencyGraph& graph);
+   [[nodiscard]] static std::vector<std::string> available_methods();
+
+protected:
+   const std::string ordering_method;
+   const std::string cache_file_name; /*!< "none": no persistence */
+   struct CachedPermutation {
+      size_t number_nonzeros;
+      std::vector<size_t> permutation;
+   };
+   std::unordered_map<size_t, CachedPermutation> cache{};
+   std::vector<std::string> other_methods_lines{}; // lines of the file of the other methods, rewritten as they are
+
+   [[nodiscard]] std::vector<size_t> compute_permutation(const AdjacencyGraph& graph) const;
+   void load_cache();
+   void save_cache() const;
+};
+
+#endif // UNO_FILLREDUCINGORDERING_H
@@ -25,10 +25,12 @@ lifact, const double rhs[], double x[], double resid[], double work[], int iwork
       double cntl[], int info[], double rinfo[]);
 }
 
-MA57Solver::MA57Solver(size_t max_dimension, size_t max_number_nonzeros) : SymmetricIndefiniteLinearSolver<double>(max_dimension),
+MA57Solver::MA57Solver(size_t max_dimension, size_t max_number_nonzeros, std::unique_ptr<FillReducingOrdering> ordering) :
+   SymmetricIndefiniteLinearSolver<double>(max_dimension),
    iwork(5 * max_dimension),
    lwork(static_cast<int>(1.2 * static_cast<double>(max_dimension))),
-   work(static_cast<size_t>(this->lwork)), residuals(max_dimension) {
+   work(static_cast<size_t>(this->lwork)), residuals(max_dimension),
+   ordering(std::move(ordering)) {
    this->row_indices.reserve(max_number_nonzeros);
    this->column_indices.reserve(max_number_nonzeros);
    // set the default values of the controlling parameters
@@ -37,6 +39,10 @@ MA57Solver::MA57Solver(size_t max_dimension, size_t max_number_nonzeros) : Symme
    this->icntl[4] = 0;
    // iterative refinement enabled
    this->icntl[8] = 1;
+   // pivot order given in keep
+   if (this->ordering != nullptr) {
+      this->icntl[5] = 1;
+   }
 }
 
 void MA57Solver::factorize(const SymmetricMatrix<double>& matrix) {
@@ -59,6 +65,13 @@ void MA57Solver::do_symbolic_factorization(const SymmetricMatrix<double>& matrix
    // sparsity pattern
    const int lkeep = 5 * n + nnz + std::max(n, nnz) + 42;
    std::vector<int> keep(static_cast<size_t>(lkeep));
+   if (this->ordering != nullptr) {
+      // keep(i) is the position of variable i in the pivot order
+      const std::vector<size_t>& permutation = this->ordering->get_permutation(matrix);
+      for (size_t k: Range(matrix.dimension)) {
+         keep[permutation[k]] = static_cast<int>(k + this->fortran_shift);
+      }
+   }
 
    // symbolic factorization
    ma57ad_(/* const */ &n,
@@ -4,8 +4,10 @@
 #ifndef UNO_MA57SOLVER_H
 #define UNO_MA57SOLVER_H
 
+#include <memory>
 #include <vector>
 #include "SymmetricIndefiniteLinearSolver.hpp"
+#include "FillReducingOrdering.hpp"
 #include "linear_algebra/COOSymmetricMatrix.hpp"
 
 struct MA57Factorization {
@@ -29,7 +31,7 @@ struct MA57Factorization {
  */
 class MA57Solver : public SymmetricIndefiniteLinearSolver<double> {
 public:
-   explicit MA57Solver(size_t max_dimension, size_t max_number_nonzeros);
+   MA57Solver(size_t max_dimension, size_t max_number_nonzeros, std::unique_ptr<FillReducingOrdering> ordering = nullptr);
    ~MA57Solver() override = default;
 
    void factorize(const SymmetricMatrix<double>& matrix) override;
@@ -62,6 +64,8 @@ private:
    const size_t fortran_shift{1};
 
    MA57Factorization factorization{};
+   // pivot order provided by the user (nullptr: MA57 computes its own ordering)
+   std::unique_ptr<FillReducingOrdering> ordering;
    bool use_iterative_refinement{false};
    void save_matrix_to_local_format(const SymmetricMatrix<double>& matrix);
 };
@@ -0,0 +1,265 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include "SparseLDLSolver.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "tools/Logger.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// marks the absence of a parent in the elimination tree
+constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
+
+SparseLDLSolver::SparseLDLSolver(size_t max_dimension, size_t max_number_nonzeros, std::unique_ptr<FillReducingOrdering> ordering,
+      size_t number_threads):
+      SymmetricIndefiniteLinearSolver<double>(max_dimension),
+      ordering(std::move(ordering)),
+      number_threads(number_threads),
+      permuted_rhs(max_dimension) {
+   this->row_indices.reserve(max_number_nonzeros);
+   this->values.reserve(max_number_nonzeros);
+   this->entry_positions.reserve(max_number_nonzeros);
+}
+
+void SparseLDLSolver::set_number_threads(size_t new_number_threads) {
+   this->number_threads = new_number_threads;
+}
+
+void SparseLDLSolver::factorize(const SymmetricMatrix<double>& matrix) {
+   // general factorization method: symbolic factorization and numerical factorization
+   this->do_symbolic_factorization(matrix);
+   this->do_numerical_factorization(matrix);
+}
+
+void SparseLDLSolver::do_symbolic_factorization(const SymmetricMatrix<double>& matrix) {
+   assert(matrix.dimension <= this->max_dimension && "SparseLDLSolver: the dimension of the matrix is larger than the preallocated size");
+   const size_t n = matrix.dimension;
+   this->dimension = n;
+
+   // fill-reducing ordering
+   this->permutation = this->ordering->get_permutation(matrix);
+   this->inverse_permutation.resize(n);
+   for (size_t k: Range(n)) {
+      this->inverse_permutation[this->permutation[k]] = k;
+   }
+
+   // upper triangle of P A P^T: count the entries of each column, then store their positions (duplicates are kept)
+   this->column_starts.assign(n + 1, 0);
+   matrix.for_each([&](size_t i, size_t j, double /*entry*/) {
+      const size_t column = std::max(this->inverse_permutation[i], this->inverse_permutation[j]);
+      this->column_starts[column + 1]++;
+   });
+   for (size_t k: Range(n)) {
+      this->column_starts[k + 1] += this->column_starts[k];
+   }
+   const size_t number_entries = this->column_starts[n];
+   this->row_indices.resize(number_entries);
+   this->values.resize(number_entries);
+   this->entry_positions.clear();
+   std::vector<size_t> next_position(this->column_starts.cbegin(), this->column_starts.cend() - 1);
+   matrix.for_each([&](size_t i, size_t j, double /*entry*/) {
+      const size_t row = std::min(this->inverse_permutation[i], this->inverse_permutation[j]);
+      const size_t column = std::max(this->inverse_permutation[i], this->inverse_permutation[j]);
+      const size_t position = next_position[column]++;
+      this->row_indices[position] = row;
+      this->entry_positions.push_back(position);
+   });
+
+   // elimination tree and column counts of L
+   this->parent.assign(n, NO_PARENT);
+   this->L_column_lengths.assign(n, 0);
+   std::vector<size_t> flag(n);
+   for (size_t k: Range(n)) {
+      flag[k] = k;
+      for (size_t position: Range(this->column_starts[k], this->column_starts[k + 1])) {
+         size_t i = this->row_indices[position];
+         // follow the path from i to the root of the current subtree
+         while (i < k && flag[i] != k) {
+            if (this->parent[i] == NO_PARENT) {
+               this->parent[i] = k;
+            }
+            this->L_column_lengths[i]++;
+            flag[i] = k;
+            i = this->parent[i];
+         }
+      }
+   }
+   this->L_column_starts.assign(n + 1, 0);
+   for (size_t k: Range(n)) {
+      this->L_column_starts[k + 1] = this->L_column_starts[k] + this->L_column_lengths[k];
+   }
+   this->L_row_indices.resize(this->L_column_starts[n]);
+   this->L_values.resize(this->L_column_starts[n]);
+   this->D.resize(n);
+
+   // levels of the elimination tree (parent[k] > k)
+   std::vector<size_t> level(n, 0);
+   size_t number_levels = (0 < n) ? 1 : 0;
+   for (size_t k: Range(n)) {
+      if (this->parent[k] != NO_PARENT) {
+         level[this->parent[k]] = std::max(level[this->parent[k]], level[k] + 1);
+         number_levels = std::max(number_levels, level[this->parent[k]] + 1);
+      }
+   }
+   this->levels.assign(number_levels, {});
+   for (size_t k: Range(n)) {
+      this->levels[level[k]].push_back(k);
+   }
+   DEBUG << "SparseLDLSolver: " << this->L_column_starts[n] << " nonzeros in L, elimination tree with " << number_levels << " levels\n";
+}
+
+void SparseLDLSolver::do_numerical_factorization(const SymmetricMatrix<double>& matrix) {
+   assert(matrix.dimension == this->dimension && "SparseLDLSolver: the symbolic factorization was performed on a different matrix");
+   const size_t n = this->dimension;
+
+   // scatter the values (same traversal order as in the symbolic factorization)
+   initialize_vector(this->values, 0.);
+   size_t entry_index = 0;
+   matrix.for_each([&](size_t /*i*/, size_t /*j*/, double entry) {
+      this->values[this->entry_positions[entry_index++]] = entry;
+   });
+   initialize_vector(this->L_column_lengths, size_t(0));
+
+   // thread-local workspaces
+   size_t maximum_number_threads = 1;
+#ifdef _OPENMP
+   maximum_number_threads = (0 < this->number_threads) ? this->number_threads : static_cast<size_t>(omp_get_max_threads());
+#endif
+   if (this->workspaces.size() < maximum_number_threads || (not this->workspaces.empty() && this->workspaces[0].y.size() < n)) {
+      this->workspaces.assign(maximum_number_threads, Workspace{std::vector<double>(n, 0.), std::vector<size_t>(n), std::vector<size_t>(n)});
+   }
+   for (Workspace& workspace: this->workspaces) {
+      std::fill(workspace.flag.begin(), workspace.flag.end(), NO_PARENT);
+   }
+
+   // the nodes of a level are roots of disjoint subtrees: their rows are computed concurrently
+   for (const std::vector<size_t>& level: this->levels) {
+      const auto level_size = static_cast<std::ptrdiff_t>(level.size());
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) num_threads(static_cast<int>(maximum_number_threads)) if(1 < level_size)
+#endif
+      for (std::ptrdiff_t index = 0; index < level_size; index++) {
+         size_t thread_number = 0;
+#ifdef _OPENMP
+         thread_number = static_cast<size_t>(omp_get_thread_num());
+#endif
+         this->factorize_row(level[static_cast<size_t>(index)], this->workspaces[thread_number]);
+      }
+   }
+
+   // inertia given by the signs of D (the zero pivots were set to 0)
+   this->number_positive = 0;
+   this->number_negative = 0;
+   this->number_zero = 0;
+   for (size_t k: Range(n)) {
+      if (this->D[k] == 0.) {
+         this->number_zero++;
+      }
+      else if (0. < this->D[k]) {
+         this->number_positive++;
+      }
+      else {
+         this->number_negative++;
+      }
+   }
+}
+
+// row k of L and D[k]: sparse triangular solve L(0:k-1, 0:k-1) y = A(0:k-1, k)
+void SparseLDLSolver::factorize_row(size_t k, Workspace& workspace) {
+   std::vector<double>& y = workspace.y;
+   std::vector<size_t>& pattern = workspace.pattern;
+   std::vector<size_t>& flag = workspace.flag;
+   const size_t n = this->dimension;
+
+   // nonzero pattern of row k: union of the paths from the nonzeros of A(0:k-1, k) to k, in topological order
+   size_t top = n;
+   flag[k] = k;
+   y[k] = 0.;
+   for (size_t position: Range(this->column_starts[k], this->column_starts[k + 1])) {
+      size_t i = this->row_indices[position];
+      y[i] += this->values[position];
+      size_t length = 0;
+      while (flag[i] != k) {
+         pattern[length++] = i;
+         flag[i] = k;
+         i = this->parent[i];
+      }
+      while (0 < length) {
+         pattern[--top] = pattern[--length];
+      }
+   }
+
+   // compute the nonzeros of row k
+   this->D[k] = y[k];
+   double magnitude = std::abs(y[k]);
+   y[k] = 0.;
+   for (; top < n; top++) {
+      const size_t i = pattern[top];
+      const double yi = y[i];
+      y[i] = 0.;
+      const size_t end = this->L_column_starts[i] + this->L_column_lengths[i];
+      for (size_t position: Range(this->L_column_starts[i], end)) {
+         y[this->L_row_indices[position]] -= this->L_values[position] * yi;
+      }
+      // a zero pivot decouples its variable
+      const double l_ki = (this->D[i] != 0.) ? yi / this->D[i] : 0.;
+      this->D[k] -= l_ki * yi;
+      magnitude += std::abs(l_ki * yi);
+      this->L_row_indices[end] = k;
+      this->L_values[end] = l_ki;
+      this->L_column_lengths[i]++;
+   }
+   // zero pivot: tiny in absolute value or cancelled out
+   if (std::abs(this->D[k]) <= std::max(this->zero_pivot_tolerance, this->cancellation_tolerance * magnitude)) {
+      this->D[k] = 0.;
+   }
+}
+
+// P A P^T = L D L^T
+void SparseLDLSolver::solve_indefinite_system(const SymmetricMatrix<double>& /*matrix*/, const std::vector<double>& rhs, std::vector<double>& result) {
+   const size_t n = this->dimension;
+   std::vector<double>& x = this->permuted_rhs;
+   for (size_t k: Range(n)) {
+      x[k] = rhs[this->permutation[k]];
+   }
+   // L z = P b
+   for (size_t j: Range(n)) {
+      for (size_t position: Range(this->L_column_starts[j], this->L_column_starts[j] + this->L_column_lengths[j])) {
+         x[this->L_row_indices[position]] -= this->L_values[position] * x[j];
+      }
+   }
+   // D w = z (the components of the zero pivots are set to zero)
+   for (size_t k: Range(n)) {
+      x[k] = (this->D[k] != 0.) ? x[k] / this->D[k] : 0.;
+   }
+   // L^T v = w
+   for (size_t index: Range<BACKWARD>(n, 0)) {
+      const size_t j = index - 1;
+      for (size_t position: Range(this->L_column_starts[j], this->L_column_starts[j] + this->L_column_lengths[j])) {
+         x[j] -= this->L_values[position] * x[this->L_row_indices[position]];
+      }
+   }
+   for (size_t k: Range(n)) {
+      result[this->permutation[k]] = x[k];
+   }
+}
+
+std::tuple<size_t, size_t, size_t> SparseLDLSolver::get_inertia() const {
+   return std::make_tuple(this->number_positive, this->number_negative, this->number_zero);
+}
+
+size_t SparseLDLSolver::number_negative_eigenvalues() const {
+   return this->number_negative;
+}
+
+bool SparseLDLSolver::matrix_is_singular() const {
+   return (0 < this->number_zero);
+}
+
+size_t SparseLDLSolver::rank() const {
+   return this->number_positive + this->number_negative;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSELDLSOLVER_H
+#define UNO_SPARSELDLSOLVER_H
+
+#include <memory>
+#include <vector>
+#include "SymmetricIndefiniteLinearSolver.hpp"
+#include "FillReducingOrdering.hpp"
+
+/*! \class SparseLDLSolver
+ * \brief Multithreaded sparse LDL^T factorization with static pivoting
+ *
+ *  Up-looking LDL^T factorization (T. A. Davis, "Algorithm 849: A concise sparse Cholesky factorization package")
+ *  of the symmetrically permuted matrix P A P^T. Row k of L only depends on the rows of its subtree in the elimination tree,
+ *  therefore the nodes of a given level of the elimination tree (disjoint subtrees) are factorized concurrently by OpenMP threads.
+ *  Pivots are not exchanged: a pivot that vanishes by cancellation (small with respect to the terms it was computed from)
+ *  is a zero eigenvalue and is not perturbed. The factorization is then reported singular (the caller regularizes the
+ *  matrix, which makes the augmented systems quasi-definite), the variable is decoupled from the others and its
+ *  component of the solution is set to zero, as MA57 does. The inertia is given by the signs of D.
+ */
+class SparseLDLSolver : public SymmetricIndefiniteLinearSolver<double> {
+public:
+   SparseLDLSolver(size_t max_dimension, size_t max_number_nonzeros, std::unique_ptr<FillReducingOrdering> ordering, size_t number_threads);
+   ~SparseLDLSolver() override = default;
+
+   void factorize(const SymmetricMatrix<double>& matrix) override;
+   void do_symbolic_factorization(const SymmetricMatrix<double>& matrix) override;
+   void do_numerical_factorization(const SymmetricMatrix<double>& matrix) override;
+   void solve_indefinite_system(const SymmetricMatrix<double>& matrix, const std::vector<double>& rhs, std::vector<double>& result) override;
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+   [[nodiscard]] size_t number_negative_eigenvalues() const override;
+   [[nodiscard]] bool matrix_is_singular() const override;
+   [[nodiscard]] size_t rank() const override;
+
+   void set_number_threads(size_t new_number_threads);
+
+private:
+   const std::unique_ptr<FillReducingOrdering> ordering;
+   size_t number_threads; /*!< 0: OpenMP default */
+   const double zero_pivot_tolerance{1e-20}; /*!< absolute */
+   const double cancellation_tolerance{1e-12}; /*!< relative to the magnitude of the terms of the pivot */
+   size_t dimension{0};
+
+   // permutation: the k-th pivot is variable permutation[k], inverse_permutation[permutation[k]] = k
+   std::vector<size_t> permutation{};
+   std::vector<size_t> inverse_permutation{};
+
+   // upper triangle of P A P^T (compressed columns) and position of each entry of the original matrix in it
+   std::vector<size_t> column_starts{};
+   std::vector<size_t> row_indices{};
+   std::vector<double> values{};
+   std::vector<size_t> entry_positions{};
+
+   // elimination tree, grouped by levels (the nodes of a level are roots of disjoint subtrees)
+   std::vector<size_t> parent{};
+   std::vector<std::vector<size_t>> levels{};
+
+   // factors L (strict lower triangle, compressed columns) and D
+   std::vector<size_t> L_column_starts{};
+   std::vector<size_t> L_column_lengths{};
+   std::vector<size_t> L_row_indices{};
+   std::vector<double> L_values{};
+   std::vector<double> D{};
+
+   size_t number_positive{0};
+   size_t number_negative{0};
+   size_t number_zero{0};
+
+   // thread-local workspace
+   struct Workspace {
+      std::vector<double> y;
+      std::vector<size_t> pattern;
+      std::vector<size_t> flag;
+   };
+   std::vector<Workspace> workspaces{};
+   std::vector<double> permuted_rhs{};
+
+   void factorize_row(size_t k, Workspace& workspace);
+};
+
+#endif // UNO_SPARSELDLSOLVER_H
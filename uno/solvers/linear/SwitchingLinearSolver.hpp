@@ -0,0 +1,72 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SWITCHINGLINEARSOLVER_H
+#define UNO_SWITCHINGLINEARSOLVER_H
+
+#include <cassert>
+#include <memory>
+#include "SymmetricIndefiniteLinearSolver.hpp"
+#include "DenseSolver.hpp"
+#include "tools/Logger.hpp"
+
+/*! \class SwitchingLinearSolver
+ * \brief Switch between a sparse solver and the dense solver
+ *
+ *  The solver is chosen at each symbolic factorization from the actual number of nonzeros of the matrix: the dense
+ *  solver (allocated on first use) factorizes the matrices whose density is above a threshold, the sparse solver the others.
+ *  The factory only creates it for dimensions small enough for a dense copy of the matrix
+ */
+class SwitchingLinearSolver : public SymmetricIndefiniteLinearSolver<double> {
+public:
+   SwitchingLinearSolver(size_t max_dimension, std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> sparse_solver, double min_density):
+         SymmetricIndefiniteLinearSolver<double>(max_dimension), sparse_solver(std::move(sparse_solver)), min_density(min_density) { }
+   ~SwitchingLinearSolver() override = default;
+
+   void factorize(const SymmetricMatrix<double>& matrix) override {
+      this->do_symbolic_factorization(matrix);
+      this->do_numerical_factorization(matrix);
+   }
+
+   void do_symbolic_factorization(const SymmetricMatrix<double>& matrix) override {
+      // density of the upper triangle
+      const double dimension = static_cast<double>(matrix.dimension);
+      const double density = (0 < matrix.dimension) ? static_cast<double>(matrix.number_nonzeros) / (dimension * (dimension + 1.) / 2.) : 1.;
+      if (this->min_density <= density) {
+         if (this->dense_solver == nullptr) {
+            DEBUG << "Switching to the dense linear solver (dimension " << matrix.dimension << ", density " << density << ")\n";
+            this->dense_solver = std::make_unique<DenseSolver>(this->max_dimension);
+         }
+         this->current_solver = this->dense_solver.get();
+      }
+      else {
+         this->current_solver = this->sparse_solver.get();
+      }
+      this->current_solver->do_symbolic_factorization(matrix);
+   }
+
+   void do_numerical_factorization(const SymmetricMatrix<double>& matrix) override {
+      assert(this->current_solver != nullptr && "SwitchingLinearSolver: the symbolic factorization was not performed");
+      this->current_solver->do_numerical_factorization(matrix);
+   }
+
+   void solve_indefinite_system(const SymmetricMatrix<double>& matrix, const std::vector<double>& rhs, std::vector<double>& result) override {
+      this->current_solver->solve_indefinite_system(matrix, rhs, result);
+   }
+
+   [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override { return this->current_solver->get_inertia(); }
+   [[nodiscard]] size_t number_negative_eigenvalues() const override { return this->current_solver->number_negative_eigenvalues(); }
+   [[nodiscard]] bool matrix_is_singular() const override { return this->current_solver->matrix_is_singular(); }
+   [[nodiscard]] size_t rank() const override { return this->current_solver->rank(); }
+
+   // whether the last symbolic factorization selected the dense solver
+   [[nodiscard]] bool uses_dense_solver() const { return this->current_solver != nullptr && this->current_solver == this->dense_solver.get(); }
+
+private:
+   const std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> sparse_solver;
+   std::unique_ptr<DenseSolver> dense_solver{nullptr};
+   SymmetricIndefiniteLinearSolver<double>* current_solver{nullptr};
+   const double min_density;
+};
+
+#endif // UNO_SWITCHINGLINEARSOLVER_H
@@ -6,6 +6,10 @@
 
 #include <memory>
 #include "SymmetricIndefiniteLinearSolver.hpp"
+#include "DenseSolver.hpp"
+#include "SparseLDLSolver.hpp"
+#include "SwitchingLinearSolver.hpp"
+#include "tools/Options.hpp"
 
 #ifdef HAS_MA57
 #include "MA57Solver.hpp"
@@ -20,17 +24,57 @@ public:
          return std::make_unique<MA57Solver>(max_dimension, max_number_nonzeros);
       }
 #endif
+      if (linear_solver_name == "dense") {
+         return std::make_unique<DenseSolver>(max_dimension);
+      }
+      if (linear_solver_name == "LDL") {
+         return std::make_unique<SparseLDLSolver>(max_dimension, max_number_nonzeros, std::make_unique<FillReducingOrdering>("MD", "none"), 0);
+      }
       throw std::invalid_argument("Linear solver name is unknown");
    }
 
-   // return the list of available QP solvers
+   // switch to the dense solver when the matrix is dense (actual number of nonzeros) and small enough for a dense copy,
+   // use the solver given by the options otherwise
+   static std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> create(size_t max_dimension, size_t max_number_nonzeros, const Options& options) {
+      std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> solver = SymmetricIndefiniteLinearSolverFactory::create_sparse(max_dimension,
+            max_number_nonzeros, options);
+      if (options.get_bool("dense_linear_solver_switch") && max_dimension <= options.get_unsigned_int("dense_linear_solver_max_dimension")) {
+         return std::make_unique<SwitchingLinearSolver>(max_dimension, std::move(solver), options.get_double("dense_linear_solver_min_density"));
+      }
+      return solver;
+   }
+
+   // return the list of available linear solvers
    static std::vector<std::string> available_solvers() {
       std::vector<std::string> solvers{};
       #ifdef HAS_MA57
       solvers.emplace_back("MA57");
       #endif
+      solvers.emplace_back("dense");
+      solvers.emplace_back("LDL");
       return solvers;
    }
+
+private:
+   // solver given by the options
+   static std::unique_ptr<SymmetricIndefiniteLinearSolver<double>> create_sparse(size_t max_dimension, size_t max_number_nonzeros,
+         const Options& options) {
+#ifdef HAS_MA57
+      // sparse solver with a fill-reducing ordering computed outside of the solver
+      const std::string& ordering_method = options.get_string("linear_solver_ordering");
+      if (options.get_string("linear_solver") == "MA57" && ordering_method != "internal") {
+         return std::make_unique<MA57Solver>(max_dimension, max_number_nonzeros,
+               std::make_unique<FillReducingOrdering>(ordering_method, options.get_string("linear_solver_ordering_cache_file")));
+      }
+#endif
+      if (options.get_string("linear_solver") == "LDL") {
+         const std::string& ordering_method = options.get_string("linear_solver_ordering");
+         return std::make_unique<SparseLDLSolver>(max_dimension, max_number_nonzeros,
+               std::make_unique<FillReducingOrdering>(ordering_method == "internal" ? "MD" : ordering_method,
+                     options.get_string("linear_solver_ordering_cache_file")), options.get_unsigned_int("linear_solver_threads"));
+      }
+      return SymmetricIndefiniteLinearSolverFactory::create(options.get_string("linear_solver"), max_dimension, max_number_nonzeros);
+   }
 };
 
 #endif // UNO_LINEARSOLVERFACTORY_H
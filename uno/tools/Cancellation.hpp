@@ -0,0 +1,38 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_CANCELLATION_H
+#define UNO_CANCELLATION_H
+
+#include <atomic>
+#include <exception>
+
+struct SolveCancelled : public std::exception {
+   [[nodiscard]] const char* what() const noexcept override {
+      return "The solve was cancelled\n";
+   }
+};
+
+/*! \class Cancellation
+ * \brief Cooperative cancellation of the solve running on the current thread
+ *
+ *  Another thread requests the cancellation by setting the flag. The solve checks it at the iteration and subproblem
+ *  boundaries and unwinds with a SolveCancelled exception.
+ */
+class Cancellation {
+public:
+   // the flag is owned by the caller (nullptr: the solve cannot be cancelled)
+   static void set_flag(const std::atomic<bool>* flag) { Cancellation::flag = flag; }
+   [[nodiscard]] static bool is_requested() { return Cancellation::flag != nullptr && Cancellation::flag->load(std::memory_order_relaxed); }
+
+   static void check() {
+      if (Cancellation::is_requested()) {
+         throw SolveCancelled();
+      }
+   }
+
+private:
+   static inline thread_local const std::atomic<bool>* flag{nullptr};
+};
+
+#endif // UNO_CANCELLATION_H
@@ -4,7 +4,7 @@
 #include "Logger.hpp"
 
 #ifdef UNO_SHARED
-Level Logger::level = INFO;
+thread_local Level Logger::level = INFO;
 
 void Logger::set_logger(const std::string& logger_level) {
    if (logger_level == "ERROR") {
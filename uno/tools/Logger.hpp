@@ -21,7 +21,7 @@ enum Level {
 
 class Logger {
 public:
-   static Level level;
+   static thread_local Level level; // per thread, so that concurrent solves have their own verbosity
 #ifdef UNO_SHARED
     void set_logger(const std::string& logger_level);
 #else
@@ -194,3 +194,36 @@ void get_command_line_options(int argc, char* argv[], Options& options) {
       }
    }
 }
+
+// each line "name option value option value ..." defines a set of options on top of the base options
+std::vector<std::pair<std::string, Options>> read_option_sets(const std::string& file_name, const Options& base_options) {
+   std::vector<std::pair<std::string, Options>> option_sets;
+   if (file_name == "none") {
+      option_sets.emplace_back("default", base_options);
+      return option_sets;
+   }
+   std::ifstream file(file_name);
+   if (not file) {
+      throw std::invalid_argument("The option sets file " + file_name + " could not be opened");
+   }
+   std::string line;
+   while (std::getline(file, line)) {
+      std::istringstream stream(line);
+      std::string name;
+      if (line.empty() || line[0] == '#' || not (stream >> name)) {
+         continue;
+      }
+      Options options = base_options;
+      std::string key, value;
+      while (stream >> key >> value) {
+         if (key == "preset") {
+            find_preset(value, options);
+         }
+         else {
+            options[key] = value;
+         }
+      }
+      option_sets.emplace_back(std::move(name), std::move(options));
+   }
+   return option_sets;
+}
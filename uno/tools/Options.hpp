@@ -6,6 +6,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 class Options {
 public:
@@ -30,5 +32,7 @@ Options get_default_options(const std::string& file_name);
 void find_preset(const std::string& preset_name, Options& options);
 void get_command_line_options(int argc, char* argv[], Options& options);
 void set_logger(const std::string& logger_level);
+// named sets of options read from a file (none: the base options only)
+std::vector<std::pair<std::string, Options>> read_option_sets(const std::string& file_name, const Options& base_options);
 
 #endif // UNO_OPTIONS_H
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cstring>
+#include <iomanip>
+#include "Profiler.hpp"
+
+std::mutex Profiler::mutex;
+ProfilerNode Profiler::merged_root{"total", nullptr};
+
+ProfilerNode& ProfilerNode::find_or_create_child(const char* child_name) {
+   for (const std::unique_ptr<ProfilerNode>& child: this->children) {
+      // names are usually string literals: compare the pointers first
+      if (child->name == child_name || std::strcmp(child->name, child_name) == 0) {
+         return *child;
+      }
+   }
+   this->children.emplace_back(std::make_unique<ProfilerNode>(child_name, this));
+   return *this->children.back();
+}
+
+Profiler::ThreadProfile& Profiler::get_thread_profile() {
+   thread_local ThreadProfile thread_profile{};
+   return thread_profile;
+}
+
+// the times of a terminating thread are kept in the global tree
+Profiler::ThreadProfile::~ThreadProfile() {
+   Profiler::merge_thread_profile(*this);
+}
+
+void Profiler::enter(const char* name) {
+   ThreadProfile& profile = Profiler::get_thread_profile();
+   profile.current_node = &profile.current_node->find_or_create_child(name);
+}
+
+void Profiler::exit(double duration) {
+   ThreadProfile& profile = Profiler::get_thread_profile();
+   profile.current_node->total_time += duration;
+   profile.current_node->number_calls++;
+   profile.current_node = profile.current_node->parent;
+}
+
+static void reset_node(ProfilerNode& node) {
+   node.total_time = 0.;
+   node.number_calls = 0;
+   for (const std::unique_ptr<ProfilerNode>& child: node.children) {
+      reset_node(*child);
+   }
+}
+
+void Profiler::reset() {
+   // the nodes of the thread tree are kept, since the open scopes point to them
+   reset_node(Profiler::get_thread_profile().root);
+   std::lock_guard<std::mutex> lock(Profiler::mutex);
+   Profiler::merged_root.children.clear();
+}
+
+// add the times of a thread tree into the merged tree
+static void merge_node(ProfilerNode& merged_node, const ProfilerNode& node) {
+   merged_node.total_time += node.total_time;
+   merged_node.number_calls += node.number_calls;
+   for (const std::unique_ptr<ProfilerNode>& child: node.children) {
+      if (0 < child->number_calls) {
+         merge_node(merged_node.find_or_create_child(child->name), *child);
+      }
+   }
+}
+
+// move the times of a thread tree into the global tree
+void Profiler::merge_thread_profile(ThreadProfile& profile) {
+   {
+      std::lock_guard<std::mutex> lock(Profiler::mutex);
+      merge_node(Profiler::merged_root, profile.root);
+   }
+   reset_node(profile.root);
+}
+
+static void print_node(std::ostream& stream, const ProfilerNode& node, double parent_time, size_t depth) {
+   const double percentage = (0. < parent_time) ? 100. * node.total_time / parent_time : 100.;
+   stream << std::string(2 * depth, ' ') << std::left << std::setw(static_cast<int>(40 - 2 * depth)) << node.name << std::right <<
+         std::fixed << std::setprecision(4) << std::setw(12) << node.total_time << " s" << std::setprecision(1) << std::setw(8) << percentage << "%" <<
+         std::setw(10) << node.number_calls << " calls\n";
+   for (const std::unique_ptr<ProfilerNode>& child: node.children) {
+      print_node(stream, *child, node.total_time, depth + 1);
+   }
+}
+
+void Profiler::print_summary(std::ostream& stream) {
+   Profiler::merge_thread_profile(Profiler::get_thread_profile());
+   const std::ios_base::fmtflags flags = stream.flags();
+   const std::streamsize precision = stream.precision();
+   stream << "Wall-clock profile (time, % of parent phase, number of calls):\n";
+   {
+      std::lock_guard<std::mutex> lock(Profiler::mutex);
+      for (const std::unique_ptr<ProfilerNode>& child: Profiler::merged_root.children) {
+         print_node(stream, *child, 0., 0);
+      }
+   }
+   stream.flags(flags);
+   stream.precision(precision);
+}
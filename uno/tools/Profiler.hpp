@@ -0,0 +1,89 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PROFILER_H
+#define UNO_PROFILER_H
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Tracer.hpp"
+
+// node of the tree of phases: time and number of calls accumulated by the scopes with the same name and the same ancestors
+struct ProfilerNode {
+   const char* name;
+   ProfilerNode* parent;
+   double total_time{0.};
+   size_t number_calls{0};
+   std::vector<std::unique_ptr<ProfilerNode>> children{};
+
+   ProfilerNode(const char* name, ProfilerNode* parent): name(name), parent(parent) { }
+   [[nodiscard]] ProfilerNode& find_or_create_child(const char* child_name);
+};
+
+/*! \class Profiler
+ * \brief Hierarchical wall-clock profiler
+ *
+ *  Each thread accumulates the durations of its scopes in its own thread-local tree (no synchronization on the hot path),
+ *  which no other thread reads. A tree is merged, under a mutex, into the global tree when its thread terminates or when
+ *  the thread prints the summary: the trees of worker threads are therefore included once the workers are joined.
+ */
+class Profiler {
+public:
+   static void enter(const char* name);
+   static void exit(double duration);
+   // reset the global tree and the tree of the calling thread
+   static void reset();
+   // merge the tree of the calling thread and print the global tree
+   static void print_summary(std::ostream& stream);
+
+protected:
+   struct ThreadProfile {
+      ProfilerNode root{"total", nullptr};
+      ProfilerNode* current_node{&root};
+
+      ~ThreadProfile();
+   };
+
+   static std::mutex mutex;
+   static ProfilerNode merged_root; // guarded by the mutex
+
+   static ThreadProfile& get_thread_profile();
+   static void merge_thread_profile(ThreadProfile& profile);
+};
+
+// scope measured on a monotonic clock from its creation to its destruction (and written as a span in the trace, if any)
+class ProfilerScope {
+public:
+   explicit ProfilerScope(const char* name): name(name), start_time(std::chrono::steady_clock::now()) {
+      Profiler::enter(name);
+   }
+
+   ~ProfilerScope() {
+      const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - this->start_time;
+      Profiler::exit(duration.count());
+      if (Tracer::is_enabled()) {
+         Tracer::add_span(this->name, this->start_time, duration.count());
+      }
+   }
+
+   ProfilerScope(const ProfilerScope&) = delete;
+   ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+protected:
+   const char* name;
+   const std::chrono::steady_clock::time_point start_time;
+};
+
+// the profiler is compiled out with -DUNO_DISABLE_PROFILER (CMake option WITH_PROFILER=OFF)
+#ifdef UNO_DISABLE_PROFILER
+#define PROFILE_SCOPE(name)
+#else
+#define PROFILE_SCOPE_CONCATENATE_(prefix, line) prefix##line
+#define PROFILE_SCOPE_CONCATENATE(prefix, line) PROFILE_SCOPE_CONCATENATE_(prefix, line)
+#define PROFILE_SCOPE(name) const ProfilerScope PROFILE_SCOPE_CONCATENATE(profiler_scope_, __LINE__)(name)
+#endif
+
+#endif // UNO_PROFILER_H
@@ -1,207 +1,158 @@
 // Copyright (c) 2018-2023 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
-#include <fstream>
+#include <sstream>
 #include "Statistics.hpp"
 
-// TODO move this to the option file
-int Statistics::int_width = 7;
-int Statistics::double_width = 17;
-int Statistics::char_width = 7;
+const int Statistics::int_width = 7;
+const int Statistics::double_width = 17;
+const int Statistics::string_width = 7;
 
-Statistics::Statistics(const Options& options): print_header_every_iterations(options.get_unsigned_int("statistics_print_header_every_iterations")) {
+StatisticsColumn::StatisticsColumn(std::string name, ColumnType type, int width): name(std::move(name)), type(type), width(width) {
 }
 
-void Statistics::add_column(std::string name, int width, int order) {
-   this->columns[order] = name;
-   this->widths[std::move(name)] = width;
+bool StatisticsColumn::has_value(size_t line) const {
+   return this->first_line <= line && line - this->first_line < this->is_set.size() && this->is_set[line - this->first_line];
 }
 
-void Statistics::add_statistic(std::string name, std::string value) {
-   this->current_line[std::move(name)] = std::move(value);
-}
-
-void Statistics::add_statistic(std::string name, int value) {
-   add_statistic(std::move(name), std::to_string(value));
-}
-
-void Statistics::add_statistic(std::string name, size_t value) {
-   add_statistic(std::move(name), std::to_string(value));
-}
-
-void Statistics::add_statistic(std::string name, double value) {
+std::string StatisticsColumn::format(size_t line) const {
+   if (not this->has_value(line)) {
+      return "-";
+   }
+   if (this->type == ColumnType::STRING) {
+      return this->string(line);
+   }
    std::ostringstream stream;
-   stream << std::defaultfloat << std::setprecision(7) << value;
-   add_statistic(std::move(name), stream.str());
+   if (this->type == ColumnType::INTEGER && std::isfinite(this->value(line))) {
+      stream << static_cast<long long>(this->value(line));
+   }
+   else {
+      stream << std::defaultfloat << std::setprecision(7) << this->value(line);
+   }
+   return stream.str();
 }
 
-void Statistics::print_header(bool first_occurrence) {
-   /* line above */
-   std::cout << (first_occurrence ? Statistics::symbol("top-left") : Statistics::symbol("left-mid"));
-   int k = 0;
-   for (const auto& element: this->columns) {
-      if (0 < k) {
-         std::cout << (first_occurrence ? Statistics::symbol("top-mid") : Statistics::symbol("mid-mid"));
-      }
-      std::string header = element.second;
-      for (int j = 0; j < this->widths[header]; j++) {
-         std::cout << Statistics::symbol("top");
-      }
-      k++;
-   }
-   std::cout << (first_occurrence ? Statistics::symbol("top-right") : Statistics::symbol("right-mid")) << '\n';
-   /* headers */
-   std::cout << Statistics::symbol("left");
-   k = 0;
-   for (const auto& element: this->columns) {
-      if (0 < k) {
-         std::cout << Statistics::symbol("middle");
+void StatisticsColumn::store_lines(size_t first_stored_line, size_t number_lines) {
+   if (this->first_line < first_stored_line) {
+      const size_t number_dropped_lines = std::min(first_stored_line - this->first_line, this->is_set.size());
+      const auto end = static_cast<std::ptrdiff_t>(number_dropped_lines);
+      this->is_set.erase(this->is_set.begin(), this->is_set.begin() + end);
+      if (this->type == ColumnType::STRING) {
+         this->strings.erase(this->strings.begin(), this->strings.begin() + end);
       }
-      std::string header = element.second;
-      std::cout << " " << header;
-      for (int j = 0; j < this->widths[header] - static_cast<int>(header.size()) - 1; j++) {
-         std::cout << " ";
+      else {
+         this->values.erase(this->values.begin(), this->values.begin() + end);
       }
-      k++;
+      this->first_line = first_stored_line;
+   }
+   // a column added after the first lines is unset on those lines
+   const size_t number_stored_lines = number_lines - this->first_line;
+   this->is_set.resize(number_stored_lines, false);
+   if (this->type == ColumnType::STRING) {
+      this->strings.resize(number_stored_lines);
+   }
+   else {
+      this->values.resize(number_stored_lines, 0.);
    }
-   std::cout << Statistics::symbol("right") << '\n';
 }
 
-void Statistics::print_current_line() {
-   if (this->iteration % this->print_header_every_iterations == 0) {
-      this->print_header(this->iteration == 0);
-   }
-   std::cout << Statistics::symbol("left-mid");
-   int k = 0;
-   for (const auto& element: this->columns) {
-      if (0 < k) {
-         std::cout << Statistics::symbol("mid-mid");
-      }
-      std::string header = element.second;
-      for (int j = 0; j < this->widths[header]; j++) {
-         std::cout << Statistics::symbol("bottom");
-      }
-      k++;
-   }
-   std::cout << Statistics::symbol("right-mid") << '\n';
-   /* headers */
-   std::cout << Statistics::symbol("left");
-   k = 0;
-   for (const auto& element: this->columns) {
-      if (0 < k) {
-         std::cout << Statistics::symbol("middle");
-      }
-      const std::string& header = element.second;
-      int size;
-      try {
-         std::string value = this->current_line.at(header);
-         std::cout << " " << value;
-         size = 1 + static_cast<int>(value.size());
-      }
-      catch (const std::out_of_range&) {
-         std::cout << " -";
-         size = 2;
-      }
-      int number_spaces = (size <= this->widths[header]) ? this->widths[header] - size : 0;
-      for (int j = 0; j < number_spaces; j++) {
-         std::cout << " ";
-      }
-      k++;
-   }
-   std::cout << Statistics::symbol("right") << '\n';
-   this->iteration++;
+Statistics::Statistics(const Options& options): sink(StatisticsSink::create(options)) {
 }
 
-void Statistics::print_footer() {
-   std::cout << Statistics::symbol("bottom-left");
-   int k = 0;
-   for (const auto& element: this->columns) {
-      if (0 < k) {
-         std::cout << Statistics::symbol("bottom-mid");
-      }
-      std::string header = element.second;
-      for (int j = 0; j < this->widths[header]; j++) {
-         std::cout << Statistics::symbol("bottom");
-      }
-      k++;
+void Statistics::add_column(std::string name, ColumnType type, int order) {
+   const int type_width = (type == ColumnType::INTEGER) ? Statistics::int_width :
+         (type == ColumnType::DOUBLE) ? Statistics::double_width : Statistics::string_width;
+   // leave room for the header and its surrounding spaces
+   const int width = std::max(type_width, static_cast<int>(name.size()) + 2);
+
+   size_t column_index;
+   if (auto position = this->column_indices.find(name); position != this->column_indices.end()) {
+      // a column registered twice (e.g. by two ingredients) keeps its type
+      column_index = position->second;
+      this->columns[column_index].width = std::max(this->columns[column_index].width, width);
+   }
+   else {
+      column_index = this->columns.size();
+      this->column_indices.emplace(name, column_index);
+      this->columns.emplace_back(std::move(name), type, width);
+   }
+   // a column replaces any previous column with the same order
+   this->columns_by_order[order] = column_index;
+   this->display_order.clear();
+   for (const auto& [column_order, index]: this->columns_by_order) {
+      this->display_order.push_back(index);
    }
-   std::cout << Statistics::symbol("bottom-right") << '\n';
 }
 
-void Statistics::new_line() {
-   this->current_line.clear();
+StatisticsColumn* Statistics::current_cell(std::string_view name) {
+   if (this->lines == 0) {
+      return nullptr;
+   }
+   // statistics of unregistered columns are ignored
+   auto position = this->column_indices.find(name);
+   return (position != this->column_indices.end()) ? &this->columns[position->second] : nullptr;
 }
 
-// Add the stats of one iteration to the map of all iterations
-void Statistics::add_iteration() {
-   std::string iterations_number = std::to_string(this->iteration);
-   this->iteration_info[std::move(iterations_number)] = std::move(this->current_line);
+void Statistics::add_statistic(std::string_view name, int value) {
+   this->add_statistic(name, static_cast<double>(value));
 }
 
-std::ostream& Statistics::write_line(std::ostream& os, std::map<std::string, std::string>& line)
-{
-   os << "    {\n";
+void Statistics::add_statistic(std::string_view name, size_t value) {
+   this->add_statistic(name, static_cast<double>(value));
+}
 
-   std::map<int, std::string>::iterator it;
-   for (it = this->columns.begin(); it != this->columns.end(); it++) {
-      
-      if (it != this->columns.begin()){
-         os << ",\n"; //Write the comma
-      }
-      const std::string& header = it->second;
-      try {
-         std::string value = line.at(header);
-         os << "        \"" << header << "\": " << value;
-      }
-      catch (const std::out_of_range&) {
-         os << "        \"" << header << "\": -";
-      }
+void Statistics::add_statistic(std::string_view name, double value) {
+   if (not this->enabled) {
+      return;
+   }
+   StatisticsColumn* column = this->current_cell(name);
+   if (column != nullptr && column->type != ColumnType::STRING) {
+      column->values[this->lines - 1 - column->first_line] = value;
+      column->is_set[this->lines - 1 - column->first_line] = true;
    }
-
-    os << "    }";
-    return os;
 }
 
+void Statistics::add_statistic(std::string_view name, std::string value) {
+   if (not this->enabled) {
+      return;
+   }
+   StatisticsColumn* column = this->current_cell(name);
+   if (column != nullptr && column->type == ColumnType::STRING) {
+      column->strings[this->lines - 1 - column->first_line] = std::move(value);
+      column->is_set[this->lines - 1 - column->first_line] = true;
+   }
+}
 
-void Statistics::serialize() {
-
-   std::ofstream output_file; 
-   output_file.open("uno_statistics.json");
-   output_file << "{\n";
-   std::map<std::string, std::map<std::string, std::string>>::iterator it;
-   for (it = this->iteration_info.begin(); it != this->iteration_info.end(); it++)
-   {
-      if (it != this->iteration_info.begin()){
-         output_file << ",\n"; //Write the comma
-      }
-      output_file << "    \"" << it->first << "\":\n";
-      this->write_line(output_file, it->second);
+void Statistics::new_line() {
+   // the verbosity may have changed since the last line
+   this->enabled = (this->sink != nullptr) && this->sink->is_active();
+   if (not this->enabled) {
+      return;
+   }
+   // the lines written by the sink are dropped: the memory does not grow with the number of iterations
+   for (StatisticsColumn& column: this->columns) {
+      column.store_lines(this->number_written_lines, this->lines + 1);
    }
+   this->lines++;
+}
 
-   output_file << "}";
-   output_file.close();
+void Statistics::print_current_line() {
+   if (this->enabled && 0 < this->lines) {
+      this->sink->write_line(*this, this->lines - 1);
+      this->number_written_lines = this->lines;
+   }
 }
 
+void Statistics::close() {
+   if (this->sink != nullptr && 0 < this->lines) {
+      this->sink->finish(*this);
+   }
+}
 
-const std::string& Statistics::symbol(const std::string& value) {
-   static std::map<std::string, std::string> symbols = {
-         {"top", "─"},
-         {"top-mid", "┬"},
-         {"top-left", "┌"},
-         {"top-right", "┐"},
-         {"bottom", "─"},
-         {"bottom-mid", "┴"},
-         {"bottom-left", "└"},
-         {"bottom-right", "┘"},
-         {"left", "│"},
-         {"left-mid", "├"},
-         {"mid", "─"},
-         {"mid-mid", "┼"},
-         {"right", "│"},
-         {"right-mid", "┤"},
-         {"middle", "│"}
-   };
-   return symbols[value];
-}
\ No newline at end of file
+const StatisticsColumn* Statistics::find_column(std::string_view name) const {
+   auto position = this->column_indices.find(name);
+   return (position != this->column_indices.end()) ? &this->columns[position->second] : nullptr;
+}
@@ -4,43 +4,73 @@
 #ifndef UNO_STATISTICS_H
 #define UNO_STATISTICS_H
 
-#include <string>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StatisticsSink.hpp"
 #include "tools/Options.hpp"
 
+enum class ColumnType {INTEGER, DOUBLE, STRING};
+
+// a column stores the raw values of the lines that the sink has not written yet; formatting is deferred until the sink
+// displays them. The lines are numbered from the start of the solve
+struct StatisticsColumn {
+   StatisticsColumn(std::string name, ColumnType type, int width);
+
+   std::string name;
+   ColumnType type;
+   int width;
+   size_t first_line{0}; // line of the first stored value
+   std::vector<double> values{}; // INTEGER and DOUBLE columns
+   std::vector<std::string> strings{}; // STRING columns
+   std::vector<bool> is_set{};
+
+   [[nodiscard]] bool has_value(size_t line) const;
+   // preconditions: has_value(line)
+   [[nodiscard]] double value(size_t line) const { return this->values[line - this->first_line]; }
+   [[nodiscard]] const std::string& string(size_t line) const { return this->strings[line - this->first_line]; }
+   [[nodiscard]] std::string format(size_t line) const;
+   // drop the values of the lines before first_stored_line, store the lines up to number_lines (excluded)
+   void store_lines(size_t first_stored_line, size_t number_lines);
+};
+
 class Statistics {
 public:
    explicit Statistics(const Options& options);
 
-   static int int_width;
-   static int double_width;
-   static int char_width;
-
-   bool serialize_iterations = false;
+   static const int int_width;
+   static const int double_width;
+   static const int string_width;
 
-   void add_column(std::string name, int width, int order);
-   void add_statistic(std::string name, std::string value);
-   void add_statistic(std::string name, int value);
-   void add_statistic(std::string name, size_t value);
-   void add_statistic(std::string name, double value);
-   void print_header(bool first_occurrence);
-   void print_current_line();
-   void print_footer();
+   void add_column(std::string name, ColumnType type, int order);
+   void add_statistic(std::string_view name, int value);
+   void add_statistic(std::string_view name, size_t value);
+   void add_statistic(std::string_view name, double value);
+   void add_statistic(std::string_view name, std::string value);
    void new_line();
+   void print_current_line();
+   void close();
 
-   void add_iteration();
-   void serialize();
-   std::ostream& write_line(std::ostream& os, std::map<std::string, std::string>& line);
+   [[nodiscard]] bool is_enabled() const { return this->enabled; }
+   [[nodiscard]] size_t number_lines() const { return this->lines; }
+   [[nodiscard]] const std::vector<size_t>& get_display_order() const { return this->display_order; }
+   [[nodiscard]] const StatisticsColumn& get_column(size_t column_index) const { return this->columns[column_index]; }
+   [[nodiscard]] const StatisticsColumn* find_column(std::string_view name) const;
 
 private:
-   size_t iteration{0};
-   std::map<int, std::string> columns{};
-   std::map<std::string, int> widths{};
-   std::map<std::string, std::string> current_line{};
-   std::map<std::string, std::map<std::string, std::string>> iteration_info;
-
-   size_t print_header_every_iterations{};
-   static const std::string& symbol(const std::string& value);
+   std::vector<StatisticsColumn> columns{};
+   std::map<std::string, size_t, std::less<>> column_indices{};
+   std::map<int, size_t> columns_by_order{};
+   std::vector<size_t> display_order{};
+   size_t lines{0};
+   size_t number_written_lines{0};
+   std::unique_ptr<StatisticsSink> sink;
+   bool enabled{false};
+
+   [[nodiscard]] StatisticsColumn* current_cell(std::string_view name);
 };
 
-#endif // UNO_STATISTICS_H
\ No newline at end of file
+#endif // UNO_STATISTICS_H
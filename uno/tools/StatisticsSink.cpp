@@ -0,0 +1,203 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include "StatisticsSink.hpp"
+#include "Statistics.hpp"
+#include "tools/Logger.hpp"
+
+std::unique_ptr<StatisticsSink> StatisticsSink::create(const Options& options) {
+   const std::string& sink_name = options.get_string("statistics_sink");
+   if (sink_name == "none") {
+      return nullptr;
+   }
+   else if (sink_name == "console") {
+      return std::make_unique<ConsoleStatisticsSink>(options.get_unsigned_int("statistics_print_header_every_iterations"));
+   }
+   else if (sink_name == "CSV") {
+      return std::make_unique<CSVStatisticsSink>(options.get_string("statistics_file"));
+   }
+   else if (sink_name == "NDJSON") {
+      return std::make_unique<NDJSONStatisticsSink>(options.get_string("statistics_file"));
+   }
+   throw std::invalid_argument("Statistics sink " + sink_name + " does not exist");
+}
+
+// console table
+
+ConsoleStatisticsSink::ConsoleStatisticsSink(size_t print_header_every_iterations):
+      StatisticsSink(), print_header_every_iterations(print_header_every_iterations) {
+}
+
+bool ConsoleStatisticsSink::is_active() const {
+   return Logger::level == INFO;
+}
+
+void ConsoleStatisticsSink::print_separator(const Statistics& statistics, const char* left, const char* middle, const char* right) {
+   std::cout << left;
+   bool first_column = true;
+   for (size_t column_index: statistics.get_display_order()) {
+      if (not first_column) {
+         std::cout << middle;
+      }
+      for (int j = 0; j < statistics.get_column(column_index).width; j++) {
+         std::cout << "─";
+      }
+      first_column = false;
+   }
+   std::cout << right << '\n';
+}
+
+void ConsoleStatisticsSink::print_header(const Statistics& statistics, bool first_occurrence) const {
+   if (first_occurrence) {
+      ConsoleStatisticsSink::print_separator(statistics, "┌", "┬", "┐");
+   }
+   else {
+      ConsoleStatisticsSink::print_separator(statistics, "├", "┼", "┤");
+   }
+   std::cout << "│";
+   bool first_column = true;
+   for (size_t column_index: statistics.get_display_order()) {
+      if (not first_column) {
+         std::cout << "│";
+      }
+      const StatisticsColumn& column = statistics.get_column(column_index);
+      std::cout << ' ' << std::left << std::setw(column.width - 1) << column.name << std::right;
+      first_column = false;
+   }
+   std::cout << "│\n";
+}
+
+void ConsoleStatisticsSink::write_line(const Statistics& statistics, size_t line) {
+   if (this->number_printed_lines % this->print_header_every_iterations == 0) {
+      this->print_header(statistics, this->number_printed_lines == 0);
+   }
+   ConsoleStatisticsSink::print_separator(statistics, "├", "┼", "┤");
+   std::cout << "│";
+   bool first_column = true;
+   for (size_t column_index: statistics.get_display_order()) {
+      if (not first_column) {
+         std::cout << "│";
+      }
+      const StatisticsColumn& column = statistics.get_column(column_index);
+      std::cout << ' ' << std::left << std::setw(column.width - 1) << column.format(line) << std::right;
+      first_column = false;
+   }
+   std::cout << "│\n";
+   this->number_printed_lines++;
+}
+
+void ConsoleStatisticsSink::finish(const Statistics& statistics) {
+   if (0 < this->number_printed_lines) {
+      ConsoleStatisticsSink::print_separator(statistics, "└", "┴", "┘");
+   }
+}
+
+// streamed sinks
+
+StreamStatisticsSink::StreamStatisticsSink(const std::string& file_name): StatisticsSink(), stream(&std::cout) {
+   if (file_name != "none") {
+      this->file.open(file_name);
+      if (not this->file) {
+         throw std::runtime_error("The statistics file " + file_name + " could not be opened");
+      }
+      this->stream = &this->file;
+   }
+}
+
+bool StreamStatisticsSink::is_active() const {
+   return true;
+}
+
+void StreamStatisticsSink::finish(const Statistics& /*statistics*/) {
+   this->stream->flush();
+}
+
+CSVStatisticsSink::CSVStatisticsSink(const std::string& file_name): StreamStatisticsSink(file_name) {
+}
+
+void CSVStatisticsSink::write_line(const Statistics& statistics, size_t line) {
+   std::ostream& stream = *this->stream;
+   // doubles are written with enough digits to be read back exactly
+   const std::streamsize precision = stream.precision(std::numeric_limits<double>::max_digits10);
+   if (not this->header_written) {
+      bool first_column = true;
+      for (size_t column_index: statistics.get_display_order()) {
+         stream << (first_column ? "" : ",") << statistics.get_column(column_index).name;
+         first_column = false;
+      }
+      stream << '\n';
+      this->header_written = true;
+   }
+   bool first_column = true;
+   for (size_t column_index: statistics.get_display_order()) {
+      const StatisticsColumn& column = statistics.get_column(column_index);
+      if (not first_column) {
+         stream << ',';
+      }
+      // unset cells are left empty
+      if (column.has_value(line)) {
+         if (column.type == ColumnType::STRING) {
+            stream << '"';
+            for (char character: column.string(line)) {
+               stream << ((character == '"') ? "\"\"" : std::string(1, character));
+            }
+            stream << '"';
+         }
+         else if (column.type == ColumnType::INTEGER) {
+            stream << column.format(line);
+         }
+         else {
+            stream << column.value(line);
+         }
+      }
+      first_column = false;
+   }
+   stream << '\n';
+   stream.precision(precision);
+}
+
+NDJSONStatisticsSink::NDJSONStatisticsSink(const std::string& file_name): StreamStatisticsSink(file_name) {
+}
+
+void NDJSONStatisticsSink::write_line(const Statistics& statistics, size_t line) {
+   std::ostream& stream = *this->stream;
+   // doubles are written with enough digits to be read back exactly
+   const std::streamsize precision = stream.precision(std::numeric_limits<double>::max_digits10);
+   stream << '{';
+   bool first_column = true;
+   for (size_t column_index: statistics.get_display_order()) {
+      const StatisticsColumn& column = statistics.get_column(column_index);
+      // unset cells are omitted
+      if (not column.has_value(line)) {
+         continue;
+      }
+      stream << (first_column ? "\"" : ",\"") << column.name << "\":";
+      if (column.type == ColumnType::STRING) {
+         stream << '"';
+         for (char character: column.string(line)) {
+            if (character == '"' || character == '\\') {
+               stream << '\\';
+            }
+            stream << character;
+         }
+         stream << '"';
+      }
+      // JSON has no representation of infinity and NaN
+      else if (not std::isfinite(column.value(line))) {
+         stream << "null";
+      }
+      else if (column.type == ColumnType::INTEGER) {
+         stream << column.format(line);
+      }
+      else {
+         stream << column.value(line);
+      }
+      first_column = false;
+   }
+   stream << "}\n";
+   stream.precision(precision);
+}
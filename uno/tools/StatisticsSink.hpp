@@ -0,0 +1,77 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_STATISTICSSINK_H
+#define UNO_STATISTICSSINK_H
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "tools/Options.hpp"
+
+class Statistics;
+
+// destination of the per-iteration statistics. Lines are streamed as they are completed
+class StatisticsSink {
+public:
+   virtual ~StatisticsSink() = default;
+
+   // an inactive sink disables the collection of statistics altogether
+   [[nodiscard]] virtual bool is_active() const = 0;
+   virtual void write_line(const Statistics& statistics, size_t line) = 0;
+   virtual void finish(const Statistics& statistics) = 0;
+
+   // "none" returns a null pointer
+   static std::unique_ptr<StatisticsSink> create(const Options& options);
+};
+
+// box-drawn table on the standard output, printed at the INFO level
+class ConsoleStatisticsSink : public StatisticsSink {
+public:
+   explicit ConsoleStatisticsSink(size_t print_header_every_iterations);
+
+   [[nodiscard]] bool is_active() const override;
+   void write_line(const Statistics& statistics, size_t line) override;
+   void finish(const Statistics& statistics) override;
+
+private:
+   const size_t print_header_every_iterations;
+   size_t number_printed_lines{0};
+
+   void print_header(const Statistics& statistics, bool first_occurrence) const;
+   static void print_separator(const Statistics& statistics, const char* left, const char* middle, const char* right);
+};
+
+// machine-readable sinks write to a file, or to the standard output if the file name is "none"
+class StreamStatisticsSink : public StatisticsSink {
+public:
+   explicit StreamStatisticsSink(const std::string& file_name);
+
+   [[nodiscard]] bool is_active() const override;
+   void finish(const Statistics& statistics) override;
+
+protected:
+   std::ofstream file{};
+   std::ostream* stream;
+};
+
+class CSVStatisticsSink : public StreamStatisticsSink {
+public:
+   explicit CSVStatisticsSink(const std::string& file_name);
+
+   void write_line(const Statistics& statistics, size_t line) override;
+
+private:
+   bool header_written{false};
+};
+
+// one JSON object per line
+class NDJSONStatisticsSink : public StreamStatisticsSink {
+public:
+   explicit NDJSONStatisticsSink(const std::string& file_name);
+
+   void write_line(const Statistics& statistics, size_t line) override;
+};
+
+#endif // UNO_STATISTICSSINK_H
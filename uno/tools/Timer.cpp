@@ -5,11 +5,12 @@
 #include <chrono>
 #include <ctime>
 
-Timer::Timer(): start_time(std::clock()) {
+Timer::Timer(): start_time(std::chrono::steady_clock::now()) {
 }
 
 double Timer::get_duration() const {
-   return static_cast<double>(std::clock() - this->start_time) / static_cast<double>(CLOCKS_PER_SEC);
+   const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - this->start_time;
+   return duration.count();
 }
 
 char* Timer::get_current_date() {
@@ -4,9 +4,9 @@
 #ifndef UNO_TIMER_H
 #define UNO_TIMER_H
 
-#include <ctime>
+#include <chrono>
 
-// timer starts upon creation
+// wall-clock timer (monotonic clock), starts upon creation
 class Timer {
 public:
    Timer();
@@ -14,7 +14,7 @@ public:
    [[nodiscard]] static char* get_current_date();
 
 private:
-   std::clock_t start_time;
+   const std::chrono::steady_clock::time_point start_time;
 };
 
 #endif //UNO_TIMER_H
@@ -0,0 +1,122 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include "Tracer.hpp"
+#include "Logger.hpp"
+
+std::atomic<bool> Tracer::enabled{false};
+std::mutex Tracer::mutex;
+std::ofstream Tracer::file;
+std::string Tracer::file_name;
+size_t Tracer::number_sessions{0};
+std::chrono::steady_clock::time_point Tracer::origin;
+bool Tracer::first_event{true};
+std::vector<std::unique_ptr<Tracer::ThreadBuffer>> Tracer::thread_buffers;
+
+void Tracer::open(const std::string& file_name) {
+   std::lock_guard<std::mutex> lock(Tracer::mutex);
+   // a trace is already open: the solve joins it
+   if (0 < Tracer::number_sessions) {
+      if (file_name != Tracer::file_name) {
+         WARNING << YELLOW << "The trace is written to " << Tracer::file_name << " instead of " << file_name << '\n' << RESET;
+      }
+      Tracer::number_sessions++;
+      return;
+   }
+   Tracer::file.open(file_name);
+   if (not Tracer::file) {
+      throw std::runtime_error("The trace file " + file_name + " could not be opened");
+   }
+   Tracer::file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+   Tracer::file_name = file_name;
+   Tracer::number_sessions = 1;
+   Tracer::origin = std::chrono::steady_clock::now();
+   Tracer::first_event = true;
+   Tracer::enabled = true;
+}
+
+void Tracer::close() {
+   // the registration of new buffers is blocked while the list is walked
+   std::lock_guard<std::mutex> lock(Tracer::mutex);
+   if (Tracer::number_sessions == 0 || 0 < --Tracer::number_sessions) {
+      return;
+   }
+   Tracer::enabled = false;
+   for (const std::unique_ptr<ThreadBuffer>& buffer: Tracer::thread_buffers) {
+      Tracer::write_events(*buffer);
+   }
+   Tracer::file << "\n]}\n";
+   Tracer::file.close();
+}
+
+Tracer::ThreadBuffer& Tracer::get_thread_buffer() {
+   // the buffers are owned by the tracer, so that they can be flushed after their thread terminated
+   thread_local ThreadBuffer* thread_buffer = []() {
+      std::lock_guard<std::mutex> lock(Tracer::mutex);
+      Tracer::thread_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+      Tracer::thread_buffers.back()->thread_id = Tracer::thread_buffers.size();
+      Tracer::thread_buffers.back()->events.reserve(Tracer::buffer_capacity);
+      return Tracer::thread_buffers.back().get();
+   }();
+   return *thread_buffer;
+}
+
+// in microseconds since the trace was opened
+double Tracer::timestamp(std::chrono::steady_clock::time_point time) {
+   const std::chrono::duration<double, std::micro> elapsed = time - Tracer::origin;
+   return elapsed.count();
+}
+
+void Tracer::append_event(const std::string& event) {
+   ThreadBuffer& buffer = Tracer::get_thread_buffer();
+   buffer.events += ",\n";
+   buffer.events += event;
+   if (Tracer::buffer_capacity <= buffer.events.size()) {
+      Tracer::flush(buffer);
+   }
+}
+
+void Tracer::flush(ThreadBuffer& buffer) {
+   std::lock_guard<std::mutex> lock(Tracer::mutex);
+   Tracer::write_events(buffer);
+}
+
+// the mutex must be held by the caller
+void Tracer::write_events(ThreadBuffer& buffer) {
+   if (buffer.events.empty()) {
+      return;
+   }
+   // the events are separated by commas: skip the first one of the trace
+   const size_t start = Tracer::first_event ? 2 : 0;
+   Tracer::file.write(buffer.events.data() + start, static_cast<std::streamsize>(buffer.events.size() - start));
+   Tracer::first_event = false;
+   buffer.events.clear();
+}
+
+void Tracer::add_span(const char* name, std::chrono::steady_clock::time_point start_time, double duration) {
+   char event[256];
+   std::snprintf(event, sizeof(event), R"({"name":"%s","cat":"uno","ph":"X","ts":%.3f,"dur":%.3f,"pid":1,"tid":%zu})", name,
+         Tracer::timestamp(start_time), 1e6 * duration, Tracer::get_thread_buffer().thread_id);
+   Tracer::append_event(event);
+}
+
+void Tracer::add_counter(const char* name, double value) {
+   // JSON has no representation of infinite values
+   if (not std::isfinite(value)) {
+      return;
+   }
+   char event[256];
+   std::snprintf(event, sizeof(event), R"({"name":"%s","ph":"C","ts":%.3f,"pid":1,"tid":%zu,"args":{"value":%.17g}})", name,
+         Tracer::timestamp(std::chrono::steady_clock::now()), Tracer::get_thread_buffer().thread_id, value);
+   Tracer::append_event(event);
+}
+
+void Tracer::add_instant_event(const char* name) {
+   char event[256];
+   std::snprintf(event, sizeof(event), R"({"name":"%s","cat":"uno","ph":"i","s":"p","ts":%.3f,"pid":1,"tid":%zu})", name,
+         Tracer::timestamp(std::chrono::steady_clock::now()), Tracer::get_thread_buffer().thread_id);
+   Tracer::append_event(event);
+}
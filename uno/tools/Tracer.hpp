@@ -0,0 +1,89 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_TRACER_H
+#define UNO_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*! \class Tracer
+ * \brief Timeline of the solver phases in the Chrome trace-event format (chrome://tracing, Perfetto)
+ *
+ *  The spans of the profiler scopes, the counters and the instant events are formatted into per-thread buffers
+ *  of bounded size that are flushed to the file when full: the memory usage does not grow with the number of iterations.
+ *  The trace is reference counted: concurrent or nested solves share the file, opened by the first one and closed by the last one.
+ */
+class Tracer {
+public:
+   static void open(const std::string& file_name);
+   // the last close flushes the buffers of all the threads: the threads must have stopped tracing
+   static void close();
+   [[nodiscard]] static bool is_enabled() {
+      return Tracer::enabled.load(std::memory_order_relaxed);
+   }
+
+   static void add_span(const char* name, std::chrono::steady_clock::time_point start_time, double duration);
+   static void add_counter(const char* name, double value);
+   static void add_instant_event(const char* name);
+
+protected:
+   struct ThreadBuffer {
+      std::string events{};
+      size_t thread_id{0};
+   };
+
+   static constexpr size_t buffer_capacity = 1 << 16;
+   static std::atomic<bool> enabled;
+   static std::mutex mutex;
+   static std::ofstream file;
+   static std::string file_name;
+   static size_t number_sessions; // guarded by the mutex
+   static std::chrono::steady_clock::time_point origin;
+   static bool first_event;
+   static std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers;
+
+   [[nodiscard]] static ThreadBuffer& get_thread_buffer();
+   [[nodiscard]] static double timestamp(std::chrono::steady_clock::time_point time);
+   static void append_event(const std::string& event);
+   static void flush(ThreadBuffer& buffer);
+   static void write_events(ThreadBuffer& buffer);
+};
+
+// trace of a solve ("none": no trace), closed when the scope ends, including by an exception
+class TraceSession {
+public:
+   explicit TraceSession(const std::string& file_name): is_traced(file_name != "none") {
+      if (this->is_traced) {
+         Tracer::open(file_name);
+      }
+   }
+
+   ~TraceSession() {
+      if (this->is_traced) {
+         Tracer::close();
+      }
+   }
+
+   TraceSession(const TraceSession&) = delete;
+   TraceSession& operator=(const TraceSession&) = delete;
+
+protected:
+   const bool is_traced;
+};
+
+// the counters are compiled out with the profiler (-DUNO_DISABLE_PROFILER)
+#ifdef UNO_DISABLE_PROFILER
+#define TRACE_COUNTER(name, value) do { } while (0)
+#define TRACE_INSTANT_EVENT(name) do { } while (0)
+#else
+#define TRACE_COUNTER(name, value) do { if (Tracer::is_enabled()) Tracer::add_counter(name, value); } while (0)
+#define TRACE_INSTANT_EVENT(name) do { if (Tracer::is_enabled()) Tracer::add_instant_event(name); } while (0)
+#endif
+
+#endif // UNO_TRACER_H
@@ -0,0 +1,57 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+// the AMPL model is only built with the ASL (amplsolver library)
+#ifdef HAS_AMPLSOLVER
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "interfaces/AMPL/AMPLModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+
+// c0 = x0 x1 + 2 x2 and c1 = exp(x0) + 3 x1 are nonlinear, c2 has no variables (empty row). The Jacobian values are
+// stored by jacval column by column, therefore the entries of c0 are not contiguous (permuted with respect to the rows)
+const std::string JACOBIAN_ROWS_FILE = "examples/jacobian_rows.nl";
+
+std::vector<double> dense_row(const SparseVector<double>& row, size_t number_variables) {
+   std::vector<double> entries(number_variables, 0.);
+   row.for_each([&](size_t i, double derivative) {
+      entries[i] += derivative;
+   });
+   return entries;
+}
+
+TEST(AMPLModel, JacobianMatchesConstraintGradients) {
+   const AMPLModel model(JACOBIAN_ROWS_FILE);
+   ASSERT_EQ(model.number_variables, 3);
+   ASSERT_EQ(model.number_constraints, 3);
+   EXPECT_EQ(model.get_number_jacobian_nonzeros(), 5);
+
+   std::vector<double> initial_point(3);
+   model.get_initial_primal_point(initial_point);
+   for (const std::vector<double>& x: {initial_point, std::vector<double>{-0.5, 4., 0.25}}) {
+      RectangularMatrix<double> jacobian(3, SparseVector<double>(3));
+      model.evaluate_constraint_jacobian(x, jacobian);
+      for (size_t j: Range(3)) {
+         SparseVector<double> gradient(3);
+         model.evaluate_constraint_gradient(x, j, gradient);
+         const std::vector<double> jacobian_row = dense_row(jacobian[j], 3);
+         const std::vector<double> gradient_row = dense_row(gradient, 3);
+         for (size_t i: Range(3)) {
+            EXPECT_DOUBLE_EQ(jacobian_row[i], gradient_row[i]);
+         }
+      }
+      // analytical derivatives
+      const std::vector<double> row0 = dense_row(jacobian[0], 3);
+      EXPECT_DOUBLE_EQ(row0[0], x[1]);
+      EXPECT_DOUBLE_EQ(row0[1], x[0]);
+      EXPECT_DOUBLE_EQ(row0[2], 2.);
+      const std::vector<double> row1 = dense_row(jacobian[1], 3);
+      EXPECT_DOUBLE_EQ(row1[0], std::exp(x[0]));
+      EXPECT_DOUBLE_EQ(row1[1], 3.);
+      EXPECT_DOUBLE_EQ(row1[2], 0.);
+      EXPECT_EQ(jacobian[2].size(), 0);
+   }
+}
+
+#endif // HAS_AMPLSOLVER
@@ -0,0 +1,48 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include "BatchSolver.hpp"
+#include "ProjectionModel.hpp"
+
+TEST(BatchSolver, ConcurrentSolves) {
+   const Options options = projection_model_options();
+   std::vector<BatchJob> jobs;
+   for (const char* a: {"1", "3", "-1", "1"}) {
+      jobs.push_back({a, "ipopt", options});
+   }
+   const BatchSolver batch_solver([](const std::string& model_file) {
+      return std::make_unique<ProjectionModel>(std::stod(model_file));
+   }, 2, 0);
+   const std::vector<BatchResult> results = batch_solver.solve(jobs);
+   ASSERT_EQ(results.size(), jobs.size());
+   // projections of (a, 2) onto {x >= 0, x0 + x1 <= 2}: (0.5, 1.5), (1.5, 0.5) and (0, 2)
+   const std::vector<double> objectives{0.5, 4.5, 1., 0.5};
+   for (size_t job_index: Range(jobs.size())) {
+      EXPECT_EQ(results[job_index].status, "feasible KKT point");
+      EXPECT_NEAR(results[job_index].objective, objectives[job_index], 1e-6);
+   }
+   // the evaluation counters are per solve
+   EXPECT_EQ(results[0].objective_evaluations, results[3].objective_evaluations);
+   EXPECT_EQ(results[0].iterations, results[3].iterations);
+
+   std::ostringstream stream;
+   BatchSolver::write_results(stream, results);
+   std::string line;
+   std::istringstream lines(stream.str());
+   size_t number_lines = 0;
+   while (std::getline(lines, line)) {
+      number_lines++;
+   }
+   EXPECT_EQ(number_lines, jobs.size() + 1);
+}
+
+TEST(BatchSolver, FailedJob) {
+   const BatchSolver batch_solver([](const std::string& model_file) -> std::unique_ptr<Model> {
+      throw std::invalid_argument("The model " + model_file + " does not exist");
+   }, 1, 0);
+   const std::vector<BatchResult> results = batch_solver.solve({{"missing.nl", "default", projection_model_options()}});
+   ASSERT_EQ(results.size(), 1);
+   EXPECT_EQ(results[0].status, "error: The model missing.nl does not exist");
+}
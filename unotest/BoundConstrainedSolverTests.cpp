@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "Uno.hpp"
+#include "BoundConstrainedSolver.hpp"
+#include "ProjectionModel.hpp"
+
+// min 100 (x1 - x0^2)^2 + (1 - x0)^2 s.t. -2 <= x0 <= 0.5, -1 <= x1 <= 2
+// solution (0.5, 0.25) with an active upper bound on x0
+class BoundedRosenbrockModel : public Model {
+public:
+   BoundedRosenbrockModel(): Model("bounded_rosenbrock", 2, 0) {
+      this->lower_bounded_variables = {0, 1};
+      this->upper_bounded_variables = {0, 1};
+      this->number_objective_gradient_nonzeros = 2;
+      this->number_jacobian_nonzeros = 0;
+      this->number_hessian_nonzeros = 3;
+   }
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override { return (i == 0) ? -2. : -1.; }
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override { return (i == 0) ? 0.5 : 2.; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t /*j*/) const override { return -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t /*j*/) const override { return INF<double>; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*i*/) const override { return BOUNDED_BOTH_SIDES; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*j*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*j*/) const override { return UNBOUNDED; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return this->number_objective_gradient_nonzeros; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return this->number_jacobian_nonzeros; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return this->number_hessian_nonzeros; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override {
+      return 100. * (x[1] - x[0] * x[0]) * (x[1] - x[0] * x[0]) + (1. - x[0]) * (1. - x[0]);
+   }
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, -400. * x[0] * (x[1] - x[0] * x[0]) - 2. * (1. - x[0]));
+      gradient.insert(1, 200. * (x[1] - x[0] * x[0]));
+   }
+   void evaluate_constraints(const std::vector<double>& /*x*/, std::vector<double>& /*constraints*/) const override { }
+   void evaluate_constraint_gradient(const std::vector<double>& /*x*/, size_t /*j*/, SparseVector<double>& /*gradient*/) const override { }
+   void evaluate_constraint_jacobian(const std::vector<double>& /*x*/, RectangularMatrix<double>& /*constraint_jacobian*/) const override { }
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& /*multipliers*/,
+         SymmetricMatrix<double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(objective_multiplier * (1200. * x[0] * x[0] - 400. * x[1] + 2.), 0, 0);
+      hessian.finalize_column(0);
+      hessian.insert(objective_multiplier * (-400. * x[0]), 0, 1);
+      hessian.insert(objective_multiplier * 200., 1, 1);
+      hessian.finalize_column(1);
+   }
+
+   void get_initial_primal_point(std::vector<double>& x) const override {
+      x[0] = -1.2;
+      x[1] = 1.;
+   }
+   void get_initial_dual_point(std::vector<double>& /*multipliers*/) const override { }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+private:
+   const std::vector<size_t> linear_constraints{};
+};
+
+TEST(BoundConstrainedSolver, GradientProjection) {
+   const Options options = projection_model_options();
+   ASSERT_TRUE(BoundConstrainedSolver::is_applicable(BoundedRosenbrockModel(), options));
+   const Result result = Uno::solve_model(std::make_unique<BoundedRosenbrockModel>(), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.primals[0], 0.5, 1e-8);
+   EXPECT_NEAR(result.solution.primals[1], 0.25, 1e-8);
+   EXPECT_NEAR(result.solution.evaluations.objective, 0.25, 1e-8);
+   // the gradient at the active upper bound is the bound multiplier
+   EXPECT_NEAR(result.solution.multipliers.upper_bounds[0], -1., 1e-8);
+   EXPECT_EQ(result.solution.multipliers.lower_bounds[0], 0.);
+   EXPECT_EQ(result.solution.multipliers.upper_bounds[1], 0.);
+   EXPECT_EQ(result.constraint_evaluations, 0);
+   // the Hessian is only evaluated at the initial point and after the accepted steps
+   EXPECT_LE(result.hessian_evaluations, result.objective_gradient_evaluations);
+   EXPECT_LT(result.hessian_evaluations, result.iteration);
+}
+
+TEST(BoundConstrainedSolver, SameSolutionAsIngredients) {
+   Options options = projection_model_options();
+   const Result gradient_projection_result = Uno::solve_model(std::make_unique<BoundedRosenbrockModel>(), options);
+   options["gradient_projection"] = "no";
+   const Result ingredients_result = Uno::solve_model(std::make_unique<BoundedRosenbrockModel>(), options);
+   ASSERT_EQ(ingredients_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   for (size_t i: Range(2)) {
+      EXPECT_NEAR(gradient_projection_result.solution.primals[i], ingredients_result.solution.primals[i], 1e-4);
+   }
+   EXPECT_NEAR(gradient_projection_result.solution.multipliers.upper_bounds[0], ingredients_result.solution.multipliers.upper_bounds[0], 1e-4);
+}
+
+TEST(BoundConstrainedSolver, TraceFile) {
+   const std::string file_name = "unotest_bound_constrained_trace.json";
+   Options options = projection_model_options();
+   options["trace_file"] = file_name;
+   const Result result = Uno::solve_model(std::make_unique<BoundedRosenbrockModel>(), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+
+   std::ifstream file(file_name);
+   const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+   std::remove(file_name.c_str());
+   ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+   ASSERT_NE(trace.find("\n]}\n"), std::string::npos);
+#ifndef UNO_DISABLE_PROFILER
+   ASSERT_NE(trace.find(R"("name":"iteration","cat":"uno","ph":"X")"), std::string::npos);
+   ASSERT_NE(trace.find(R"("name":"trust-region radius","ph":"C")"), std::string::npos);
+#endif
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "Uno.hpp"
+#include "optimization/CachedModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "interfaces/NL/NLModel.hpp"
+
+TEST(CachedModel, IteratesAtSamePoint) {
+   const CachedModel model(std::make_unique<NLModel>("examples/hs015.nl"), 2);
+   Uno::reset_evaluation_counters();
+   Iterate first_iterate(model.number_variables, model.number_constraints);
+   first_iterate.primals = {-2., 1.};
+   first_iterate.evaluate_objective(model);
+   first_iterate.evaluate_constraints(model);
+   first_iterate.evaluate_constraint_jacobian(model);
+   ASSERT_EQ(CachedModel::number_hits, 0);
+   ASSERT_EQ(CachedModel::number_misses, 3);
+
+   // a copy of the point: the evaluations are shared
+   Iterate second_iterate(model.number_variables, model.number_constraints);
+   second_iterate.primals = first_iterate.primals;
+   second_iterate.evaluate_objective(model);
+   second_iterate.evaluate_constraints(model);
+   second_iterate.evaluate_constraint_jacobian(model);
+   ASSERT_EQ(CachedModel::number_hits, 3);
+   EXPECT_EQ(CachedModel::number_misses, 3);
+   // the iterates count all their evaluations, the cache tells the hits from the misses
+   EXPECT_EQ(Iterate::number_eval_objective, 2);
+   EXPECT_EQ(Iterate::number_eval_constraints, 2);
+   EXPECT_EQ(Iterate::number_eval_jacobian, 2);
+   EXPECT_EQ(second_iterate.evaluations.objective, 909.);
+   EXPECT_EQ(second_iterate.evaluations.constraints, first_iterate.evaluations.constraints);
+   for (size_t j: Range(model.number_constraints)) {
+      ASSERT_EQ(second_iterate.evaluations.constraint_jacobian[j].size(), first_iterate.evaluations.constraint_jacobian[j].size());
+   }
+   // the gradient was never evaluated at this point
+   second_iterate.evaluate_objective_gradient(model);
+   EXPECT_EQ(CachedModel::number_misses, 4);
+   EXPECT_EQ(Iterate::number_eval_objective_gradient, 1);
+}
+
+TEST(CachedModel, LeastRecentlyUsedEviction) {
+   const CachedModel model(std::make_unique<NLModel>("examples/hs015.nl"), 2);
+   CachedModel::number_hits = 0;
+   CachedModel::number_misses = 0;
+   const std::vector<double> x1{-2., 1.}, x2{0., 1.}, x3{0.5, 2.};
+   (void) model.evaluate_objective(x1);
+   (void) model.evaluate_objective(x2);
+   (void) model.evaluate_objective(x1); // hit: x1 is now the most recently used point
+   (void) model.evaluate_objective(x3); // evicts x2
+   (void) model.evaluate_objective(x1); // hit
+   EXPECT_EQ(CachedModel::number_hits, 2);
+   EXPECT_DOUBLE_EQ(model.evaluate_objective(x2), 101.); // miss
+   EXPECT_EQ(CachedModel::number_misses, 4);
+   EXPECT_DOUBLE_EQ(model.evaluate_objective(x3), 306.5); // x3 was evicted by x2
+   EXPECT_EQ(CachedModel::number_misses, 5);
+}
+
+TEST(CachedModel, RecycledEntries) {
+   const NLModel original_model("examples/hs015.nl");
+   const CachedModel model(std::make_unique<NLModel>("examples/hs015.nl"), 2);
+   // the entries of the evicted points are reused for the new points
+   for (const std::vector<double>& x: {std::vector<double>{-2., 1.}, std::vector<double>{0., 1.}, std::vector<double>{0.5, 2.},
+         std::vector<double>{-2., 1.}}) {
+      RectangularMatrix<double> jacobian(2, SparseVector<double>(2)), original_jacobian(2, SparseVector<double>(2));
+      model.evaluate_constraint_jacobian(x, jacobian);
+      original_model.evaluate_constraint_jacobian(x, original_jacobian);
+      std::vector<double> constraints(2), original_constraints(2);
+      model.evaluate_constraints(x, constraints);
+      original_model.evaluate_constraints(x, original_constraints);
+      EXPECT_EQ(constraints, original_constraints);
+      for (size_t j: Range(2)) {
+         std::vector<double> row_difference(2, 0.);
+         jacobian[j].for_each([&](size_t i, double derivative) { row_difference[i] += derivative; });
+         original_jacobian[j].for_each([&](size_t i, double derivative) { row_difference[i] -= derivative; });
+         EXPECT_EQ(row_difference, (std::vector<double>{0., 0.}));
+      }
+   }
+}
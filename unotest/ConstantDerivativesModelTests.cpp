@@ -0,0 +1,176 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "Uno.hpp"
+#include "optimization/ConstantDerivativesModel.hpp"
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+#include "ProjectionModel.hpp"
+
+// projection model that reports it is a quadratic program and counts the derivative evaluations
+class CountingProjectionModel: public ProjectionModel {
+public:
+   explicit CountingProjectionModel(size_t& jacobian_evaluations, size_t& hessian_evaluations): ProjectionModel(1.),
+         jacobian_evaluations(jacobian_evaluations), hessian_evaluations(hessian_evaluations) { }
+
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      this->jacobian_evaluations++;
+      ProjectionModel::evaluate_constraint_jacobian(x, constraint_jacobian);
+   }
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override {
+      this->hessian_evaluations++;
+      ProjectionModel::evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+   }
+   [[nodiscard]] bool is_quadratic_program() const override { return true; }
+
+private:
+   size_t& jacobian_evaluations;
+   size_t& hessian_evaluations;
+};
+
+TEST(ConstantDerivativesModel, LinearConstraintGradients) {
+   size_t jacobian_evaluations = 0, hessian_evaluations = 0;
+   const ConstantDerivativesModel model(std::make_unique<CountingProjectionModel>(jacobian_evaluations, hessian_evaluations));
+   RectangularMatrix<double> jacobian(1, SparseVector<double>(2));
+   for (const std::vector<double>& x: {std::vector<double>{0., 0.}, {1., 2.}, {-3., 5.}}) {
+      model.evaluate_constraint_jacobian(x, jacobian);
+      std::vector<double> dense_gradient(2, 0.);
+      jacobian[0].for_each([&](size_t i, double derivative) {
+         dense_gradient[i] += derivative;
+      });
+      EXPECT_EQ(dense_gradient[0], 1.);
+      EXPECT_EQ(dense_gradient[1], 1.);
+   }
+   EXPECT_EQ(jacobian_evaluations, 1);
+}
+
+TEST(ConstantDerivativesModel, QuadraticProgramHessian) {
+   size_t jacobian_evaluations = 0, hessian_evaluations = 0;
+   const ConstantDerivativesModel model(std::make_unique<CountingProjectionModel>(jacobian_evaluations, hessian_evaluations));
+   COOSymmetricMatrix<double> hessian(2, 2, false);
+   const std::vector<double> multipliers{0.};
+   for (const double objective_multiplier: {1., 3., 0.}) {
+      model.evaluate_lagrangian_hessian({0.5, 0.5}, objective_multiplier, multipliers, hessian);
+      // the sparsity pattern is preserved, even when the objective multiplier is 0
+      EXPECT_EQ(hessian.number_nonzeros, 2);
+      hessian.for_each([&](size_t i, size_t j, double entry) {
+         EXPECT_EQ(i, j);
+         EXPECT_EQ(entry, 2. * objective_multiplier);
+      });
+   }
+   EXPECT_EQ(hessian_evaluations, 1);
+}
+
+TEST(ConstantDerivativesModel, SameSolution) {
+   Options options = projection_model_options();
+   options["convex_qp_solver"] = "no";
+   size_t jacobian_evaluations = 0, hessian_evaluations = 0;
+   const Result cached_result = Uno::solve_model(std::make_unique<CountingProjectionModel>(jacobian_evaluations, hessian_evaluations), options);
+   ASSERT_EQ(cached_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   // the scaling evaluates the Jacobian of the original model at the initial point
+   EXPECT_EQ(jacobian_evaluations, 2);
+   EXPECT_EQ(hessian_evaluations, 1);
+
+   options["cache_constant_derivatives"] = "no";
+   const Result result = Uno::solve_model(std::make_unique<ProjectionModel>(1.), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_EQ(cached_result.iteration, result.iteration);
+   for (size_t i: Range(2)) {
+      EXPECT_NEAR(cached_result.solution.primals[i], result.solution.primals[i], 1e-10);
+   }
+   EXPECT_NEAR(cached_result.solution.multipliers.constraints[0], result.solution.multipliers.constraints[0], 1e-10);
+}
+
+// min x0^2 + x1^2 s.t. x0 + x1 >= 1 (linear), x0 x1 <= 1 (nonlinear). Counts the evaluations of the Jacobian and of
+// the constraint gradients
+class MixedConstraintsModel: public Model {
+public:
+   MixedConstraintsModel(size_t& jacobian_evaluations, std::vector<size_t>& gradient_evaluations): Model("mixed_constraints", 2, 2),
+         jacobian_evaluations(jacobian_evaluations), gradient_evaluations(gradient_evaluations) {
+      this->inequality_constraints = {0, 1};
+      this->number_objective_gradient_nonzeros = 2;
+      this->number_jacobian_nonzeros = 4;
+      this->number_hessian_nonzeros = 3;
+   }
+
+   [[nodiscard]] double get_variable_lower_bound(size_t /*i*/) const override { return -INF<double>; }
+   [[nodiscard]] double get_variable_upper_bound(size_t /*i*/) const override { return INF<double>; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override { return (j == 0) ? 1. : -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override { return (j == 0) ? INF<double> : 1.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*i*/) const override { return UNBOUNDED; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override { return (j == 0) ? LINEAR : NONLINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override { return (j == 0) ? BOUNDED_LOWER : BOUNDED_UPPER; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return this->number_objective_gradient_nonzeros; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return this->number_jacobian_nonzeros; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return this->number_hessian_nonzeros; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override { return x[0] * x[0] + x[1] * x[1]; }
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 2. * x[0]);
+      gradient.insert(1, 2. * x[1]);
+   }
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] + x[1];
+      constraints[1] = x[0] * x[1];
+   }
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override {
+      this->gradient_evaluations[j]++;
+      gradient.insert(0, (j == 0) ? 1. : x[1]);
+      gradient.insert(1, (j == 0) ? 1. : x[0]);
+   }
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      this->jacobian_evaluations++;
+      for (size_t j: Range(2)) {
+         constraint_jacobian[j].clear();
+         this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+      }
+   }
+   void evaluate_lagrangian_hessian(const std::vector<double>& /*x*/, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override {
+      hessian.reset();
+      hessian.insert(2. * objective_multiplier, 0, 0);
+      hessian.finalize_column(0);
+      hessian.insert(-multipliers[1], 0, 1);
+      hessian.insert(2. * objective_multiplier, 1, 1);
+      hessian.finalize_column(1);
+   }
+
+   void get_initial_primal_point(std::vector<double>& x) const override {
+      x[0] = 1.;
+      x[1] = 1.;
+   }
+   void get_initial_dual_point(std::vector<double>& multipliers) const override {
+      multipliers[0] = 0.;
+      multipliers[1] = 0.;
+   }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+private:
+   size_t& jacobian_evaluations;
+   std::vector<size_t>& gradient_evaluations;
+   const std::vector<size_t> linear_constraints{0};
+};
+
+TEST(ConstantDerivativesModel, OnlyNonlinearRowsAreEvaluated) {
+   size_t jacobian_evaluations = 0;
+   std::vector<size_t> gradient_evaluations(2, 0);
+   const ConstantDerivativesModel model(std::make_unique<MixedConstraintsModel>(jacobian_evaluations, gradient_evaluations));
+   RectangularMatrix<double> jacobian(2, SparseVector<double>(2));
+   for (const std::vector<double>& x: {std::vector<double>{0., 0.}, {1., 2.}, {-3., 5.}}) {
+      model.evaluate_constraint_jacobian(x, jacobian);
+      std::vector<std::vector<double>> dense_jacobian(2, std::vector<double>(2, 0.));
+      for (size_t j: Range(2)) {
+         jacobian[j].for_each([&](size_t i, double derivative) {
+            dense_jacobian[j][i] += derivative;
+         });
+      }
+      EXPECT_EQ(dense_jacobian[0], (std::vector<double>{1., 1.}));
+      EXPECT_EQ(dense_jacobian[1], (std::vector<double>{x[1], x[0]}));
+   }
+   // the whole Jacobian is evaluated once, then only the nonlinear row
+   EXPECT_EQ(jacobian_evaluations, 1);
+   EXPECT_EQ(gradient_evaluations[0], 1);
+   EXPECT_EQ(gradient_evaluations[1], 3);
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "DecompositionSolver.hpp"
+#include "interfaces/Modeling/ModelBuilder.hpp"
+#include "linear_algebra/CSCSymmetricMatrix.hpp"
+#include "optimization/SubModel.hpp"
+#include "ProjectionModel.hpp"
+
+// independent copies of the projection problem: min sum_k (x_2k - a_k)^2 + (x_2k+1 - 2)^2 s.t. x_2k + x_2k+1 <= 2, x >= 0
+class BlockProjectionModel : public Model {
+public:
+   explicit BlockProjectionModel(std::vector<double> a): Model("block_projection", 2 * a.size(), a.size()), a(std::move(a)) {
+      for (size_t i: Range(this->number_variables)) {
+         this->lower_bounded_variables.push_back(i);
+         this->single_lower_bounded_variables.push_back(i);
+      }
+      for (size_t j: Range(this->number_constraints)) {
+         this->inequality_constraints.push_back(j);
+         this->linear_constraints.push_back(j);
+      }
+      this->number_objective_gradient_nonzeros = this->number_variables;
+      this->number_jacobian_nonzeros = this->number_variables;
+      this->number_hessian_nonzeros = this->number_variables;
+   }
+
+   [[nodiscard]] double get_variable_lower_bound(size_t /*i*/) const override { return 0.; }
+   [[nodiscard]] double get_variable_upper_bound(size_t /*i*/) const override { return INF<double>; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t /*j*/) const override { return -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t /*j*/) const override { return 2.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*i*/) const override { return BOUNDED_LOWER; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*j*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*j*/) const override { return BOUNDED_UPPER; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return this->number_objective_gradient_nonzeros; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return this->number_jacobian_nonzeros; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return this->number_hessian_nonzeros; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override {
+      double objective = 0.;
+      for (size_t k: Range(this->a.size())) {
+         objective += (x[2 * k] - this->a[k]) * (x[2 * k] - this->a[k]) + (x[2 * k + 1] - 2.) * (x[2 * k + 1] - 2.);
+      }
+      return objective;
+   }
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      for (size_t k: Range(this->a.size())) {
+         gradient.insert(2 * k, 2. * (x[2 * k] - this->a[k]));
+         gradient.insert(2 * k + 1, 2. * (x[2 * k + 1] - 2.));
+      }
+   }
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override {
+      for (size_t k: Range(this->a.size())) {
+         constraints[k] = x[2 * k] + x[2 * k + 1];
+      }
+   }
+   void evaluate_constraint_gradient(const std::vector<double>& /*x*/, size_t j, SparseVector<double>& gradient) const override {
+      gradient.insert(2 * j, 1.);
+      gradient.insert(2 * j + 1, 1.);
+   }
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      for (size_t j: Range(this->number_constraints)) {
+         this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+      }
+   }
+   void evaluate_lagrangian_hessian(const std::vector<double>& /*x*/, double objective_multiplier, const std::vector<double>& /*multipliers*/,
+         SymmetricMatrix<double>& hessian) const override {
+      hessian.reset();
+      for (size_t i: Range(this->number_variables)) {
+         hessian.insert(2. * objective_multiplier, i, i);
+         hessian.finalize_column(i);
+      }
+   }
+
+   void get_initial_primal_point(std::vector<double>& x) const override {
+      for (size_t i: Range(this->number_variables)) {
+         x[i] = 0.5;
+      }
+   }
+   void get_initial_dual_point(std::vector<double>& multipliers) const override {
+      for (size_t j: Range(this->number_constraints)) {
+         multipliers[j] = 0.;
+      }
+   }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+private:
+   const std::vector<double> a;
+   std::vector<size_t> linear_constraints{};
+};
+
+TEST(Decomposition, Components) {
+   const BlockProjectionModel model({1., 3., -1.});
+   const std::vector<double> x(model.number_variables, 0.5);
+   const std::vector<ModelComponent> components = Decomposition::compute_components(model, x);
+   ASSERT_EQ(components.size(), 3);
+   for (size_t k: Range(3)) {
+      EXPECT_EQ(components[k].variables, (std::vector<size_t>{2 * k, 2 * k + 1}));
+      EXPECT_EQ(components[k].constraints, std::vector<size_t>{k});
+   }
+}
+
+TEST(Decomposition, ConcurrentBlocks) {
+   const DecompositionSolver decomposition_solver([]() {
+      return std::make_unique<BlockProjectionModel>(std::vector<double>{1., 3., -1.});
+   }, 2);
+   const Result result = decomposition_solver.solve(projection_model_options());
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   // projections of (a, 2) onto {x >= 0, x0 + x1 <= 2}: (0.5, 1.5), (1.5, 0.5) and (0, 2)
+   EXPECT_NEAR(result.solution.evaluations.objective, 0.5 + 4.5 + 1., 1e-6);
+   const std::vector<double> primals{0.5, 1.5, 1.5, 0.5, 0., 2.};
+   for (size_t i: Range(primals.size())) {
+      EXPECT_NEAR(result.solution.primals[i], primals[i], 1e-4);
+   }
+   // the multiplier of each block constraint
+   EXPECT_NEAR(result.solution.multipliers.constraints[0], -1., 1e-4);
+   EXPECT_NEAR(result.solution.multipliers.constraints[1], -3., 1e-4);
+}
+
+// reentrant model that counts the evaluations of the whole Jacobian
+class ReentrantBlockProjectionModel : public BlockProjectionModel {
+public:
+   ReentrantBlockProjectionModel(std::vector<double> a, std::atomic<size_t>& jacobian_evaluations):
+         BlockProjectionModel(std::move(a)), jacobian_evaluations(jacobian_evaluations) { }
+
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      this->jacobian_evaluations++;
+      BlockProjectionModel::evaluate_constraint_jacobian(x, constraint_jacobian);
+   }
+   [[nodiscard]] bool is_reentrant() const override { return true; }
+
+private:
+   std::atomic<size_t>& jacobian_evaluations;
+};
+
+TEST(Decomposition, SharedReentrantModel) {
+   size_t number_loads = 0;
+   std::atomic<size_t> jacobian_evaluations{0};
+   const DecompositionSolver decomposition_solver([&]() {
+      number_loads++;
+      return std::make_unique<ReentrantBlockProjectionModel>(std::vector<double>{1., 3., -1.}, jacobian_evaluations);
+   }, 2);
+   const Result result = decomposition_solver.solve(projection_model_options());
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.evaluations.objective, 0.5 + 4.5 + 1., 1e-6);
+   // the components share the model and only evaluate the gradients of their own constraints: the whole Jacobian is
+   // evaluated once, to compute the components
+   EXPECT_EQ(number_loads, 1);
+   EXPECT_EQ(jacobian_evaluations, 1);
+}
+
+// model that is not reentrant and records the largest number of concurrent evaluations of its objective
+class ConcurrencyBlockProjectionModel : public BlockProjectionModel {
+public:
+   ConcurrencyBlockProjectionModel(std::vector<double> a, std::atomic<size_t>& maximum_concurrent_evaluations):
+         BlockProjectionModel(std::move(a)), maximum_concurrent_evaluations(maximum_concurrent_evaluations) { }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override {
+      const size_t concurrent_evaluations = ++this->current_evaluations;
+      size_t maximum = this->maximum_concurrent_evaluations;
+      while (maximum < concurrent_evaluations &&
+            not this->maximum_concurrent_evaluations.compare_exchange_weak(maximum, concurrent_evaluations)) {
+      }
+      // leave time to the other workers
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      const double objective = BlockProjectionModel::evaluate_objective(x);
+      this->current_evaluations--;
+      return objective;
+   }
+
+private:
+   mutable std::atomic<size_t> current_evaluations{0};
+   std::atomic<size_t>& maximum_concurrent_evaluations;
+};
+
+TEST(Decomposition, NonReentrantModelIsSolvedSequentially) {
+   size_t number_loads = 0;
+   std::atomic<size_t> maximum_concurrent_evaluations{0};
+   const DecompositionSolver decomposition_solver([&]() {
+      number_loads++;
+      return std::make_unique<ConcurrencyBlockProjectionModel>(std::vector<double>{1., 3., -1., 0.5}, maximum_concurrent_evaluations);
+   }, 4);
+   const Result result = decomposition_solver.solve(projection_model_options());
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.evaluations.objective, 0.5 + 4.5 + 1. + 0.125, 1e-6);
+   // the components share the model and never evaluate it concurrently
+   EXPECT_EQ(number_loads, 1);
+   EXPECT_EQ(maximum_concurrent_evaluations, 1);
+}
+
+// min sum_k (x_2k - k)^2 + x_2k x_2k+1 + exp(x_2k+1) + 3 x_2k+1 s.t. x_2k^2 x_2k+1 <= 1
+std::unique_ptr<Model> build_coupled_blocks(size_t number_blocks) {
+   ModelBuilder builder("coupled_blocks");
+   std::vector<Expression> terms;
+   for (size_t k: Range(number_blocks)) {
+      const Expression x = builder.add_variable(-INF<double>, INF<double>, 1.);
+      const Expression y = builder.add_variable(-INF<double>, INF<double>, 0.5);
+      terms.push_back(pow(x - static_cast<double>(k), 2.) + x * y + exp(y) + 3. * y);
+      builder.add_constraint(pow(x, 2.) * y, -INF<double>, 1.);
+   }
+   builder.minimize(sum(terms));
+   return builder.build();
+}
+
+TEST(Decomposition, SubModelEvaluatesItsBlock) {
+   const std::shared_ptr<const Model> model = build_coupled_blocks(3);
+   std::vector<double> x(model->number_variables);
+   model->get_initial_primal_point(x);
+   const SubModel block("block", model, {2, 3}, {1}, x, {{-INF<double>, INF<double>}, {-INF<double>, INF<double>}});
+
+   const std::vector<double> block_x{2.5, -0.5};
+   std::vector<double> full_x = x;
+   full_x[2] = block_x[0];
+   full_x[3] = block_x[1];
+   // the objective terms of the other blocks are constant
+   EXPECT_NEAR(block.evaluate_objective(block_x), model->evaluate_objective(full_x), 1e-12);
+
+   SparseVector<double> gradient(2);
+   block.evaluate_objective_gradient(block_x, gradient);
+   std::vector<double> dense_gradient(2, 0.);
+   gradient.for_each([&](size_t i, double derivative) {
+      dense_gradient[i] += derivative;
+   });
+   EXPECT_NEAR(dense_gradient[0], 2. * (2.5 - 1.) - 0.5, 1e-12);
+   EXPECT_NEAR(dense_gradient[1], 2.5 + std::exp(-0.5) + 3., 1e-12);
+
+   // Lagrangian sigma f - y c with c = x^2 y
+   const double objective_multiplier = 2., multiplier = 0.5;
+   CSCSymmetricMatrix<double> hessian(2, block.get_number_hessian_nonzeros(), false);
+   block.evaluate_lagrangian_hessian(block_x, objective_multiplier, {multiplier}, hessian);
+   std::vector<double> dense_hessian(4, 0.);
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      dense_hessian[std::min(i, j) * 2 + std::max(i, j)] += entry;
+   });
+   EXPECT_NEAR(dense_hessian[0], objective_multiplier * 2. - multiplier * 2. * (-0.5), 1e-12);
+   EXPECT_NEAR(dense_hessian[1], objective_multiplier * 1. - multiplier * 2. * 2.5, 1e-12);
+   EXPECT_NEAR(dense_hessian[3], objective_multiplier * std::exp(-0.5), 1e-12);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+#include "solvers/linear/DenseSolver.hpp"
+#include "solvers/linear/SymmetricIndefiniteLinearSolverFactory.hpp"
+
+const double tolerance = 1e-8;
+
+COOSymmetricMatrix<double> create_indefinite_matrix() {
+   const size_t n = 5;
+   COOSymmetricMatrix<double> matrix(n, 7, false);
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   return matrix;
+}
+
+TEST(DenseSolver, Solve) {
+   const COOSymmetricMatrix<double> matrix = create_indefinite_matrix();
+   const std::vector<double> rhs{8., 45., 31., 15., 17.};
+   std::vector<double> result(5);
+   const std::vector<double> reference{1., 2., 3., 4., 5.};
+
+   DenseSolver solver(5);
+   solver.factorize(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   for (size_t i: Range(5)) {
+      EXPECT_NEAR(result[i], reference[i], tolerance);
+   }
+}
+
+TEST(DenseSolver, Inertia) {
+   const COOSymmetricMatrix<double> matrix = create_indefinite_matrix();
+   DenseSolver solver(5);
+   solver.factorize(matrix);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+   ASSERT_FALSE(solver.matrix_is_singular());
+}
+
+TEST(DenseSolver, Singular) {
+   COOSymmetricMatrix<double> matrix(2, 3, false);
+   matrix.insert(1., 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(1., 1, 1);
+   DenseSolver solver(2);
+   solver.factorize(matrix);
+   ASSERT_TRUE(solver.matrix_is_singular());
+   ASSERT_EQ(solver.rank(), 1);
+}
+
+// augmented system of an interior-point method close to the solution: the dual pivot is tiny but nonzero
+TEST(DenseSolver, TinyPivotIsNotZero) {
+   COOSymmetricMatrix<double> matrix(2, 2, false);
+   matrix.insert(1e10, 0, 0);
+   matrix.insert(1., 0, 1);
+   DenseSolver solver(2);
+   solver.factorize(matrix);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 1);
+   ASSERT_EQ(number_negative, 1);
+   ASSERT_EQ(number_zero, 0);
+}
+
+Options dense_switch_options() {
+   Options options = get_default_options("uno.options");
+   options["linear_solver"] = "LDL";
+   options["dense_linear_solver_switch"] = "yes";
+   return options;
+}
+
+TEST(DenseSolver, SwitchIsOffByDefault) {
+   Options options = get_default_options("uno.options");
+   options["linear_solver"] = "LDL";
+   const auto solver = SymmetricIndefiniteLinearSolverFactory::create(5, 7, options);
+   EXPECT_EQ(dynamic_cast<const SwitchingLinearSolver*>(solver.get()), nullptr);
+}
+
+TEST(DenseSolver, SwitchOnActualDensity) {
+   // the capacity is large, the actual density decides
+   const Options options = dense_switch_options();
+   const auto solver = SymmetricIndefiniteLinearSolverFactory::create(5, 100, options);
+   auto* switching_solver = dynamic_cast<SwitchingLinearSolver*>(solver.get());
+   ASSERT_NE(switching_solver, nullptr);
+
+   // 7 nonzeros out of 15: dense
+   const COOSymmetricMatrix<double> matrix = create_indefinite_matrix();
+   switching_solver->factorize(matrix);
+   EXPECT_TRUE(switching_solver->uses_dense_solver());
+   const auto [number_positive, number_negative, number_zero] = switching_solver->get_inertia();
+   EXPECT_EQ(number_positive, 3);
+   EXPECT_EQ(number_negative, 2);
+   EXPECT_EQ(number_zero, 0);
+
+   // diagonal matrix: 10 nonzeros out of 55, sparse
+   COOSymmetricMatrix<double> diagonal_matrix(10, 10, false);
+   for (size_t i: Range(10)) {
+      diagonal_matrix.insert(1. + static_cast<double>(i), i, i);
+   }
+   const auto large_solver = SymmetricIndefiniteLinearSolverFactory::create(10, 10, options);
+   auto* large_switching_solver = dynamic_cast<SwitchingLinearSolver*>(large_solver.get());
+   ASSERT_NE(large_switching_solver, nullptr);
+   large_switching_solver->factorize(diagonal_matrix);
+   EXPECT_FALSE(large_switching_solver->uses_dense_solver());
+}
+
+TEST(DenseSolver, SwitchIsCappedByDimension) {
+   Options options = dense_switch_options();
+   options["dense_linear_solver_max_dimension"] = "4";
+   const auto solver = SymmetricIndefiniteLinearSolverFactory::create(5, 7, options);
+   EXPECT_EQ(dynamic_cast<const SwitchingLinearSolver*>(solver.get()), nullptr);
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+#include "solvers/linear/FillReducingOrdering.hpp"
+
+// arrow matrix: vertex 0 is connected to all the other vertices
+COOSymmetricMatrix<double> create_arrow_matrix(size_t n) {
+   COOSymmetricMatrix<double> matrix(n, 2*n, false);
+   for (size_t i: Range(n)) {
+      matrix.insert(1., i, i);
+      if (0 < i) {
+         matrix.insert(1., 0, i);
+      }
+   }
+   return matrix;
+}
+
+bool is_permutation(std::vector<size_t> permutation) {
+   std::sort(permutation.begin(), permutation.end());
+   for (size_t i: Range(permutation.size())) {
+      if (permutation[i] != i) {
+         return false;
+      }
+   }
+   return true;
+}
+
+TEST(FillReducingOrdering, MinimumDegreeArrow) {
+   const COOSymmetricMatrix<double> matrix = create_arrow_matrix(6);
+   const std::vector<size_t> permutation = FillReducingOrdering::minimum_degree(FillReducingOrdering::compute_adjacency_graph(matrix));
+   ASSERT_TRUE(is_permutation(permutation));
+   // the hub is eliminated once it has a single neighbor left: no fill-in
+   const auto hub_position = std::find(permutation.cbegin(), permutation.cend(), 0) - permutation.cbegin();
+   ASSERT_GE(hub_position, 4);
+}
+
+TEST(FillReducingOrdering, ReverseCuthillMcKee) {
+   const COOSymmetricMatrix<double> matrix = create_arrow_matrix(6);
+   const std::vector<size_t> permutation = FillReducingOrdering::reverse_cuthill_mckee(FillReducingOrdering::compute_adjacency_graph(matrix));
+   ASSERT_EQ(permutation.size(), 6);
+   ASSERT_TRUE(is_permutation(permutation));
+}
+
+TEST(FillReducingOrdering, PersistentCache) {
+   const std::string file_name = "unotest_orderings.txt";
+   std::remove(file_name.c_str());
+   const COOSymmetricMatrix<double> matrix = create_arrow_matrix(6);
+   std::vector<size_t> permutation;
+   {
+      FillReducingOrdering ordering("MD", file_name);
+      permutation = ordering.get_permutation(matrix);
+      ASSERT_EQ(ordering.number_cached_permutations(), 1);
+   }
+   // a new instance reads the permutation from the file
+   FillReducingOrdering ordering("MD", file_name);
+   ASSERT_EQ(ordering.number_cached_permutations(), 1);
+   ASSERT_EQ(ordering.get_permutation(matrix), permutation);
+   std::remove(file_name.c_str());
+}
+
+size_t number_lines(const std::string& file_name) {
+   std::ifstream file(file_name);
+   size_t number_lines = 0;
+   std::string line;
+   while (std::getline(file, line)) {
+      number_lines++;
+   }
+   return number_lines;
+}
+
+TEST(FillReducingOrdering, CacheFileIsRewritten) {
+   const std::string file_name = "unotest_orderings_rewritten.txt";
+   std::remove(file_name.c_str());
+   {
+      // a permutation of another method and a malformed line
+      std::ofstream file(file_name);
+      file << "RCM 12345 3 2 2 1 0\n";
+      file << "MD 678 3 2 0 1\n";
+   }
+   for (size_t repetition = 0; repetition < 2; repetition++) {
+      FillReducingOrdering ordering("MD", file_name);
+      (void) ordering.get_permutation(create_arrow_matrix(6));
+      (void) ordering.get_permutation(create_arrow_matrix(8));
+   }
+   // the same patterns are saved once, the malformed line is dropped and the other method is kept
+   ASSERT_EQ(number_lines(file_name), 3);
+   FillReducingOrdering ordering("MD", file_name);
+   ASSERT_EQ(ordering.number_cached_permutations(), 2);
+   std::remove(file_name.c_str());
+}
+
+TEST(FillReducingOrdering, CachedPatternIsChecked) {
+   const std::string file_name = "unotest_orderings_checked.txt";
+   const COOSymmetricMatrix<double> matrix = create_arrow_matrix(6);
+   {
+      // same hash, different number of nonzeros (collision): the identity is not reused
+      std::ofstream file(file_name);
+      file << "MD " << matrix.compute_sparsity_pattern_hash() << " 6 " << matrix.number_nonzeros + 1 << " 0 1 2 3 4 5\n";
+   }
+   FillReducingOrdering ordering("MD", file_name);
+   const std::vector<size_t> permutation = ordering.get_permutation(matrix);
+   ASSERT_EQ(permutation, FillReducingOrdering::minimum_degree(FillReducingOrdering::compute_adjacency_graph(matrix)));
+   std::remove(file_name.c_str());
+}
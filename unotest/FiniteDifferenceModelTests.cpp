@@ -0,0 +1,238 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include "Uno.hpp"
+#include "optimization/FiniteDifferenceModel.hpp"
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+#include "preprocessing/Coloring.hpp"
+#include "ProjectionModel.hpp"
+
+// min sum_i (x_i - 2)^2 + 0.1 sum_i exp(x_i - x_{i+1}) s.t. x_j^2 + x_{j+1}^2 <= 10
+// the derivatives are only available if provide_derivatives is true. The constraint evaluations are counted
+class ChainedModel: public Model {
+public:
+   ChainedModel(size_t number_variables, bool provide_derivatives): Model("chained", number_variables, number_variables - 1),
+         provide_derivatives(provide_derivatives) {
+      for (size_t j: Range(this->number_constraints)) {
+         this->inequality_constraints.push_back(j);
+      }
+      this->number_objective_gradient_nonzeros = number_variables;
+      this->number_jacobian_nonzeros = 2 * this->number_constraints;
+      this->number_hessian_nonzeros = 2 * number_variables - 1;
+   }
+
+   mutable size_t number_constraint_evaluations{0};
+
+   [[nodiscard]] double get_variable_lower_bound(size_t /*i*/) const override { return -INF<double>; }
+   [[nodiscard]] double get_variable_upper_bound(size_t /*i*/) const override { return INF<double>; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t /*j*/) const override { return -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t /*j*/) const override { return 10.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*i*/) const override { return UNBOUNDED; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*j*/) const override { return NONLINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*j*/) const override { return BOUNDED_UPPER; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return this->number_objective_gradient_nonzeros; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return this->number_jacobian_nonzeros; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return this->number_hessian_nonzeros; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override {
+      double objective = 0.;
+      for (size_t i: Range(this->number_variables)) {
+         objective += (x[i] - 2.) * (x[i] - 2.);
+      }
+      for (size_t i: Range(this->number_variables - 1)) {
+         objective += 0.1 * std::exp(x[i] - x[i + 1]);
+      }
+      return objective;
+   }
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override {
+      this->number_constraint_evaluations++;
+      for (size_t j: Range(this->number_constraints)) {
+         constraints[j] = x[j] * x[j] + x[j + 1] * x[j + 1];
+      }
+   }
+
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      this->check_derivatives();
+      for (size_t i: Range(this->number_variables)) {
+         double derivative = 2. * (x[i] - 2.);
+         if (i < this->number_variables - 1) {
+            derivative += 0.1 * std::exp(x[i] - x[i + 1]);
+         }
+         if (0 < i) {
+            derivative -= 0.1 * std::exp(x[i - 1] - x[i]);
+         }
+         gradient.insert(i, derivative);
+      }
+   }
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override {
+      this->check_derivatives();
+      gradient.clear();
+      gradient.insert(j, 2. * x[j]);
+      gradient.insert(j + 1, 2. * x[j + 1]);
+   }
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      for (size_t j: Range(this->number_constraints)) {
+         this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+      }
+   }
+   void evaluate_lagrangian_hessian(const std::vector<double>& x, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override {
+      this->check_derivatives();
+      hessian.reset();
+      for (size_t i: Range(this->number_variables)) {
+         if (0 < i) {
+            hessian.insert(-0.1 * objective_multiplier * std::exp(x[i - 1] - x[i]), i - 1, i);
+         }
+         double diagonal_term = 2. * objective_multiplier;
+         if (i < this->number_variables - 1) {
+            diagonal_term += 0.1 * objective_multiplier * std::exp(x[i] - x[i + 1]) - 2. * multipliers[i];
+         }
+         if (0 < i) {
+            diagonal_term += 0.1 * objective_multiplier * std::exp(x[i - 1] - x[i]) - 2. * multipliers[i - 1];
+         }
+         hessian.insert(diagonal_term, i, i);
+         hessian.finalize_column(i);
+      }
+   }
+
+   void get_initial_primal_point(std::vector<double>& x) const override {
+      std::fill(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(this->number_variables), 0.5);
+   }
+   void get_initial_dual_point(std::vector<double>& multipliers) const override {
+      std::fill(multipliers.begin(), multipliers.begin() + static_cast<std::ptrdiff_t>(this->number_constraints), 0.);
+   }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+   // declared sparsity: dense objective, bidiagonal Jacobian, tridiagonal Hessian
+   [[nodiscard]] DerivativeSparsity sparsity() const {
+      DerivativeSparsity sparsity = DerivativeSparsity::dense(this->number_variables, 0);
+      for (size_t j: Range(this->number_constraints)) {
+         sparsity.jacobian.push_back({j, j + 1});
+      }
+      for (size_t i: Range(this->number_variables)) {
+         sparsity.hessian.push_back((0 < i) ? std::vector<size_t>{i - 1, i} : std::vector<size_t>{i});
+      }
+      return sparsity;
+   }
+
+private:
+   const bool provide_derivatives;
+   const std::vector<size_t> linear_constraints{};
+
+   void check_derivatives() const {
+      if (not this->provide_derivatives) {
+         throw std::logic_error("The derivatives are not available");
+      }
+   }
+};
+
+constexpr size_t NUMBER_VARIABLES = 30;
+
+// dense copy of the (upper triangular) entries of a symmetric matrix
+std::vector<double> dense_hessian(const SymmetricMatrix<double>& hessian, size_t dimension) {
+   std::vector<double> entries(dimension * dimension, 0.);
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      entries[i * dimension + j] += entry;
+   });
+   return entries;
+}
+
+TEST(Coloring, ArrowPattern) {
+   // the first variable is coupled with all the others
+   const size_t dimension = 10;
+   std::vector<std::vector<size_t>> columns(dimension);
+   for (size_t i: Range(dimension)) {
+      columns[i] = (0 < i) ? std::vector<size_t>{0, i} : std::vector<size_t>{0};
+   }
+   EXPECT_EQ(Coloring::number_colors(Coloring::color_star(dimension, columns)), 2);
+   // Curtis-Powell-Reid: the columns of the first row are all different
+   std::vector<std::vector<size_t>> rows{{0, 1, 2}, {2, 3}, {3, 4}};
+   const std::vector<size_t> colors = Coloring::color_columns(5, rows);
+   EXPECT_EQ(Coloring::number_colors(colors), 3);
+   EXPECT_NE(colors[0], colors[1]);
+   EXPECT_NE(colors[1], colors[2]);
+   EXPECT_NE(colors[2], colors[3]);
+   EXPECT_NE(colors[3], colors[4]);
+}
+
+TEST(FiniteDifferenceModel, NumberColors) {
+   auto original_model = std::make_unique<ChainedModel>(NUMBER_VARIABLES, false);
+   const DerivativeSparsity sparsity = original_model->sparsity();
+   const ChainedModel& chained_model = *original_model;
+   const FiniteDifferenceModel model(std::move(original_model), sparsity, projection_model_options());
+   EXPECT_EQ(model.get_number_jacobian_colors(), 2);
+   EXPECT_EQ(model.get_number_hessian_colors(), 3);
+
+   // the number of constraint evaluations does not depend on the number of variables
+   RectangularMatrix<double> jacobian(NUMBER_VARIABLES - 1, SparseVector<double>(2));
+   model.evaluate_constraint_jacobian(std::vector<double>(NUMBER_VARIABLES, 1.), jacobian);
+   EXPECT_EQ(chained_model.number_constraint_evaluations, 1 + 2);
+}
+
+TEST(FiniteDifferenceModel, Derivatives) {
+   const ChainedModel exact_model(NUMBER_VARIABLES, true);
+   for (const std::string scheme: {"forward", "central"}) {
+      Options options = projection_model_options();
+      options["finite_difference_scheme"] = scheme;
+      const double tolerance = (scheme == "forward") ? 1e-5 : 1e-8;
+      auto original_model = std::make_unique<ChainedModel>(NUMBER_VARIABLES, false);
+      const DerivativeSparsity sparsity = original_model->sparsity();
+      const FiniteDifferenceModel model(std::move(original_model), sparsity, options);
+
+      std::vector<double> x(NUMBER_VARIABLES);
+      for (size_t i: Range(NUMBER_VARIABLES)) {
+         x[i] = 0.1 * static_cast<double>(i) - 1.;
+      }
+      SparseVector<double> exact_gradient(NUMBER_VARIABLES), gradient(NUMBER_VARIABLES);
+      exact_model.evaluate_objective_gradient(x, exact_gradient);
+      model.evaluate_objective_gradient(x, gradient);
+      std::vector<double> difference(NUMBER_VARIABLES, 0.);
+      exact_gradient.for_each([&](size_t i, double derivative) { difference[i] += derivative; });
+      gradient.for_each([&](size_t i, double derivative) { difference[i] -= derivative; });
+      for (size_t i: Range(NUMBER_VARIABLES)) {
+         EXPECT_NEAR(difference[i], 0., tolerance);
+      }
+
+      RectangularMatrix<double> exact_jacobian(NUMBER_VARIABLES - 1, SparseVector<double>(2)), jacobian(NUMBER_VARIABLES - 1, SparseVector<double>(2));
+      exact_model.evaluate_constraint_jacobian(x, exact_jacobian);
+      model.evaluate_constraint_jacobian(x, jacobian);
+      for (size_t j: Range(NUMBER_VARIABLES - 1)) {
+         std::vector<double> row_difference(NUMBER_VARIABLES, 0.);
+         exact_jacobian[j].for_each([&](size_t i, double derivative) { row_difference[i] += derivative; });
+         jacobian[j].for_each([&](size_t i, double derivative) { row_difference[i] -= derivative; });
+         for (size_t i: Range(NUMBER_VARIABLES)) {
+            EXPECT_NEAR(row_difference[i], 0., tolerance);
+         }
+      }
+
+      const std::vector<double> multipliers(NUMBER_VARIABLES - 1, 0.5);
+      COOSymmetricMatrix<double> exact_hessian(NUMBER_VARIABLES, 2 * NUMBER_VARIABLES, false);
+      COOSymmetricMatrix<double> hessian(NUMBER_VARIABLES, 2 * NUMBER_VARIABLES, false);
+      exact_model.evaluate_lagrangian_hessian(x, 2., multipliers, exact_hessian);
+      model.evaluate_lagrangian_hessian(x, 2., multipliers, hessian);
+      EXPECT_EQ(hessian.number_nonzeros, 2 * NUMBER_VARIABLES - 1);
+      const std::vector<double> exact_entries = dense_hessian(exact_hessian, NUMBER_VARIABLES);
+      const std::vector<double> entries = dense_hessian(hessian, NUMBER_VARIABLES);
+      for (size_t k: Range(NUMBER_VARIABLES * NUMBER_VARIABLES)) {
+         EXPECT_NEAR(entries[k], exact_entries[k], (scheme == "forward") ? 1e-3 : 1e-5);
+      }
+   }
+}
+
+TEST(FiniteDifferenceModel, SameSolutionAsExactDerivatives) {
+   const Options options = projection_model_options();
+   const Result exact_result = Uno::solve_model(std::make_unique<ChainedModel>(NUMBER_VARIABLES, true), options);
+   ASSERT_EQ(exact_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+
+   auto original_model = std::make_unique<ChainedModel>(NUMBER_VARIABLES, false);
+   const DerivativeSparsity sparsity = original_model->sparsity();
+   const Result result = Uno::solve_model(std::make_unique<FiniteDifferenceModel>(std::move(original_model), sparsity, options), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   for (size_t i: Range(NUMBER_VARIABLES)) {
+      EXPECT_NEAR(result.solution.primals[i], exact_result.solution.primals[i], 1e-5);
+   }
+}
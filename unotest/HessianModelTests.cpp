@@ -0,0 +1,36 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "Uno.hpp"
+#include "ProjectionModel.hpp"
+
+// counts the evaluations of the objective gradient, including those that bypass the counters of the iterates
+class CountingProjectionModel : public ProjectionModel {
+public:
+   explicit CountingProjectionModel(size_t& number_gradient_evaluations):
+         ProjectionModel(1.), number_gradient_evaluations(number_gradient_evaluations) { }
+
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      this->number_gradient_evaluations++;
+      ProjectionModel::evaluate_objective_gradient(x, gradient);
+   }
+
+private:
+   size_t& number_gradient_evaluations;
+};
+
+TEST(HessianModel, LBFGSReusesIterateDerivatives) {
+   Options options = projection_model_options();
+   options["hessian_model"] = "BFGS";
+   // solve the QP as a nonlinear problem, without the caches of the model
+   options["convex_qp_solver"] = "no";
+   options["evaluation_cache_size"] = "0";
+   options["cache_constant_derivatives"] = "no";
+   size_t number_gradient_evaluations = 0;
+   const Result result = Uno::solve_model(std::make_unique<CountingProjectionModel>(number_gradient_evaluations), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.evaluations.objective, 0.5, 1e-6);
+   // the curvature pairs are computed from the gradients of the iterates. The extra evaluation computes the scaling
+   EXPECT_EQ(number_gradient_evaluations, result.objective_gradient_evaluations + 1);
+}
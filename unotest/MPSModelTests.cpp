@@ -0,0 +1,116 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "Uno.hpp"
+#include "ConvexQPSolver.hpp"
+#include "interfaces/MPS/MPSModel.hpp"
+#include "interfaces/NL/NLModel.hpp"
+#include "ProjectionModel.hpp"
+
+const std::string LP_FILE = "examples/lp_small.mps";
+const std::string QP_FILE = "examples/qp_small.qps";
+
+TEST(MPSModel, LinearProgram) {
+   for (const MPSFormat format: {MPSFormat::FREE, MPSFormat::FIXED}) {
+      const MPSModel model(LP_FILE, format);
+      ASSERT_EQ(model.number_variables, 2);
+      ASSERT_EQ(model.number_constraints, 3);
+      EXPECT_EQ(model.objective_sign, -1.);
+      EXPECT_EQ(model.get_number_jacobian_nonzeros(), 6);
+      EXPECT_EQ(model.get_number_hessian_nonzeros(), 0);
+      EXPECT_EQ(model.get_variable_bound_type(0), BOUNDED_BOTH_SIDES);
+      EXPECT_EQ(model.get_variable_upper_bound(0), 3.);
+      EXPECT_EQ(model.get_variable_bound_type(1), BOUNDED_LOWER);
+      EXPECT_EQ(model.get_constraint_lower_bound(0), -INF<double>);
+      EXPECT_EQ(model.get_constraint_upper_bound(0), 4.);
+      // G row with a range: [rhs, rhs + |R|]
+      EXPECT_EQ(model.get_constraint_lower_bound(2), 1.);
+      EXPECT_EQ(model.get_constraint_upper_bound(2), 2.);
+      EXPECT_TRUE(model.is_quadratic_program());
+      // the RHS of the objective row is the opposite of the objective constant
+      EXPECT_DOUBLE_EQ(model.evaluate_objective({3., 1.}), -12.);
+   }
+}
+
+TEST(MPSModel, QuadraticProgram) {
+   const MPSModel model(QP_FILE);
+   ASSERT_EQ(model.number_variables, 2);
+   ASSERT_EQ(model.number_constraints, 3);
+   EXPECT_EQ(model.get_number_hessian_nonzeros(), 2);
+   EXPECT_NEAR(model.evaluate_objective({1.4, 1.7}), 0.8, 1e-12);
+   SparseVector<double> gradient(2);
+   model.evaluate_objective_gradient({1.4, 1.7}, gradient);
+   std::vector<double> dense_gradient(2, 0.);
+   gradient.for_each([&](size_t i, double derivative) {
+      dense_gradient[i] += derivative;
+   });
+   EXPECT_NEAR(dense_gradient[0], 0.8, 1e-12);
+   EXPECT_NEAR(dense_gradient[1], -1.6, 1e-12);
+}
+
+TEST(MPSModel, Detection) {
+   const Options options = projection_model_options();
+   EXPECT_TRUE(ConvexQPSolver::is_applicable(MPSModel(LP_FILE), options));
+   EXPECT_TRUE(ConvexQPSolver::is_applicable(MPSModel(QP_FILE), options));
+   // hs015 has a nonlinear objective and a nonlinear constraint
+   EXPECT_FALSE(NLModel("examples/hs015.nl").is_quadratic_program());
+}
+
+TEST(ConvexQPSolver, LinearProgram) {
+   const Options options = projection_model_options();
+   const Result result = Uno::solve_model(std::make_unique<MPSModel>(LP_FILE), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.primals[0], 3., 1e-6);
+   EXPECT_NEAR(result.solution.primals[1], 1., 1e-6);
+   EXPECT_NEAR(result.solution.evaluations.objective, -12., 1e-6);
+   EXPECT_EQ(result.hessian_evaluations, 1);
+}
+
+TEST(ConvexQPSolver, SameSolutionAsIngredients) {
+   Options options = projection_model_options();
+   const Result qp_result = Uno::solve_model(std::make_unique<MPSModel>(QP_FILE), options);
+   ASSERT_EQ(qp_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(qp_result.solution.primals[0], 1.4, 1e-6);
+   EXPECT_NEAR(qp_result.solution.primals[1], 1.7, 1e-6);
+   EXPECT_NEAR(qp_result.solution.evaluations.objective, 0.8, 1e-6);
+   EXPECT_EQ(qp_result.hessian_evaluations, 1);
+
+   options["convex_qp_solver"] = "no";
+   const Result ingredients_result = Uno::solve_model(std::make_unique<MPSModel>(QP_FILE), options);
+   ASSERT_EQ(ingredients_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   for (size_t i: Range(2)) {
+      EXPECT_NEAR(qp_result.solution.primals[i], ingredients_result.solution.primals[i], 1e-4);
+   }
+   for (size_t j: Range(3)) {
+      EXPECT_NEAR(qp_result.solution.multipliers.constraints[j], ingredients_result.solution.multipliers.constraints[j], 1e-4);
+   }
+   EXPECT_LT(qp_result.hessian_evaluations, ingredients_result.hessian_evaluations);
+}
+
+TEST(ConvexQPSolver, EveryPreset) {
+   // the presets use different sparse formats (and tolerances): the augmented system is assembled in COO regardless
+   for (const std::string preset: {"ipopt", "filtersqp", "byrd", "funnelsqp"}) {
+      Options options = get_default_options("uno.options");
+      find_preset(preset, options);
+      options["linear_solver"] = "LDL";
+      options["logger"] = "ERROR";
+      options["statistics_sink"] = "none";
+      ASSERT_TRUE(ConvexQPSolver::is_applicable(MPSModel(LP_FILE), options)) << preset;
+      const Result lp_result = Uno::solve_model(std::make_unique<MPSModel>(LP_FILE), options);
+      ASSERT_EQ(lp_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT) << preset;
+      EXPECT_NEAR(lp_result.solution.evaluations.objective, -12., 1e-4) << preset;
+      const Result qp_result = Uno::solve_model(std::make_unique<MPSModel>(QP_FILE), options);
+      ASSERT_EQ(qp_result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT) << preset;
+      EXPECT_NEAR(qp_result.solution.evaluations.objective, 0.8, 1e-4) << preset;
+   }
+}
+
+TEST(ConvexQPSolver, TransportationProblem) {
+   // degenerate LP: the demands sum up to less than the supplies
+   const Options options = projection_model_options();
+   const Result result = Uno::solve_model(std::make_unique<MPSModel>("examples/transport.mps"), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.evaluations.objective, 550., 1e-6);
+   EXPECT_EQ(result.hessian_evaluations, 1);
+}
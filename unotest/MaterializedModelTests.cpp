@@ -0,0 +1,40 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "optimization/ModelFactory.hpp"
+#include "optimization/EqualityConstrainedModel.hpp"
+#include "optimization/BoundRelaxedModel.hpp"
+#include "optimization/MaterializedModel.hpp"
+#include "interfaces/NL/NLModel.hpp"
+#include "ProjectionModel.hpp"
+
+std::unique_ptr<Model> create_interior_point_chain(const Options& options) {
+   std::unique_ptr<Model> model = std::make_unique<NLModel>("examples/hs015.nl");
+   model = std::make_unique<EqualityConstrainedModel>(std::move(model));
+   return std::make_unique<BoundRelaxedModel>(std::move(model), options);
+}
+
+TEST(MaterializedModel, SameBoundsAsChain) {
+   const Options options = projection_model_options();
+   const std::unique_ptr<Model> chain = create_interior_point_chain(options);
+   const MaterializedModel model(create_interior_point_chain(options));
+   ASSERT_EQ(model.number_variables, chain->number_variables);
+   ASSERT_EQ(model.number_constraints, chain->number_constraints);
+   for (size_t i: Range(model.number_variables)) {
+      EXPECT_EQ(model.get_variable_lower_bound(i), chain->get_variable_lower_bound(i));
+      EXPECT_EQ(model.get_variable_upper_bound(i), chain->get_variable_upper_bound(i));
+      EXPECT_EQ(model.get_variable_bound_type(i), chain->get_variable_bound_type(i));
+   }
+   for (size_t j: Range(model.number_constraints)) {
+      EXPECT_EQ(model.get_constraint_lower_bound(j), chain->get_constraint_lower_bound(j));
+      EXPECT_EQ(model.get_constraint_upper_bound(j), chain->get_constraint_upper_bound(j));
+      EXPECT_EQ(model.get_constraint_bound_type(j), chain->get_constraint_bound_type(j));
+      EXPECT_EQ(model.get_constraint_type(j), chain->get_constraint_type(j));
+   }
+   EXPECT_EQ(model.lower_bounded_variables, chain->lower_bounded_variables);
+   EXPECT_EQ(model.upper_bounded_variables, chain->upper_bounded_variables);
+   EXPECT_EQ(model.equality_constraints, chain->equality_constraints);
+   EXPECT_EQ(model.get_number_jacobian_nonzeros(), chain->get_number_jacobian_nonzeros());
+   EXPECT_EQ(model.get_number_hessian_nonzeros(), chain->get_number_hessian_nonzeros());
+}
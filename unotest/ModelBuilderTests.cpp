@@ -0,0 +1,177 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include "Uno.hpp"
+#include "interfaces/Modeling/ModelBuilder.hpp"
+#include "interfaces/NL/NLModel.hpp"
+#include "linear_algebra/CSCSymmetricMatrix.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "ProjectionModel.hpp"
+
+// hs015: min 100 (x1 - x0^2)^2 + (1 - x0)^2 s.t. x0 x1 >= 1, x0 + x1^2 >= 0, x0 <= 0.5
+std::unique_ptr<Model> build_hs015() {
+   ModelBuilder builder("hs015");
+   const Expression x0 = builder.add_variable(-INF<double>, 0.5, -2.);
+   const Expression x1 = builder.add_variable(-INF<double>, INF<double>, 1.);
+   builder.minimize(100. * pow(x1 - pow(x0, 2.), 2.) + pow(1. - x0, 2.));
+   builder.add_constraint(x0 * x1, 1., INF<double>);
+   builder.add_constraint(x0 + pow(x1, 2.), 0., INF<double>);
+   return builder.build();
+}
+
+// dense copy of the (upper triangular) entries of a symmetric matrix
+std::vector<double> dense_upper_triangle(const SymmetricMatrix<double>& hessian, size_t dimension) {
+   std::vector<double> entries(dimension * dimension, 0.);
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      entries[std::min(i, j) * dimension + std::max(i, j)] += entry;
+   });
+   return entries;
+}
+
+TEST(ModelBuilder, SameDerivativesAsNLFile) {
+   const std::unique_ptr<Model> model = build_hs015();
+   const NLModel file_model("examples/hs015.nl");
+   ASSERT_EQ(model->number_variables, 2);
+   ASSERT_EQ(model->number_constraints, 2);
+   EXPECT_EQ(model->get_number_objective_gradient_nonzeros(), file_model.get_number_objective_gradient_nonzeros());
+   EXPECT_EQ(model->get_number_jacobian_nonzeros(), file_model.get_number_jacobian_nonzeros());
+   EXPECT_EQ(model->get_number_hessian_nonzeros(), file_model.get_number_hessian_nonzeros());
+   EXPECT_EQ(model->get_variable_bound_type(0), BOUNDED_UPPER);
+   EXPECT_EQ(model->get_constraint_type(0), NONLINEAR);
+   std::vector<double> x(2);
+   model->get_initial_primal_point(x);
+   EXPECT_EQ(x[0], -2.);
+   EXPECT_EQ(x[1], 1.);
+
+   EXPECT_DOUBLE_EQ(model->evaluate_objective(x), 909.);
+   SparseVector<double> gradient(2), file_gradient(2);
+   model->evaluate_objective_gradient(x, gradient);
+   file_model.evaluate_objective_gradient(x, file_gradient);
+   std::vector<double> gradient_difference(2, 0.);
+   gradient.for_each([&](size_t i, double derivative) { gradient_difference[i] += derivative; });
+   file_gradient.for_each([&](size_t i, double derivative) { gradient_difference[i] -= derivative; });
+   EXPECT_DOUBLE_EQ(gradient_difference[0], 0.);
+   EXPECT_DOUBLE_EQ(gradient_difference[1], 0.);
+
+   RectangularMatrix<double> jacobian(2, SparseVector<double>(2)), file_jacobian(2, SparseVector<double>(2));
+   model->evaluate_constraint_jacobian(x, jacobian);
+   file_model.evaluate_constraint_jacobian(x, file_jacobian);
+   for (size_t j: Range(2)) {
+      std::vector<double> row_difference(2, 0.);
+      jacobian[j].for_each([&](size_t i, double derivative) { row_difference[i] += derivative; });
+      file_jacobian[j].for_each([&](size_t i, double derivative) { row_difference[i] -= derivative; });
+      EXPECT_DOUBLE_EQ(row_difference[0], 0.);
+      EXPECT_DOUBLE_EQ(row_difference[1], 0.);
+   }
+
+   CSCSymmetricMatrix<double> hessian(2, model->get_number_hessian_nonzeros(), false);
+   CSCSymmetricMatrix<double> file_hessian(2, file_model.get_number_hessian_nonzeros(), false);
+   model->evaluate_lagrangian_hessian(x, 1., {1., 2.}, hessian);
+   file_model.evaluate_lagrangian_hessian(x, 1., {1., 2.}, file_hessian);
+   const std::vector<double> entries = dense_upper_triangle(hessian, 2);
+   const std::vector<double> file_entries = dense_upper_triangle(file_hessian, 2);
+   for (size_t k: Range(4)) {
+      EXPECT_DOUBLE_EQ(entries[k], file_entries[k]);
+   }
+}
+
+TEST(ModelBuilder, AffinePartsAndConstants) {
+   ModelBuilder builder("affine");
+   const std::vector<Expression> x = builder.add_variables(3, 0., INF<double>, 1.);
+   // constant expressions are folded without being recorded
+   const size_t tape_size = builder.tape_size();
+   const Expression constant = pow(Expression(2.), 3.) + 1.;
+   ASSERT_TRUE(constant.is_constant());
+   EXPECT_EQ(constant.get_constant(), 9.);
+   EXPECT_EQ(builder.tape_size(), tape_size);
+
+   // 2 x0 + 3 (x1 - 1) - x0/2 = 1.5 x0 + 3 x1 - 3 is linear
+   builder.add_constraint(2. * x[0] + 3. * (x[1] - 1.) - x[0] / 2., -INF<double>, 4.);
+   // x2 + exp(x0) is nonlinear, but its Hessian only involves x0
+   builder.add_constraint(x[2] + exp(x[0]), -INF<double>, constant.get_constant());
+   builder.minimize(sum({x[0], pow(x[1], 2.), 5.}));
+   const std::unique_ptr<Model> model = builder.build();
+
+   EXPECT_EQ(model->get_constraint_type(0), LINEAR);
+   EXPECT_EQ(model->get_constraint_type(1), NONLINEAR);
+   EXPECT_EQ(model->get_linear_constraints(), std::vector<size_t>{0});
+   EXPECT_EQ(model->get_constraint_upper_bound(1), 9.);
+   EXPECT_EQ(model->get_number_jacobian_nonzeros(), 4);
+   // entries (0, 0) and (1, 1)
+   EXPECT_EQ(model->get_number_hessian_nonzeros(), 2);
+
+   const std::vector<double> point{2., 1., 3.};
+   std::vector<double> constraints(2);
+   model->evaluate_constraints(point, constraints);
+   EXPECT_DOUBLE_EQ(constraints[0], 3.);
+   EXPECT_DOUBLE_EQ(constraints[1], 3. + std::exp(2.));
+   EXPECT_DOUBLE_EQ(model->evaluate_objective(point), 8.);
+}
+
+TEST(ModelBuilder, SharedSubexpressions) {
+   // e = e + e doubles the expression: the tape has a linear number of nodes, the tree has an exponential number of paths
+   ModelBuilder builder("chain");
+   const Expression x0 = builder.add_variable();
+   const Expression x1 = builder.add_variable();
+   Expression linear_chain = x0 - 1.;
+   Expression nonlinear_chain = exp(x1);
+   const size_t number_doublings = 40;
+   for (size_t doubling = 0; doubling < number_doublings; doubling++) {
+      linear_chain = linear_chain + linear_chain;
+      nonlinear_chain = nonlinear_chain + nonlinear_chain;
+   }
+   builder.add_constraint(linear_chain, 0., 0.);
+   builder.add_constraint(nonlinear_chain, 0., 0.);
+   const std::unique_ptr<Model> model = builder.build();
+
+   const double factor = std::ldexp(1., static_cast<int>(number_doublings));
+   EXPECT_EQ(model->get_constraint_type(0), LINEAR);
+   EXPECT_EQ(model->get_constraint_type(1), NONLINEAR);
+   const std::vector<double> point{3., 0.5};
+   std::vector<double> constraints(2);
+   model->evaluate_constraints(point, constraints);
+   EXPECT_DOUBLE_EQ(constraints[0], factor * 2.);
+   EXPECT_DOUBLE_EQ(constraints[1], factor * std::exp(0.5));
+   SparseVector<double> gradient(2);
+   model->evaluate_constraint_gradient(point, 0, gradient);
+   gradient.for_each([&](size_t i, double derivative) {
+      EXPECT_EQ(i, 0);
+      EXPECT_DOUBLE_EQ(derivative, factor);
+   });
+}
+
+TEST(ModelBuilder, OperandsOfDifferentModels) {
+   ModelBuilder first_builder("first");
+   ModelBuilder second_builder("second");
+   const Expression x = first_builder.add_variable();
+   const Expression y = second_builder.add_variable();
+   EXPECT_THROW(static_cast<void>(x + y), std::invalid_argument);
+   EXPECT_THROW(second_builder.minimize(x), std::invalid_argument);
+   EXPECT_THROW(static_cast<void>(first_builder.add_variable(1., 0.)), std::invalid_argument);
+}
+
+TEST(ModelBuilder, SolveHS015) {
+   const Result result = Uno::solve_model(build_hs015(), projection_model_options());
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.primals[0], 0.5, 1e-4);
+   EXPECT_NEAR(result.solution.primals[1], 2., 1e-4);
+   EXPECT_NEAR(result.solution.evaluations.objective, 306.5, 1e-4);
+}
+
+// max -(x0 - 1)^2 - (x1 - 2)^2 s.t. x0 + x1 <= 2, x >= 0 is the projection model
+TEST(ModelBuilder, Maximization) {
+   ModelBuilder builder("projection");
+   const Expression x0 = builder.add_variable(0., INF<double>, 0.5);
+   const Expression x1 = builder.add_variable(0., INF<double>, 0.5);
+   builder.maximize(-pow(x0 - 1., 2.) - pow(x1 - 2., 2.));
+   builder.add_constraint(x0 + x1, -INF<double>, 2.);
+   const Options options = projection_model_options();
+   const Result result = Uno::solve_model(builder.build(), options);
+   const Result projection_result = Uno::solve_model(std::make_unique<ProjectionModel>(1.), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.primals[0], projection_result.solution.primals[0], 1e-6);
+   EXPECT_NEAR(result.solution.primals[1], projection_result.solution.primals[1], 1e-6);
+}
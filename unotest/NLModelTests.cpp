@@ -0,0 +1,180 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include "Uno.hpp"
+#include "interfaces/NL/NLModel.hpp"
+#include "linear_algebra/CSCSymmetricMatrix.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "ProjectionModel.hpp"
+
+const std::string HS015_FILE = "examples/hs015.nl";
+const std::string POLAK5_FILE = "examples/polak5.nl";
+
+// sum of the (upper triangular) entries (i, j) of a symmetric matrix
+double hessian_entry(const SymmetricMatrix<double>& hessian, size_t row_index, size_t column_index) {
+   double value = 0.;
+   hessian.for_each([&](size_t i, size_t j, double entry) {
+      if ((i == row_index && j == column_index) || (i == column_index && j == row_index)) {
+         value += entry;
+      }
+   });
+   return value;
+}
+
+TEST(NLModel, Dimensions) {
+   const NLModel model(HS015_FILE);
+   ASSERT_EQ(model.number_variables, 2);
+   ASSERT_EQ(model.number_constraints, 2);
+   ASSERT_EQ(model.get_number_objective_gradient_nonzeros(), 2);
+   ASSERT_EQ(model.get_number_jacobian_nonzeros(), 4);
+   EXPECT_EQ(model.get_variable_lower_bound(0), -INF<double>);
+   EXPECT_EQ(model.get_variable_upper_bound(0), 0.5);
+   EXPECT_EQ(model.get_variable_bound_type(0), BOUNDED_UPPER);
+   EXPECT_EQ(model.get_variable_bound_type(1), UNBOUNDED);
+   EXPECT_EQ(model.get_constraint_lower_bound(0), 1.);
+   EXPECT_EQ(model.get_constraint_lower_bound(1), 0.);
+   EXPECT_EQ(model.get_constraint_type(0), NONLINEAR);
+   std::vector<double> x(2);
+   model.get_initial_primal_point(x);
+   EXPECT_EQ(x[0], -2.);
+   EXPECT_EQ(x[1], 1.);
+}
+
+TEST(NLModel, Evaluations) {
+   const NLModel model(HS015_FILE);
+   const std::vector<double> x{-2., 1.};
+   EXPECT_DOUBLE_EQ(model.evaluate_objective(x), 909.);
+   std::vector<double> constraints(2);
+   model.evaluate_constraints(x, constraints);
+   EXPECT_DOUBLE_EQ(constraints[0], -2.);
+   EXPECT_DOUBLE_EQ(constraints[1], -1.);
+
+   SparseVector<double> gradient(2);
+   model.evaluate_objective_gradient(x, gradient);
+   std::vector<double> dense_gradient(2, 0.);
+   gradient.for_each([&](size_t i, double derivative) {
+      dense_gradient[i] += derivative;
+   });
+   EXPECT_DOUBLE_EQ(dense_gradient[0], -2406.);
+   EXPECT_DOUBLE_EQ(dense_gradient[1], -600.);
+
+   RectangularMatrix<double> jacobian(2, SparseVector<double>(2));
+   model.evaluate_constraint_jacobian(x, jacobian);
+   std::vector<double> dense_jacobian(4, 0.);
+   for (size_t j: Range(2)) {
+      jacobian[j].for_each([&](size_t i, double derivative) {
+         dense_jacobian[2*j + i] += derivative;
+      });
+   }
+   // c0 = x0 x1, c1 = x0 + x1^2
+   EXPECT_DOUBLE_EQ(dense_jacobian[0], 1.);
+   EXPECT_DOUBLE_EQ(dense_jacobian[1], -2.);
+   EXPECT_DOUBLE_EQ(dense_jacobian[2], 1.);
+   EXPECT_DOUBLE_EQ(dense_jacobian[3], 2.);
+
+   // Hessian of f - c0 - 2 c1
+   CSCSymmetricMatrix<double> hessian(2, model.get_number_hessian_nonzeros(), false);
+   model.evaluate_lagrangian_hessian(x, 1., {1., 2.}, hessian);
+   EXPECT_DOUBLE_EQ(hessian_entry(hessian, 0, 0), 4402.);
+   EXPECT_DOUBLE_EQ(hessian_entry(hessian, 0, 1), 799.);
+   EXPECT_DOUBLE_EQ(hessian_entry(hessian, 1, 1), 196.);
+}
+
+TEST(NLModel, SolveHS015) {
+   const Result result = Uno::solve_model(std::make_unique<NLModel>(HS015_FILE), projection_model_options());
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.primals[0], 0.5, 1e-4);
+   EXPECT_NEAR(result.solution.primals[1], 2., 1e-4);
+   EXPECT_NEAR(result.solution.evaluations.objective, 306.5, 1e-4);
+}
+
+TEST(NLModel, SolvePolak5) {
+   const Result result = Uno::solve_model(std::make_unique<NLModel>(POLAK5_FILE), projection_model_options());
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.evaluations.objective, 50., 1e-4);
+}
+
+// min x0^2 + x1 s.t. sin(x0) + x1 = 1, in binary format
+TEST(NLModel, BinaryFormat) {
+   const std::string file_name = "binary_model.nl";
+   {
+      std::ofstream file(file_name, std::ios::binary);
+      file << "b3 1 1 0\n 2 1 1 0 1\n 1 1\n 0 0\n 1 1 1\n 0 0 0 1\n 0 0 0 0 0\n 2 2\n 0 0\n 0 0 0 0 0\n";
+      const auto write_integer = [&](int32_t value) {
+         file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      };
+      const auto write_double = [&](double value) {
+         file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      };
+      file << 'C'; write_integer(0);
+      file << 'o'; write_integer(41); file << 'v'; write_integer(0);
+      file << 'O'; write_integer(0); write_integer(0);
+      file << 'o'; write_integer(5); file << 'v'; write_integer(0); file << 'n'; write_double(2.);
+      file << 'r' << '4'; write_double(1.);
+      file << 'b' << '3' << '3';
+      file << 'x'; write_integer(1); write_integer(0); write_double(0.5);
+      file << 'J'; write_integer(0); write_integer(2); write_integer(0); write_double(0.); write_integer(1); write_double(1.);
+      file << 'G'; write_integer(0); write_integer(2); write_integer(0); write_double(0.); write_integer(1); write_double(1.);
+   }
+   const NLModel model(file_name);
+   std::remove(file_name.c_str());
+
+   ASSERT_EQ(model.number_variables, 2);
+   ASSERT_EQ(model.number_constraints, 1);
+   EXPECT_EQ(model.get_constraint_bound_type(0), EQUAL_BOUNDS);
+   std::vector<double> x(2);
+   model.get_initial_primal_point(x);
+   EXPECT_EQ(x[0], 0.5);
+   EXPECT_EQ(x[1], 0.);
+   x[1] = 0.3;
+   EXPECT_DOUBLE_EQ(model.evaluate_objective(x), 0.55);
+   std::vector<double> constraints(1);
+   model.evaluate_constraints(x, constraints);
+   EXPECT_DOUBLE_EQ(constraints[0], std::sin(0.5) + 0.3);
+   CSCSymmetricMatrix<double> hessian(2, model.get_number_hessian_nonzeros(), false);
+   model.evaluate_lagrangian_hessian(x, 1., {2.}, hessian);
+   EXPECT_DOUBLE_EQ(hessian_entry(hessian, 0, 0), 2. + 2. * std::sin(0.5));
+   EXPECT_DOUBLE_EQ(hessian_entry(hessian, 1, 1), 0.);
+}
+
+TEST(NLModel, ConcurrentEvaluations) {
+   const NLModel model(HS015_FILE);
+   const size_t number_threads = 4;
+   const size_t number_points = 200;
+   const auto point = [](size_t k) {
+      return std::vector<double>{-2. + 0.01 * static_cast<double>(k), 1. - 0.005 * static_cast<double>(k)};
+   };
+   std::vector<double> serial_objectives(number_points);
+   for (size_t k: Range(number_points)) {
+      serial_objectives[k] = model.evaluate_objective(point(k));
+   }
+   std::vector<size_t> mismatches(number_threads, 0);
+   std::vector<std::thread> threads;
+   for (size_t thread_index: Range(number_threads)) {
+      threads.emplace_back([&, thread_index]() {
+         CSCSymmetricMatrix<double> hessian(2, model.get_number_hessian_nonzeros(), false);
+         for (size_t k: Range(number_points)) {
+            const std::vector<double> x = point(k);
+            if (model.evaluate_objective(x) != serial_objectives[k]) {
+               mismatches[thread_index]++;
+            }
+            model.evaluate_lagrangian_hessian(x, 1., {1., 2.}, hessian);
+            if (hessian_entry(hessian, 1, 1) != 196.) {
+               mismatches[thread_index]++;
+            }
+         }
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   for (size_t thread_index: Range(number_threads)) {
+      EXPECT_EQ(mismatches[thread_index], 0);
+   }
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <optional>
+#include <thread>
+#include "PortfolioSolver.hpp"
+#include "ProjectionModel.hpp"
+#include "Uno.hpp"
+#include "solvers/QP/QPSolverFactory.hpp"
+#include "tools/Cancellation.hpp"
+
+Options sqp_projection_model_options(const std::string& preset_name) {
+   Options options = projection_model_options();
+   find_preset(preset_name, options);
+   return options;
+}
+
+TEST(PortfolioSolver, ConvergedConfigurationWins) {
+   const Options options = projection_model_options();
+   Options failing_options = options;
+   failing_options["subproblem"] = "unknown";
+   const PortfolioSolver portfolio_solver([]() {
+      return std::make_unique<ProjectionModel>(1.);
+   });
+   const PortfolioResult result = portfolio_solver.solve({{"failing", failing_options}, {"ipopt", options}});
+   ASSERT_EQ(result.winner, "ipopt");
+   ASSERT_TRUE(result.result.has_value());
+   EXPECT_NEAR(result.result->solution.evaluations.objective, 0.5, 1e-6);
+   ASSERT_EQ(result.runs.size(), 2);
+   EXPECT_EQ(result.runs[0].status.rfind("error", 0), 0) << result.runs[0].status;
+   EXPECT_EQ(result.runs[1].status, "feasible KKT point");
+}
+
+TEST(PortfolioSolver, CancelledSolveStopsAtFirstIteration) {
+   const Options options = projection_model_options();
+   std::atomic<bool> cancellation_flag{true};
+   std::thread thread([&]() {
+      Cancellation::set_flag(&cancellation_flag);
+      Logger::set_logger("ERROR");
+      const Result result = Uno::solve_model(std::make_unique<ProjectionModel>(1.), options);
+      EXPECT_EQ(result.iteration, 0);
+      EXPECT_EQ(result.solution.status, TerminationStatus::NOT_OPTIMAL);
+      Cancellation::set_flag(nullptr);
+   });
+   thread.join();
+}
+
+// the SQP presets share the (non-reentrant) BQPD solver
+TEST(PortfolioSolver, ConcurrentSQPPresets) {
+   const std::vector<std::string> QP_solvers = QPSolverFactory::available_solvers();
+   if (std::find(QP_solvers.cbegin(), QP_solvers.cend(), "BQPD") == QP_solvers.cend()) {
+      GTEST_SKIP() << "BQPD is not available";
+   }
+   const std::vector<std::string> presets{"filtersqp", "byrd"};
+   std::vector<std::optional<Result>> concurrent_results(presets.size());
+   std::vector<std::thread> threads;
+   for (size_t preset_index: Range(presets.size())) {
+      threads.emplace_back([&, preset_index]() {
+         Logger::set_logger("ERROR");
+         concurrent_results[preset_index] = Uno::solve_model(std::make_unique<ProjectionModel>(1.),
+               sqp_projection_model_options(presets[preset_index]));
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   for (size_t preset_index: Range(presets.size())) {
+      ASSERT_TRUE(concurrent_results[preset_index].has_value());
+      const Result& result = *concurrent_results[preset_index];
+      EXPECT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT) << presets[preset_index];
+      EXPECT_NEAR(result.solution.evaluations.objective, 0.5, 1e-6) << presets[preset_index];
+   }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "Uno.hpp"
+#include "ProjectionModel.hpp"
+#include "preprocessing/Presolve.hpp"
+
+// min (x0 - 3)^2 + x1^2 + (x2 - 2)^2 + (x3 - 1)^2 - x4 - 2 x5
+// s.t. x0 + x1 <= 4 (singleton once x1 is removed)
+//      x2 - x3 <= 1 (redundant)
+//      x0^2 + x3^2 >= 1 (nonlinear)
+//      x4 + x5 <= b (forcing if b = 0, infeasible if b < 0)
+//      x0 >= 0, x1 = 2, 0 <= x2 <= 1, x3 >= 0, x4 >= 0, x5 >= 0
+class PresolveTestModel : public Model {
+public:
+   explicit PresolveTestModel(double b): Model("presolve", 6, 4), b(b) {
+      this->lower_bounded_variables = {0, 1, 2, 3, 4, 5};
+      this->upper_bounded_variables = {1, 2};
+      this->single_lower_bounded_variables = {0, 3, 4, 5};
+      this->inequality_constraints = {0, 1, 2, 3};
+      this->number_objective_gradient_nonzeros = 6;
+      this->number_jacobian_nonzeros = 8;
+      this->number_hessian_nonzeros = 4;
+   }
+
+   [[nodiscard]] double get_variable_lower_bound(size_t i) const override { return (i == 1) ? 2. : 0.; }
+   [[nodiscard]] double get_variable_upper_bound(size_t i) const override { return (i == 1) ? 2. : (i == 2) ? 1. : INF<double>; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t j) const override { return (j == 2) ? 1. : -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t j) const override { return (j == 0) ? 4. : (j == 1) ? 1. : (j == 2) ? INF<double> : this->b; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t i) const override {
+      return (i == 1) ? EQUAL_BOUNDS : (i == 2) ? BOUNDED_BOTH_SIDES : BOUNDED_LOWER;
+   }
+   [[nodiscard]] FunctionType get_constraint_type(size_t j) const override { return (j == 2) ? NONLINEAR : LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t j) const override { return (j == 2) ? BOUNDED_LOWER : BOUNDED_UPPER; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return this->number_objective_gradient_nonzeros; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return this->number_jacobian_nonzeros; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return this->number_hessian_nonzeros; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override {
+      return (x[0] - 3.) * (x[0] - 3.) + x[1] * x[1] + (x[2] - 2.) * (x[2] - 2.) + (x[3] - 1.) * (x[3] - 1.) - x[4] - 2. * x[5];
+   }
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 2. * (x[0] - 3.));
+      gradient.insert(1, 2. * x[1]);
+      gradient.insert(2, 2. * (x[2] - 2.));
+      gradient.insert(3, 2. * (x[3] - 1.));
+      gradient.insert(4, -1.);
+      gradient.insert(5, -2.);
+   }
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] + x[1];
+      constraints[1] = x[2] - x[3];
+      constraints[2] = x[0] * x[0] + x[3] * x[3];
+      constraints[3] = x[4] + x[5];
+   }
+   void evaluate_constraint_gradient(const std::vector<double>& x, size_t j, SparseVector<double>& gradient) const override {
+      if (j == 0) {
+         gradient.insert(0, 1.);
+         gradient.insert(1, 1.);
+      }
+      else if (j == 1) {
+         gradient.insert(2, 1.);
+         gradient.insert(3, -1.);
+      }
+      else if (j == 2) {
+         gradient.insert(0, 2. * x[0]);
+         gradient.insert(3, 2. * x[3]);
+      }
+      else {
+         gradient.insert(4, 1.);
+         gradient.insert(5, 1.);
+      }
+   }
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      for (size_t j: Range(this->number_constraints)) {
+         this->evaluate_constraint_gradient(x, j, constraint_jacobian[j]);
+      }
+   }
+   void evaluate_lagrangian_hessian(const std::vector<double>& /*x*/, double objective_multiplier, const std::vector<double>& multipliers,
+         SymmetricMatrix<double>& hessian) const override {
+      hessian.reset();
+      for (size_t i: Range(this->number_variables)) {
+         if (i < 4) {
+            const double constraint_term = (i == 0 || i == 3) ? 2. * multipliers[2] : 0.;
+            hessian.insert(2. * objective_multiplier - constraint_term, i, i);
+         }
+         hessian.finalize_column(i);
+      }
+   }
+
+   void get_initial_primal_point(std::vector<double>& x) const override {
+      for (size_t i: Range(this->number_variables)) {
+         x[i] = 0.5;
+      }
+   }
+   void get_initial_dual_point(std::vector<double>& multipliers) const override {
+      for (size_t j: Range(this->number_constraints)) {
+         multipliers[j] = 0.;
+      }
+   }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+private:
+   const double b;
+   const std::vector<size_t> linear_constraints{0, 1, 3};
+};
+
+TEST(Presolve, Reductions) {
+   const PresolveTestModel model(0.);
+   const Presolve presolve(model, 1e-9, 1e-6);
+   // x1 is fixed by its bounds, x4 and x5 by the forcing row
+   ASSERT_EQ(presolve.get_number_variables(), 3);
+   EXPECT_EQ(presolve.original_variable(0), 0);
+   EXPECT_EQ(presolve.original_variable(1), 2);
+   EXPECT_EQ(presolve.original_variable(2), 3);
+   EXPECT_EQ(presolve.reduced_variable(1), Presolve::NOT_KEPT);
+   ASSERT_EQ(presolve.get_number_constraints(), 1);
+   EXPECT_EQ(presolve.original_constraint(0), 2);
+   EXPECT_EQ(presolve.get_row_reduction(0), RowReduction::SINGLETON);
+   EXPECT_EQ(presolve.get_row_reduction(1), RowReduction::REDUNDANT);
+   EXPECT_EQ(presolve.get_row_reduction(3), RowReduction::FORCING_UPPER);
+   // the singleton row x0 + x1 <= 4 becomes x0 <= 2
+   EXPECT_EQ(presolve.get_variable_bounds(0).ub, 2.);
+   EXPECT_EQ(presolve.get_fixed_value(1), 2.);
+   EXPECT_EQ(presolve.get_fixed_value(4), 0.);
+}
+
+TEST(Presolve, InfeasibleRow) {
+   const PresolveTestModel model(-1.);
+   EXPECT_THROW(Presolve(model, 1e-9, 1e-6), std::runtime_error);
+}
+
+TEST(Presolve, Postsolve) {
+   Options options = projection_model_options();
+   options["presolve"] = "yes";
+   const Result result = Uno::solve_model(std::make_unique<PresolveTestModel>(0.), options);
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.evaluations.objective, 6., 1e-6);
+
+   // primal solution (2, 2, 1, 1, 0, 0) of the original model
+   ASSERT_EQ(result.solution.number_variables, 6);
+   const std::vector<double> primals{2., 2., 1., 1., 0., 0.};
+   for (size_t i: Range(6)) {
+      EXPECT_NEAR(result.solution.primals[i], primals[i], 1e-6);
+   }
+   // multipliers of the removed constraints and bound multipliers of the removed variables
+   ASSERT_EQ(result.solution.multipliers.constraints.size(), 4);
+   EXPECT_NEAR(result.solution.multipliers.constraints[0], -2., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.constraints[1], 0., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.constraints[3], -2., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.lower_bounds[0], 0., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.upper_bounds[0], 0., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.lower_bounds[1], 6., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.lower_bounds[4], 1., 1e-6);
+   EXPECT_NEAR(result.solution.multipliers.lower_bounds[5], 0., 1e-6);
+}
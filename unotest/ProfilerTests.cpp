@@ -0,0 +1,97 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "tools/Profiler.hpp"
+
+TEST(Profiler, NestedScopesAndThreads) {
+   Profiler::reset();
+   for (size_t iteration = 0; iteration < 3; iteration++) {
+      ProfilerScope outer_scope("outer phase");
+      ProfilerScope inner_scope("inner phase");
+   }
+   std::thread thread([]() {
+      ProfilerScope thread_scope("outer phase");
+   });
+   thread.join();
+
+   std::ostringstream stream;
+   Profiler::print_summary(stream);
+   const std::string summary = stream.str();
+   // the calls of both threads are merged
+   ASSERT_NE(summary.find("outer phase"), std::string::npos);
+   ASSERT_NE(summary.find("4 calls"), std::string::npos);
+   ASSERT_NE(summary.find("  inner phase"), std::string::npos);
+   ASSERT_NE(summary.find("3 calls"), std::string::npos);
+}
+
+TEST(Profiler, ConcurrentSummaries) {
+   Profiler::reset();
+   std::vector<std::thread> threads;
+   for (size_t thread_index = 0; thread_index < 4; thread_index++) {
+      threads.emplace_back([]() {
+         for (size_t iteration = 0; iteration < 100; iteration++) {
+            ProfilerScope scope("worker phase");
+         }
+      });
+   }
+   // the summary of the main thread does not read the trees of the running workers
+   std::ostringstream intermediate_stream;
+   Profiler::print_summary(intermediate_stream);
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+
+   // the trees of the workers were merged when they terminated
+   std::ostringstream stream;
+   Profiler::print_summary(stream);
+   ASSERT_NE(stream.str().find("400 calls"), std::string::npos);
+}
+
+TEST(Tracer, TraceFile) {
+   const std::string file_name = "uno_test_trace.json";
+   Tracer::open(file_name);
+   {
+      ProfilerScope scope("traced phase");
+      Tracer::add_counter("barrier parameter", 0.1);
+      Tracer::add_counter("trust-region radius", INFINITY); // skipped
+   }
+   Tracer::close();
+
+   std::ifstream file(file_name);
+   const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+   std::remove(file_name.c_str());
+   ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{"), 0);
+   ASSERT_NE(trace.find(R"("name":"traced phase","cat":"uno","ph":"X")"), std::string::npos);
+   ASSERT_NE(trace.find(R"("name":"barrier parameter","ph":"C")"), std::string::npos);
+   ASSERT_EQ(trace.find("trust-region radius"), std::string::npos);
+   ASSERT_NE(trace.find("\n]}\n"), std::string::npos);
+}
+
+TEST(Tracer, NestedSessions) {
+   const std::string file_name = "uno_test_nested_trace.json";
+   {
+      const TraceSession outer_session(file_name);
+      {
+         // a nested (or concurrent) solve joins the trace
+         const TraceSession inner_session(file_name);
+         ProfilerScope scope("inner solve");
+      }
+      ASSERT_TRUE(Tracer::is_enabled());
+      ProfilerScope scope("outer solve");
+   }
+   ASSERT_FALSE(Tracer::is_enabled());
+
+   std::ifstream file(file_name);
+   const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+   std::remove(file_name.c_str());
+   ASSERT_NE(trace.find(R"("name":"inner solve")"), std::string::npos);
+   ASSERT_NE(trace.find(R"("name":"outer solve")"), std::string::npos);
+   ASSERT_EQ(trace.find("\n]}\n"), trace.size() - 4);
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PROJECTIONMODEL_H
+#define UNO_PROJECTIONMODEL_H
+
+#include "optimization/Iterate.hpp"
+#include "optimization/Model.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Options.hpp"
+
+// min (x0 - a)^2 + (x1 - 2)^2 s.t. x0 + x1 <= 2, x >= 0
+class ProjectionModel : public Model {
+public:
+   explicit ProjectionModel(double a): Model("projection", 2, 1), a(a) {
+      this->lower_bounded_variables = {0, 1};
+      this->single_lower_bounded_variables = {0, 1};
+      this->inequality_constraints = {0};
+      this->number_objective_gradient_nonzeros = 2;
+      this->number_jacobian_nonzeros = 2;
+      this->number_hessian_nonzeros = 2;
+   }
+
+   [[nodiscard]] double get_variable_lower_bound(size_t /*i*/) const override { return 0.; }
+   [[nodiscard]] double get_variable_upper_bound(size_t /*i*/) const override { return INF<double>; }
+   [[nodiscard]] double get_constraint_lower_bound(size_t /*j*/) const override { return -INF<double>; }
+   [[nodiscard]] double get_constraint_upper_bound(size_t /*j*/) const override { return 2.; }
+   [[nodiscard]] BoundType get_variable_bound_type(size_t /*i*/) const override { return BOUNDED_LOWER; }
+   [[nodiscard]] FunctionType get_constraint_type(size_t /*j*/) const override { return LINEAR; }
+   [[nodiscard]] BoundType get_constraint_bound_type(size_t /*j*/) const override { return BOUNDED_UPPER; }
+   [[nodiscard]] size_t get_number_objective_gradient_nonzeros() const override { return this->number_objective_gradient_nonzeros; }
+   [[nodiscard]] size_t get_number_jacobian_nonzeros() const override { return this->number_jacobian_nonzeros; }
+   [[nodiscard]] size_t get_number_hessian_nonzeros() const override { return this->number_hessian_nonzeros; }
+
+   [[nodiscard]] double evaluate_objective(const std::vector<double>& x) const override {
+      return (x[0] - this->a) * (x[0] - this->a) + (x[1] - 2.) * (x[1] - 2.);
+   }
+   void evaluate_objective_gradient(const std::vector<double>& x, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 2. * (x[0] - this->a));
+      gradient.insert(1, 2. * (x[1] - 2.));
+   }
+   void evaluate_constraints(const std::vector<double>& x, std::vector<double>& constraints) const override {
+      constraints[0] = x[0] + x[1];
+   }
+   void evaluate_constraint_gradient(const std::vector<double>& /*x*/, size_t /*j*/, SparseVector<double>& gradient) const override {
+      gradient.insert(0, 1.);
+      gradient.insert(1, 1.);
+   }
+   void evaluate_constraint_jacobian(const std::vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+      this->evaluate_constraint_gradient(x, 0, constraint_jacobian[0]);
+   }
+   void evaluate_lagrangian_hessian(const std::vector<double>& /*x*/, double objective_multiplier, const std::vector<double>& /*multipliers*/,
+         SymmetricMatrix<double>& hessian) const override {
+      hessian.reset();
+      for (size_t i: Range(2)) {
+         hessian.insert(2. * objective_multiplier, i, i);
+         hessian.finalize_column(i);
+      }
+   }
+
+   void get_initial_primal_point(std::vector<double>& x) const override {
+      x[0] = 0.5;
+      x[1] = 0.5;
+   }
+   void get_initial_dual_point(std::vector<double>& multipliers) const override { multipliers[0] = 0.; }
+   void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+   [[nodiscard]] const std::vector<size_t>& get_linear_constraints() const override { return this->linear_constraints; }
+
+private:
+   const double a;
+   const std::vector<size_t> linear_constraints{0};
+};
+
+// interior-point method with the internal linear solver, without output
+inline Options projection_model_options() {
+   Options options = get_default_options("uno.options");
+   find_preset("ipopt", options);
+   options["linear_solver"] = "LDL";
+   options["logger"] = "ERROR";
+   options["statistics_sink"] = "none";
+   return options;
+}
+
+#endif // UNO_PROJECTIONMODEL_H
@@ -0,0 +1,123 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "linear_algebra/COOSymmetricMatrix.hpp"
+#include "solvers/linear/SparseLDLSolver.hpp"
+
+const double ldl_tolerance = 1e-8;
+
+// quasi-definite KKT matrix [H A^T; A -I] with 4 variables and 2 constraints
+COOSymmetricMatrix<double> create_quasidefinite_matrix() {
+   COOSymmetricMatrix<double> matrix(6, 13, false);
+   matrix.insert(4., 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(3., 1, 1);
+   matrix.insert(5., 2, 2);
+   matrix.insert(2., 3, 3);
+   matrix.insert(1., 0, 4);
+   matrix.insert(1., 2, 4);
+   matrix.insert(-1., 4, 4);
+   matrix.insert(1., 1, 5);
+   matrix.insert(2., 3, 5);
+   matrix.insert(-1., 5, 5);
+   return matrix;
+}
+
+std::vector<double> multiply(const COOSymmetricMatrix<double>& matrix, const std::vector<double>& x) {
+   std::vector<double> result(x.size(), 0.);
+   matrix.for_each([&](size_t i, size_t j, double entry) {
+      result[i] += entry * x[j];
+      if (i != j) {
+         result[j] += entry * x[i];
+      }
+   });
+   return result;
+}
+
+TEST(SparseLDLSolver, Solve) {
+   const COOSymmetricMatrix<double> matrix = create_quasidefinite_matrix();
+   const std::vector<double> reference{1., 2., 3., 4., 5., 6.};
+   const std::vector<double> rhs = multiply(matrix, reference);
+   std::vector<double> result(6);
+
+   SparseLDLSolver solver(6, 13, std::make_unique<FillReducingOrdering>("MD", "none"), 1);
+   solver.factorize(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   for (size_t i: Range(6)) {
+      EXPECT_NEAR(result[i], reference[i], ldl_tolerance);
+   }
+}
+
+TEST(SparseLDLSolver, Inertia) {
+   const COOSymmetricMatrix<double> matrix = create_quasidefinite_matrix();
+   SparseLDLSolver solver(6, 13, std::make_unique<FillReducingOrdering>("MD", "none"), 1);
+   solver.factorize(matrix);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 4);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+}
+
+TEST(SparseLDLSolver, MultithreadedFactorization) {
+   // block tridiagonal matrix: the elimination tree has many independent subtrees
+   const size_t n = 200;
+   COOSymmetricMatrix<double> matrix(n, 2 * n, false);
+   for (size_t i: Range(n)) {
+      matrix.insert(4., i, i);
+      if (i % 10 != 0) {
+         matrix.insert(-1., i - 1, i);
+      }
+   }
+   std::vector<double> reference(n);
+   for (size_t i: Range(n)) {
+      reference[i] = static_cast<double>(i % 7);
+   }
+   const std::vector<double> rhs = multiply(matrix, reference);
+   std::vector<double> result(n);
+
+   SparseLDLSolver solver(n, 2 * n, std::make_unique<FillReducingOrdering>("MD", "none"), 4);
+   solver.factorize(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   for (size_t i: Range(n)) {
+      EXPECT_NEAR(result[i], reference[i], ldl_tolerance);
+   }
+   ASSERT_EQ(solver.number_negative_eigenvalues(), 0);
+}
+
+TEST(SparseLDLSolver, SingularMatrixIsNotPerturbed) {
+   // [[1, 1], [1, 1]]: the second pivot cancels out
+   COOSymmetricMatrix<double> matrix(2, 3, false);
+   matrix.insert(1., 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(1., 1, 1);
+   SparseLDLSolver solver(2, 3, std::make_unique<FillReducingOrdering>("MD", "none"), 1);
+   solver.factorize(matrix);
+   ASSERT_TRUE(solver.matrix_is_singular());
+   ASSERT_EQ(solver.rank(), 1);
+
+   // consistent right-hand side: the solution is finite and solves the system
+   const std::vector<double> rhs{2., 2.};
+   std::vector<double> result(2);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   const std::vector<double> product = multiply(matrix, result);
+   for (size_t i: Range(2)) {
+      ASSERT_TRUE(std::isfinite(result[i]));
+      EXPECT_NEAR(product[i], rhs[i], ldl_tolerance);
+   }
+}
+
+TEST(SparseLDLSolver, TinyPivotIsNotZero) {
+   // augmented system of an interior-point method close to the solution: the dual pivot is tiny but nonzero
+   COOSymmetricMatrix<double> matrix(2, 3, false);
+   matrix.insert(1e10, 0, 0);
+   matrix.insert(1., 0, 1);
+   matrix.insert(-1e-8, 1, 1);
+   SparseLDLSolver solver(2, 3, std::make_unique<FillReducingOrdering>("MD", "none"), 1);
+   solver.factorize(matrix);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 1);
+   ASSERT_EQ(number_negative, 1);
+   ASSERT_EQ(number_zero, 0);
+}
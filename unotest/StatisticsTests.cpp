@@ -0,0 +1,83 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "tools/Statistics.hpp"
+
+Options statistics_options(const std::string& sink, const std::string& file) {
+   Options options;
+   options["statistics_sink"] = sink;
+   options["statistics_file"] = file;
+   options["statistics_print_header_every_iterations"] = "15";
+   return options;
+}
+
+TEST(Statistics, TypedColumns) {
+   const std::string file_name = "statistics_test.csv";
+   {
+      Statistics statistics(statistics_options("CSV", file_name));
+      statistics.add_column("iters", ColumnType::INTEGER, 1);
+      statistics.add_column("objective", ColumnType::DOUBLE, 100);
+      statistics.add_column("status", ColumnType::STRING, 50);
+      statistics.new_line();
+      ASSERT_TRUE(statistics.is_enabled());
+      statistics.add_statistic("iters", size_t(1));
+      statistics.add_statistic("objective", 0.5);
+      statistics.add_statistic("status", std::string("ok"));
+      // unregistered columns are ignored
+      statistics.add_statistic("unknown", 1.);
+      statistics.print_current_line();
+      statistics.new_line();
+      statistics.add_statistic("iters", 2);
+      statistics.print_current_line();
+      statistics.close();
+
+      ASSERT_EQ(statistics.number_lines(), 2);
+      const StatisticsColumn* objective = statistics.find_column("objective");
+      ASSERT_NE(objective, nullptr);
+      // the first line was written by the sink: it is no longer stored
+      ASSERT_FALSE(objective->has_value(0));
+      ASSERT_EQ(objective->format(1), "-");
+      ASSERT_EQ(statistics.find_column("iters")->format(1), "2");
+      ASSERT_EQ(statistics.find_column("unknown"), nullptr);
+   }
+   std::ifstream file(file_name);
+   std::stringstream contents;
+   contents << file.rdbuf();
+   std::remove(file_name.c_str());
+   ASSERT_EQ(contents.str(), "iters,status,objective\n1,\"ok\",0.5\n2,,\n");
+}
+
+TEST(Statistics, NoSinkDisablesCollection) {
+   Statistics statistics(statistics_options("none", "none"));
+   statistics.add_column("iters", ColumnType::INTEGER, 1);
+   statistics.new_line();
+   ASSERT_FALSE(statistics.is_enabled());
+   statistics.add_statistic("iters", 1);
+   ASSERT_EQ(statistics.number_lines(), 0);
+   ASSERT_FALSE(statistics.find_column("iters")->has_value(0));
+}
+
+TEST(Statistics, WrittenLinesAreDropped) {
+   const std::string file_name = "statistics_test.ndjson";
+   Statistics statistics(statistics_options("NDJSON", file_name));
+   statistics.add_column("iters", ColumnType::INTEGER, 1);
+   statistics.add_column("status", ColumnType::STRING, 50);
+   for (size_t iteration = 1; iteration <= 1000; iteration++) {
+      statistics.new_line();
+      statistics.add_statistic("iters", iteration);
+      statistics.add_statistic("status", std::string("ok"));
+      statistics.print_current_line();
+   }
+   statistics.close();
+   std::remove(file_name.c_str());
+   ASSERT_EQ(statistics.number_lines(), 1000);
+   // only the last line is stored
+   const StatisticsColumn* iters = statistics.find_column("iters");
+   ASSERT_EQ(iters->values.size(), 1);
+   ASSERT_EQ(statistics.find_column("status")->strings.size(), 1);
+   ASSERT_EQ(iters->format(999), "1000");
+}
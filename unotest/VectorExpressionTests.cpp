@@ -0,0 +1,59 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "linear_algebra/Vector.hpp"
+#include "linear_algebra/VectorExpression.hpp"
+
+const std::vector<double> x{1., -2., 3., -4.};
+const std::vector<double> y{0.5, 0.5, -1., 2.};
+
+TEST(VectorExpression, Leaf) {
+   const VectorExpression squares(x.size(), [&](size_t i) {
+      return x[i] * x[i];
+   });
+   ASSERT_EQ(squares.size(), 4);
+   ASSERT_EQ(squares[3], 16.);
+   ASSERT_EQ(norm_1(squares), 30.);
+}
+
+TEST(VectorExpression, Arithmetic) {
+   const auto expression = x + 2. * scale(1., y) - scale(3., x);
+   const std::vector<double> reference{-1., 5., -8., 12.};
+   for (size_t i: Range(x.size())) {
+      ASSERT_EQ(expression[i], reference[i]);
+   }
+   ASSERT_EQ(norm_inf(expression), 12.);
+}
+
+TEST(VectorExpression, MinMaxProjection) {
+   const auto minimum = componentwise_min(x, y);
+   const auto maximum = componentwise_max(x, y);
+   const auto projection = project(x, -1., 2.);
+   const std::vector<double> reference_minimum{0.5, -2., -1., -4.};
+   const std::vector<double> reference_maximum{1., 0.5, 3., 2.};
+   const std::vector<double> reference_projection{1., -1., 2., -1.};
+   for (size_t i: Range(x.size())) {
+      ASSERT_EQ(minimum[i], reference_minimum[i]);
+      ASSERT_EQ(maximum[i], reference_maximum[i]);
+      ASSERT_EQ(projection[i], reference_projection[i]);
+   }
+}
+
+TEST(VectorExpression, Subset) {
+   const std::vector<size_t> indices{1, 3};
+   const auto expression = subset(componentwise_max(x, y), indices);
+   ASSERT_EQ(expression.size(), 2);
+   ASSERT_EQ(expression[0], 0.5);
+   ASSERT_EQ(expression[1], 2.);
+   ASSERT_EQ(norm_1(expression), 2.5);
+}
+
+// the view of the indices is a temporary: it is stored by value
+TEST(VectorExpression, SubsetOfView) {
+   const std::vector<size_t> indices{3, 1, 0};
+   const auto expression = subset(x, view<size_t>(indices, 2));
+   ASSERT_EQ(expression.size(), 2);
+   ASSERT_EQ(expression[0], x[3]);
+   ASSERT_EQ(expression[1], x[1]);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "linear_algebra/Vector.hpp"
+#include "linear_algebra/VectorExpression.hpp"
+
+const double kernel_tolerance = 1e-10;
+
+// lengths that are not multiples of the vector width exercise the remainder loops
+std::vector<double> create_vector(size_t length, double shift) {
+   std::vector<double> x(length);
+   for (size_t i: Range(length)) {
+      x[i] = std::sin(static_cast<double>(i) + shift) * static_cast<double>(i % 5);
+   }
+   return x;
+}
+
+TEST(VectorKernels, Norms) {
+   for (size_t length: {0, 1, 7, 16, 37, 1001}) {
+      const std::vector<double> x = create_vector(length, 0.);
+      double reference_norm_1 = 0., reference_norm_2_squared = 0., reference_norm_inf = 0.;
+      for (double xi: x) {
+         reference_norm_1 += std::abs(xi);
+         reference_norm_2_squared += xi * xi;
+         reference_norm_inf = std::max(reference_norm_inf, std::abs(xi));
+      }
+      EXPECT_NEAR(norm_1(x), reference_norm_1, kernel_tolerance);
+      EXPECT_NEAR(norm_2_squared(x), reference_norm_2_squared, kernel_tolerance);
+      EXPECT_EQ(norm_inf(x), reference_norm_inf);
+   }
+}
+
+// a NaN entry makes the inf norm NaN, whether it lies in the vectorized part or in the remainder
+TEST(VectorKernels, NormInfNaN) {
+   for (size_t length: {1, 7, 16, 37, 1001}) {
+      for (size_t position: {size_t(0), length / 2, length - 1}) {
+         std::vector<double> x = create_vector(length, 0.);
+         x[position] = std::numeric_limits<double>::quiet_NaN();
+         EXPECT_TRUE(std::isnan(norm_inf(x))) << "length " << length << ", NaN at " << position;
+         // non-contiguous expression
+         EXPECT_TRUE(std::isnan(norm_inf(scale(2., x)))) << "length " << length << ", NaN at " << position;
+      }
+   }
+}
+
+TEST(VectorKernels, View) {
+   const std::vector<double> x = create_vector(100, 1.);
+   const view<double> first_elements(x, 45);
+   double reference_norm_1 = 0.;
+   for (size_t i: Range(45)) {
+      reference_norm_1 += std::abs(x[i]);
+   }
+   EXPECT_NEAR(norm_1(first_elements), reference_norm_1, kernel_tolerance);
+}
+
+TEST(VectorKernels, DotAndAddVectors) {
+   const size_t length = 43;
+   const std::vector<double> x = create_vector(length, 0.);
+   const std::vector<double> y = create_vector(length, 2.);
+   double reference_dot = 0.;
+   for (size_t i: Range(length)) {
+      reference_dot += x[i] * y[i];
+   }
+   EXPECT_NEAR(dot(x, y), reference_dot, kernel_tolerance);
+
+   std::vector<double> result(length);
+   add_vectors(x, y, -3., result);
+   for (size_t i: Range(length)) {
+      EXPECT_NEAR(result[i], x[i] - 3. * y[i], kernel_tolerance);
+   }
+   scale(result, 2.);
+   for (size_t i: Range(length)) {
+      EXPECT_NEAR(result[i], 2. * (x[i] - 3. * y[i]), kernel_tolerance);
+   }
+}
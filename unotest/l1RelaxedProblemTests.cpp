@@ -0,0 +1,91 @@
+// Copyright (c) 2018-2023 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "optimization/ModelFactory.hpp"
+#include "optimization/EqualityConstrainedModel.hpp"
+#include "reformulation/OptimalityProblem.hpp"
+#include "reformulation/l1RelaxedProblem.hpp"
+#include "ingredients/subproblem/interior_point_methods/PrimalDualInteriorPointSubproblem.hpp"
+#include "interfaces/NL/NLModel.hpp"
+#include "tools/Statistics.hpp"
+#include "ProjectionModel.hpp"
+
+// the elastic variables are eliminated from the augmented system: the recovered direction must solve the full system
+TEST(l1RelaxedProblem, EliminatedElasticVariables) {
+   const Options options = projection_model_options();
+   Statistics statistics(options);
+   const EqualityConstrainedModel model(std::make_unique<NLModel>("examples/hs015.nl"));
+   const OptimalityProblem optimality_problem(model);
+   const l1RelaxedProblem feasibility_problem(model, 0., 1.);
+   ASSERT_EQ(feasibility_problem.elastic_variables.size(), 2 * model.number_constraints);
+
+   PrimalDualInteriorPointSubproblem subproblem(statistics, feasibility_problem.number_variables, feasibility_problem.number_constraints,
+         feasibility_problem.get_number_jacobian_nonzeros(), feasibility_problem.get_number_hessian_nonzeros(), options);
+   Iterate iterate(feasibility_problem.number_variables, feasibility_problem.number_constraints);
+   model.get_initial_primal_point(iterate.primals);
+   subproblem.generate_initial_iterate(optimality_problem, iterate);
+   subproblem.initialize_feasibility_problem();
+   subproblem.set_elastic_variable_values(feasibility_problem, iterate);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   const Direction direction = subproblem.solve(statistics, feasibility_problem, iterate, warmstart_information);
+
+   std::vector<double> constraints(model.number_constraints);
+   model.evaluate_constraints(iterate.primals, constraints);
+   RectangularMatrix<double> constraint_jacobian(model.number_constraints, SparseVector<double>(model.number_variables));
+   model.evaluate_constraint_jacobian(iterate.primals, constraint_jacobian);
+   // linearized relaxed constraints: c(x) + ∇c(x)^T d - (p + Δp) + (n + Δn) = 0
+   std::vector<double> linearized_constraints(constraints);
+   for (size_t j: Range(model.number_constraints)) {
+      constraint_jacobian[j].for_each([&](size_t i, double derivative) {
+         linearized_constraints[j] += derivative * direction.primals[i];
+      });
+   }
+   const double damping_factor = options.get_double("barrier_damping_factor");
+   const auto check_elastic = [&](size_t j, size_t elastic_index, double jacobian_coefficient) {
+      const double elastic = iterate.primals[elastic_index];
+      linearized_constraints[j] += jacobian_coefficient * (elastic + direction.primals[elastic_index]);
+
+      // row of the elastic variable: (z/e) Δe - a Δy_j = -(1 - μ/e + κμ) + a y_j with μ = z e
+      const double multiplier = iterate.multipliers.lower_bounds[elastic_index];
+      const double barrier_parameter = multiplier * elastic;
+      const double lhs = multiplier / elastic * direction.primals[elastic_index] - jacobian_coefficient * direction.multipliers.constraints[j];
+      const double rhs = -(1. - barrier_parameter / elastic + damping_factor * barrier_parameter) +
+            jacobian_coefficient * iterate.multipliers.constraints[j];
+      EXPECT_NEAR(lhs, rhs, 1e-10);
+   };
+   feasibility_problem.elastic_variables.positive.for_each([&](size_t j, size_t elastic_index) {
+      check_elastic(j, elastic_index, -1.);
+   });
+   feasibility_problem.elastic_variables.negative.for_each([&](size_t j, size_t elastic_index) {
+      check_elastic(j, elastic_index, 1.);
+   });
+   for (size_t j: Range(model.number_constraints)) {
+      EXPECT_NEAR(linearized_constraints[j], model.get_constraint_lower_bound(j), 1e-10);
+   }
+}
+
+// the derivatives are views on the evaluations of the iterate. The elastic columns are only materialized on demand
+TEST(l1RelaxedProblem, DerivativeViews) {
+   const EqualityConstrainedModel model(std::make_unique<NLModel>("examples/hs015.nl"));
+   const OptimalityProblem optimality_problem(model);
+   const l1RelaxedProblem feasibility_problem(model, 0., 1.);
+   Iterate iterate(feasibility_problem.number_variables, feasibility_problem.number_constraints);
+   model.get_initial_primal_point(iterate.primals);
+   SparseVector<double> objective_gradient(feasibility_problem.number_variables);
+   RectangularMatrix<double> constraint_jacobian(feasibility_problem.number_constraints, SparseVector<double>(feasibility_problem.number_variables));
+
+   EXPECT_EQ(&optimality_problem.evaluate_objective_gradient(iterate, objective_gradient), &iterate.evaluations.objective_gradient);
+   EXPECT_EQ(&optimality_problem.evaluate_constraint_jacobian(iterate, constraint_jacobian), &iterate.evaluations.constraint_jacobian);
+   EXPECT_EQ(&feasibility_problem.evaluate_original_constraint_jacobian(iterate), &iterate.evaluations.constraint_jacobian);
+
+   // explicit elastic columns
+   const RectangularMatrix<double>& relaxed_jacobian = feasibility_problem.evaluate_constraint_jacobian(iterate, constraint_jacobian);
+   ASSERT_EQ(&relaxed_jacobian, &constraint_jacobian);
+   for (size_t j: Range(model.number_constraints)) {
+      EXPECT_EQ(relaxed_jacobian[j].size(), iterate.evaluations.constraint_jacobian[j].size() + 2);
+   }
+   // the objective is the l1 norm of the elastic variables
+   EXPECT_EQ(feasibility_problem.evaluate_objective_gradient(iterate, objective_gradient).size(), feasibility_problem.elastic_variables.size());
+}
@@ -4,7 +4,7 @@
 #include <gtest/gtest.h>
 #include "tools/Logger.hpp"
 
-Level Logger::level = INFO;
+thread_local Level Logger::level = INFO;
 
 // https://www.eriksmistad.no/getting-started-with-google-test-on-ubuntu/
 int main(int argc, char **argv) {